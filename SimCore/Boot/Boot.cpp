@@ -44,6 +44,8 @@ namespace simboot {
             return false;
         }
 
+        dw.SetUserBaseSnapshot(opts.user_base_snapshot);
+
         // 3) Sync Sys/ + User/ from base into our user dir; reload configs & re-init pads
         if (!dw.SyncFromDolphinQtBase(opts.force_resync_from_base, &err)) {
             if (error_out) *error_out = "SyncFromDolphinQtBase failed: " + err;
@@ -0,0 +1,83 @@
+#include "BranchExecutor.h"
+#include <stdexcept>
+
+namespace simcore {
+
+    BranchTreeExecutor::BranchTreeExecutor(BranchSpec spec) : m_spec(std::move(spec)) {
+        if (auto err = BranchExplorer::validate_spec(m_spec); !err.empty())
+            throw std::invalid_argument("BranchSpec invalid: " + err);
+    }
+
+    BranchExecStats BranchTreeExecutor::run(IBranchHost& host, const LeafCallback& on_leaf, const NodeCallback& on_node) {
+        m_host = &host;
+        m_leaf = &on_leaf;
+        m_node = &on_node;
+        m_stats = {};
+        m_path.clear();
+        m_path.reserve(m_spec.decisions.size());
+        m_frame = 0;
+
+        m_stats.stopped = !walk(0, 0);
+        m_stats.naive_frames = m_stats.leaves * m_spec.total_frames;
+
+        m_host = nullptr;
+        m_leaf = nullptr;
+        m_node = nullptr;
+        return m_stats;
+    }
+
+    bool BranchTreeExecutor::step_to(uint32_t end) {
+        for (; m_frame < end; ++m_frame) {
+            if (!m_host->step(m_spec.default_frame)) return false;
+            ++m_stats.frames_stepped;
+        }
+        return true;
+    }
+
+    // false => stop the whole walk (callback said so, or the host failed)
+    bool BranchTreeExecutor::walk(size_t decision, size_t depth) {
+        const auto& decisions = m_spec.decisions;
+        const uint32_t next = decision < decisions.size() ? decisions[decision].frame_index : m_spec.total_frames;
+        if (!step_to(next)) return false;
+
+        if (decision == decisions.size()) {
+            ++m_stats.leaves;
+            return !*m_leaf || (*m_leaf)(m_path);
+        }
+        if (*m_node && !(*m_node)(next, m_path)) return true;
+
+        const DecisionPoint& dp = decisions[decision];
+        const bool fan = dp.options.size() > 1;
+        if (fan) {
+            if (!m_host->save_slot(depth)) return false;
+            ++m_stats.snapshots_saved;
+        }
+
+        for (size_t o = 0; o < dp.options.size(); ++o) {
+            if (o > 0) {
+                if (!m_host->load_slot(depth)) return false;
+                ++m_stats.snapshots_loaded;
+                m_frame = dp.frame_index;
+            }
+            if (!m_host->step(dp.options[o])) return false;
+            ++m_stats.frames_stepped;
+            ++m_frame;
+
+            m_path.emplace_back(dp.frame_index, o);
+            const bool go = walk(decision + 1, fan ? depth + 1 : depth);
+            m_path.pop_back();
+            if (!go) return false;
+        }
+        return true;
+    }
+
+    BranchSpec BranchSubtree(const BranchSpec& spec, size_t decision, size_t option) {
+        BranchSpec out = spec;
+        if (decision < out.decisions.size() && option < out.decisions[decision].options.size()) {
+            auto& opts = out.decisions[decision].options;
+            opts = { opts[option] };
+        }
+        return out;
+    }
+
+} // namespace simcore
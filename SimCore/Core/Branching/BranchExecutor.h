@@ -0,0 +1,68 @@
+#pragma once
+#include "Branching.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace simcore {
+
+    // What the executor needs from an emulator: numbered snapshot slots and single-frame stepping.
+    // Slot `depth` is only ever reloaded while no deeper slot is live, so a stack of buffers suffices.
+    class IBranchHost {
+    public:
+        virtual ~IBranchHost() = default;
+        virtual bool save_slot(size_t slot) = 0;
+        virtual bool load_slot(size_t slot) = 0;
+        virtual bool step(const GCInputFrame& f) = 0;   // apply `f`, advance one frame
+    };
+
+    struct BranchExecStats {
+        uint64_t frames_stepped{ 0 };
+        uint64_t snapshots_saved{ 0 };
+        uint64_t snapshots_loaded{ 0 };
+        uint64_t leaves{ 0 };
+        uint64_t naive_frames{ 0 };   // leaves * total_frames: what replaying every branch from frame 0 costs
+        bool stopped{ false };        // a callback asked to stop, or the host failed
+    };
+
+    // Depth-first execution of a BranchSpec from the host's current state (frame 0).
+    //
+    // Each segment between decisions is emulated once per tree node instead of once per leaf: the state
+    // in front of a DecisionPoint with >1 option is snapshotted, each option is fanned out from it, and
+    // single-option decisions are stepped through without one. Plans are never materialized; the path
+    // is reported as (frame_index, option_index) pairs like BranchInstance::chosen.
+    //
+    // With d decisions of k options the cost is sum over tree levels of k^level * segment length,
+    // versus k^d * total_frames for BranchExplorer replays.
+    class BranchTreeExecutor {
+    public:
+        using Path = std::vector<std::pair<uint32_t, size_t>>;
+
+        // Called at frame total_frames with the host paused there; false stops the walk.
+        using LeafCallback = std::function<bool(const Path& chosen)>;
+        // Called in front of decision `frame` before any option is taken; false skips its subtree.
+        using NodeCallback = std::function<bool(uint32_t frame, const Path& chosen)>;
+
+        explicit BranchTreeExecutor(BranchSpec spec);   // throws std::invalid_argument like BranchExplorer
+
+        BranchExecStats run(IBranchHost& host, const LeafCallback& on_leaf, const NodeCallback& on_node = nullptr);
+
+    private:
+        bool walk(size_t decision, size_t depth);
+        bool step_to(uint32_t end);
+
+        BranchSpec m_spec;
+        IBranchHost* m_host = nullptr;
+        const LeafCallback* m_leaf = nullptr;
+        const NodeCallback* m_node = nullptr;
+        BranchExecStats m_stats;
+        Path m_path;
+        uint32_t m_frame = 0;
+    };
+
+    // `spec` with decision `decision` pinned to option `option`: one shard of the tree per job.
+    BranchSpec BranchSubtree(const BranchSpec& spec, size_t decision, size_t option);
+
+} // namespace simcore
@@ -11,6 +11,21 @@ namespace simcore {
         return m;
     }
 
+    static bool same_frame(const GCInputFrame& a, const GCInputFrame& b) {
+        return a.buttons == b.buttons && a.main_x == b.main_x && a.main_y == b.main_y
+            && a.c_x == b.c_x && a.c_y == b.c_y && a.trig_l == b.trig_l && a.trig_r == b.trig_r;
+    }
+
+    BranchSpec BranchSpecFromPlan(const InputPlan& plan, const GCInputFrame& default_frame) {
+        BranchSpec spec;
+        spec.total_frames = static_cast<uint32_t>(plan.size());
+        spec.default_frame = default_frame;
+        for (uint32_t i = 0; i < spec.total_frames; ++i)
+            if (!same_frame(plan[i], default_frame))
+                spec.decisions.push_back(DecisionPoint{ i, { plan[i] } });
+        return spec;
+    }
+
     bool BranchExplorer::is_sorted_unique(const std::vector<DecisionPoint>& d) {
         for (size_t i = 1; i < d.size(); ++i)
             if (d[i - 1].frame_index >= d[i].frame_index) return false;
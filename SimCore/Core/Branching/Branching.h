@@ -22,6 +22,11 @@ namespace simcore {
         std::vector<DecisionPoint> decisions; // sorted by frame_index, unique
     };
 
+    // Skeleton that reproduces `plan` exactly: every frame that differs from `default_frame` becomes a
+    // single-option decision, so alternatives can be appended to the options of the frames to branch on.
+    // Frames equal to the default get no decision; insert one (keeping the order) to branch there.
+    BranchSpec BranchSpecFromPlan(const InputPlan& plan, const GCInputFrame& default_frame = GCInputFrame{});
+
     // A single concrete expansion (materialized)
     struct BranchInstance {
         InputPlan plan; // length == total_frames
@@ -41,6 +46,9 @@ namespace simcore {
         using PerFrameCallback = std::function<bool(uint32_t frame_idx, const GCInputFrame& frame)>;
         size_t for_each_branch(const PerFrameCallback& cb);
 
+        // Empty if `s` is usable, else the reason.
+        static std::string validate_spec(const BranchSpec& s);
+
     private:
         BranchSpec m_spec;
 
@@ -51,7 +59,6 @@ namespace simcore {
 
 
         static bool is_sorted_unique(const std::vector<DecisionPoint>& d);
-        static std::string validate_spec(const BranchSpec& s);
 
         BranchInstance materialize_with_indices(const std::vector<size_t>& choice_idx) const;
     };
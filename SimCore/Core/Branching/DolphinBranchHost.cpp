@@ -0,0 +1,20 @@
+#include "DolphinBranchHost.h"
+
+namespace simcore {
+
+    bool DolphinBranchHost::save_slot(size_t slot) {
+        if (slot >= m_slots.size()) m_slots.resize(slot + 1);
+        return m_host.saveStateToBuffer(m_slots[slot]);
+    }
+
+    bool DolphinBranchHost::load_slot(size_t slot) {
+        if (slot >= m_slots.size() || m_slots[slot].empty()) return false;
+        return m_host.loadStateFromBuffer(m_slots[slot]);
+    }
+
+    bool DolphinBranchHost::step(const GCInputFrame& f) {
+        m_host.setInput(f);
+        return m_host.stepOneFrameBlocking(m_step_timeout_ms);
+    }
+
+} // namespace simcore
@@ -0,0 +1,26 @@
+#pragma once
+#include "BranchExecutor.h"
+#include "../DolphinWrapper.h"
+
+namespace simcore {
+
+    // IBranchHost over a paused DolphinWrapper: slots are in-memory savestates (kept and reused across
+    // runs, so a walk allocates once per depth), steps are setInput + stepOneFrameBlocking.
+    class DolphinBranchHost : public IBranchHost {
+    public:
+        explicit DolphinBranchHost(DolphinWrapper& host, int step_timeout_ms = 1000)
+            : m_host(host), m_step_timeout_ms(step_timeout_ms) {}
+
+        bool save_slot(size_t slot) override;
+        bool load_slot(size_t slot) override;
+        bool step(const GCInputFrame& f) override;
+
+        void set_step_timeout_ms(int ms) { m_step_timeout_ms = ms; }
+
+    private:
+        DolphinWrapper& m_host;
+        int m_step_timeout_ms;
+        std::vector<Common::UniqueBuffer<u8>> m_slots;
+    };
+
+} // namespace simcore
@@ -6,6 +6,7 @@
 #include <filesystem>
 #include <fstream>
 #include "../Utils/SafeEnv.h"
+#include "../Utils/SharedUserBase.h"
 #include "../Utils/Log.h"
 #include "../Utils/Time.h"
 #include "../Runner/IPC/Wire.h"
@@ -390,6 +391,21 @@ namespace simcore {
         return ok;
     }
 
+    bool DolphinWrapper::startMoviePlaybackFromBuffer(const std::vector<uint8_t>& dtm)
+    {
+        const fs::path scratch = m_user_dir / "Movies" / "simcore_play.dtm";
+        std::error_code ec;
+        fs::create_directories(scratch.parent_path(), ec);
+        {
+            std::ofstream f(scratch, std::ios::binary | std::ios::trunc);
+            if (!f || !f.write(reinterpret_cast<const char*>(dtm.data()), (std::streamsize)dtm.size())) {
+                SCLOGE("[Movie] could not stage %zu DTM bytes at %s", dtm.size(), scratch.string().c_str());
+                return false;
+            }
+        }
+        return startMoviePlayback(scratch.string());
+    }
+
     bool DolphinWrapper::endMoviePlaybackBlocking(uint32_t timeout_ms)
     {
         
@@ -629,9 +645,22 @@ namespace simcore {
         if (m_imported_from_qt && !force) return true;
 
         std::string err;
-        const fs::path base_user = m_qt_base_dir / "User";
-        if (!require_exists_dir(base_user, "User", &err)) { if (error_out) *error_out = err; return false; }
-        if (!copy_tree(base_user, m_user_dir, &err)) { if (error_out) *error_out = err; return false; }
+        if (!m_user_base_snapshot.empty()) {
+            const auto t0 = std::chrono::steady_clock::now();
+            UserLinkStats st{};
+            if (!LinkUserDirFromSnapshot(m_user_base_snapshot, m_user_dir, force, &st, &err)) { if (error_out) *error_out = err; return false; }
+            SCLOGD("[user] %s from %s in %llu ms: %llu linked (%llu KiB), %llu copied (%llu KiB), %llu link fallbacks",
+                st.reused ? "reused" : "linked", m_user_base_snapshot.filename().string().c_str(),
+                (unsigned long long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count(),
+                (unsigned long long)st.files_linked, (unsigned long long)(st.bytes_linked >> 10),
+                (unsigned long long)st.files_copied, (unsigned long long)(st.bytes_copied >> 10),
+                (unsigned long long)st.link_fallbacks);
+        }
+        else {
+            const fs::path base_user = m_qt_base_dir / "User";
+            if (!require_exists_dir(base_user, "User", &err)) { if (error_out) *error_out = err; return false; }
+            if (!copy_tree(base_user, m_user_dir, &err)) { if (error_out) *error_out = err; return false; }
+        }
 
         SConfig::GetInstance().LoadSettings();
         if (m_system_pad_is_inited)
@@ -718,6 +747,25 @@ namespace simcore {
         return true;
     }
 
+    bool simcore::DolphinWrapper::readBlock(uint32_t addr, void* dst, size_t n) const
+    {
+        if (!isRunning()) return false;
+
+        if (Core::GetState(*m_system) == Core::State::Paused)
+        {
+            auto& mem = m_system->GetMemory();
+            mem.CopyFromEmu(dst, addr, n);
+        }
+        else {
+            Core::CPUThreadGuard guard(Core::System::GetInstance());
+            auto& mem = guard.GetSystem().GetMemory();
+            mem.CopyFromEmu(dst, addr, n);
+        }
+
+        SCLOGT("[mem read] Successfully read %zu bytes @0x%08X", n, addr);
+        return true;
+    }
+
     bool simcore::DolphinWrapper::readU64(uint32_t addr, uint64_t& out) const
     {
         if (!isRunning()) return false;
@@ -994,6 +1042,7 @@ namespace simcore {
         resetViCounterBaseline();
         uint64_t last_vi = getViFieldCountApprox();
         auto last_vi_change = steady_clock::now();
+        m_last_run_max_vi_gap_ms = 0;
 
         const ProgressSink& emit = sink ? sink : m_progress_sink; // toggle: null = no progress
         auto last_emit = steady_clock::time_point{};
@@ -1021,6 +1070,11 @@ namespace simcore {
         while (true)
         {
             const auto now = steady_clock::now();
+            if (abortRequested()) {
+                Core::SetState(*m_system, Core::State::Paused);
+                SCLOGD("[DW/run] ABORTED polls=%zu pc=%08X", polls, getPC());
+                return { false, 0u, "aborted" };
+            }
             if (now >= deadline) {
                 // TIMEOUT: enforce postcondition (Paused) then return
                 Core::SetState(*m_system, Core::State::Paused);
@@ -1058,8 +1112,22 @@ namespace simcore {
                     return { false, 0u, "movie_ended" };
                 }
 
-                // VI-stall detection
-                if (vi_stall_ms > 0) {
+                // Movie checkpoint due: pause, let the sink save, then go round the paused branch
+                // (a BP that landed on the same pause still wins there) which resumes the core.
+                if (had_movie && m_ckpt_every_vi && movie.GetCurrentFrame() >= m_ckpt_next_frame) {
+                    Core::SetState(*m_system, Core::State::Paused);
+                    const uint64_t frame = movie.GetCurrentFrame();
+                    m_ckpt_sink(frame, movie.GetCurrentInputCount());
+                    m_ckpt_next_frame = frame + m_ckpt_every_vi;
+
+                    const auto spent = steady_clock::now() - now;
+                    deadline += spent;
+                    last_vi_change += spent;
+                    continue;
+                }
+
+                // VI-stall detection (the gap is tracked even when disabled; it feeds learned stall windows)
+                {
                     const uint64_t vi_now = getViFieldCountApprox();
                     if (vi_now != last_vi) {
                         last_vi = vi_now;
@@ -1067,7 +1135,8 @@ namespace simcore {
                     }
                     else {
                         const auto since_ms = std::chrono::duration_cast<milliseconds>(now - last_vi_change).count();
-                        if (since_ms >= vi_stall_ms) {
+                        m_last_run_max_vi_gap_ms = std::max<uint32_t>(m_last_run_max_vi_gap_ms, (uint32_t)since_ms);
+                        if (vi_stall_ms > 0 && since_ms >= vi_stall_ms) {
                             Core::SetState(*m_system, Core::State::Paused); // ensure postcondition
                             SCLOGD("[DW/run] VI_STALLED polls=%zu pc=%08X", polls, getPC());
                             return { false, 0u, "vi_stalled" };
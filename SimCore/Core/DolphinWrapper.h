@@ -82,6 +82,8 @@ namespace simcore {
         const std::filesystem::path& GetUserDirectory() const { return m_user_dir; }
         const std::filesystem::path& GetDolphinQtBaseDir() const { return m_qt_base_dir; }
         bool SyncFromDolphinQtBase(bool force = false, std::string* error_out = nullptr);
+        // Sync links User from this PrepareUserBaseSnapshot snapshot instead of copying the base's User.
+        void SetUserBaseSnapshot(const std::filesystem::path& snapshot) { m_user_base_snapshot = snapshot; }
         bool EnsureReadyForSavestate(std::string* error_out = nullptr) {
             return SyncFromDolphinQtBase(/*force=*/false, error_out);
         }
@@ -101,6 +103,7 @@ namespace simcore {
         bool readU64(uint32_t addr, uint64_t& out) const;
         bool readF32(uint32_t addr, float& out) const;
         bool readF64(uint32_t addr, double& out) const;
+        bool readBlock(uint32_t addr, void* dst, size_t n) const; // raw big-endian bytes
 
         // Resolve an address key to a VA using the paused core's memory (no MEM1 copy).
         bool resolveKey(addr::AddrKey k, uint32_t& out_va) const;
@@ -138,6 +141,25 @@ namespace simcore {
             uint32_t poll_ms = 0,
             ProgressSink sink = nullptr);
 
+        // External abort: runUntilBreakpointFlexible returns "aborted" (core paused) at its next poll.
+        // Safe to call from any thread; the owner clears it between jobs.
+        void requestAbort() { m_abort.store(true, std::memory_order_release); }
+        void clearAbort() { m_abort.store(false, std::memory_order_release); }
+        bool abortRequested() const { return m_abort.load(std::memory_order_acquire); }
+
+        // Movie checkpoints: while a movie plays, runUntilBreakpointFlexible pauses every `every_vi` movie
+        // frames, hands the movie's (frame, input polls) to the sink - which may save a state - and then
+        // carries on; time spent in the sink does not count against the run's timeout. 0 disables.
+        using CheckpointSink = std::function<void(uint64_t frame, uint64_t polls)>;
+        void setMovieCheckpointSink(uint32_t every_vi, CheckpointSink sink) {
+            m_ckpt_every_vi = sink ? every_vi : 0;
+            m_ckpt_sink = std::move(sink);
+            m_ckpt_next_frame = every_vi;
+        }
+
+        // Longest stretch without a VI field advance observed by the last runUntilBreakpointFlexible call.
+        uint32_t lastRunMaxViGapMs() const { return m_last_run_max_vi_gap_ms; }
+
         uint32_t pickPollIntervalMs(uint32_t timeout_ms);
         static uint32_t pickPollIntervalMsForTimeLeft(uint32_t timeout_ms, uint32_t time_left_ms);
 
@@ -148,6 +170,9 @@ namespace simcore {
         void restoreStdOutInfo();
 
         bool startMoviePlayback(const std::string& dtm_path);
+        // Plays DTM bytes already in memory. Dolphin only opens movies by path, so the bytes go to one
+        // scratch file in this worker's User dir that every call overwrites (never a file per movie).
+        bool startMoviePlaybackFromBuffer(const std::vector<uint8_t>& dtm);
         bool endMoviePlaybackBlocking(uint32_t timeout_ms = 4000);
         bool setGCMemoryCardA(const std::string& raw_path);
 
@@ -173,10 +198,16 @@ namespace simcore {
 
         std::filesystem::path m_user_dir;
         std::filesystem::path m_qt_base_dir;
+        std::filesystem::path m_user_base_snapshot;
         bool m_imported_from_qt = false;
         void sterilizeConfigs();
 
         ProgressSink m_progress_sink{};
+        CheckpointSink m_ckpt_sink{};
+        uint32_t m_ckpt_every_vi{ 0 };
+        uint64_t m_ckpt_next_frame{ 0 };
+        std::atomic<bool> m_abort{ false };
+        uint32_t m_last_run_max_vi_gap_ms{ 0 };
     };
 
 } // namespace simcore
@@ -2,7 +2,7 @@
 
 namespace soa::battle::actions {
 
-    bool ActionLibrary::generateTurnPlan(const soa::battle::ctx::BattleContext& bc,
+    bool ActionLibrary::generateTurnPlan(const soa::battle::ctx::BattleContextView& bc,
         const TurnPlan& plan,
         simcore::InputPlan& out,
         MaterializeErr& err)
@@ -2,12 +2,12 @@
 #include "ActionTypes.h"
 #include "PlanWriter.h"
 #include "../../../Core/Input/InputPlan.h"
-#include "../../Memory/Soa/Battle/BattleContext.h"
+#include "../../Memory/Soa/Battle/BattleContextView.h"
 
 namespace soa::battle::actions {
 
     struct ActionLibrary {
-        static bool generateTurnPlan(const soa::battle::ctx::BattleContext& bc,
+        static bool generateTurnPlan(const soa::battle::ctx::BattleContextView& bc,
             const TurnPlan& plan,
             simcore::InputPlan& out,
             MaterializeErr& err);
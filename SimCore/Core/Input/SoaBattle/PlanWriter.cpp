@@ -10,7 +10,7 @@ namespace soa::battle::actions {
         p.push_back(GCInputFrame{}); // enforce neutral between identical presses
     }
 
-    PlanWriter::PlanWriter(const soa::battle::ctx::BattleContext& bc) : bc_(bc) {}
+    PlanWriter::PlanWriter(const soa::battle::ctx::BattleContextView& bc) : bc_(bc) {}
 
     void PlanWriter::tapA(InputPlan& p) { push_btn(p, simcore::GC_A); }
     void PlanWriter::tapB(InputPlan& p) { push_btn(p, simcore::GC_B); }
@@ -25,7 +25,7 @@ namespace soa::battle::actions {
     }
 
     int PlanWriter::firstAliveEnemyIndex() const {
-        for (int i = 4; i < 12; ++i) if (bc_.slots[i].present && !bc_.slots[i].is_player) return i - 4;
+        for (int i = 4; i < 12; ++i) if (bc_.present(i) && !bc_.is_player(i)) return i - 4;
         return -1;
     }
 
@@ -39,7 +39,7 @@ namespace soa::battle::actions {
         if (base < 0) return -1;
         if (!mask) return base;
         for (int i = 4; i < 12; ++i) {
-            if (bc_.slots[i].present && bc_.slots[i].is_alive && !bc_.slots[i].is_player) {
+            if (bc_.present(i) && bc_.is_alive(i) && !bc_.is_player(i)) {
                 if (mask & (1u << (i & 31u))) return i - 4;
             }
         }
@@ -101,7 +101,7 @@ namespace soa::battle::actions {
     }
 
     bool PlanWriter::if_stop_rotate() {
-        return bc_.turn_count == 1 && bc_.battle_phase == 4;
+        return bc_.turn_count() == 1 && bc_.battle_phase() == 4;
     }
 
     bool PlanWriter::buildTurn(const TurnPlan& plan, InputPlan& out, MaterializeErr& err) {
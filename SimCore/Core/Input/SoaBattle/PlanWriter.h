@@ -2,7 +2,7 @@
 #include <cstdint>
 #include <vector>
 #include "../InputPlan.h"
-#include "../../Memory/Soa/Battle/BattleContext.h"
+#include "../../Memory/Soa/Battle/BattleContextView.h"
 #include "ActionTypes.h"
 
 namespace soa::battle::actions {
@@ -32,12 +32,13 @@ namespace soa::battle::actions {
 
     class PlanWriter {
     public:
-        PlanWriter(const soa::battle::ctx::BattleContext& bc);
+        // `bc` is only read while building turns and must outlive the writer.
+        PlanWriter(const soa::battle::ctx::BattleContextView& bc);
 
         bool buildTurn(const TurnPlan& plan, simcore::InputPlan& out, MaterializeErr& err);
 
     private:
-        soa::battle::ctx::BattleContext bc_;
+        const soa::battle::ctx::BattleContextView& bc_;
         uint8_t cmd_index_ = 3; // Attack
         uint8_t actor_slot_ = 0;
 
@@ -4,7 +4,9 @@
 #include <cstring>
 #include <type_traits>
 #include <tuple>
-#include "SoaStructs.reflect.h"  // generated file
+#include "Soa/SoaStructs.reflect.h"  // generated file
+#include "Soa/SoaStructs.swapmask.h" // generated file
+#include "SwapPlan.h"
 
 namespace simcore::endian {
 
@@ -105,4 +107,29 @@ namespace simcore::endian {
         }
     }
 
+    // Whole-image swap from the generated swap plan (16-byte shuffles) where T has one; otherwise
+    // the member-by-member reflection walk above. Same result either way.
+    template <class T>
+    inline void fix_endianness_fast(T& v) {
+        if constexpr (has_swap_plan<T>::value) {
+            apply_swap_plan(&v, 1);
+        }
+        else {
+            fix_endianness_in_place(v);
+        }
+    }
+
+    // Batch form: `n` structs, `stride` bytes apart (sizeof(T) for a plain array; larger when each
+    // T is a member of an array of records).
+    template <class T>
+    inline void fix_endianness_array(T* first, size_t n, size_t stride = sizeof(T)) {
+        if constexpr (has_swap_plan<T>::value) {
+            apply_swap_plan(first, n, stride);
+        }
+        else {
+            auto* p = reinterpret_cast<uint8_t*>(first);
+            for (size_t i = 0; i < n; ++i) fix_endianness_in_place(*reinterpret_cast<T*>(p + i * stride));
+        }
+    }
+
 } // namespace simcore::endian
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "MemView.h"
+
+namespace simcore {
+
+    // Big-endian reads of emulated memory by virtual address, wherever it lives: a MEM1 copy
+    // (MemViewGuestMemory) or the paused core itself (DolphinGuestMemory, Core/Memory/KeyHostRouter.h).
+    class IGuestMemory {
+    public:
+        virtual ~IGuestMemory() = default;
+        virtual bool read_u8(uint32_t va, uint8_t& out) const = 0;
+        virtual bool read_u16(uint32_t va, uint16_t& out) const = 0;
+        virtual bool read_u32(uint32_t va, uint32_t& out) const = 0;
+        virtual bool read_block(uint32_t va, void* dst, size_t n) const = 0;   // raw bytes, no swapping
+        virtual bool in_mem1(uint32_t va) const {
+            return va >= MemView::kMem1Base && va < MemView::kMem1Base + MemView::kMem1Size;
+        }
+    };
+
+    class MemViewGuestMemory final : public IGuestMemory {
+    public:
+        explicit MemViewGuestMemory(const MemView& view) : view_(view) {}
+
+        bool read_u8(uint32_t va, uint8_t& out) const override { return view_.read_u8(va, out); }
+        bool read_u16(uint32_t va, uint16_t& out) const override { return view_.read_u16(va, out); }
+        bool read_u32(uint32_t va, uint32_t& out) const override { return view_.read_u32(va, out); }
+        bool read_block(uint32_t va, void* dst, size_t n) const override { return view_.read_block(va, dst, n); }
+
+    private:
+        MemView view_;
+    };
+
+} // namespace simcore
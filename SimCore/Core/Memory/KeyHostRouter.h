@@ -3,6 +3,7 @@
 #include "Soa/SoaAddrRegistry.h"
 #include "../../Core/DolphinWrapper.h"
 #include "DerivedBase.h"
+#include "GuestMemory.h"
 
 namespace simcore {
 
@@ -23,6 +24,18 @@ namespace simcore {
         const simcore::DolphinWrapper* host_{};
     };
 
+    // Reads straight from the paused core; no MEM1 copy.
+    class DolphinGuestMemory final : public IGuestMemory {
+    public:
+        explicit DolphinGuestMemory(const simcore::DolphinWrapper* host) : host_(host) {}
+        bool read_u8(uint32_t va, uint8_t& out) const override { return host_ && host_->readU8(va, out); }
+        bool read_u16(uint32_t va, uint16_t& out) const override { return host_ && host_->readU16(va, out); }
+        bool read_u32(uint32_t va, uint32_t& out) const override { return host_ && host_->readU32(va, out); }
+        bool read_block(uint32_t va, void* dst, size_t n) const override { return host_ && host_->readBlock(va, dst, n); }
+    private:
+        const simcore::DolphinWrapper* host_{};
+    };
+
     class KeyHostRouter {
     public:
         KeyHostRouter(const DolphinKeyReader* mem1, const IDerivedBuffer* derived)
@@ -0,0 +1,174 @@
+#include "MemDiff.h"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include "Soa/SoaAddrRegistry.h"
+#include "Soa/SoaStructs.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define SIMCORE_DIFF_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace simcore {
+
+    // Bit i set = byte i of the 64-byte block differs. Zero for equal blocks, which take one
+    // movemask: the four compares are ANDed before anything is extracted.
+    static inline uint64_t block_diff_mask(const uint8_t* a, const uint8_t* b)
+    {
+#if defined(SIMCORE_DIFF_SSE2)
+        const __m128i e0 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + 0)), _mm_loadu_si128((const __m128i*)(b + 0)));
+        const __m128i e1 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + 16)), _mm_loadu_si128((const __m128i*)(b + 16)));
+        const __m128i e2 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + 32)), _mm_loadu_si128((const __m128i*)(b + 32)));
+        const __m128i e3 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + 48)), _mm_loadu_si128((const __m128i*)(b + 48)));
+        const __m128i all = _mm_and_si128(_mm_and_si128(e0, e1), _mm_and_si128(e2, e3));
+        if (_mm_movemask_epi8(all) == 0xFFFF) return 0;
+
+        const uint64_t eq = uint64_t(uint16_t(_mm_movemask_epi8(e0)))
+            | (uint64_t(uint16_t(_mm_movemask_epi8(e1))) << 16)
+            | (uint64_t(uint16_t(_mm_movemask_epi8(e2))) << 32)
+            | (uint64_t(uint16_t(_mm_movemask_epi8(e3))) << 48);
+        return ~eq;
+#else
+        if (std::memcmp(a, b, 64) == 0) return 0;
+        uint64_t m = 0;
+        for (int i = 0; i < 64; ++i) m |= uint64_t(a[i] != b[i]) << i;
+        return m;
+#endif
+    }
+
+    namespace {
+        struct RangeSink {
+            std::vector<MemDiffRange>& out;
+            uint32_t base_va;
+            uint32_t merge_gap;
+
+            void add(size_t off, size_t len) {
+                const uint32_t va = base_va + uint32_t(off);
+                if (!out.empty()) {
+                    MemDiffRange& last = out.back();
+                    const uint64_t end = uint64_t(last.va) + last.len;
+                    if (uint64_t(va) <= end + merge_gap) {
+                        last.len = uint32_t(uint64_t(va) + len - last.va);
+                        return;
+                    }
+                }
+                out.push_back({ va, uint32_t(len) });
+            }
+        };
+    }
+
+    std::vector<MemDiffRange> DiffMemory(const uint8_t* a, const uint8_t* b, size_t size, uint32_t base_va,
+        const MemDiffOptions& opt)
+    {
+        std::vector<MemDiffRange> out;
+        if (!a || !b || !size) return out;
+        RangeSink sink{ out, base_va, opt.merge_gap };
+
+        size_t off = 0;
+        for (; off + 64 <= size; off += 64) {
+            uint64_t m = block_diff_mask(a + off, b + off);
+            while (m) {
+                const int start = std::countr_zero(m);
+                const int len = std::countr_one(m >> start);
+                sink.add(off + start, size_t(len));
+                m = (start + len >= 64) ? 0 : (m & ~((uint64_t(1) << (start + len)) - 1));
+            }
+        }
+        for (; off < size; ++off) {
+            if (a[off] != b[off]) sink.add(off, 1);
+        }
+        return out;
+    }
+
+    MemDiffAnnotator::MemDiffAnnotator(uint32_t key_reach, size_t max_fields)
+        : key_reach_(key_reach), max_fields_(max_fields)
+    {
+        for (const addr::AddrRec& r : addr::Registry::all()) {
+            // DERIVED keys live in the derived buffer, and base 0 marks keys resolved through a pointer
+            if (r.spec.region == addr::Region::DERIVED || r.spec.base == 0) continue;
+            anchors_.push_back({ r.spec.base, r.name });
+        }
+        std::sort(anchors_.begin(), anchors_.end(), [](const Anchor& x, const Anchor& y) { return x.va < y.va; });
+    }
+
+    void MemDiffAnnotator::add_region(uint32_t va, uint32_t size, std::string label, const std::vector<SoaField>* fields)
+    {
+        auto it = std::lower_bound(regions_.begin(), regions_.end(), va, [](const Region& r, uint32_t v) { return r.va < v; });
+        if (it != regions_.end() && it->va == va) return;
+        regions_.insert(it, Region{ va, size, std::move(label), fields });
+    }
+
+    void MemDiffAnnotator::add_battle_structs(const MemView& mem)
+    {
+        const uint32_t table = addr::Registry::base(addr::battle::CombatantInstancesTable);
+        for (int i = 0; i < 12; ++i) {
+            uint32_t p = 0, ed = 0;
+            if (!mem.read_u32(table + i * 4, p) || !mem.in_mem1(p)) continue;
+            add_struct<soa::CombatantInstance>(p, "slot" + std::to_string(i) + ".instance");
+            if (mem.read_u32(p + uint32_t(offsetof(soa::CombatantInstance, Enemy_Definition)), ed) && mem.in_mem1(ed))
+                add_struct<soa::EnemyDefinition>(ed, "slot" + std::to_string(i) + ".enemy_def");
+        }
+        uint32_t st = 0;
+        if (mem.read_u32(addr::Registry::base(addr::battle::MainInstancePtr), st) && mem.in_mem1(st))
+            add_struct<soa::BattleState>(st, "battle_state");
+    }
+
+    std::vector<MemDiffNote> MemDiffAnnotator::annotate(const std::vector<MemDiffRange>& ranges) const
+    {
+        std::vector<MemDiffNote> notes;
+        notes.reserve(ranges.size());
+        for (const MemDiffRange& r : ranges) {
+            MemDiffNote n{ r, {}, {}, 0 };
+            const uint64_t r_end = uint64_t(r.va) + r.len;
+
+            // Nearest key at or below the range start
+            auto a = std::upper_bound(anchors_.begin(), anchors_.end(), r.va, [](uint32_t v, const Anchor& x) { return v < x.va; });
+            if (a != anchors_.begin()) {
+                --a;
+                const uint32_t d = r.va - a->va;
+                if (d < key_reach_) {
+                    char off[16];
+                    if (d) std::snprintf(off, sizeof(off), "+0x%X", d);
+                    else off[0] = '\0';
+                    n.key = std::string(a->name) + off;
+                }
+            }
+
+            // Regions are few (a battle has at most ~25), so the overlap test is a scan
+            for (const Region& g : regions_) {
+                if (g.va >= r_end) break;
+                if (uint64_t(g.va) + g.size <= r.va) continue;
+                const uint32_t lo = r.va > g.va ? r.va - g.va : 0;
+                const uint32_t hi = uint32_t(std::min<uint64_t>(r_end - g.va, g.size));
+                const auto& f = *g.fields;
+                auto it = std::upper_bound(f.begin(), f.end(), lo, [](uint32_t v, const SoaField& x) { return v < x.off; });
+                if (it != f.begin()) --it;
+                for (; it != f.end() && it->off < hi; ++it) {
+                    if (it->off + it->size <= lo) continue;
+                    if (n.fields.size() < max_fields_) n.fields.push_back(g.label + "." + it->path);
+                    else ++n.more_fields;
+                }
+            }
+            notes.push_back(std::move(n));
+        }
+        return notes;
+    }
+
+    std::string MemDiffAnnotator::format(const MemDiffNote& n)
+    {
+        char head[48];
+        std::snprintf(head, sizeof(head), "0x%08X +%-6u", n.range.va, n.range.len);
+        std::string s = head;
+        if (!n.key.empty()) s += "  " + n.key;
+        if (!n.fields.empty() || n.more_fields) {
+            s += "  [";
+            for (size_t i = 0; i < n.fields.size(); ++i) s += (i ? ", " : "") + n.fields[i];
+            if (n.more_fields) s += (n.fields.empty() ? "+" : ", +") + std::to_string(n.more_fields) + " more";
+            s += "]";
+        }
+        return s;
+    }
+
+} // namespace simcore
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MemView.h"
+#include "Soa/SoaFieldTable.h"
+
+namespace simcore {
+
+    // Byte-level diff of two guest RAM images (MEM1 from DolphinWrapper::getMem1, a MEM2 image, or
+    // dumps written to disk), annotated with registry keys and reflected struct field paths.
+    //
+    // The compare walks 64-byte blocks with SSE2 and only looks at bytes in blocks that differ, so a
+    // whole 24 MiB MEM1 costs a few milliseconds and can run on every failing/succeeding pair of a
+    // batch. Savestates are not parsed here: load one, then take getMem1.
+
+    struct MemDiffRange {
+        uint32_t va;    // guest address of the first differing byte
+        uint32_t len;
+    };
+
+    struct MemDiffOptions {
+        uint32_t merge_gap = 8;     // runs separated by at most this many equal bytes are one range
+    };
+
+    // Changed ranges between a and b (both `size` bytes, mapped at base_va), ascending.
+    std::vector<MemDiffRange> DiffMemory(const uint8_t* a, const uint8_t* b, size_t size, uint32_t base_va,
+        const MemDiffOptions& opt = {});
+
+    inline constexpr uint32_t kMem2Base = 0x90000000u;
+    inline constexpr uint32_t kMem2Size = 0x04000000u; // 64 MiB
+
+    struct MemDiffNote {
+        MemDiffRange range;
+        std::string key;                    // "battle.TurnPhase", "battle.CombatantInstancesTable+0x14"; empty if none
+        std::vector<std::string> fields;    // "slot5.instance.Current_HP", ...
+        size_t more_fields = 0;             // overlapped leaves past max_fields
+    };
+
+    class MemDiffAnnotator {
+    public:
+        // key_reach: how far past a registry key's base a range still counts as that key
+        // (the registry has bases, not sizes; the largest keyed object is a 12-entry table).
+        explicit MemDiffAnnotator(uint32_t key_reach = 0x40, size_t max_fields = 8);
+
+        // Labels [va, va + sizeof(T)) with T's reflected fields. A second struct at the same address is ignored.
+        template <class T>
+        void add_struct(uint32_t va, std::string label) {
+            add_region(va, uint32_t(sizeof(T)), std::move(label), &soa_field_table<T>());
+        }
+
+        // Combatant instances, their enemy definitions and the battle state reachable from the battle
+        // tables in `mem`. Call once per snapshot when the two may point at different objects.
+        void add_battle_structs(const MemView& mem);
+
+        std::vector<MemDiffNote> annotate(const std::vector<MemDiffRange>& ranges) const;
+
+        // "0x80347340 +4  battle.CurrentTurn  [slot5.instance.Current_HP, ...]"
+        static std::string format(const MemDiffNote& n);
+
+    private:
+        struct Anchor { uint32_t va; const char* name; };
+        struct Region { uint32_t va; uint32_t size; std::string label; const std::vector<SoaField>* fields; };
+
+        void add_region(uint32_t va, uint32_t size, std::string label, const std::vector<SoaField>* fields);
+
+        std::vector<Anchor> anchors_;   // sorted by va
+        std::vector<Region> regions_;   // sorted by va
+        uint32_t key_reach_;
+        size_t max_fields_;
+    };
+
+} // namespace simcore
@@ -9,7 +9,8 @@ namespace soa::battle::ctx::codec {
 	// Extracts the full context from a MEM1 snapshot (fills materialized structs)
 	bool extract_from_mem1(const simcore::MemView& view, BattleContext& out);
 
-	// Encodes/decodes the rich context (no version bump; v1 is now materialized)
+	// Encodes/decodes the wire image (BattleContextWire.h). Readers that only look at a received
+	// blob can use wire::view() on it directly instead of decoding.
 	bool encode(const BattleContext& in, std::string& out);
 	bool decode(std::string_view in, BattleContext& out);
 
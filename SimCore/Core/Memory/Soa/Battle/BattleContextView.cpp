@@ -0,0 +1,184 @@
+#include "BattleContextView.h"
+#include <cstddef>
+#include "../SoaAddrRegistry.h"
+#include "../../Endian.h"
+
+namespace soa::battle::ctx {
+
+    static constexpr uint32_t kStatusOff = offsetof(soa::CombatantInstance, status_flags);
+    static constexpr uint32_t kEnemyDefOff = offsetof(soa::CombatantInstance, Enemy_Definition);
+
+    void BattleContextView::invalidate()
+    {
+        for (auto& b : slot_bits_) b = 0;
+        global_bits_ = 0;
+        failed_ = false;
+        reads_ = 0;
+    }
+
+    const BattleSlot& BattleContextView::slot_ptr(int i) const
+    {
+        if (src_) return src_->slots[i];
+        BattleSlot& s = cache_.slots[i];
+        if (slot_bits_[i] & kPtr) return s;
+        slot_bits_[i] |= kPtr;
+
+        s.instance_addr = 0;
+        s.present = s.is_alive = 0;
+        s.is_player = is_player(i) ? 1 : 0;
+
+        uint32_t p = 0, flags = 0;
+        if (!rd_u32(addr::Registry::base(addr::battle::CombatantInstancesTable) + i * 4, p)) { failed_ = true; return s; }
+        if (!p || !mem_->in_mem1(p)) return s;
+        s.instance_addr = p;
+        if (!rd_u32(p + kStatusOff, flags)) { failed_ = true; return s; }
+        s.present = !(flags & StatusFlags::Fled);
+        s.is_alive = !(flags & StatusFlags::Dead);
+        return s;
+    }
+
+    bool BattleContextView::present(int slot) const { return slot >= 0 && slot < kSlots && slot_ptr(slot).present; }
+    bool BattleContextView::is_alive(int slot) const { return slot >= 0 && slot < kSlots && slot_ptr(slot).is_alive; }
+    uint32_t BattleContextView::instance_addr(int slot) const { return (slot >= 0 && slot < kSlots) ? slot_ptr(slot).instance_addr : 0; }
+
+    uint16_t BattleContextView::id(int slot) const
+    {
+        if (slot < 0 || slot >= kSlots) return 0;
+        if (src_) return src_->slots[slot].id;
+        BattleSlot& s = cache_.slots[slot];
+        if (!(slot_bits_[slot] & kId)) {
+            slot_bits_[slot] |= kId;
+            s.id = 0;
+            if (!rd_u16(addr::Registry::base(addr::battle::CombatantIdTable) + slot * 2, s.id)) failed_ = true;
+        }
+        return s.id;
+    }
+
+    const soa::CombatantInstance* BattleContextView::instance(int slot) const
+    {
+        if (slot < 0 || slot >= kSlots) return nullptr;
+        const BattleSlot& p = slot_ptr(slot);
+        if (!p.instance_addr) return nullptr;
+        if (src_) return &p.instance;
+
+        BattleSlot& s = cache_.slots[slot];
+        if (!(slot_bits_[slot] & kInstance)) {
+            slot_bits_[slot] |= kInstance;
+            if (rd_block(s.instance_addr, &s.instance, sizeof(s.instance))) simcore::endian::fix_endianness_fast(s.instance);
+            else { s.instance = {}; failed_ = true; }
+        }
+        return &s.instance;
+    }
+
+    const soa::EnemyDefinition* BattleContextView::enemy_def(int slot) const
+    {
+        if (slot < 4 || slot >= kSlots) return nullptr;
+        const BattleSlot& p = slot_ptr(slot);
+        if (src_) return p.has_enemy_def ? &p.enemy_def : nullptr;
+
+        BattleSlot& s = cache_.slots[slot];
+        if (!(slot_bits_[slot] & kEnemyDef)) {
+            slot_bits_[slot] |= kEnemyDef;
+            s.has_enemy_def = 0;
+            s.enemy_def_addr = 0;
+            uint32_t ed = 0;
+            if (s.present) {
+                if (!rd_u32(s.instance_addr + kEnemyDefOff, ed)) failed_ = true;
+                else if (mem_->in_mem1(ed)) {
+                    if (rd_block(ed, &s.enemy_def, sizeof(s.enemy_def))) {
+                        simcore::endian::fix_endianness_fast(s.enemy_def);
+                        s.enemy_def_addr = ed;
+                        s.has_enemy_def = 1;
+                    }
+                    else failed_ = true;
+                }
+            }
+        }
+        return s.has_enemy_def ? &s.enemy_def : nullptr;
+    }
+
+    bool BattleContextView::load_globals(uint8_t bits) const
+    {
+        const uint8_t need = uint8_t(bits & ~global_bits_);
+        if (!need) return true;
+        global_bits_ |= need;
+
+        bool ok = true;
+        if (need & kTurnCount) {
+            uint8_t ct = 0;
+            ok &= rd_u8(addr::Registry::base(addr::battle::CurrentTurn), ct);
+            cache_.turn_count = ct;
+        }
+        if (need & kPhase) {
+            cache_.battle_phase = 0;
+            ok &= rd_u32(addr::Registry::base(addr::battle::BattlePhase), cache_.battle_phase);
+        }
+        if (need & kTurnType) {
+            uint32_t v = 0;
+            const uint32_t p = addr::Registry::base(addr::battle::TurnType);
+            if (p && mem_->in_mem1(p)) ok &= rd_u32(p, v);
+            cache_.turn_type = soa::battle::TurnType(v);
+        }
+        if (need & kState) {
+            cache_.state = {};
+            uint32_t p = 0;
+            ok &= rd_u32(addr::Registry::base(addr::battle::MainInstancePtr), p);
+            if (ok && p && mem_->in_mem1(p)) {
+                if (rd_block(p, &cache_.state, sizeof(cache_.state))) simcore::endian::fix_endianness_fast(cache_.state);
+                else cache_.state = {};
+            }
+        }
+        if (!ok) failed_ = true;
+        return ok;
+    }
+
+    uint32_t BattleContextView::turn_count() const
+    {
+        if (src_) return src_->turn_count;
+        load_globals(kTurnCount);
+        return cache_.turn_count;
+    }
+
+    uint32_t BattleContextView::battle_phase() const
+    {
+        if (src_) return src_->battle_phase;
+        load_globals(kPhase);
+        return cache_.battle_phase;
+    }
+
+    soa::battle::TurnType BattleContextView::turn_type() const
+    {
+        if (src_) return src_->turn_type;
+        load_globals(kTurnType);
+        return cache_.turn_type;
+    }
+
+    const soa::BattleState& BattleContextView::state() const
+    {
+        if (src_) return src_->state;
+        load_globals(kState);
+        return cache_.state;
+    }
+
+    bool BattleContextView::materialize(BattleContext& out) const
+    {
+        if (src_) { out = *src_; return true; }
+
+        for (int i = 0; i < kSlots; ++i) {
+            (void)instance(i);
+            (void)id(i);
+            (void)enemy_def(i);
+        }
+        load_globals(kTurnCount | kPhase | kTurnType | kState);
+        if (failed_) return false;
+
+        out = cache_;
+        for (int i = 0; i < kSlots; ++i) {
+            BattleSlot& s = out.slots[i];
+            if (!s.instance_addr) s.instance = {};
+            if (!s.has_enemy_def) { s.enemy_def = {}; s.enemy_def_addr = 0; }
+        }
+        return true;
+    }
+
+} // namespace soa::battle::ctx
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include "BattleContext.h"
+#include "../../GuestMemory.h"
+
+namespace soa::battle::ctx {
+
+    // Lazy, read-only access to the battle context at the current breakpoint hit.
+    //
+    // Each field is read from emulated memory the first time it is asked for and cached until
+    // invalidate(), which the owner calls whenever emulation moves on. Targeting only needs presence,
+    // liveness and ids, which is two u32 reads per slot instead of the full CombatantInstance and
+    // EnemyDefinition images extract_from_mem1 copies; the images are still there on demand.
+    //
+    // A view can also wrap an already materialized BattleContext, so the same consumers (PlanWriter)
+    // run against a context that came over the wire.
+    class BattleContextView {
+    public:
+        explicit BattleContextView(const simcore::IGuestMemory& mem) : mem_(&mem) {}
+        explicit BattleContextView(const BattleContext& bc) : src_(&bc) {}
+
+        BattleContextView(const BattleContextView&) = delete;
+        BattleContextView& operator=(const BattleContextView&) = delete;
+
+        // Drops every cached field; the next access reads memory again.
+        void invalidate();
+
+        static constexpr int kSlots = 12;
+        static bool is_player(int slot) { return slot >= 0 && slot < 4; }
+
+        bool present(int slot) const;
+        bool is_alive(int slot) const;
+        uint16_t id(int slot) const;
+        uint32_t instance_addr(int slot) const;
+
+        // Byte-swapped images; nullptr when the slot has none (absent, player slot for enemy_def).
+        const soa::CombatantInstance* instance(int slot) const;
+        const soa::EnemyDefinition* enemy_def(int slot) const;
+
+        uint32_t turn_count() const;
+        uint32_t battle_phase() const;
+        soa::battle::TurnType turn_type() const;
+        const soa::BattleState& state() const;
+
+        // Every field, as codec::extract_from_mem1 would produce it from a MEM1 copy.
+        bool materialize(BattleContext& out) const;
+
+        // Memory reads issued since the last invalidate() (0 for a wrapped context).
+        uint32_t reads() const { return reads_; }
+
+    private:
+        enum SlotBit : uint8_t { kPtr = 1 << 0, kId = 1 << 1, kInstance = 1 << 2, kEnemyDef = 1 << 3 };
+        enum GlobalBit : uint8_t { kTurnCount = 1 << 0, kPhase = 1 << 1, kTurnType = 1 << 2, kState = 1 << 3 };
+
+        const BattleSlot& slot_ptr(int slot) const;     // instance_addr, present, is_alive
+        bool load_globals(uint8_t bits) const;
+
+        bool rd_u8(uint32_t va, uint8_t& v) const { ++reads_; return mem_->read_u8(va, v); }
+        bool rd_u16(uint32_t va, uint16_t& v) const { ++reads_; return mem_->read_u16(va, v); }
+        bool rd_u32(uint32_t va, uint32_t& v) const { ++reads_; return mem_->read_u32(va, v); }
+        bool rd_block(uint32_t va, void* dst, size_t n) const { ++reads_; return mem_->read_block(va, dst, n); }
+
+        const simcore::IGuestMemory* mem_{ nullptr };
+        const BattleContext* src_{ nullptr };
+
+        // Lazily filled copy; only fields whose bit is set are meaningful
+        mutable BattleContext cache_{};
+        mutable uint8_t slot_bits_[kSlots]{};
+        mutable uint8_t global_bits_{ 0 };
+        mutable bool failed_{ false };                  // a read failed since invalidate()
+        mutable uint32_t reads_{ 0 };
+    };
+
+} // namespace soa::battle::ctx
@@ -0,0 +1,102 @@
+#include "BattleContextWire.h"
+#include <cstring>
+#include <new>
+
+namespace soa::battle::ctx::wire {
+
+    void encode(const BattleContext& in, std::string& out)
+    {
+        out.assign(sizeof(BattleContextWire), '\0');
+        auto* w = new (out.data()) BattleContextWire{};
+
+        w->hdr.magic = kMagic;
+        w->hdr.version = kVersion;
+        w->hdr.slot_count = kSlots;
+        w->hdr.total_size = sizeof(BattleContextWire);
+        w->hdr.slot_size = sizeof(WireSlot);
+        w->hdr.turn_type = uint32_t(in.turn_type);
+        w->hdr.turn_count = in.turn_count;
+        w->hdr.battle_phase = in.battle_phase;
+        w->state = in.state;
+
+        for (int i = 0; i < kSlots; ++i) {
+            const BattleSlot& s = in.slots[i];
+            WireSlot& d = w->slots[i];
+            const uint16_t bit = uint16_t(1u << i);
+            if (s.present) w->hdr.present_mask |= bit;
+            if (s.is_alive) w->hdr.alive_mask |= bit;
+            if (s.is_player) w->hdr.player_mask |= bit;
+
+            d.id = s.id;
+            d.instance_addr = s.instance_addr;
+            if (s.instance_addr) d.instance = s.instance;
+            if (s.has_enemy_def) {
+                w->hdr.enemy_def_mask |= bit;
+                d.enemy_def_addr = s.enemy_def_addr;
+                d.enemy_def = s.enemy_def;
+            }
+        }
+    }
+
+    static const BattleContextWire* fail(std::string* error_out, const char* why)
+    {
+        if (error_out) *error_out = why;
+        return nullptr;
+    }
+
+    const BattleContextWire* view(const void* data, size_t size, std::string* error_out)
+    {
+        if (!data || size < sizeof(WireHeader)) return fail(error_out, "BattleContext blob too short");
+        if (reinterpret_cast<uintptr_t>(data) % alignof(BattleContextWire)) return fail(error_out, "BattleContext blob misaligned");
+
+        const auto* w = static_cast<const BattleContextWire*>(data);
+        const WireHeader& h = w->hdr;
+        if (h.magic != kMagic) return fail(error_out, "Not a BattleContext blob (or written with the other byte order)");
+        if (h.version != kVersion) return fail(error_out, "Unsupported BattleContext blob version");
+        if (h.slot_count != kSlots || h.slot_size != sizeof(WireSlot) || h.total_size != sizeof(BattleContextWire))
+            return fail(error_out, "BattleContext blob layout mismatch");
+        if (size != sizeof(BattleContextWire)) return fail(error_out, "BattleContext blob size mismatch");
+
+        if ((h.present_mask | h.alive_mask | h.player_mask | h.enemy_def_mask) & ~kSlotMask)
+            return fail(error_out, "BattleContext bitmap names slots past 12");
+        if (h.alive_mask & ~h.present_mask)
+            return fail(error_out, "BattleContext alive bit on an absent slot");
+        if (h.player_mask != kPlayerMask)
+            return fail(error_out, "BattleContext player slots are not 0..3");
+        if (h.enemy_def_mask & (kPlayerMask | ~h.present_mask))
+            return fail(error_out, "BattleContext enemy definition on a player or absent slot");
+        for (int i = 0; i < kSlots; ++i) {
+            if (w->present(i) && !w->slots[i].instance_addr)
+                return fail(error_out, "BattleContext present slot has no instance");
+            if (w->has_enemy_def(i) && !w->slots[i].enemy_def_addr)
+                return fail(error_out, "BattleContext enemy definition has no address");
+        }
+        return w;
+    }
+
+    void to_context(const BattleContextWire& w, BattleContext& out)
+    {
+        out.state = w.state;
+        out.turn_type = soa::battle::TurnType(w.hdr.turn_type);
+        out.turn_count = w.hdr.turn_count;
+        out.battle_phase = w.hdr.battle_phase;
+
+        for (int i = 0; i < kSlots; ++i) {
+            const WireSlot& s = w.slots[i];
+            BattleSlot& d = out.slots[i];
+            d = {};
+            d.present = w.present(i);
+            d.is_alive = w.is_alive(i);
+            d.is_player = w.is_player(i);
+            d.has_enemy_def = w.has_enemy_def(i);
+            d.id = s.id;
+            d.instance_addr = s.instance_addr;
+            if (s.instance_addr) d.instance = s.instance;
+            if (d.has_enemy_def) {
+                d.enemy_def_addr = s.enemy_def_addr;
+                d.enemy_def = s.enemy_def;
+            }
+        }
+    }
+
+} // namespace soa::battle::ctx::wire
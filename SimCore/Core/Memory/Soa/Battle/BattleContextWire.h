@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "BattleContext.h"
+
+namespace soa::battle::ctx::wire {
+
+    // Fixed-layout BattleContext: one 10 KiB POD with no pointers and no variable sections.
+    //
+    // Every slot has room for both images whether or not it is populated (absent ones are zero),
+    // and which ones are meaningful is carried by the bitmaps in the header. view() checks the
+    // header and bitmaps and returns the buffer cast to BattleContextWire, so a reader that is done
+    // with the blob before it goes away needs no decode. Callers that keep the context past the
+    // blob's lifetime still copy it out with to_context(). Images are already byte-swapped (host
+    // order, little-endian hosts only: the magic reads back reversed on a big-endian reader and is
+    // rejected).
+
+    inline constexpr uint32_t kMagic = 0x58544342u;   // "BCTX"
+    inline constexpr uint16_t kVersion = 2;           // v1 was the variable-length stream
+    inline constexpr int kSlots = 12;
+    inline constexpr uint16_t kPlayerMask = 0x000F;   // slots 0..3
+    inline constexpr uint16_t kSlotMask = 0x0FFF;
+
+    struct alignas(8) WireSlot {
+        uint32_t instance_addr;
+        uint32_t enemy_def_addr;
+        uint16_t id;
+        uint8_t  _pad0[6];
+        soa::CombatantInstance instance;   // meaningful iff instance_addr != 0
+        soa::EnemyDefinition   enemy_def;  // meaningful iff the slot's enemy_def_mask bit is set
+        uint8_t  _pad1[2];
+    };
+
+    struct alignas(8) WireHeader {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t slot_count;
+        uint32_t total_size;
+        uint32_t slot_size;
+        uint16_t present_mask;      // bit i = slots[i].present
+        uint16_t alive_mask;
+        uint16_t player_mask;
+        uint16_t enemy_def_mask;    // has_enemy_def
+        uint32_t turn_type;
+        uint32_t turn_count;
+        uint32_t battle_phase;
+        uint8_t  _reserved[28];
+    };
+
+    struct alignas(8) BattleContextWire {
+        WireHeader hdr;
+        soa::BattleState state;
+        uint8_t _pad[8];
+        WireSlot slots[kSlots];
+
+        bool present(int i) const { return (hdr.present_mask >> i) & 1u; }
+        bool is_alive(int i) const { return (hdr.alive_mask >> i) & 1u; }
+        bool is_player(int i) const { return (hdr.player_mask >> i) & 1u; }
+        bool has_enemy_def(int i) const { return (hdr.enemy_def_mask >> i) & 1u; }
+    };
+
+    static_assert(sizeof(WireSlot) == 816, "wire slot layout");
+    static_assert(sizeof(WireHeader) == 64, "wire header layout");
+    static_assert(offsetof(BattleContextWire, state) == 64, "wire layout");
+    static_assert(offsetof(BattleContextWire, slots) == 448, "wire layout");
+    static_assert(sizeof(BattleContextWire) == 10240, "wire layout: bump kVersion when it changes");
+
+    // Writes the wire image of `in` into `out` (resized to sizeof(BattleContextWire)).
+    void encode(const BattleContext& in, std::string& out);
+
+    // The buffer as a context if it is one: right size, alignment, magic, version and consistent
+    // bitmaps (alive and enemy definitions only on present slots, players exactly slots 0..3). nullptr otherwise, with the reason in error_out. The buffer must outlive the result.
+    const BattleContextWire* view(const void* data, size_t size, std::string* error_out = nullptr);
+    inline const BattleContextWire* view(std::string_view blob, std::string* error_out = nullptr) {
+        return view(blob.data(), blob.size(), error_out);
+    }
+
+    // Copies the wire image back into the in-memory form (for callers that keep or edit it).
+    void to_context(const BattleContextWire& w, BattleContext& out);
+
+} // namespace soa::battle::ctx::wire
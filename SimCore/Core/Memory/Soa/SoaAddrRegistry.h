@@ -32,14 +32,34 @@ namespace addr {
         const char* name;        // "dom.NAME"
     };
 
+    // The table is laid out in AddrKey order (both come from ADDR_TABLE_ALL), so a key indexes it
+    // directly; lookups are constexpr and fold away for constant keys.
+    namespace detail {
+        inline constexpr AddrRec kAll[] = {
+#define ROW(dom, NAME, R, B) { AddrKey::dom##_##NAME, DolphinAddr{ Region::R, static_cast<uint32_t>(B) }, #dom "." #NAME },
+            ADDR_TABLE_ALL(ROW)
+#undef ROW
+        };
+        inline constexpr size_t kCount = sizeof(kAll) / sizeof(kAll[0]);
+    }
+
     class Registry {
     public:
-        static std::span<const AddrRec> all();
-        static const AddrRec* find(AddrKey k);
-        static const DolphinAddr& spec(AddrKey k);
-        static const uint32_t base(AddrKey k);
-        static const Region region(AddrKey k);
-        static const char* name(AddrKey k);
+        static constexpr std::span<const AddrRec> all() { return std::span<const AddrRec>(detail::kAll, detail::kCount); }
+        static constexpr const AddrRec* find(AddrKey k) {
+            const size_t i = static_cast<size_t>(k);
+            return i < detail::kCount ? &detail::kAll[i] : nullptr;
+        }
+        static constexpr const DolphinAddr& spec(AddrKey k) {
+            const auto* r = find(k);
+            return r ? r->spec : detail::kAll[0].spec; // table is non-empty
+        }
+        static constexpr uint32_t base(AddrKey k) { return spec(k).base; }
+        static constexpr Region region(AddrKey k) { return spec(k).region; }
+        static constexpr const char* name(AddrKey k) {
+            const auto* r = find(k);
+            return r ? r->name : "";
+        }
     };
 
     // ergonomic aliases: addr::core::X, addr::battle::Y, addr::derived::Z
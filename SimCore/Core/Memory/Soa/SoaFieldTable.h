@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "../Endian.h"
+
+namespace simcore {
+
+    // One leaf of a reflected struct: byte range inside the image and its path from the root,
+    // e.g. "items[2].amount". Byte arrays (names, padding) stay whole instead of one leaf per byte.
+    struct SoaField {
+        uint32_t off;
+        uint32_t size;
+        std::string path;
+    };
+
+    namespace detail {
+
+        template <class T>
+        void append_soa_struct(std::vector<SoaField>& out, uint32_t off, const std::string& prefix);
+
+        template <class F>
+        void append_soa_field(std::vector<SoaField>& out, uint32_t off, const std::string& path)
+        {
+            if constexpr (std::is_array_v<F>) {
+                using E = std::remove_extent_t<F>;
+                if constexpr (sizeof(E) == 1 && !endian::has_reflect_members<E>::value) {
+                    out.push_back({ off, uint32_t(sizeof(F)), path });
+                }
+                else {
+                    for (size_t k = 0; k < std::extent_v<F>; ++k)
+                        append_soa_field<E>(out, off + uint32_t(k * sizeof(E)), path + "[" + std::to_string(k) + "]");
+                }
+            }
+            else if constexpr (endian::has_reflect_members<F>::value) {
+                append_soa_struct<F>(out, off, path + ".");
+            }
+            else {
+                out.push_back({ off, uint32_t(sizeof(F)), path });
+            }
+        }
+
+        template <class T>
+        void append_soa_struct(std::vector<SoaField>& out, uint32_t off, const std::string& prefix)
+        {
+            // Offsets come from a value-initialized probe: the structs are packed aggregates,
+            // and member pointers do not give offsets directly.
+            static const T probe{};
+            const auto* base = reinterpret_cast<const uint8_t*>(&probe);
+            size_t i = 0;
+            std::apply([&](auto... mp) {
+                ((append_soa_field<std::remove_cvref_t<decltype(probe.*mp)>>(out,
+                    off + uint32_t(reinterpret_cast<const uint8_t*>(&(probe.*mp)) - base),
+                    prefix + reflect<T>::names[i++])), ...);
+            }, reflect<T>::members);
+        }
+
+    } // namespace detail
+
+    // Leaves of T in layout order, built once per type.
+    template <class T>
+    const std::vector<SoaField>& soa_field_table()
+    {
+        static const std::vector<SoaField> table = [] {
+            std::vector<SoaField> v;
+            detail::append_soa_struct<T>(v, 0, "");
+            return v;
+        }();
+        return table;
+    }
+
+} // namespace simcore
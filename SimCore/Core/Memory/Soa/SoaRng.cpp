@@ -0,0 +1,85 @@
+#include "SoaRng.h"
+
+namespace soa::rng {
+
+    Lcg Jump(const Lcg& g, uint64_t k)
+    {
+        // Square-and-multiply over affine maps x -> m*x + a
+        uint32_t m = 1, a = 0;
+        uint32_t pm = g.mul, pa = g.add;
+        while (k) {
+            if (k & 1) { m = pm * m; a = pm * a + pa; }
+            pa = pm * pa + pa;
+            pm = pm * pm;
+            k >>= 1;
+        }
+        return Lcg{ m, a, g.out_shift, g.out_mask };
+    }
+
+    bool Distance(const Lcg& g, uint32_t from, uint32_t to, uint32_t max_steps, uint32_t& steps)
+    {
+        uint32_t s = from;
+        for (uint32_t k = 0; k <= max_steps; ++k) {
+            if (s == to) { steps = k; return true; }
+            s = Step(g, s);
+        }
+        return false;
+    }
+
+    std::vector<int64_t> StepsBetween(const Lcg& g, const std::vector<uint32_t>& seq, uint32_t max_steps)
+    {
+        std::vector<int64_t> out;
+        for (size_t i = 0; i + 1 < seq.size(); ++i) {
+            uint32_t k = 0;
+            out.push_back(Distance(g, seq[i], seq[i + 1], max_steps, k) ? int64_t(k) : -1);
+        }
+        return out;
+    }
+
+    static uint32_t inverse_odd(uint32_t d)
+    {
+        uint32_t x = d;                       // correct to 3 bits for odd d
+        for (int i = 0; i < 4; ++i) x *= 2u - d * x;
+        return x;
+    }
+
+    bool FitLcg(const std::vector<uint32_t>& states, Lcg& out, const Lcg& shape)
+    {
+        if (states.size() < 3) return false;
+
+        // mul * d[i] == d[i + 1] (mod 2^32) for the deltas d[i] = s[i + 1] - s[i]
+        std::vector<uint32_t> d;
+        for (size_t i = 0; i + 1 < states.size(); ++i) d.push_back(states[i + 1] - states[i]);
+
+        // The delta with the fewest trailing zeros pins mul down to its top tz bits
+        size_t best = d.size();
+        int tz_best = 33;
+        for (size_t i = 0; i + 1 < d.size(); ++i) {
+            if (d[i] == 0) continue;
+            int tz = 0;
+            while (!((d[i] >> tz) & 1)) ++tz;
+            if (tz < tz_best) { tz_best = tz; best = i; }
+        }
+        if (best == d.size() || tz_best > 8) return false;
+
+        const uint32_t lo = (d[best + 1] >> tz_best) * inverse_odd(d[best] >> tz_best);
+        const uint32_t lo_mask = tz_best == 0 ? 0xFFFFFFFFu : (0xFFFFFFFFu >> tz_best);
+
+        bool found = false;
+        Lcg fit{};
+        for (uint32_t hi = 0; hi < (1u << tz_best); ++hi) {
+            const uint32_t mul = (lo & lo_mask) | (tz_best == 0 ? 0u : hi << (32 - tz_best));
+            const uint32_t add = states[1] - mul * states[0];
+            const Lcg g{ mul, add, shape.out_shift, shape.out_mask };
+            bool ok = true;
+            for (size_t i = 0; ok && i + 1 < states.size(); ++i) ok = Step(g, states[i]) == states[i + 1];
+            if (!ok) continue;
+            if (found) return false;  // ambiguous
+            found = true;
+            fit = g;
+        }
+        if (found) out = fit;
+        return found;
+    }
+
+} // namespace soa::rng
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Host-side model of the game's RNG, so seed/roll questions can be answered without emulating.
+//
+// The word at addr::core::RNG_SEED is modelled as the state of a 32-bit LCG:
+//   state' = mul * state + add (mod 2^32),   roll = (state' >> out_shift) & out_mask
+// kMslRand (the CodeWarrior MSL rand() the toolchain ships) is the working hypothesis. It is not
+// trusted blindly: RunRngValidation (Phases/RngValidation.h) traces RNG_SEED at breakpoints in the
+// emulator and checks that every pair of reads is a whole number of model steps apart, and
+// FitLcg recovers mul/add from consecutive emulator states if it is not.
+
+namespace soa::rng {
+
+    struct Lcg {
+        uint32_t mul{ 0 };
+        uint32_t add{ 0 };
+        uint8_t  out_shift{ 0 };
+        uint32_t out_mask{ 0xFFFFFFFFu };
+
+        bool operator==(const Lcg& o) const {
+            return mul == o.mul && add == o.add && out_shift == o.out_shift && out_mask == o.out_mask;
+        }
+    };
+
+    inline constexpr Lcg kMslRand{ 1103515245u, 12345u, 16, 0x7FFFu };
+
+    constexpr uint32_t Step(const Lcg& g, uint32_t s) { return g.mul * s + g.add; }
+    constexpr uint32_t Output(const Lcg& g, uint32_t s) { return (s >> g.out_shift) & g.out_mask; }
+
+    // k steps folded into one affine map (same output shape), O(log k).
+    Lcg Jump(const Lcg& g, uint64_t k);
+    inline uint32_t Advance(const Lcg& g, uint32_t s, uint64_t k) { return Step(Jump(g, k), s); }
+
+    // Number of steps from `from` to `to` (0 if equal), searching at most max_steps.
+    bool Distance(const Lcg& g, uint32_t from, uint32_t to, uint32_t max_steps, uint32_t& steps);
+
+    // Steps between each consecutive pair of `seq`; -1 where no count <= max_steps explains the pair.
+    std::vector<int64_t> StepsBetween(const Lcg& g, const std::vector<uint32_t>& seq, uint32_t max_steps);
+
+    // Recovers mul/add from >= 3 consecutive states; out_shift/out_mask are taken from `shape`.
+    // false if the states are inconsistent with any LCG or leave mul ambiguous (too few odd deltas).
+    bool FitLcg(const std::vector<uint32_t>& states, Lcg& out, const Lcg& shape = kMslRand);
+
+    class Rng {
+    public:
+        explicit Rng(uint32_t seed, const Lcg& g = kMslRand) : g_(g), s_(seed) {}
+
+        uint32_t state() const { return s_; }
+        uint64_t consumed() const { return n_; }
+        const Lcg& model() const { return g_; }
+
+        uint32_t next() { s_ = Step(g_, s_); ++n_; return Output(g_, s_); }
+        uint32_t peek(uint64_t ahead = 0) const { return Output(g_, Advance(g_, s_, ahead + 1)); }
+        void skip(uint64_t k) { s_ = Advance(g_, s_, k); n_ += k; }
+
+    private:
+        Lcg g_;
+        uint32_t s_;
+        uint64_t n_{ 0 };
+    };
+
+} // namespace soa::rng
@@ -17,7 +17,15 @@ namespace soa::readers {
 	template <class T>
 	inline bool read(const simcore::MemView& view, uint32_t va, T& out) {
 		if (!read_raw(view, va, out)) return false;
-		simcore::endian::fix_endianness_in_place(out);
+		simcore::endian::fix_endianness_fast(out);
+		return true;
+	}
+
+	// `n` consecutive structs from `va` into out[0..n), swapped in one batch.
+	template <class T>
+	inline bool read_array(const simcore::MemView& view, uint32_t va, T* out, size_t n) {
+		if (!view.valid() || !view.in_mem1(va) || !view.read_block(va, out, sizeof(T) * n)) return false;
+		simcore::endian::fix_endianness_array(out, n);
 		return true;
 	}
 
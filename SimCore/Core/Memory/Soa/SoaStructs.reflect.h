@@ -1,5 +1,6 @@
 // AUTO-GENERATED. DO NOT EDIT.
 #pragma once
+#include <array>
 #include <tuple>
 #include "SoaStructs.h"
 
@@ -16,6 +17,7 @@ template <> struct reflect<soa::Vec2> {
     &type::x,
     &type::y
   );
+  static constexpr std::array<const char*, 2> names{{ "x", "y" }};
 };
 
 template <> struct reflect<soa::Vec3Float> {
@@ -25,6 +27,7 @@ template <> struct reflect<soa::Vec3Float> {
     &type::y,
     &type::z
   );
+  static constexpr std::array<const char*, 3> names{{ "x", "y", "z" }};
 };
 
 template <> struct reflect<soa::Instruction> {
@@ -37,6 +40,7 @@ template <> struct reflect<soa::Instruction> {
     &type::atkResult,
     &type::_pad
   );
+  static constexpr std::array<const char*, 6> names{{ "inst", "target", "targetMethod", "instParam", "atkResult", "_pad" }};
 };
 
 template <> struct reflect<soa::InstructionSet> {
@@ -45,6 +49,7 @@ template <> struct reflect<soa::InstructionSet> {
     &type::current,
     &type::previous
   );
+  static constexpr std::array<const char*, 2> names{{ "current", "previous" }};
 };
 
 template <> struct reflect<soa::Thread> {
@@ -60,6 +65,7 @@ template <> struct reflect<soa::Thread> {
     &type::phase,
     &type::name
   );
+  static constexpr std::array<const char*, 9> names{{ "fxn", "next", "parent", "id", "onQueue", "fn", "priority", "phase", "name" }};
 };
 
 template <> struct reflect<soa::AllCombatInstances> {
@@ -78,6 +84,7 @@ template <> struct reflect<soa::AllCombatInstances> {
     &type::EC_7,
     &type::EC_8
   );
+  static constexpr std::array<const char*, 12> names{{ "PC_1", "PC_2", "PC_3", "PC_4", "EC_1", "EC_2", "EC_3", "EC_4", "EC_5", "EC_6", "EC_7", "EC_8" }};
 };
 
 template <> struct reflect<soa::ElementalEffectiveness> {
@@ -90,6 +97,7 @@ template <> struct reflect<soa::ElementalEffectiveness> {
     &type::Yellow,
     &type::Silver
   );
+  static constexpr std::array<const char*, 6> names{{ "green", "red", "purple", "blue", "Yellow", "Silver" }};
 };
 
 template <> struct reflect<soa::DerivedStats> {
@@ -102,6 +110,7 @@ template <> struct reflect<soa::DerivedStats> {
     &type::DodgeChance,
     &type::_pad
   );
+  static constexpr std::array<const char*, 6> names{{ "Attack", "Defense", "MagicDefense", "HitChance", "DodgeChance", "_pad" }};
 };
 
 template <> struct reflect<soa::StatusEffectiveness> {
@@ -119,6 +128,7 @@ template <> struct reflect<soa::StatusEffectiveness> {
     &type::_pad0,
     &type::Danger
   );
+  static constexpr std::array<const char*, 11> names{{ "Poison", "Death", "Stone", "Sleep", "Confusion", "Silence", "Fatigue", "Revive", "Weak", "_pad0", "Danger" }};
 };
 
 template <> struct reflect<soa::ItemDrop> {
@@ -128,6 +138,7 @@ template <> struct reflect<soa::ItemDrop> {
     &type::amount,
     &type::itemId
   );
+  static constexpr std::array<const char*, 3> names{{ "chance", "amount", "itemId" }};
 };
 
 template <> struct reflect<soa::AIInstruction> {
@@ -137,6 +148,7 @@ template <> struct reflect<soa::AIInstruction> {
     &type::instruction,
     &type::param
   );
+  static constexpr std::array<const char*, 3> names{{ "type", "instruction", "param" }};
 };
 
 template <> struct reflect<soa::Wksht> {
@@ -147,6 +159,7 @@ template <> struct reflect<soa::Wksht> {
     &type::capacity,
     &type::data
   );
+  static constexpr std::array<const char*, 4> names{{ "vtable", "size", "capacity", "data" }};
 };
 
 template <> struct reflect<soa::GridRow> {
@@ -154,6 +167,7 @@ template <> struct reflect<soa::GridRow> {
   static constexpr auto members = std::make_tuple(
     &type::cell
   );
+  static constexpr std::array<const char*, 1> names{{ "cell" }};
 };
 
 template <> struct reflect<soa::Grid> {
@@ -161,6 +175,7 @@ template <> struct reflect<soa::Grid> {
   static constexpr auto members = std::make_tuple(
     &type::row
   );
+  static constexpr std::array<const char*, 1> names{{ "row" }};
 };
 
 template <> struct reflect<soa::GridCoord> {
@@ -169,6 +184,7 @@ template <> struct reflect<soa::GridCoord> {
     &type::x,
     &type::z
   );
+  static constexpr std::array<const char*, 2> names{{ "x", "z" }};
 };
 
 template <> struct reflect<soa::Magic_Ranks> {
@@ -181,6 +197,7 @@ template <> struct reflect<soa::Magic_Ranks> {
     &type::Yellow,
     &type::Silver
   );
+  static constexpr std::array<const char*, 6> names{{ "Green", "Red", "Purple", "Blue", "Yellow", "Silver" }};
 };
 
 template <> struct reflect<soa::Character_Stats> {
@@ -192,6 +209,7 @@ template <> struct reflect<soa::Character_Stats> {
     &type::Agility,
     &type::Magic
   );
+  static constexpr std::array<const char*, 5> names{{ "Strength", "Will", "Vigor", "Agility", "Magic" }};
 };
 
 template <> struct reflect<soa::Color_XP> {
@@ -204,6 +222,7 @@ template <> struct reflect<soa::Color_XP> {
     &type::Yellow,
     &type::Silver
   );
+  static constexpr std::array<const char*, 6> names{{ "Green", "Red", "Purple", "Blue", "Yellow", "Silver" }};
 };
 
 template <> struct reflect<soa::CombatantInstance> {
@@ -254,6 +273,7 @@ template <> struct reflect<soa::CombatantInstance> {
     &type::_pad7,
     &type::Enemy_Definition
   );
+  static constexpr std::array<const char*, 44> names{{ "regen_amount", "_pad0", "counter_chance", "_pad1", "battleState_flags_1", "battleState_flags_2", "Current_HP", "Max_HP", "status_flags", "new_status_flags", "destruction_recharge_1", "destruction_recharge_2", "current_elemental_eff", "change_elemental_eff", "current_status_eff", "change_status_eff", "current_base_stats", "change_base_stats", "current_derived_stats", "change_derived_stats", "width", "depth", "movement_flags", "_pad2", "current_counter_chance", "equipped_weapon", "_pad3", "base_counter_chance", "base_elemental_eff", "base_status_eff", "base_base_stats", "base_derived_stats", "spells_cast", "_pad4", "current_weapon_element", "_pad5", "equipped_armor", "equipped_accessory", "death_count", "_pad6", "kill_count", "new_regen_amount", "_pad7", "Enemy_Definition" }};
 };
 
 template <> struct reflect<soa::PC_Data> {
@@ -282,6 +302,7 @@ template <> struct reflect<soa::PC_Data> {
     &type::Base_Stats,
     &type::Magic_XP
   );
+  static constexpr std::array<const char*, 22> names{{ "Name", "Level", "Deaths", "Current_MP", "Max_MP", "Weapon_Element", "Equipped_Weapon", "Equipped_Armor", "Equipped_Accessory", "Moonberries_Used", "Current_HP", "Max_HP", "Spirit", "Max_Spirit", "Current_Counter_Chance", "Enemies_Killed", "Experience", "Max_MP_fractional", "Ability_Flags", "Magic_Levels", "Base_Stats", "Magic_XP" }};
 };
 
 template <> struct reflect<soa::EnemyDefinition> {
@@ -310,6 +331,7 @@ template <> struct reflect<soa::EnemyDefinition> {
     &type::items,
     &type::inst
   );
+  static constexpr std::array<const char*, 22> names{{ "japaneseName", "width", "depth", "elemental_alignment", "_pad0", "movment_flags", "counter_pcnt", "experience", "gold", "_pad1", "max_HP", "_pad2", "elemental_eff", "status_eff", "atk_effect_id", "atk_state_id", "atd_state_miss_chance", "_pad3", "base_stats", "derive_stats", "items", "inst" }};
 };
 
 template <> struct reflect<soa::All_PC_Data> {
@@ -322,6 +344,7 @@ template <> struct reflect<soa::All_PC_Data> {
     &type::Enrique,
     &type::Gilder
   );
+  static constexpr std::array<const char*, 6> names{{ "Vyse", "Aika", "Fina", "Drachma", "Enrique", "Gilder" }};
 };
 
 template <> struct reflect<soa::BattleItemDropSlot> {
@@ -330,6 +353,7 @@ template <> struct reflect<soa::BattleItemDropSlot> {
     &type::count,
     &type::item_id
   );
+  static constexpr std::array<const char*, 2> names{{ "count", "item_id" }};
 };
 
 template <> struct reflect<soa::ItemSlot> {
@@ -339,6 +363,7 @@ template <> struct reflect<soa::ItemSlot> {
     &type::count,
     &type::_pad0
   );
+  static constexpr std::array<const char*, 3> names{{ "item_id", "count", "_pad0" }};
 };
 
 template <> struct reflect<soa::BattleState> {
@@ -359,5 +384,6 @@ template <> struct reflect<soa::BattleState> {
     &type::gold_earned,
     &type::useable_items
   );
+  static constexpr std::array<const char*, 14> names{{ "initiative", "_pad0", "PC_escape_chance", "EC_escape_chance", "_pad1", "maxSP", "curSP", "sp_after_instructions", "enemies_killed", "item_drops", "_pad2", "experience_earned", "gold_earned", "useable_items" }};
 };
 
@@ -0,0 +1,310 @@
+// AUTO-GENERATED. DO NOT EDIT.
+#pragma once
+#include <array>
+#include "SoaStructs.h"
+#include "../SwapPlan.h"
+
+namespace simcore::endian {
+
+template <> struct swap_plan<soa::Vec2> {
+  static constexpr size_t size = 8;
+  static constexpr std::array<SwapBlock, 1> blocks{{
+    { 0, 8, { 3, 2, 1, 0, 7, 6, 5, 4, 8, 9, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::Vec2) == swap_plan<soa::Vec2>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::Vec3Float> {
+  static constexpr size_t size = 12;
+  static constexpr std::array<SwapBlock, 1> blocks{{
+    { 0, 12, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::Vec3Float) == swap_plan<soa::Vec3Float>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::Instruction> {
+  static constexpr size_t size = 16;
+  static constexpr std::array<SwapBlock, 1> blocks{{
+    { 0, 8, { 3, 2, 1, 0, 4, 5, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::Instruction) == swap_plan<soa::Instruction>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::InstructionSet> {
+  static constexpr size_t size = 32;
+  static constexpr std::array<SwapBlock, 2> blocks{{
+    { 0, 8, { 3, 2, 1, 0, 4, 5, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15 } },
+    { 16, 8, { 3, 2, 1, 0, 4, 5, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::InstructionSet) == swap_plan<soa::InstructionSet>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::Thread> {
+  static constexpr size_t size = 36;
+  static constexpr std::array<SwapBlock, 3> blocks{{
+    { 0, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } },
+    { 16, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } },
+    { 32, 4, { 3, 2, 1, 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::Thread) == swap_plan<soa::Thread>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::AllCombatInstances> {
+  static constexpr size_t size = 48;
+  static constexpr std::array<SwapBlock, 3> blocks{{
+    { 0, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } },
+    { 16, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } },
+    { 32, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } }
+  }};
+};
+static_assert(sizeof(soa::AllCombatInstances) == swap_plan<soa::AllCombatInstances>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::ElementalEffectiveness> {
+  static constexpr size_t size = 12;
+  static constexpr std::array<SwapBlock, 1> blocks{{
+    { 0, 12, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::ElementalEffectiveness) == swap_plan<soa::ElementalEffectiveness>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::DerivedStats> {
+  static constexpr size_t size = 12;
+  static constexpr std::array<SwapBlock, 1> blocks{{
+    { 0, 10, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::DerivedStats) == swap_plan<soa::DerivedStats>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::StatusEffectiveness> {
+  static constexpr size_t size = 32;
+  static constexpr std::array<SwapBlock, 2> blocks{{
+    { 0, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 16, 16, { 1, 0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 15, 14 } }
+  }};
+};
+static_assert(sizeof(soa::StatusEffectiveness) == swap_plan<soa::StatusEffectiveness>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::ItemDrop> {
+  static constexpr size_t size = 6;
+  static constexpr std::array<SwapBlock, 1> blocks{{
+    { 0, 6, { 1, 0, 3, 2, 5, 4, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::ItemDrop) == swap_plan<soa::ItemDrop>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::AIInstruction> {
+  static constexpr size_t size = 6;
+  static constexpr std::array<SwapBlock, 1> blocks{{
+    { 0, 6, { 1, 0, 3, 2, 5, 4, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::AIInstruction) == swap_plan<soa::AIInstruction>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::Wksht> {
+  static constexpr size_t size = 16;
+  static constexpr std::array<SwapBlock, 1> blocks{{
+    { 0, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } }
+  }};
+};
+static_assert(sizeof(soa::Wksht) == swap_plan<soa::Wksht>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::GridRow> {
+  static constexpr size_t size = 11;
+  static constexpr std::array<SwapBlock, 0> blocks{{}};
+};
+static_assert(sizeof(soa::GridRow) == swap_plan<soa::GridRow>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::Grid> {
+  static constexpr size_t size = 121;
+  static constexpr std::array<SwapBlock, 0> blocks{{}};
+};
+static_assert(sizeof(soa::Grid) == swap_plan<soa::Grid>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::GridCoord> {
+  static constexpr size_t size = 2;
+  static constexpr std::array<SwapBlock, 0> blocks{{}};
+};
+static_assert(sizeof(soa::GridCoord) == swap_plan<soa::GridCoord>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::Magic_Ranks> {
+  static constexpr size_t size = 6;
+  static constexpr std::array<SwapBlock, 0> blocks{{}};
+};
+static_assert(sizeof(soa::Magic_Ranks) == swap_plan<soa::Magic_Ranks>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::Character_Stats> {
+  static constexpr size_t size = 10;
+  static constexpr std::array<SwapBlock, 1> blocks{{
+    { 0, 10, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::Character_Stats) == swap_plan<soa::Character_Stats>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::Color_XP> {
+  static constexpr size_t size = 24;
+  static constexpr std::array<SwapBlock, 2> blocks{{
+    { 0, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } },
+    { 16, 8, { 3, 2, 1, 0, 7, 6, 5, 4, 8, 9, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::Color_XP) == swap_plan<soa::Color_XP>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::CombatantInstance> {
+  static constexpr size_t size = 276;
+  static constexpr std::array<SwapBlock, 17> blocks{{
+    { 0, 16, { 1, 0, 2, 3, 4, 5, 6, 7, 9, 8, 10, 11, 12, 13, 15, 14 } },
+    { 16, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } },
+    { 32, 16, { 3, 2, 1, 0, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 48, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 64, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 80, 16, { 1, 0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 15, 14 } },
+    { 96, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 112, 16, { 1, 0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 15, 14 } },
+    { 128, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 144, 14, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 14, 15 } },
+    { 160, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 10, 11, 12, 13, 15, 14 } },
+    { 180, 16, { 1, 0, 3, 2, 4, 5, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 196, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 212, 6, { 1, 0, 3, 2, 5, 4, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } },
+    { 230, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 246, 16, { 1, 0, 3, 2, 5, 4, 6, 7, 8, 9, 10, 11, 13, 12, 15, 14 } },
+    { 264, 12, { 1, 0, 3, 2, 4, 5, 6, 7, 11, 10, 9, 8, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::CombatantInstance) == swap_plan<soa::CombatantInstance>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::PC_Data> {
+  static constexpr size_t size = 92;
+  static constexpr std::array<SwapBlock, 5> blocks{{
+    { 16, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 32, 12, { 1, 0, 3, 2, 7, 6, 5, 4, 11, 10, 9, 8, 12, 13, 14, 15 } },
+    { 58, 14, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 13, 12, 11, 10, 14, 15 } },
+    { 72, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } },
+    { 88, 4, { 3, 2, 1, 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::PC_Data) == swap_plan<soa::PC_Data>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::EnemyDefinition> {
+  static constexpr size_t size = 522;
+  static constexpr std::array<SwapBlock, 31> blocks{{
+    { 26, 14, { 1, 0, 3, 2, 5, 4, 7, 6, 8, 9, 13, 12, 11, 10, 14, 15 } },
+    { 44, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 60, 14, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 14, 15 } },
+    { 86, 16, { 1, 0, 2, 3, 4, 5, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 102, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 10, 11, 13, 12, 15, 14 } },
+    { 118, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 134, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 150, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 166, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 182, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 198, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 214, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 230, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 246, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 262, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 278, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 294, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 310, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 326, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 342, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 358, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 374, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 390, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 406, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 422, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 438, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 454, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 470, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 486, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 502, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 518, 4, { 1, 0, 3, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::EnemyDefinition) == swap_plan<soa::EnemyDefinition>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::All_PC_Data> {
+  static constexpr size_t size = 552;
+  static constexpr std::array<SwapBlock, 30> blocks{{
+    { 16, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 32, 12, { 1, 0, 3, 2, 7, 6, 5, 4, 11, 10, 9, 8, 12, 13, 14, 15 } },
+    { 58, 14, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 13, 12, 11, 10, 14, 15 } },
+    { 72, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } },
+    { 88, 4, { 3, 2, 1, 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } },
+    { 108, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 124, 12, { 1, 0, 3, 2, 7, 6, 5, 4, 11, 10, 9, 8, 12, 13, 14, 15 } },
+    { 150, 14, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 13, 12, 11, 10, 14, 15 } },
+    { 164, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } },
+    { 180, 4, { 3, 2, 1, 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } },
+    { 200, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 216, 12, { 1, 0, 3, 2, 7, 6, 5, 4, 11, 10, 9, 8, 12, 13, 14, 15 } },
+    { 242, 14, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 13, 12, 11, 10, 14, 15 } },
+    { 256, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } },
+    { 272, 4, { 3, 2, 1, 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } },
+    { 292, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 308, 12, { 1, 0, 3, 2, 7, 6, 5, 4, 11, 10, 9, 8, 12, 13, 14, 15 } },
+    { 334, 14, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 13, 12, 11, 10, 14, 15 } },
+    { 348, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } },
+    { 364, 4, { 3, 2, 1, 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } },
+    { 384, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 400, 12, { 1, 0, 3, 2, 7, 6, 5, 4, 11, 10, 9, 8, 12, 13, 14, 15 } },
+    { 426, 14, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 13, 12, 11, 10, 14, 15 } },
+    { 440, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } },
+    { 456, 4, { 3, 2, 1, 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } },
+    { 476, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 492, 12, { 1, 0, 3, 2, 7, 6, 5, 4, 11, 10, 9, 8, 12, 13, 14, 15 } },
+    { 518, 14, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 13, 12, 11, 10, 14, 15 } },
+    { 532, 16, { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 } },
+    { 548, 4, { 3, 2, 1, 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::All_PC_Data) == swap_plan<soa::All_PC_Data>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::BattleItemDropSlot> {
+  static constexpr size_t size = 4;
+  static constexpr std::array<SwapBlock, 1> blocks{{
+    { 0, 4, { 1, 0, 3, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::BattleItemDropSlot) == swap_plan<soa::BattleItemDropSlot>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::ItemSlot> {
+  static constexpr size_t size = 4;
+  static constexpr std::array<SwapBlock, 1> blocks{{
+    { 0, 2, { 1, 0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::ItemSlot) == swap_plan<soa::ItemSlot>::size, "regenerate SoaStructs.swapmask.h");
+
+template <> struct swap_plan<soa::BattleState> {
+  static constexpr size_t size = 376;
+  static constexpr std::array<SwapBlock, 24> blocks{{
+    { 6, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 22, 16, { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 } },
+    { 38, 14, { 1, 0, 3, 2, 5, 4, 7, 6, 8, 9, 13, 12, 11, 10, 14, 15 } },
+    { 52, 14, { 3, 2, 1, 0, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 68, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 84, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 100, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 116, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 132, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 148, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 164, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 180, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 196, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 212, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 228, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 244, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 260, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 276, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 292, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 308, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 324, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 340, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 356, 14, { 1, 0, 2, 3, 5, 4, 6, 7, 9, 8, 10, 11, 13, 12, 14, 15 } },
+    { 372, 2, { 1, 0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } }
+  }};
+};
+static_assert(sizeof(soa::BattleState) == swap_plan<soa::BattleState>::size, "regenerate SoaStructs.swapmask.h");
+
+} // namespace simcore::endian
@@ -0,0 +1,49 @@
+#include "SwapPlan.h"
+#include <cstring>
+
+#if defined(SIMCORE_SWAP_SSSE3)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace simcore::endian {
+
+    void apply_swap_blocks_scalar(uint8_t* p, size_t size, size_t stride, size_t n,
+        const SwapBlock* blocks, size_t count)
+    {
+        (void)size;
+        for (size_t i = 0; i < n; ++i, p += stride) {
+            for (size_t j = 0; j < count; ++j) {
+                const SwapBlock& b = blocks[j];
+                uint8_t* q = p + b.off;
+                uint8_t tmp[16];
+                std::memcpy(tmp, q, b.len);
+                for (size_t k = 0; k < b.len; ++k) q[k] = tmp[b.shuf[k]];
+            }
+        }
+    }
+
+    static bool cpu_has_ssse3()
+    {
+#if !defined(SIMCORE_SWAP_SSSE3)
+        return false;
+#elif defined(_MSC_VER)
+        int r[4]{};
+        __cpuid(r, 1);
+        return (r[2] & (1 << 9)) != 0;
+#else
+        unsigned a = 0, b = 0, c = 0, d = 0;
+        return __get_cpuid(1, &a, &b, &c, &d) && (c & (1u << 9)) != 0;
+#endif
+    }
+
+    bool swap_simd_available()
+    {
+        static const bool has = cpu_has_ssse3();
+        return has;
+    }
+
+} // namespace simcore::endian
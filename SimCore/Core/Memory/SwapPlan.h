@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define SIMCORE_SWAP_SSSE3 1
+#include <immintrin.h>
+#endif
+
+#if defined(SIMCORE_SWAP_SSSE3) && (defined(__GNUC__) || defined(__clang__))
+#define SIMCORE_TARGET_SSSE3 __attribute__((target("ssse3")))
+#else
+#define SIMCORE_TARGET_SSSE3
+#endif
+
+namespace simcore::endian {
+
+    // One 16-byte window of a struct image: bytes [off, off + len) are permuted by `shuf`
+    // (window-relative source index per destination byte; identity past len). Windows never
+    // split a scalar, so the same table serves a pshufb and a scalar byte loop.
+    struct SwapBlock {
+        uint16_t off;
+        uint8_t  len;
+        uint8_t  shuf[16];
+    };
+
+    // Specialized per reflected struct in the generated SoaStructs.swapmask.h:
+    //   static constexpr size_t size;  static constexpr std::array<SwapBlock, N> blocks;
+    template <class T> struct swap_plan;
+
+    template <class T, class = void>
+    struct has_swap_plan : std::false_type {};
+    template <class T>
+    struct has_swap_plan<T, std::void_t<decltype(swap_plan<T>::blocks)>> : std::true_type {};
+
+    // True when the CPU has SSSE3 (checked once).
+    bool swap_simd_available();
+
+    // Applies the blocks bytewise to `n` images of `size` bytes starting at `p`, `stride` bytes apart.
+    // The reference the shuffle path is tested against, and the fallback without SSSE3.
+    void apply_swap_blocks_scalar(uint8_t* p, size_t size, size_t stride, size_t n,
+        const SwapBlock* blocks, size_t count);
+
+    namespace detail {
+
+#if defined(SIMCORE_SWAP_SSSE3)
+        // Instantiated per struct so the block table is a compile-time constant: offsets fold into
+        // the addressing and the loop over blocks unrolls. The bytes past len are written back
+        // unchanged, so a full 16-byte window is fine wherever it stays inside the images; only in
+        // the last image can one reach past the end, and those few are done bytewise.
+        template <class T, bool Last>
+        SIMCORE_TARGET_SSSE3 inline void swap_image_ssse3(uint8_t* p)
+        {
+            using P = swap_plan<T>;
+            for (const SwapBlock& b : P::blocks) {
+                if (Last && b.off + 16u > P::size) {
+                    apply_swap_blocks_scalar(p, P::size, P::size, 1, &b, 1);
+                    continue;
+                }
+                const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b.shuf));
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + b.off));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(p + b.off), _mm_shuffle_epi8(v, mask));
+            }
+        }
+
+        template <class T>
+        SIMCORE_TARGET_SSSE3 void apply_swap_plan_ssse3(uint8_t* p, size_t stride, size_t n)
+        {
+            using P = swap_plan<T>;
+            if (!n) return;
+            constexpr size_t kEnd = P::blocks.size() ? P::blocks.back().off + 16u : 0;
+            const bool inner_ok = kEnd <= stride + P::size;   // every image but the last has >= stride bytes after it
+            for (size_t i = 0; i + 1 < n; ++i, p += stride) {
+                if (inner_ok) swap_image_ssse3<T, false>(p);
+                else swap_image_ssse3<T, true>(p);
+            }
+            swap_image_ssse3<T, true>(p);
+        }
+#endif
+
+    } // namespace detail
+
+    // Byte-swaps `n` images of T (`stride` bytes apart) in place with T's generated plan.
+    template <class T>
+    inline void apply_swap_plan(T* first, size_t n, size_t stride = sizeof(T))
+    {
+        using P = swap_plan<T>;
+        auto* p = reinterpret_cast<uint8_t*>(first);
+#if defined(SIMCORE_SWAP_SSSE3)
+        if (swap_simd_available()) {
+            detail::apply_swap_plan_ssse3<T>(p, stride, n);
+            return;
+        }
+#endif
+        apply_swap_blocks_scalar(p, P::size, stride, n, P::blocks.data(), P::blocks.size());
+    }
+
+} // namespace simcore::endian
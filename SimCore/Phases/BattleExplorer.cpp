@@ -7,11 +7,18 @@
 #include <queue>
 #include <functional>
 #include <optional>
+#include <filesystem>
+#include <cstring>
+#include <cstdio>
+#include <memory>
 #include "../Core/Input/SoaBattle/ActionPlanSerializer.h"
 #include "../Runner/IPC/Wire.h"
 #include "../Core/Memory/Soa/Battle/BattleContextCodec.h"
 #include "../Phases/Programs/BattleContext/BattleContextPayload.h"
+#include "../Core/Memory/Soa/Battle/BattleContextWire.h"
 #include "../Phases/Programs/BattleRunner/BattleRunnerPayload.h"
+#include "../Runner/Parallel/ResultStore.h"  // HashFileContents
+#include "ExplorationJournal.h"
 
 namespace simcore::battleexplorer {
 
@@ -92,6 +99,9 @@ namespace simcore::battleexplorer {
         soa::battle::ctx::BattleContext bc{};
         for (;;) {
             if (!runner.try_get_result(rr)) {
+                if (!runner.has_active_workers()) {
+                    throw std::runtime_error("BattleExplorer.gather_context: no worker left to run the job");
+                }
                 // busy-spin very lightly; in a real UI loop you might pump events / sleep(1)
                 continue;
             }
@@ -107,15 +117,21 @@ namespace simcore::battleexplorer {
             //
             //    Below, we handle a blob in std::string under keys::battle::CTX_BLOB (replace with your real key).
             //    If your script uses per-field keys instead, replace this block with those reads.
+            //    The blob is a fixed-layout wire image, validated where it sits in the result and then
+            //    copied out once: the context outlives rr.
             {
-                std::string blob;
                 constexpr auto CTX_BLOB_KEY = simcore::keys::battle::CTX_BLOB;
-                if (!rr.ps.ctx.get(CTX_BLOB_KEY, blob)) {
+                auto it = rr.ps.ctx.find(CTX_BLOB_KEY);
+                const std::string* blob = (it != rr.ps.ctx.end()) ? std::get_if<std::string>(&it->second) : nullptr;
+                if (!blob) {
                     throw std::runtime_error("BattleExplorer.gather_context: context blob not present");
                 }
-                if (!soa::battle::ctx::codec::decode(blob, bc)) {
-                    throw std::runtime_error("BattleExplorer.gather_context: decode_from_blob failed");
+                std::string err;
+                const auto* w = soa::battle::ctx::wire::view(*blob, &err);
+                if (!w) {
+                    throw std::runtime_error("BattleExplorer.gather_context: " + err);
                 }
+                soa::battle::ctx::wire::to_context(*w, bc);
             }
             break;
         }
@@ -425,13 +441,301 @@ namespace simcore::battleexplorer {
         return out;
     }
 
+    // --- Incremental re-exploration helpers ---
+
+    static inline uint64_t fnv64(uint64_t h, const void* data, size_t n) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= 1099511628211ull; }
+        return h;
+    }
+
+    // Predicate identity for change detection: everything the VM evaluates, minus id/desc/turn_mask.
+    static std::vector<uint8_t> canonical_pred(const pred::Spec& s) {
+        std::vector<uint8_t> b;
+        auto put = [&](const void* p, size_t n) { const auto* c = static_cast<const uint8_t*>(p); b.insert(b.end(), c, c + n); };
+        const uint16_t lk = s.lhs_key ? (uint16_t)*s.lhs_key : 0, rk = s.rhs_key ? (uint16_t)*s.rhs_key : 0;
+        const uint8_t has_lk = s.lhs_key.has_value(), has_rk = s.rhs_key.has_value();
+        put(&s.required_bp, 2); put(&s.kind, 1); put(&s.width, 1); put(&s.cmp, 1); put(&s.flags, 1);
+        put(&s.lhs_addr, 4); put(&has_lk, 1); put(&lk, 2); put(&s.rhs_value, 8); put(&has_rk, 1); put(&rk, 2);
+        const uint32_t nl = (uint32_t)s.lhs_prog.size(), nr = (uint32_t)s.rhs_prog.size();
+        put(&nl, 4); put(s.lhs_prog.data(), nl); put(&nr, 4); put(s.rhs_prog.data(), nr);
+        return b;
+    }
+
+    static std::vector<std::vector<uint8_t>> preds_for_turn(const std::vector<pred::Spec>& preds, uint32_t turn) {
+        std::vector<std::vector<uint8_t>> out;
+        for (const auto& s : preds)
+            if (pred::applies_to_turn(s.turn_mask, turn)) out.push_back(canonical_pred(s));
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    // True if both predicate sets evaluate identically on every turn in [0, through_turn].
+    static bool preds_unchanged_through(const std::vector<pred::Spec>& a, const std::vector<pred::Spec>& b, uint32_t through_turn) {
+        for (uint32_t t = 0; t <= through_turn; ++t)
+            if (preds_for_turn(a, t) != preds_for_turn(b, t)) return false;
+        return true;
+    }
+
+    static bool same_turns(const BattlePath& a, const BattlePath& b, size_t turns) {
+        if (a.size() < turns || b.size() < turns) return false;
+        std::vector<uint8_t> ea, eb;
+        soa::battle::actions::encode_turn_plans_to_buffer(BattlePath(a.begin(), a.begin() + turns), ea);
+        soa::battle::actions::encode_turn_plans_to_buffer(BattlePath(b.begin(), b.begin() + turns), eb);
+        if (ea != eb) return false;
+        for (size_t t = 0; t < turns; ++t)
+            if (a[t].fake_attack_count != b[t].fake_attack_count) return false;
+        return true;
+    }
+
+    static uint64_t prefix_key(const GCInputFrame& initial, const BattlePath& path, size_t turns) {
+        std::vector<uint8_t> enc;
+        soa::battle::actions::encode_turn_plans_to_buffer(BattlePath(path.begin(), path.begin() + std::min(turns, path.size())), enc);
+        uint64_t h = fnv64(1469598103934665603ull, &initial, sizeof(GCInputFrame));
+        h = fnv64(h, enc.data(), enc.size());
+        for (size_t t = 0; t < std::min(turns, path.size()); ++t)
+            h = fnv64(h, &path[t].fake_attack_count, sizeof(uint32_t));
+        return h;
+    }
+
+    std::string BattleExplorer::turn_state_path(const GCInputFrame& initial, const BattlePath& path, size_t turns)
+    {
+        if (m_turn_state_dir.empty()) return {};
+        if (m_state_hash == 0) m_state_hash = HashFileContents(m_savestate_path);
+        const uint64_t pk = prefix_key(initial, path, turns);
+        const uint64_t h = fnv64(m_state_hash, &pk, sizeof(pk));
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.sav", (unsigned long long)h);
+        return (std::filesystem::path(m_turn_state_dir) / name).string();
+    }
+
+    phase::battle::runner::EncodeSpec BattleExplorer::make_spec(const UI_Config& ui, const GCInputFrame& initial,
+        const BattlePath& path, uint32_t first_boundary)
+    {
+        phase::battle::runner::EncodeSpec spec{};
+        spec.run_ms = 60000;
+        spec.vi_stall_ms = 2000;
+        spec.initial = initial;
+        spec.predicates = ui.predicates;
+        spec.path = path;
+
+        // Ask the worker to cache every boundary it will pass that is not cached yet.
+        if (!m_turn_state_dir.empty()) {
+            std::error_code ec;
+            spec.turn_state_paths.resize(path.size() + 1);
+            for (size_t t = first_boundary; t <= path.size(); ++t) {
+                auto sp = turn_state_path(initial, path, t);
+                if (!std::filesystem::exists(sp, ec)) spec.turn_state_paths[t] = std::move(sp);
+            }
+        }
+        return spec;
+    }
+
     RunResultSummary BattleExplorer::run_paths(const UI_Config& ui,
             const std::vector<soa::battle::actions::BattlePath>& paths,
             ParallelPhaseScriptRunner& runner)
     {
         RunResultSummary sum{};
-        uint64_t total_jobs = paths.size() * ui.initial_frames.size();
-        sum.jobs_total = total_jobs;
+        sum.jobs_total = paths.size() * ui.initial_frames.size();
+
+        if (!m_turn_state_dir.empty()) {
+            std::error_code ec;
+            std::filesystem::create_directories(m_turn_state_dir, ec);
+        }
+
+        std::vector<PathJob> jobs;
+        jobs.reserve(sum.jobs_total);
+        uint64_t path_id = 0;
+        for (const auto& initial : ui.initial_frames)
+            for (const auto& path : paths)
+                jobs.push_back(PathJob{ path_id++, make_spec(ui, initial, path, 0) });
+
+        dispatch_jobs(ui, jobs, runner, sum);
+        if (m_sink) m_sink->on_run_end();
+        return sum;
+    }
+
+    RunResultSummary BattleExplorer::run_paths_incremental(const UI_Config& ui,
+        const std::vector<soa::battle::actions::BattlePath>& paths,
+        const RunResultSummary& previous,
+        ParallelPhaseScriptRunner& runner)
+    {
+        using simcore::battle::Outcome;
+
+        RunResultSummary sum{};
+        sum.jobs_total = paths.size() * ui.initial_frames.size();
+
+        if (!m_turn_state_dir.empty()) {
+            std::error_code ec;
+            std::filesystem::create_directories(m_turn_state_dir, ec);
+        }
+
+        // Index the previous run by the prefix it actually executed (ended) and by every boundary it passed.
+        struct Prev { const JobResult* r; uint32_t end_turn; Outcome oc; };
+        std::unordered_map<uint64_t, std::vector<Prev>> ended_at, passed;
+        auto index = [&](const std::vector<JobResult>& v) {
+            for (const auto& r : v) {
+                uint32_t oc = 0, end_turn = 0;
+                if (!r.pr.ps.ctx.get<uint32_t>(keys::battle::BATTLE_OUTCOME, oc)) continue;
+                if (!r.pr.ps.ctx.get<uint32_t>(keys::battle::ACTIVE_TURN, end_turn)) continue;
+                if (end_turn > r.spec.path.size()) continue;
+                const Prev pv{ &r, end_turn, (Outcome)oc };
+                ended_at[prefix_key(r.spec.initial, r.spec.path, end_turn)].push_back(pv);
+
+                // Boundary t is passed once turn t completed with all predicates passing.
+                if (pv.oc != Outcome::TurnsExhausted && end_turn == 0) continue;
+                const uint32_t last_passed = (pv.oc == Outcome::TurnsExhausted) ? end_turn : end_turn - 1;
+                for (uint32_t t = 0; t <= last_passed; ++t)
+                    passed[prefix_key(r.spec.initial, r.spec.path, t)].push_back(pv);
+            }
+        };
+        index(previous.successes);
+        index(previous.fails);
+
+        auto remap_pred_id = [&](JobResult& jr, const JobResult& old) {
+            uint32_t old_id = 0;
+            if (!jr.pr.ps.ctx.get<uint32_t>(keys::core::PRED_FIRST_FAILED, old_id)) return;
+            for (const auto& os : old.spec.predicates) {
+                if (os.id != old_id) continue;
+                const auto canon = canonical_pred(os);
+                for (const auto& ns : ui.predicates)
+                    if (canonical_pred(ns) == canon) { jr.pr.ps.ctx[keys::core::PRED_FIRST_FAILED] = (uint32_t)ns.id; return; }
+            }
+        };
+
+        std::vector<PathJob> jobs;
+        uint64_t path_id = 0;
+        for (const auto& initial : ui.initial_frames) {
+            for (const auto& path : paths) {
+                const uint64_t id = path_id++;
+                const uint32_t N = (uint32_t)path.size();
+
+                // A) Reuse: the previous run ended on a turn that is unchanged in actions and predicates.
+                const Prev* reuse = nullptr;
+                for (uint32_t e = 0; e <= N && !reuse; ++e) {
+                    auto it = ended_at.find(prefix_key(initial, path, e));
+                    if (it == ended_at.end()) continue;
+                    for (const auto& pv : it->second) {
+                        if (pv.end_turn != e || std::memcmp(&pv.r->spec.initial, &initial, sizeof(GCInputFrame)) != 0) continue;
+                        if (!same_turns(pv.r->spec.path, path, e)) continue;
+                        if (pv.oc == Outcome::TurnsExhausted && e != N) continue;       // ran out of turns: new turns to simulate
+                        if (pv.oc == Outcome::DWRunErr || pv.oc == Outcome::Unknown) continue;
+                        if (!preds_unchanged_through(pv.r->spec.predicates, ui.predicates, e)) continue;
+                        reuse = &pv; break;
+                    }
+                }
+                if (reuse) {
+                    JobResult jr = *reuse->r;
+                    jr.job_id = id;
+                    jr.spec = make_spec(ui, initial, path, N + 1);
+                    remap_pred_id(jr, *reuse->r);
+                    emit(sum, std::move(jr));
+                    ++sum.jobs_reused;
+                    continue;
+                }
+
+                // B) Resume: deepest cached boundary passed by a previous run under unchanged predicates.
+                uint32_t resume_turn = 0;
+                std::string resume_path;
+                if (!m_turn_state_dir.empty()) {
+                    for (int t = (int)N - 1; t >= 0 && resume_path.empty(); --t) {
+                        auto it = passed.find(prefix_key(initial, path, (size_t)t));
+                        if (it == passed.end()) continue;
+                        for (const auto& pv : it->second) {
+                            if (std::memcmp(&pv.r->spec.initial, &initial, sizeof(GCInputFrame)) != 0) continue;
+                            if (!same_turns(pv.r->spec.path, path, (size_t)t)) continue;
+                            if (!preds_unchanged_through(pv.r->spec.predicates, ui.predicates, (uint32_t)t)) continue;
+                            std::error_code ec;
+                            auto sp = turn_state_path(initial, path, (size_t)t);
+                            if (!std::filesystem::exists(sp, ec)) continue;
+                            resume_turn = (uint32_t)t;
+                            resume_path = std::move(sp);
+                            break;
+                        }
+                    }
+                }
+
+                PathJob pj{ id, make_spec(ui, initial, path, resume_path.empty() ? 0 : resume_turn + 1) };
+                if (!resume_path.empty()) {
+                    pj.spec.resume_turn = resume_turn;
+                    pj.spec.resume_state_path = std::move(resume_path);
+                    ++sum.jobs_resumed;
+                }
+                jobs.push_back(std::move(pj));
+            }
+        }
+
+        SCLOGI("[explorer] incremental: %llu jobs, %llu reused, %llu resumed from turn states, %zu to simulate",
+            (unsigned long long)sum.jobs_total, (unsigned long long)sum.jobs_reused,
+            (unsigned long long)sum.jobs_resumed, jobs.size());
+
+        dispatch_jobs(ui, jobs, runner, sum);
+        if (m_sink) m_sink->on_run_end();
+        return sum;
+    }
+
+    void BattleExplorer::emit(RunResultSummary& sum, JobResult&& jr)
+    {
+        const bool success = jr.outcome == battle::Outcome::Victory;
+        if (success) ++sum.jobs_success;
+        else ++sum.jobs_failed;
+        if (m_sink) m_sink->on_result(jr);
+
+        if (success && m_retention != ResultRetention::None) sum.successes.push_back(std::move(jr));
+        else if (!success && m_retention == ResultRetention::All) sum.fails.push_back(std::move(jr));
+    }
+
+    void BattleExplorer::dispatch_jobs(const UI_Config& ui, const std::vector<PathJob>& jobs,
+            ParallelPhaseScriptRunner& runner, RunResultSummary& sum)
+    {
+        if (jobs.empty()) return;
+        const uint64_t total_jobs = jobs.size();
+
+        // 0) Crash journal: answer paths completed by an earlier (interrupted) session of this batch
+        std::vector<uint64_t> fingerprints(jobs.size());
+        std::unique_ptr<ExplorationJournal> journal;
+        if (!m_journal_path.empty()) {
+            if (m_state_hash == 0) m_state_hash = HashFileContents(m_savestate_path);
+            uint64_t batch_id = fnv64(1469598103934665603ull, &m_state_hash, sizeof(m_state_hash));
+            for (size_t i = 0; i < jobs.size(); ++i) {
+                const auto& sp = jobs[i].spec;
+                uint64_t fp = prefix_key(sp.initial, sp.path, sp.path.size());
+                for (const auto& pr : sp.predicates) {
+                    const auto c = canonical_pred(pr);
+                    fp = fnv64(fp, c.data(), c.size());
+                    fp = fnv64(fp, &pr.turn_mask, sizeof(pr.turn_mask));
+                }
+                fingerprints[i] = fp;
+                batch_id = fnv64(batch_id, &jobs[i].path_id, sizeof(uint64_t));
+                batch_id = fnv64(batch_id, &fp, sizeof(fp));
+            }
+
+            journal = std::make_unique<ExplorationJournal>();
+            std::string err;
+            if (!journal->open(m_journal_path, batch_id, &err)) {
+                SCLOGW("[explorer] journal disabled: %s", err.c_str());
+                journal.reset();
+            }
+        }
+
+        std::vector<size_t> to_submit;
+        to_submit.reserve(jobs.size());
+        size_t replayed = 0, was_in_flight = 0;
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            const auto* d = journal ? journal->find_done(jobs[i].path_id, fingerprints[i]) : nullptr;
+            if (!d) {
+                if (journal && journal->was_submitted(jobs[i].path_id)) ++was_in_flight;
+                to_submit.push_back(i);
+                continue;
+            }
+            JobResult jr{ (battle::Outcome)d->outcome, jobs[i].path_id, jobs[i].spec, d->pr };
+            emit(sum, std::move(jr));
+            ++replayed;
+        }
+        if (journal)
+            SCLOGI("[explorer] journal: %zu/%llu paths already done, %zu were in flight, %zu to submit",
+                replayed, (unsigned long long)total_jobs, was_in_flight, to_submit.size());
+        if (to_submit.empty()) return;
 
         // 1) Broadcast BattleRunner program to all workers
         PSInit init{};
@@ -457,39 +761,43 @@ namespace simcore::battleexplorer {
             uint64_t path_id;
             int retry_count = -1;
             phase::battle::runner::EncodeSpec spec;
+            uint64_t fingerprint = 0;
         };
         std::unordered_map<uint64_t, Pending> pendings;
         pendings.reserve(total_jobs);
 
-        uint64_t path_id = 0;
         SCLOGI("[explorer] Submitting Jobs");
-        for (const auto& initial : ui.initial_frames)
-        {
-            for (const auto& path : paths) {
-                phase::battle::runner::EncodeSpec spec{};
-                spec.run_ms = 60000;
-                spec.vi_stall_ms = 2000;
-                spec.initial = initial;
-                spec.predicates = ui.predicates;
-                spec.path = path;
-
-                std::vector<uint8_t> buf;
-                phase::battle::runner::encode_payload(spec, buf);
-
-                PSJob job{};
-                job.payload = std::move(buf);
-
-                const uint64_t jid = runner.submit(job);
-                Pending p{ path_id++, ui.max_retry_count, spec };
-                pendings.emplace(jid, p);
-            }
+        for (size_t i : to_submit) {
+            const auto& pj = jobs[i];
+            std::vector<uint8_t> buf;
+            phase::battle::runner::encode_payload(pj.spec, buf);
+
+            PSJob job{};
+            job.payload = std::move(buf);
+
+            if (journal) journal->record_submit(pj.path_id, fingerprints[i]);
+            const uint64_t jid = runner.submit(job);
+            Pending p{ pj.path_id, ui.max_retry_count, pj.spec, fingerprints[i] };
+            pendings.emplace(jid, p);
         }
+        if (journal) journal->flush(true);
 
         // 3) Collect results for all submitted jobs
         size_t remaining = pendings.size();
         while (remaining > 0) {
             PRResult rr{};
             if (!runner.try_get_result(rr)) {
+                if (!runner.has_active_workers()) {
+                    // Every worker is parked: what is still pending will never come back. Report it as
+                    // failed and return what was collected; the journal leaves those paths undone.
+                    SCLOGE("[explorer] No worker left; giving up on %zu of %llu jobs", pendings.size(), (unsigned long long)total_jobs);
+                    for (auto& [jid, p] : pendings) {
+                        PRResult lost{};
+                        lost.job_id = jid;
+                        emit(sum, JobResult{ battle::Outcome::DWRunErr, p.path_id, std::move(p.spec), std::move(lost) });
+                    }
+                    break;
+                }
                 // In a real UI loop, you could also poll progress here via runner.try_get_progress(...)
                 continue;
             }
@@ -499,6 +807,7 @@ namespace simcore::battleexplorer {
             if (!rr.accepted) {
                 // Transport or VM failure; treat as non-success and continue
                 SCLOGW("[explorer] Job was not accepted (probably wrong epoch): worker=%d jobid=%d", rr.worker_id, rr.job_id);
+                pendings.erase(rr.job_id);
                 --remaining;
                 continue;
             }
@@ -506,9 +815,35 @@ namespace simcore::battleexplorer {
             if (!rr.ps.ok) {
                 auto p = pendings.find(rr.job_id)->second;
                 pendings.erase(rr.job_id);
-                uint32_t outcome; rr.ps.ctx.get(keys::core::DW_RUN_OUTCOME_CODE, outcome);
-                uint32_t timeout_ms; rr.ps.ctx.get(keys::core::RUN_MS, timeout_ms);
-                if (outcome != (uint32_t)RunToBpOutcome::Hit)
+                uint32_t outcome = (uint32_t)RunToBpOutcome::Unknown; rr.ps.ctx.get(keys::core::DW_RUN_OUTCOME_CODE, outcome);
+                uint32_t timeout_ms = 0; rr.ps.ctx.get(keys::core::RUN_MS, timeout_ms);
+                uint32_t resume_failed = 0; rr.ps.ctx.get(keys::battle::RESUME_LOAD_FAILED, resume_failed);
+                if (resume_failed && !p.spec.resume_state_path.empty()) {
+                    // The cached boundary state could not be loaded: run the whole path instead, once (the
+                    // retry names no resume state, so it cannot fail this way again), and rewrite that state.
+                    // SAVE_TURN_STATE never overwrites an existing file, so the bad one has to go first.
+                    SCLOGW("[explorer] Job (%d) could not load turn state %s, rerunning in full: jobid=%d",
+                        p.path_id, p.spec.resume_state_path.c_str(), rr.job_id);
+                    std::error_code ec;
+                    std::filesystem::remove(p.spec.resume_state_path, ec);
+                    if (p.spec.resume_turn < p.spec.turn_state_paths.size())
+                        p.spec.turn_state_paths[p.spec.resume_turn] = std::move(p.spec.resume_state_path);
+                    p.spec.resume_state_path.clear();
+                    p.spec.resume_turn = 0;
+
+                    std::vector<uint8_t> buf;
+                    phase::battle::runner::encode_payload(p.spec, buf);
+                    PSJob job{};
+                    job.payload = std::move(buf);
+                    pendings.emplace(runner.submit(job), std::move(p));
+                }
+                else if (rr.ps.w_err == WERR_WorkerCrashed) {
+                    // The runner already re-ran it on fresh workers; resubmitting would only crash more of them
+                    SCLOGW("[explorer] Job (%d) keeps crashing workers, not resubmitting: jobid=%d", p.path_id, rr.job_id);
+                    if (m_sink) m_sink->on_result(JobResult{ battle::Outcome::DWRunErr, p.path_id, p.spec, rr });
+                    --remaining;
+                }
+                else if (outcome != (uint32_t)RunToBpOutcome::Hit)
                 {
                     bool do_retry = false;
                     if (p.retry_count < 0) do_retry = true;
@@ -534,17 +869,20 @@ namespace simcore::battleexplorer {
 
                         PSJob job{};
                         job.payload = std::move(buf);
+                        job.learned_timeouts = false;  // a learned budget may be what cut it short; retry with the script's own
                         uint64_t jid = runner.submit(job);
                         pendings.emplace(jid, p);
                         
                     }
                     else {
+                        if (m_sink) m_sink->on_result(JobResult{ battle::Outcome::DWRunErr, p.path_id, p.spec, rr });
                         --remaining;
                     }
 
                 }
                 else {
                     SCLOGW("[explorer] Job VM failed (%d) due to unknown reason, not resubmiting: worker=%d jobid=%d, outcome=%d", p.path_id, rr.worker_id, rr.job_id, outcome);
+                    if (m_sink) m_sink->on_result(JobResult{ battle::Outcome::DWRunErr, p.path_id, p.spec, rr });
                     --remaining;
                 }
                 continue;
@@ -556,23 +894,18 @@ namespace simcore::battleexplorer {
             if (rr.ps.ctx.get<uint32_t>(keys::battle::BATTLE_OUTCOME, oc)) {
                 is_success = (oc == static_cast<uint32_t>(battle::Outcome::Victory));
             }
+            else oc = static_cast<uint32_t>(battle::Outcome::Unknown);  // Victory is 0; a missing code must not read as one
             --remaining;
 
             SCLOGI("[explorer] Received results (%d/%d): workerid=%d jobid=%d success=%s%s", total_jobs - remaining, total_jobs, rr.worker_id, rr.job_id, is_success ? "true" : "false ", oc == 0 ? "" : battle::get_outcome_string((battle::Outcome)oc).c_str());
 
-            auto p = pendings.find(rr.job_id)->second;
+            auto p = std::move(pendings.find(rr.job_id)->second);
+            pendings.erase(rr.job_id);
+            if (journal) journal->record_done(p.path_id, p.fingerprint, (uint16_t)oc, rr);
 
-            if (is_success) 
-            {
-                sum.successes.emplace_back((battle::Outcome)oc, p.path_id, p.spec, rr);
-                ++sum.jobs_success;
-            }
-            else {
-                sum.fails.emplace_back((battle::Outcome)oc, p.path_id, p.spec, rr);
-            }
+            emit(sum, JobResult{ (battle::Outcome)oc, p.path_id, std::move(p.spec), std::move(rr) });
         }
-
-        return sum;
+        if (journal) journal->flush(true);
     }
 
     // --- Validation & estimates ---
@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <memory>
 #include "../Core/Input/SoaBattle/ActionTypes.h"
 #include "../Core/Memory/Soa/Battle/BattleContext.h"
 #include "../Runner/Parallel/ParallelPhaseScriptRunner.h"
@@ -49,6 +50,25 @@ namespace simcore::battleexplorer {
         uint64_t jobs_success = 0;
         std::vector<JobResult> fails;
         std::vector<JobResult> successes;
+        uint64_t jobs_reused = 0;   // answered from a previous summary without simulating
+        uint64_t jobs_resumed = 0;  // simulated from a cached turn-boundary state
+        uint64_t jobs_failed = 0;   // counted even when `fails` is not retained
+    };
+
+    // Receives every final job result of a run as it is collected (see ResultColumns.h for the
+    // on-disk columnar writer). Called on the dispatching thread.
+    class IResultSink {
+    public:
+        virtual ~IResultSink() = default;
+        virtual void on_result(const JobResult& r) = 0;
+        virtual void on_run_end() {}
+    };
+
+    // What RunResultSummary keeps in memory once a sink is attached.
+    enum class ResultRetention : uint8_t {
+        All,            // successes and fails (default; needed for full incremental reuse)
+        SuccessesOnly,  // fails only go to the sink
+        None,           // counters only
     };
 
     class BattleExplorer {
@@ -67,6 +87,34 @@ namespace simcore::battleexplorer {
             const std::vector<soa::battle::actions::BattlePath>& paths,
             ParallelPhaseScriptRunner& runner);
 
+        // 3b) Same as run_paths, but consults a previous run's summary first:
+        //     - a path whose previous run ended (won, lost, failed a predicate or could not materialize)
+        //       on a turn whose actions and predicates are unchanged is answered from `previous`;
+        //     - otherwise, if a previous run passed an unchanged turn-boundary whose state is cached,
+        //       only the suffix after that boundary is simulated;
+        //     - everything else is run from the savestate as usual.
+        RunResultSummary run_paths_incremental(const UI_Config& ui,
+            const std::vector<soa::battle::actions::BattlePath>& paths,
+            const RunResultSummary& previous,
+            ParallelPhaseScriptRunner& runner);
+
+        // Directory for cached turn-boundary savestates (one file per distinct initial frame + turn prefix).
+        // Empty (default) disables both saving boundary states and resuming from them.
+        void set_turn_state_dir(std::string dir) { m_turn_state_dir = std::move(dir); }
+
+        // Crash journal (see ExplorationJournal). When set, every dispatch records submitted and completed
+        // paths there; after a restart with the same paths/predicates/savestate, completed paths are
+        // answered from the journal and only unfinished ones are submitted again. Empty disables it.
+        void set_journal_path(std::string path) { m_journal_path = std::move(path); }
+
+        // Streams every result (including jobs dropped after failed retries) to `sink`. With a retention
+        // other than All the summary stays small for large runs; run_paths_incremental() can then only
+        // reuse what was retained.
+        void set_result_sink(std::shared_ptr<IResultSink> sink, ResultRetention keep = ResultRetention::All) {
+            m_sink = std::move(sink);
+            m_retention = keep;
+        }
+
         // Estimators for the CLI footer
         uint64_t estimate_paths_no_fake(const UI_Config& ui, const soa::battle::ctx::BattleContext& ctx) const;
         uint64_t estimate_paths_with_fake(const UI_Config& ui, const uint64_t paths_wo_fake) const; // X * C(B+N, N)
@@ -77,7 +125,24 @@ namespace simcore::battleexplorer {
 
         static std::vector<std::vector<uint32_t>> enumerate_fakeattack_vectors(std::size_t N, uint32_t B);
 
+        struct PathJob {
+            uint64_t path_id;
+            phase::battle::runner::EncodeSpec spec;
+        };
+
+        phase::battle::runner::EncodeSpec make_spec(const UI_Config& ui, const GCInputFrame& initial,
+            const soa::battle::actions::BattlePath& path, uint32_t first_boundary);
+        std::string turn_state_path(const GCInputFrame& initial, const soa::battle::actions::BattlePath& path, size_t turns);
+        void emit(RunResultSummary& sum, JobResult&& jr);
+        void dispatch_jobs(const UI_Config& ui, const std::vector<PathJob>& jobs,
+            ParallelPhaseScriptRunner& runner, RunResultSummary& sum);
+
         std::string m_savestate_path{""};
+        std::string m_turn_state_dir{""};
+        std::string m_journal_path{""};
+        uint64_t m_state_hash{ 0 };
+        std::shared_ptr<IResultSink> m_sink;
+        ResultRetention m_retention{ ResultRetention::All };
     };
 
 } // namespace simcore::battleexplorer
@@ -0,0 +1,94 @@
+#include "BranchTreeRun.h"
+
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+
+#include "../Core/Branching/BranchExecutor.h"
+#include "../Utils/Log.h"
+#include "../Runner/IPC/Wire.h"
+
+namespace simcore {
+
+    BranchTreeResult RunBranchTree(ParallelPhaseScriptRunner& runner, const BranchTreeArgs& args)
+    {
+        BranchTreeResult out{};
+        if (const std::string err = BranchExplorer::validate_spec(args.spec); !err.empty()) {
+            SCLOGE("[branch] invalid spec: %s", err.c_str());
+            return out;
+        }
+
+        PSInit init{};
+        init.savestate_path = args.savestate_path;
+        if (!runner.set_program(/*init_kind=*/PK_None, /*main_kind=*/PK_BranchTree, init)) {
+            SCLOGE("[branch] Failed to set program on workers.");
+            return out;
+        }
+        if (!runner.activate_main()) {
+            SCLOGE("[branch] Failed to activate main program.");
+            return out;
+        }
+
+        // Shard on the first real fork; a spec without one is a single job
+        const auto& decisions = args.spec.decisions;
+        size_t split = 0;
+        while (split < decisions.size() && decisions[split].options.size() < 2) ++split;
+        const size_t shards = split < decisions.size() ? decisions[split].options.size() : 1;
+
+        std::unordered_map<uint64_t, size_t> lookup;
+        for (size_t i = 0; i < shards; ++i) {
+            branchtree::BranchTreeSpec spec{};
+            spec.spec = shards > 1 ? BranchSubtree(args.spec, split, i) : args.spec;
+            spec.watch_addrs = args.watch_addrs;
+            spec.step_ms = args.step_timeout_ms;
+            PSJob j{};
+            if (!branchtree::encode_branch_tree_payload(spec, j.payload)) {
+                SCLOGE("[branch] could not encode shard %zu", i);
+                continue;
+            }
+            lookup.emplace(runner.submit(j), i);
+        }
+        out.jobs = (uint32_t)lookup.size();
+
+        std::vector<std::vector<branchtree::BranchLeaf>> per_shard(shards);
+        while (!lookup.empty()) {
+            PRResult r{};
+            if (!runner.try_get_result(r)) {
+                if (!runner.has_active_workers()) {
+                    SCLOGE("[branch] no worker left; %zu shard(s) not run", lookup.size());
+                    out.failed_jobs += uint32_t(lookup.size());
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+            auto it = lookup.find(r.job_id);
+            if (it == lookup.end()) continue;
+            const size_t shard = it->second;
+            lookup.erase(it);
+
+            uint32_t frames = 0;
+            auto& leaves = per_shard[shard];
+            if (!r.ps.ok || !branchtree::decode_branch_tree_result(r.ps.ctx, decisions.size(), args.watch_addrs.size(), leaves, frames)) {
+                SCLOGE("[branch] shard %zu (job %llu) failed. w_err:%d", shard, (unsigned long long)r.job_id, r.ps.w_err);
+                leaves.clear();
+                ++out.failed_jobs;
+                continue;
+            }
+            // The shard's spec pins the split decision to its only option; report the original index
+            if (shards > 1)
+                for (auto& leaf : leaves) leaf.options[split] = uint32_t(shard);
+            out.frames_stepped += frames;
+        }
+
+        for (auto& leaves : per_shard)
+            for (auto& leaf : leaves) out.leaves.push_back(std::move(leaf));
+        out.naive_frames = uint64_t(out.leaves.size()) * args.spec.total_frames;
+
+        SCLOGI("[branch] %zu leaves from %u job(s) (%u failed): %llu frames emulated, %llu replaying each leaf",
+            out.leaves.size(), out.jobs, out.failed_jobs,
+            (unsigned long long)out.frames_stepped, (unsigned long long)out.naive_frames);
+        return out;
+    }
+
+} // namespace simcore
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../Core/Branching/Branching.h"
+#include "../Runner/Parallel/ParallelPhaseScriptRunner.h"
+#include "Programs/BranchTree/BranchTreePayload.h"
+
+namespace simcore {
+
+    // Runs a BranchSpec's decision tree on the runner's workers as BranchTree jobs.
+    //
+    // Each job walks its part of the tree inside one worker (BranchTreeExecutor over
+    // DolphinBranchHost), so every segment between decisions is emulated once per tree node. The
+    // first decision with more than one option is split with BranchSubtree, one job per option, so
+    // the top of the tree spreads over that many workers.
+
+    struct BranchTreeArgs {
+        std::string savestate_path;
+        BranchSpec spec;
+        std::vector<uint32_t> watch_addrs;   // u32 reads taken at every leaf
+        uint32_t step_timeout_ms{ 1000 };    // per emulated frame
+    };
+
+    struct BranchTreeResult {
+        std::vector<branchtree::BranchLeaf> leaves;   // depth-first; options index the full spec's decisions
+        uint32_t jobs{ 0 };
+        uint32_t failed_jobs{ 0 };                    // their subtrees are missing from leaves
+        uint64_t frames_stepped{ 0 };
+        uint64_t naive_frames{ 0 };                   // leaves * total_frames: replaying every branch
+    };
+
+    // Sets PK_BranchTree on the runner, submits one job per shard and gathers the leaves.
+    BranchTreeResult RunBranchTree(ParallelPhaseScriptRunner& runner, const BranchTreeArgs& args);
+
+} // namespace simcore
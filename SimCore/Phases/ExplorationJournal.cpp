@@ -0,0 +1,241 @@
+#include "ExplorationJournal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#include "../Runner/Script/PSContextCodec.h"
+#include "../Utils/Log.h"
+
+namespace simcore::battleexplorer {
+
+    enum : uint8_t { REC_SUBMIT = 1, REC_DONE = 2 };
+
+    static constexpr uint64_t FNV_OFFSET = 1469598103934665603ull;
+    static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t REC_OVERHEAD = 4 + 1 + 4 + 8;
+
+    static inline uint64_t fnv1a(const uint8_t* p, size_t n) {
+        uint64_t h = FNV_OFFSET;
+        for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= FNV_PRIME; }
+        return h;
+    }
+
+    static inline void put_u8(std::vector<uint8_t>& b, uint8_t v) { b.push_back(v); }
+    static inline void put_u16(std::vector<uint8_t>& b, uint16_t v) { b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8)); }
+    static inline void put_u32(std::vector<uint8_t>& b, uint32_t v) {
+        b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8)); b.push_back(uint8_t(v >> 16)); b.push_back(uint8_t(v >> 24));
+    }
+    static inline void put_u64(std::vector<uint8_t>& b, uint64_t v) { put_u32(b, uint32_t(v)); put_u32(b, uint32_t(v >> 32)); }
+    static inline uint16_t rd_u16(const uint8_t* d) { return uint16_t(d[0]) | (uint16_t(d[1]) << 8); }
+    static inline uint32_t rd_u32(const uint8_t* d) {
+        return uint32_t(d[0]) | (uint32_t(d[1]) << 8) | (uint32_t(d[2]) << 16) | (uint32_t(d[3]) << 24);
+    }
+    static inline uint64_t rd_u64(const uint8_t* d) { return uint64_t(rd_u32(d)) | (uint64_t(rd_u32(d + 4)) << 32); }
+
+    static bool write_at(HANDLE h, uint64_t off, const void* p, size_t n) {
+        const BYTE* b = static_cast<const BYTE*>(p);
+        while (n) {
+            OVERLAPPED ov{}; ov.Offset = DWORD(off); ov.OffsetHigh = DWORD(off >> 32);
+            DWORD w = 0;
+            if (!WriteFile(h, b, (DWORD)std::min(n, (size_t)0x7FFFFFFF), &w, &ov) || w == 0) return false;
+            b += w; n -= w; off += w;
+        }
+        return true;
+    }
+
+    static bool read_whole(HANDLE h, std::vector<uint8_t>& out) {
+        LARGE_INTEGER sz{};
+        if (!GetFileSizeEx(h, &sz)) return false;
+        out.resize(size_t(sz.QuadPart));
+        size_t got = 0;
+        while (got < out.size()) {
+            OVERLAPPED ov{}; ov.Offset = DWORD(got); ov.OffsetHigh = DWORD(uint64_t(got) >> 32);
+            DWORD r = 0;
+            if (!ReadFile(h, out.data() + got, (DWORD)std::min(out.size() - got, (size_t)0x7FFFFFFF), &r, &ov) || r == 0) return false;
+            got += r;
+        }
+        return true;
+    }
+
+    ExplorationJournal::~ExplorationJournal() { close(); }
+
+    bool ExplorationJournal::open(const std::string& path, uint64_t batch_id, std::string* error_out)
+    {
+        close();
+        path_ = path;
+        submitted_.clear();
+        done_.clear();
+
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            h_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+            if (h_ == INVALID_HANDLE_VALUE) {
+                if (error_out) *error_out = "Could not open exploration journal: " + path;
+                return false;
+            }
+
+            bool matches = false;
+            if (!load(batch_id, matches)) {
+                if (error_out) *error_out = "Could not read exploration journal: " + path;
+                close();
+                return false;
+            }
+            if (matches) break;
+
+            // Different batch: keep the old journal around once, then start fresh.
+            CloseHandle(h_); h_ = INVALID_HANDLE_VALUE;
+            std::error_code ec;
+            std::filesystem::rename(path, path + ".prev", ec);
+            if (ec) std::filesystem::remove(path, ec);
+            SCLOGI("[journal] %s belongs to another batch; starting a new one", path.c_str());
+        }
+        if (h_ == INVALID_HANDLE_VALUE) {
+            if (error_out) *error_out = "Could not replace exploration journal of another batch: " + path;
+            return false;
+        }
+
+        last_sync_ = std::chrono::steady_clock::now();
+        if (!done_.empty() || !submitted_.empty())
+            SCLOGI("[journal] resuming: %zu paths done, %zu submitted", done_.size(), submitted_.size());
+        return true;
+    }
+
+    bool ExplorationJournal::load(uint64_t batch_id, bool& matches)
+    {
+        matches = false;
+        std::vector<uint8_t> data;
+        if (!read_whole(h_, data)) return false;
+
+        if (data.empty()) {
+            std::vector<uint8_t> hdr;
+            put_u32(hdr, FILE_MAGIC); put_u16(hdr, FILE_VERSION); put_u16(hdr, 0); put_u64(hdr, batch_id);
+            if (!write_at(h_, 0, hdr.data(), hdr.size())) return false;
+            FlushFileBuffers(h_);
+            end_ = hdr.size();
+            matches = true;
+            return true;
+        }
+
+        if (data.size() < HEADER_SIZE || rd_u32(data.data()) != FILE_MAGIC || rd_u16(data.data() + 4) != FILE_VERSION
+            || rd_u64(data.data() + 8) != batch_id)
+            return true;  // foreign or other batch
+
+        matches = true;
+        size_t off = HEADER_SIZE;
+        while (off + REC_OVERHEAD <= data.size()) {
+            const uint8_t* r = data.data() + off;
+            if (rd_u32(r) != REC_MAGIC) break;
+            const uint8_t type = r[4];
+            const uint32_t len = rd_u32(r + 5);
+            if (off + REC_OVERHEAD + len > data.size()) break;
+            const uint8_t* body = r + 9;
+            if (fnv1a(body, len) != rd_u64(body + len)) break;
+
+            if (type == REC_SUBMIT && len >= 16) {
+                submitted_[rd_u64(body)] = rd_u64(body + 8);
+            }
+            else if (type == REC_DONE && len >= 28) {
+                Done d{};
+                const uint64_t path_id = rd_u64(body);
+                d.fingerprint = rd_u64(body + 8);
+                d.outcome = rd_u16(body + 16);
+                d.pr.accepted = true;
+                d.pr.job_id = path_id;
+                d.pr.ps.ok = body[18] != 0;
+                d.pr.ps.w_err = body[19];
+                d.pr.worker_id = rd_u32(body + 20);
+                const uint32_t ctx_len = rd_u32(body + 24);
+                if (28 + size_t(ctx_len) > len) break;
+                if (ctx_len && !psctx::decode_numeric(body + 28, ctx_len, d.pr.ps.ctx)) break;
+                done_[path_id] = std::move(d);
+            }
+            off += REC_OVERHEAD + len;
+        }
+
+        if (off != data.size()) {
+            SCLOGW("[journal] dropping %zu torn bytes at the end of %s", data.size() - off, path_.c_str());
+            LARGE_INTEGER li{}; li.QuadPart = LONGLONG(off);
+            if (SetFilePointerEx(h_, li, NULL, FILE_BEGIN)) SetEndOfFile(h_);
+        }
+        end_ = off;
+        return true;
+    }
+
+    void ExplorationJournal::close()
+    {
+        if (h_ == INVALID_HANDLE_VALUE) return;
+        FlushFileBuffers(h_);
+        CloseHandle(h_);
+        h_ = INVALID_HANDLE_VALUE;
+    }
+
+    const ExplorationJournal::Done* ExplorationJournal::find_done(uint64_t path_id, uint64_t fingerprint) const
+    {
+        auto it = done_.find(path_id);
+        if (it == done_.end() || it->second.fingerprint != fingerprint) return nullptr;
+        return &it->second;
+    }
+
+    bool ExplorationJournal::append(uint8_t type, const std::vector<uint8_t>& body)
+    {
+        if (h_ == INVALID_HANDLE_VALUE) return false;
+        std::vector<uint8_t> rec;
+        rec.reserve(REC_OVERHEAD + body.size());
+        put_u32(rec, REC_MAGIC);
+        put_u8(rec, type);
+        put_u32(rec, (uint32_t)body.size());
+        rec.insert(rec.end(), body.begin(), body.end());
+        put_u64(rec, fnv1a(body.data(), body.size()));
+
+        if (!write_at(h_, end_, rec.data(), rec.size())) {
+            SCLOGW("[journal] append failed: %s", path_.c_str());
+            return false;
+        }
+        end_ += rec.size();
+        ++unsynced_;
+        flush(false);
+        return true;
+    }
+
+    void ExplorationJournal::record_submit(uint64_t path_id, uint64_t fingerprint)
+    {
+        std::vector<uint8_t> body;
+        put_u64(body, path_id);
+        put_u64(body, fingerprint);
+        if (append(REC_SUBMIT, body)) submitted_[path_id] = fingerprint;
+    }
+
+    void ExplorationJournal::record_done(uint64_t path_id, uint64_t fingerprint, uint16_t outcome, const PRResult& pr)
+    {
+        std::vector<uint8_t> ctx;
+        if (!psctx::encode_numeric(pr.ps.ctx, ctx)) ctx.clear();
+
+        std::vector<uint8_t> body;
+        put_u64(body, path_id);
+        put_u64(body, fingerprint);
+        put_u16(body, outcome);
+        put_u8(body, pr.ps.ok ? 1 : 0);
+        put_u8(body, pr.ps.w_err);
+        put_u32(body, (uint32_t)pr.worker_id);
+        put_u32(body, (uint32_t)ctx.size());
+        body.insert(body.end(), ctx.begin(), ctx.end());
+
+        if (append(REC_DONE, body)) {
+            Done d{ fingerprint, outcome, pr };
+            done_[path_id] = std::move(d);
+        }
+    }
+
+    void ExplorationJournal::flush(bool force)
+    {
+        if (h_ == INVALID_HANDLE_VALUE || unsynced_ == 0) return;
+        const auto now = std::chrono::steady_clock::now();
+        if (!force && unsynced_ < fsync_every_ && now - last_sync_ < std::chrono::milliseconds(fsync_ms_)) return;
+        FlushFileBuffers(h_);
+        unsynced_ = 0;
+        last_sync_ = now;
+    }
+
+} // namespace simcore::battleexplorer
@@ -0,0 +1,79 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <windows.h>
+
+#include "../Runner/Parallel/PRTypes.h"
+
+namespace simcore::battleexplorer {
+
+    // Append-only crash journal for one exploration batch.
+    //
+    // Jobs are identified by their path id (deterministic enumeration order) plus a fingerprint of
+    // what the path runs (initial frame, turn plans, predicates), so a restart with the same UI config
+    // maps every id to the same work. The journal records when a path is handed to the runner and
+    // when its final result is collected; anything submitted but never completed was in flight.
+    //
+    // File layout (little-endian):
+    //   header : u32 magic 'SCBJ', u16 version, u16 reserved, u64 batch_id
+    //   record : u32 magic 'JREC', u8 type, u32 body_len, body[body_len], u64 fnv1a(body)
+    //     SUBMIT body : u64 path_id, u64 fingerprint
+    //     DONE   body : u64 path_id, u64 fingerprint, u16 outcome, u8 ok, u8 w_err,
+    //                   u32 worker_id, u32 ctx_len, ctx (psctx::encode_numeric)
+    //
+    // A torn tail (crash mid-append) fails its checksum and is cut off on open. A journal written
+    // for a different batch_id is moved aside to <path>.prev and a fresh one is started.
+    class ExplorationJournal {
+    public:
+        static constexpr uint32_t FILE_MAGIC = 0x4A424353u; // 'SCBJ'
+        static constexpr uint32_t REC_MAGIC = 0x4345524Au;  // 'JREC'
+        static constexpr uint16_t FILE_VERSION = 1;
+
+        struct Done {
+            uint64_t fingerprint{ 0 };
+            uint16_t outcome{ 0 };
+            PRResult pr;
+        };
+
+        ExplorationJournal() = default;
+        ~ExplorationJournal();
+
+        ExplorationJournal(const ExplorationJournal&) = delete;
+        ExplorationJournal& operator=(const ExplorationJournal&) = delete;
+
+        bool open(const std::string& path, uint64_t batch_id, std::string* error_out = nullptr);
+        void close();
+        bool is_open() const { return h_ != INVALID_HANDLE_VALUE; }
+
+        // State recovered on open (and kept current by the record_* calls).
+        const Done* find_done(uint64_t path_id, uint64_t fingerprint) const;
+        bool was_submitted(uint64_t path_id) const { return submitted_.count(path_id) != 0; }
+        size_t done_count() const { return done_.size(); }
+
+        void record_submit(uint64_t path_id, uint64_t fingerprint);
+        void record_done(uint64_t path_id, uint64_t fingerprint, uint16_t outcome, const PRResult& pr);
+
+        // fsync (FlushFileBuffers) when forced, or every fsync_every records / fsync_ms since the last one.
+        void flush(bool force = false);
+        void set_fsync_policy(uint32_t every_records, uint32_t every_ms) { fsync_every_ = every_records; fsync_ms_ = every_ms; }
+
+    private:
+        bool load(uint64_t batch_id, bool& matches);
+        bool append(uint8_t type, const std::vector<uint8_t>& body);
+
+        HANDLE h_{ INVALID_HANDLE_VALUE };
+        std::string path_;
+        uint64_t end_{ 0 };
+        std::unordered_map<uint64_t, uint64_t> submitted_;  // path_id -> fingerprint
+        std::unordered_map<uint64_t, Done> done_;
+
+        uint32_t fsync_every_{ 64 };
+        uint32_t fsync_ms_{ 2000 };
+        uint32_t unsynced_{ 0 };
+        std::chrono::steady_clock::time_point last_sync_{};
+    };
+
+} // namespace simcore::battleexplorer
@@ -23,37 +23,12 @@ namespace simcore::tas_movie {
         return stem;
     }
 
-    static std::string join(const std::string& a, const std::string& b) {
-        return (fs::path(a) / b).string();
-    }
-
-    // Clone a DTM and adjust its recording start time by delta_sec; return new path.
-    static std::optional<std::string> write_dtm_with_delta(const std::string& base_dtm,
-        int delta_sec,
-        const std::string& out_dir)
+    // Result state name for one RTC delta: <stem>_rtc+0005.sav (sign-aware, zero-padded 4+)
+    static std::string save_path_for_delta(const std::string& base_dtm, int delta_sec, const std::string& out_dir)
     {
-        simcore::tas::DtmFile f;
-        if (!f.load(base_dtm)) return std::nullopt;
-        const auto info = f.info();
-
-        // Name like: <stem>_rtc+0005.dtm (sign-aware, zero-padded 4+)
         char suffix[32];
-        std::snprintf(suffix, sizeof(suffix), "_rtc%+05d.dtm", delta_sec);
-        const std::string out_name = basename_no_ext(base_dtm) + suffix;
-
-        fs::create_directories(out_dir);
-        const std::string out_path = join(out_dir, out_name);
-
-        f.set_recording_start_time(info.recording_start_time + static_cast<uint64_t>(delta_sec));
-        if (!f.save(out_path)) return std::nullopt;
-        return out_path;
-    }
-
-    static uint64_t read_vi_total(const std::string& dtm_path) {
-        simcore::tas::DtmFile df;
-        if (!df.load(dtm_path)) return 0;
-        const auto info = df.info();
-        return info.vi_count ? info.vi_count : info.input_count;
+        std::snprintf(suffix, sizeof(suffix), "_rtc%+05d.sav", delta_sec);
+        return (fs::path(out_dir) / (basename_no_ext(base_dtm) + suffix)).string();
     }
 
     BatchResult RunTasMovieOnePerWorkerWithProgress(ParallelPhaseScriptRunner& runner,
@@ -64,69 +39,55 @@ namespace simcore::tas_movie {
         BatchResult br{};
         if (args.rtc_delta_hi < args.rtc_delta_lo || num_workers == 0) return br;
 
-        // Boot & program activation (same as conductor)
+        // The base movie goes to every worker once with the program; jobs carry only their RTC patch.
+        simcore::tas::DtmFile base;
+        if (!base.load(args.base_dtm)) { SCLOGE("[tas] cannot read base DTM '%s'", args.base_dtm.c_str()); return br; }
+        const auto info = base.info();
+        const uint64_t vi_total = info.vi_count ? info.vi_count : info.input_count;
+
         PSInit init{};
         init.savestate_path = "";
         init.default_timeout_ms = 600000;
+        init.shared_blob = base.bytes();
 
-        if (!runner.set_program(/*init_kind=*/PK_None, /*main_kind=*/PK_TasMovie, init)) { SCLOGE("[tas] set_program failed"); return br; }
+        if (!runner.set_program(/*init_kind=*/PK_None, /*main_kind=*/PK_TasMovieBuffer, init)) { SCLOGE("[tas] set_program failed"); return br; }
         if (!runner.activate_main()) { SCLOGE("[tas] activate_main failed"); return br; }
 
-        // Build up to one job per worker using consecutive RTC deltas from [lo..hi]
-        const int span = args.rtc_delta_hi - args.rtc_delta_lo + 1;
-        const size_t jobs_to_make = static_cast<size_t>(std::min<int>(int(num_workers), span));
+        std::error_code ec;
+        fs::create_directories(args.out_dir, ec);
 
-        struct JobMeta { int delta; std::string dtm; std::string sav; uint64_t vi_total; };
-        std::vector<JobMeta> all_jobs;
-
-        for (int d = args.rtc_delta_lo; d <= args.rtc_delta_hi; ++d) {
-            auto dtm_out = write_dtm_with_delta(args.base_dtm, d, args.out_dir);
-            if (!dtm_out) { SCLOGW("[tas] skip delta %d: DTM write failed", d); continue; }
-            fs::create_directories(args.out_dir);
-            fs::path sav_path = fs::path(args.out_dir) / (fs::path(*dtm_out).stem().string() + ".sav");
-
-            JobMeta jm{};
-            jm.delta = d;
-            jm.dtm = *dtm_out;
-            jm.sav = sav_path.string();
-            jm.vi_total = read_vi_total(jm.dtm);
-            all_jobs.push_back(std::move(jm));
-        }
-
-        // Submit them; enable per-job progress in the payload
+        // Submit one job per delta; enable per-job progress in the payload
         std::unordered_map<uint64_t, ItemResult> by_id;
         std::unordered_map<uint64_t, uint64_t>   job_total_vi;
         std::unordered_map<uint64_t, int>        job_delta;
 
-        for (auto& jm : all_jobs) {
-            simcore::tasmovie::EncodeSpec spec{};
-            spec.dtm_path = jm.dtm;
-            spec.save_dir = args.out_dir;
-            spec.run_ms = 0;
+        for (int d = args.rtc_delta_lo; d <= args.rtc_delta_hi; ++d) {
+            simcore::tasmovie::BufferSpec spec{};
+            spec.id6.assign(info.game_id.data(), 6);
+            spec.rtc_delta = d;
+            spec.save_path = save_path_for_delta(args.base_dtm, d, args.out_dir);
+            spec.run_ms = simcore::tasmovie::compute_run_ms_from_counts(info.vi_count, info.input_count, /*headroom=*/1.5);
             spec.vi_stall_ms = args.vi_stall_ms;
             spec.save_on_fail = args.save_on_fail;
             spec.progress_enable = true; // <- per-job toggle
 
-            std::vector<uint8_t> blob;
-            if (!simcore::tasmovie::encode_payload(spec, blob)) {
-                SCLOGW("[tas] skip delta %d: payload encode failed", jm.delta);
+            PSJob job{};
+            if (!simcore::tasmovie::encode_buffer_payload(spec, job.payload)) {
+                SCLOGW("[tas] skip delta %d: payload encode failed", d);
                 continue;
             }
 
-            PSJob job{};
-            job.payload = std::move(blob);
-
             const uint64_t jid = runner.submit(job);
 
             ItemResult it{};
-            it.delta_sec = jm.delta;
-            it.dtm_path = jm.dtm;
-            it.save_path = jm.sav;
+            it.delta_sec = d;
+            it.dtm_path = args.base_dtm;
+            it.save_path = spec.save_path;
             it.job_id = jid;
 
             by_id.emplace(jid, std::move(it));
-            job_total_vi[jid] = (jm.vi_total ? jm.vi_total : 1);
-            job_delta[jid] = jm.delta;
+            job_total_vi[jid] = (vi_total ? vi_total : 1);
+            job_delta[jid] = d;
 
             ++br.submitted;
         }
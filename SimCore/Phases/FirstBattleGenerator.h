@@ -10,10 +10,10 @@ namespace simcore::tas_movie {
 
     struct ConductorArgs {
         BootPlan boot;
-        std::string base_dtm;          // source DTM to clone per-RTC
+        std::string base_dtm;          // source DTM, shipped once to every worker and patched per RTC in memory
         int rtc_delta_lo{ 0 };         // inclusive (seconds)
         int rtc_delta_hi{ 0 };         // inclusive (seconds)
-        std::string out_dir;           // where stamped .dtm and .sav files are written
+        std::string out_dir;           // where the per-RTC .sav files are written
         uint32_t vi_stall_ms{ 2000 };
         bool save_on_fail{ true };
         std::string gameid = "GEAE8P";
@@ -21,7 +21,7 @@ namespace simcore::tas_movie {
 
     struct ItemResult {
         int delta_sec{ 0 };
-        std::string dtm_path;
+        std::string dtm_path;          // the base DTM (no per-RTC copy is written)
         std::string save_path;
         uint64_t job_id{ 0 };
         bool ok{ false };
@@ -35,8 +35,8 @@ namespace simcore::tas_movie {
         size_t succeeded{ 0 };
     };
 
-    // Creates one DTM per second in [lo, hi], submits one job per DTM, and
-    // waits for all results. Program PK_TasMovie must be active on the runner.
+    // Submits one job per second in [lo, hi] and waits for all results. Sets PK_TasMovieBuffer on the
+    // runner with the base DTM as its shared blob; workers play it from memory with the job's RTC patch.
     BatchResult RunTasMovieOnePerWorkerWithProgress(ParallelPhaseScriptRunner& runner, const ConductorArgs& args);
 
 } // namespace simcore::tas_movie
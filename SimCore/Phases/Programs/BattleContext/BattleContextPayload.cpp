@@ -4,7 +4,9 @@
 
 namespace phase::battle::ctx {
 
-	static constexpr int VERSION = 1;
+	// v2: CTX_BLOB is the fixed-layout wire image (BattleContextWire.h). Bumping the payload version
+	// keeps v1 results (variable-length blobs) in the result store from matching new jobs.
+	static constexpr int VERSION = 2;
 
 	static inline void put_u32(std::vector<uint8_t>& b, uint32_t v) { b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8)); b.push_back(uint8_t(v >> 16)); b.push_back(uint8_t(v >> 24)); }
 	static inline bool get_u32(const uint8_t*& p, const uint8_t* e, uint32_t& v) { if (p + 4 > e) return false; v = (uint32_t)p[0] | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24); p += 4; return true; }
@@ -40,4 +42,13 @@ namespace phase::battle::ctx {
 
 		return true;
 	}
+
+	bool result_identity(const std::vector<uint8_t>& in, uint32_t& version_out, std::vector<uint8_t>& key_out) {
+		const uint8_t* p = in.data();
+		const uint8_t* e = p + in.size();
+		if (in.empty() || *p++ != simcore::PK_BattleContextProbe) return false;
+		if (!get_u32(p, e, version_out)) return false;
+		key_out = in;
+		return true;
+	}
 }
\ No newline at end of file
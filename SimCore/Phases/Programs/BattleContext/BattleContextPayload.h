@@ -15,4 +15,7 @@ namespace phase::battle::ctx {
     // ProgramRegistry.decode -> fill ctx
     bool decode_payload(const std::vector<uint8_t>& in, simcore::PSContext& out_ctx);
 
+    // Result-store identity: the whole payload (no paths, no side effects).
+    bool result_identity(const std::vector<uint8_t>& in, uint32_t& version_out, std::vector<uint8_t>& key_out);
+
 }
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include "BattleRunnerCost.h"
+
+#include "BattleRunnerPayload.h"
+#include "../../../Runner/Script/KeyRegistry.h"
+#include "../../../Core/Input/SoaBattle/PlanWriter.h"
+
+namespace phase::battle::runner {
+
+    double BattlePathCostEstimator::estimate(const simcore::PSJob& job) const
+    {
+        PSContext ctx;
+        if (!decode_payload(job.payload, ctx)) return 0.0;
+
+        soa::battle::actions::BattlePath path;
+        if (!ctx.get<soa::battle::actions::BattlePath>(keys::battle::TURN_PLANS, path)) return 0.0;
+        uint32_t first = 0; ctx.get<uint32_t>(keys::battle::RESUME_TURN, first);
+        uint32_t resume = 0; ctx.get<uint32_t>(keys::battle::RESUME_FROM_STATE, resume);
+        if (!resume) first = 0;
+
+        std::optional<soa::battle::ctx::BattleContextView> view;
+        std::optional<soa::battle::actions::PlanWriter> pw;
+        if (bc_) pw.emplace(view.emplace(*bc_));
+
+        double cost = 0.0;
+        for (size_t t = 0; t < path.size(); ++t) {
+            // PlanWriter tracks menu position across turns, so build every turn even if it is skipped
+            uint32_t frames = w_.default_turn_frames;
+            if (pw) {
+                simcore::InputPlan plan;
+                soa::battle::actions::MaterializeErr err{};
+                if (pw->buildTurn(path[t], plan, err)) frames = (uint32_t)plan.size();
+            }
+            if (t < first) continue;
+            cost += w_.turn_ms + w_.fake_attack_ms * path[t].fake_attack_count + w_.frame_ms * frames;
+        }
+        return cost;
+    }
+
+} // namespace phase::battle::runner
@@ -0,0 +1,33 @@
+#pragma once
+#include <optional>
+#include "../../../Runner/Parallel/JobCost.h"
+#include "../../../Core/Memory/Soa/Battle/BattleContext.h"
+
+namespace phase::battle::runner {
+
+    // Expected wall time (ms) of a BattleTurnRunner job, from its payload:
+    //   sum over the turns it will simulate (after any resume point) of
+    //     turn_ms + fake_attack_ms * fake_attack_count + frame_ms * planned input frames
+    // Planned frames come from PlanWriter against the battle's starting context; without a context
+    // each turn counts as `default_turn_frames`.
+    struct CostWeights {
+        double turn_ms{ 6000.0 };
+        double fake_attack_ms{ 2500.0 };
+        double frame_ms{ 1000.0 / 60.0 };
+        uint32_t default_turn_frames{ 60 };
+    };
+
+    class BattlePathCostEstimator final : public simcore::IJobCostEstimator {
+    public:
+        explicit BattlePathCostEstimator(std::optional<soa::battle::ctx::BattleContext> bc = std::nullopt,
+            CostWeights w = {})
+            : bc_(std::move(bc)), w_(w) {}
+
+        double estimate(const simcore::PSJob& job) const override;
+
+    private:
+        std::optional<soa::battle::ctx::BattleContext> bc_;
+        CostWeights w_;
+    };
+
+} // namespace phase::battle::runner
@@ -10,7 +10,13 @@ namespace phase::battle::runner {
     static inline void put_u32(std::vector<uint8_t>& b, uint32_t v) { b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8)); b.push_back(uint8_t(v >> 16)); b.push_back(uint8_t(v >> 24)); }
     static inline bool get_u32(const uint8_t*& p, const uint8_t* e, uint32_t& v) { if (p + 4 > e) return false; v = (uint32_t)p[0] | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24); p += 4; return true; }
 
-    static constexpr int VERSION = 3;
+    static inline void put_str(std::vector<uint8_t>& b, const std::string& s) { put_u32(b, (uint32_t)s.size()); b.insert(b.end(), s.begin(), s.end()); }
+    static inline bool get_str(const uint8_t*& p, const uint8_t* e, std::string& s) {
+        uint32_t n = 0; if (!get_u32(p, e, n) || p + n > e) return false;
+        s.assign(reinterpret_cast<const char*>(p), n); p += n; return true;
+    }
+
+    static constexpr int VERSION = 4;
 
     bool encode_payload(const EncodeSpec& spec, std::vector<uint8_t>& out)
     {
@@ -45,6 +51,12 @@ namespace phase::battle::runner {
         put_u32(out, nt);
         if (nt) out.insert(out.end(), plans.begin(), plans.end());
 
+        // v4: resume point + boundary save list
+        put_u32(out, spec.resume_turn);
+        put_str(out, spec.resume_state_path);
+        put_u32(out, (uint32_t)spec.turn_state_paths.size());
+        for (const auto& s : spec.turn_state_paths) put_str(out, s);
+
         return true;
     }
 
@@ -57,7 +69,7 @@ namespace phase::battle::runner {
 
         uint32_t version = 0, run_ms = 0, vi_stall_ms = 0;
         if (!get_u32(p, e, version)) return false;
-        if (version < 2 || version > 3) return false; // accept v2 (no blob) and v3 (with blob)
+        if (version < 2 || version > 4) return false; // accept v2 (no blob), v3 (with blob) and v4 (resume/save paths)
         if (!get_u32(p, e, run_ms)) return false;
         if (!get_u32(p, e, vi_stall_ms)) return false;
 
@@ -89,6 +101,19 @@ namespace phase::battle::runner {
         soa::battle::actions::decode_turn_plans_from_buffer(std::span<const uint8_t>(p, p + battle_plan_buf_size), b_path);
         p += battle_plan_buf_size;
 
+        uint32_t resume_turn = 0;
+        std::string resume_path, save_paths;
+        if (version >= 4) {
+            if (!get_u32(p, e, resume_turn)) return false;
+            if (!get_str(p, e, resume_path)) return false;
+            uint32_t n_save = 0; if (!get_u32(p, e, n_save)) return false;
+            for (uint32_t i = 0; i < n_save; ++i) {
+                std::string s; if (!get_str(p, e, s)) return false;
+                save_paths += s;
+                save_paths.push_back('\0');
+            }
+        }
+
         out_ctx[keys::core::RUN_MS] = run_ms;
         out_ctx[keys::core::VI_STALL_MS] = vi_stall_ms;
 
@@ -105,6 +130,76 @@ namespace phase::battle::runner {
         out_ctx[keys::core::PRED_ALL_PASSED] = (uint32_t) 1;
 
         out_ctx[keys::battle::TURN_PLANS] = b_path;
+
+        out_ctx[keys::battle::RESUME_FROM_STATE] = (uint32_t)(resume_path.empty() ? 0 : 1);
+        out_ctx[keys::battle::RESUME_TURN] = resume_turn;
+        out_ctx[keys::battle::RESUME_STATE_PATH] = resume_path;
+        out_ctx[keys::battle::TURN_STATE_PATHS] = save_paths;
+        return true;
+    }
+
+    // Where the v4 section starts (the whole payload for v2/v3) and whether it names any file.
+    struct PayloadShape {
+        uint32_t version{ 0 };
+        size_t head_len{ 0 };
+        bool resumes{ false };
+        bool saves{ false };
+    };
+
+    static bool shape_of(const std::vector<uint8_t>& in, PayloadShape& out)
+    {
+        const uint8_t* p = in.data();
+        const uint8_t* e = p + in.size();
+        if (in.empty() || *p++ != PK_BattleTurnRunner) return false;
+
+        uint32_t skip = 0, n = 0;
+        if (!get_u32(p, e, out.version) || out.version < 2 || out.version > 4) return false;
+        if (!get_u32(p, e, skip) || !get_u32(p, e, skip)) return false;   // run_ms, vi_stall_ms
+        if (p + sizeof(GCInputFrame) > e) return false;
+        p += sizeof(GCInputFrame);
+
+        if (!get_u32(p, e, n) || size_t(e - p) < size_t(n) * sizeof(pred::PredicateRecord)) return false;
+        p += size_t(n) * sizeof(pred::PredicateRecord);
+        if (out.version >= 3) {
+            if (!get_u32(p, e, n) || size_t(e - p) < n) return false;
+            p += n;
+        }
+        if (!get_u32(p, e, n) || size_t(e - p) < n) return false;
+        p += n;
+        out.head_len = size_t(p - in.data());
+
+        if (out.version >= 4) {
+            std::string s;
+            if (!get_u32(p, e, skip) || !get_str(p, e, s)) return false;   // resume turn and state
+            out.resumes = !s.empty();
+            if (!get_u32(p, e, n)) return false;
+            for (uint32_t i = 0; i < n; ++i) {
+                if (!get_str(p, e, s)) return false;
+                if (!s.empty()) out.saves = true;
+            }
+        }
+        return true;
+    }
+
+    bool result_identity(const std::vector<uint8_t>& in, uint32_t& version_out, std::vector<uint8_t>& key_out)
+    {
+        PayloadShape sh;
+        if (!shape_of(in, sh) || sh.saves) return false;
+        version_out = sh.version;
+        key_out.assign(in.begin(), in.begin() + sh.head_len);
+        return true;
+    }
+
+    bool drop_turn_states(const std::vector<uint8_t>& in, std::vector<uint8_t>& out)
+    {
+        PayloadShape sh;
+        if (!shape_of(in, sh)) return false;
+        out.assign(in.begin(), in.begin() + sh.head_len);
+        if (sh.version >= 4) {
+            put_u32(out, 0);
+            put_str(out, std::string{});
+            put_u32(out, 0);
+        }
         return true;
     }
 
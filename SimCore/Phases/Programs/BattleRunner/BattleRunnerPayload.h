@@ -16,6 +16,11 @@ namespace phase::battle::runner {
         GCInputFrame initial{};
         soa::battle::actions::BattlePath path;
         std::vector<simcore::pred::Spec> predicates;
+
+        // v4: incremental re-exploration
+        std::string resume_state_path;              // non-empty => load this boundary state and start at turn resume_turn + 1
+        uint32_t resume_turn{ 0 };                  // turns already completed in resume_state_path
+        std::vector<std::string> turn_state_paths;  // [t] => save the boundary state after turn t here (empty => skip)
     };
 
     // ProgramRegistry.decode -> fill ctx
@@ -24,4 +29,14 @@ namespace phase::battle::runner {
     // parent helper
     bool encode_payload(const EncodeSpec& spec, std::vector<uint8_t>& out);
 
+    // Result-store identity (see programs::result_identity_for): the payload up to the v4 section.
+    // The resume/save paths only name where boundary states live; the state a job resumes from is
+    // fixed by the savestate and the path prefix, both already in the key. A job that saves
+    // boundary states bypasses the store, since a stored result would skip the writes.
+    bool result_identity(const std::vector<uint8_t>& in, uint32_t& version_out, std::vector<uint8_t>& key_out);
+
+    // The same job as a full run that neither loads nor saves boundary states. Its result is the
+    // same; used where the named files are out of reach (a worker on another host).
+    bool drop_turn_states(const std::vector<uint8_t>& in, std::vector<uint8_t>& out);
+
 } // namespace simcore::battle
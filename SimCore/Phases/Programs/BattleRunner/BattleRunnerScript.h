@@ -22,6 +22,7 @@ namespace phase::battle::runner {
     static const std::string LabelSetTimeoutSmall = "SET_TIMEOUT_SMALL";
     static const std::string LabelSetTimeoutLarge = "SET_TIMEOUT_LARGE";
     static const std::string LabelStartRun = "START_RUN";
+    static const std::string LabelResume = "RESUME_FROM_TURN_STATE";
 
     static const std::string LabelADV = "ADV";
     static const std::string LabelVictory = "RET_SUCCESS";
@@ -42,6 +43,7 @@ namespace phase::battle::runner {
         ps.ops.push_back(OpLoadSnapshot());
 
         ps.ops.push_back(OpSetU32(keys::battle::ACTIVE_TURN, 0));
+        ps.ops.push_back(OpGotoIf(keys::battle::RESUME_FROM_STATE, PSCmp::EQ, 1, LabelResume));
         ps.ops.push_back(OpApplyInputFrom(keys::battle::INITIAL_INPUT));
         ps.ops.push_back(OpGoto(LabelRunTurn));  // Going to LabelRunTurn so that we can run until turn inputs checking that the initial battle state is favorable (might need to check turn_type at start of battle)
 
@@ -49,8 +51,7 @@ namespace phase::battle::runner {
         // Run all inputs
         ps.ops.push_back(OpLabel(LabelInputTurnActions));
 
-        // Get context and build a plan - fail fast if plan fails
-        ps.ops.push_back(OpGetBattleContext());
+        // Build a plan against the live battle context - fail fast if plan fails
         ps.ops.push_back(OpBuildTurnInputFromActions());
         ps.ops.push_back(OpGotoIf(keys::battle::PLAN_MATERIALIZE_ERR, PSCmp::NE, 0, LabelMaterializeFail));
 
@@ -79,6 +80,8 @@ namespace phase::battle::runner {
         ps.ops.push_back(OpSetTimeoutToMS(long_timeout));
         ps.ops.push_back(OpGotoIf(keys::core::RUN_HIT_BP_KEY, PSCmp::NE, (uint32_t)BP_BattleAcceptInput, LabelRunTurn));
 
+        // Turn boundary: all predicates for turns <= ACTIVE_TURN passed; cache the state if the parent asked for it
+        ps.ops.push_back(OpSaveTurnState());
         ps.ops.push_back(OpGotoIfKeys(keys::battle::ACTIVE_TURN, PSCmp::LT, keys::battle::LAST_TURN, LabelADV));
         ps.ops.push_back(OpReturnResult(Battle_Outcome, (uint32_t)Outcome::TurnsExhausted));
 
@@ -89,6 +92,12 @@ namespace phase::battle::runner {
         ps.ops.push_back(OpCapturePredBaselines());
         ps.ops.push_back(OpGoto(LabelInputTurnActions));
 
+        // ============  Label Resume  ===================
+        // Start from a cached turn-boundary state instead of replaying turns 1..RESUME_TURN
+        ps.ops.push_back(OpLabel(LabelResume));
+        ps.ops.push_back(OpLoadTurnState());
+        ps.ops.push_back(OpGoto(LabelADV));
+
         // ============  Label Victory  ===================
         ps.ops.push_back(OpLabel(LabelVictory));
         ps.ops.push_back(OpReturnResult(Battle_Outcome, (uint32_t)Outcome::Victory));
@@ -0,0 +1,136 @@
+#include "BranchTreePayload.h"
+
+#include <cstring>
+
+#include "../../../Runner/IPC/Wire.h"      // PK_BranchTree
+#include "../../../Runner/Script/KeyRegistry.h"
+
+namespace simcore::branchtree {
+
+    static inline void put_u32(std::vector<uint8_t>& b, uint32_t v) {
+        b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8)); b.push_back(uint8_t(v >> 16)); b.push_back(uint8_t(v >> 24));
+    }
+    static inline void put_u16(std::vector<uint8_t>& b, uint16_t v) {
+        b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8));
+    }
+    static inline void put_frame(std::vector<uint8_t>& b, const GCInputFrame& f) {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(&f);
+        b.insert(b.end(), p, p + sizeof(GCInputFrame));
+    }
+    static inline bool rd_u32(const uint8_t* d, size_t& o, size_t n, uint32_t& v) {
+        if (o + 4 > n) return false;
+        v = uint32_t(d[o]) | (uint32_t(d[o + 1]) << 8) | (uint32_t(d[o + 2]) << 16) | (uint32_t(d[o + 3]) << 24);
+        o += 4; return true;
+    }
+    static inline bool rd_frame(const uint8_t* d, size_t& o, size_t n, GCInputFrame& f) {
+        if (o + sizeof(GCInputFrame) > n) return false;
+        std::memcpy(&f, d + o, sizeof(GCInputFrame));
+        o += sizeof(GCInputFrame); return true;
+    }
+
+    static constexpr uint16_t kVersion = 1;
+    static constexpr size_t kHeader = 1 + 2 + 4 + 4;
+
+    bool encode_branch_tree_payload(const BranchTreeSpec& spec, std::vector<uint8_t>& out)
+    {
+        out.clear();
+        if (!BranchExplorer::validate_spec(spec.spec).empty()) return false;
+
+        out.push_back(PK_BranchTree);       // ProgramKind
+        put_u16(out, kVersion);
+        put_u32(out, spec.step_ms);
+        put_u32(out, (uint32_t)spec.watch_addrs.size());
+        for (uint32_t a : spec.watch_addrs) put_u32(out, a);
+
+        put_u32(out, spec.spec.total_frames);
+        put_frame(out, spec.spec.default_frame);
+        put_u32(out, (uint32_t)spec.spec.decisions.size());
+        for (const auto& dp : spec.spec.decisions) {
+            put_u32(out, dp.frame_index);
+            put_u32(out, (uint32_t)dp.options.size());
+            for (const auto& f : dp.options) put_frame(out, f);
+        }
+        return true;
+    }
+
+    bool decode_branch_spec(const std::string& blob, BranchSpec& out)
+    {
+        const auto* d = reinterpret_cast<const uint8_t*>(blob.data());
+        const size_t n = blob.size();
+        size_t off = 0;
+
+        out = BranchSpec{};
+        uint32_t count = 0;
+        if (!rd_u32(d, off, n, out.total_frames) || !rd_frame(d, off, n, out.default_frame) || !rd_u32(d, off, n, count)) return false;
+        if (count > n) return false;   // each decision takes at least 8 bytes
+        out.decisions.resize(count);
+        for (auto& dp : out.decisions) {
+            uint32_t k = 0;
+            if (!rd_u32(d, off, n, dp.frame_index) || !rd_u32(d, off, n, k)) return false;
+            if (size_t(k) * sizeof(GCInputFrame) > n - off) return false;
+            dp.options.resize(k);
+            for (auto& f : dp.options) rd_frame(d, off, n, f);
+        }
+        return off == n && BranchExplorer::validate_spec(out).empty();
+    }
+
+    bool decode_branch_tree_payload(const std::vector<uint8_t>& in, PSContext& out_ctx)
+    {
+        if (in.size() < kHeader || in[0] != PK_BranchTree) return false;
+        if ((uint16_t(in[1]) | (uint16_t(in[2]) << 8)) != kVersion) return false;
+
+        size_t off = 3;
+        uint32_t step_ms = 0, watch = 0;
+        rd_u32(in.data(), off, in.size(), step_ms);
+        rd_u32(in.data(), off, in.size(), watch);
+        if (size_t(watch) * 4 > in.size() - off) return false;
+
+        const char* p = reinterpret_cast<const char*>(in.data());
+        out_ctx[keys::core::BRANCH_WATCH] = std::string(p + off, size_t(watch) * 4);
+        off += size_t(watch) * 4;
+
+        std::string spec(p + off, in.size() - off);
+        BranchSpec check;
+        if (!decode_branch_spec(spec, check)) return false;
+
+        out_ctx[keys::core::BRANCH_SPEC] = std::move(spec);
+        out_ctx[keys::core::BRANCH_STEP_MS] = step_ms;
+        return true;
+    }
+
+    bool decode_branch_tree_result(const PSContext& ctx, size_t decisions, size_t watch,
+        std::vector<BranchLeaf>& out, uint32_t& frames_stepped)
+    {
+        out.clear();
+        frames_stepped = 0;
+        ctx.get<uint32_t>(keys::core::BRANCH_FRAMES, frames_stepped);
+
+        uint32_t leaves = 0;
+        std::string paths, values;
+        if (!ctx.get<uint32_t>(keys::core::BRANCH_LEAVES, leaves)) return false;
+        ctx.get<std::string>(keys::core::BRANCH_PATHS, paths);
+        ctx.get<std::string>(keys::core::BRANCH_VALUES, values);
+        if (paths.size() != size_t(leaves) * decisions * 4 || values.size() != size_t(leaves) * watch * 4) return false;
+
+        const auto* pp = reinterpret_cast<const uint8_t*>(paths.data());
+        const auto* vp = reinterpret_cast<const uint8_t*>(values.data());
+        size_t po = 0, vo = 0;
+        out.resize(leaves);
+        for (auto& leaf : out) {
+            leaf.options.resize(decisions);
+            leaf.values.resize(watch);
+            for (auto& o : leaf.options) rd_u32(pp, po, paths.size(), o);
+            for (auto& v : leaf.values) rd_u32(vp, vo, values.size(), v);
+        }
+        return true;
+    }
+
+    bool result_identity(const std::vector<uint8_t>& in, uint32_t& version_out, std::vector<uint8_t>& key_out)
+    {
+        if (in.size() < kHeader) return false;
+        version_out = uint32_t(in[1]) | (uint32_t(in[2]) << 8);
+        key_out = in;
+        return true;
+    }
+
+} // namespace simcore::branchtree
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../../Core/Branching/Branching.h"
+#include "../../../Runner/Script/PhaseScriptVM.h"   // PSContext
+
+namespace simcore::branchtree {
+
+    // BranchTree: one worker walks a BranchSpec's decision tree from the snapshot with
+    // BranchTreeExecutor over DolphinBranchHost (RUN_BRANCH_TREE), reading a list of u32 addresses
+    // at every leaf. A whole tree is one job; BranchSubtree shards it across jobs.
+    //
+    // On-wire layout (little-endian):
+    //
+    // [0]      : u8   ProgramKind tag (== PK_BranchTree)
+    // [1..2]   : u16  version = 1
+    // [3..6]   : u32  step_ms (per-frame step timeout, 0 => DolphinBranchHost default)
+    // [7..10]  : u32  W, then W x u32 watch addresses
+    // [..]     : spec: u32 total_frames, GCInputFrame default_frame, u32 D,
+    //            then D x { u32 frame_index, u32 K, K x GCInputFrame }
+    //
+    // Result: core.branch.leaf_paths (per leaf, one u32 option index per decision, depth-first
+    // order), core.branch.leaf_values (per leaf, one u32 per watch address), core.branch.frames
+    // (frames emulated) and core.branch.leaves. A walk cut short by the host fails the job.
+
+    struct BranchTreeSpec {
+        BranchSpec spec;
+        std::vector<uint32_t> watch_addrs;
+        uint32_t step_ms{ 0 };
+    };
+
+    struct BranchLeaf {
+        std::vector<uint32_t> options;   // option index per decision of the job's spec
+        std::vector<uint32_t> values;    // one per watch address
+    };
+
+    // Parent-side: build payload bytes (first byte = PK_BranchTree). false if the spec is invalid
+    // (BranchExplorer::validate_spec).
+    bool encode_branch_tree_payload(const BranchTreeSpec& spec, std::vector<uint8_t>& out);
+
+    // Worker-side: spec section -> core.branch.spec, watch list -> core.branch.watch,
+    // step_ms -> core.branch.step_ms.
+    bool decode_branch_tree_payload(const std::vector<uint8_t>& in, PSContext& out_ctx);
+
+    // VM-side: the core.branch.spec blob back into a BranchSpec.
+    bool decode_branch_spec(const std::string& blob, BranchSpec& out);
+
+    // Parent-side: the job's leaves for a spec with `decisions` decisions and `watch` addresses.
+    // false if the arrays are missing or do not match.
+    bool decode_branch_tree_result(const PSContext& ctx, size_t decisions, size_t watch,
+        std::vector<BranchLeaf>& out, uint32_t& frames_stepped);
+
+    // Result-store identity: the payload is self-contained, so all of it.
+    bool result_identity(const std::vector<uint8_t>& in, uint32_t& version_out, std::vector<uint8_t>& key_out);
+
+} // namespace simcore::branchtree
@@ -0,0 +1,23 @@
+#pragma once
+#include "../../../Runner/Script/PhaseScriptVM.h"
+#include "../../../Runner/Script/KeyRegistry.h"
+
+namespace simcore::branchtree {
+
+    // BranchTree (BranchTreePayload.h): from the snapshot, walk the payload's decision tree
+    // depth-first inside this worker and emit every leaf's path and watch reads.
+    inline PhaseScript MakeBranchTreeProgram()
+    {
+        PhaseScript ps{};
+
+        ps.ops.push_back(OpLoadSnapshot());
+        ps.ops.push_back(OpRunBranchTree());
+        ps.ops.push_back(OpEmitResult(keys::core::BRANCH_PATHS));
+        ps.ops.push_back(OpEmitResult(keys::core::BRANCH_VALUES));
+        ps.ops.push_back(OpEmitResult(keys::core::BRANCH_FRAMES));
+        ps.ops.push_back(OpEmitResult(keys::core::BRANCH_LEAVES));
+
+        return ps;
+    }
+
+} // namespace simcore::branchtree
@@ -52,7 +52,7 @@ namespace simcore::tasmovie {
         out.reserve(1 + 4 + 2 + 1 + 1 + 4 + spec.dtm_path.size() + 6 + 4 + 4 + 4 + spec.save_dir.size());
 
         out.push_back(PK_TasMovie);                 // payload kind tag
-        put_u16(out, 1);                            // version
+        put_u16(out, 2);                            // version
         
         uint8_t flags = 0;
         if (spec.save_on_fail)   flags |= 0x01;
@@ -72,6 +72,12 @@ namespace simcore::tasmovie {
         put_u32(out, (uint32_t)spec.save_dir.size());
         out.insert(out.end(), spec.save_dir.begin(), spec.save_dir.end());
 
+        put_u32(out, spec.checkpoint_every_vi);
+        put_u32(out, (uint32_t)spec.checkpoint_dir.size());
+        out.insert(out.end(), spec.checkpoint_dir.begin(), spec.checkpoint_dir.end());
+        put_u32(out, (uint32_t)spec.resume_state.size());
+        out.insert(out.end(), spec.resume_state.begin(), spec.resume_state.end());
+
         return true;
     }
 
@@ -83,7 +89,7 @@ namespace simcore::tasmovie {
         if (pk != PK_TasMovie) return false;
 
         const uint16_t ver = rd_u16(in.data(), off, in.size());
-        if (ver != 1) return false;
+        if (ver != 1 && ver != 2) return false;
 
         const uint8_t flags = in[off++]; // bit0: save_on_fail
         off += 1; // reserved
@@ -101,11 +107,25 @@ namespace simcore::tasmovie {
         off += len_dtm;
 
         const uint32_t len_savedir = rd_u32(in.data(), off, in.size());
-        if (off + len_savedir != in.size()) return false;
+        if (ver == 1 ? off + len_savedir != in.size() : off + len_savedir > in.size()) return false;
 
         const std::string save_dir(reinterpret_cast<const char*>(in.data() + off), len_savedir);
         off += len_savedir;
 
+        uint32_t ckpt_every_vi = 0;
+        std::string ckpt_dir, resume_state;
+        if (ver >= 2) {
+            if (off + 8 > in.size()) return false;
+            ckpt_every_vi = rd_u32(in.data(), off, in.size());
+            const uint32_t len_ckpt = rd_u32(in.data(), off, in.size());
+            if (off + len_ckpt + 4 > in.size()) return false;
+            ckpt_dir.assign(reinterpret_cast<const char*>(in.data() + off), len_ckpt);
+            off += len_ckpt;
+            const uint32_t len_resume = rd_u32(in.data(), off, in.size());
+            if (off + len_resume != in.size()) return false;
+            resume_state.assign(reinterpret_cast<const char*>(in.data() + off), len_resume);
+        }
+
         // Derive final save path from <save_dir>/<stem(dtm)>.sav
         const std::string save_path = derive_save_path(dtm_path, save_dir);
 
@@ -138,7 +158,66 @@ namespace simcore::tasmovie {
         out_ctx[keys::tas::SAVE_ON_FAIL] = static_cast<uint32_t>((flags & 1) ? 1 : 0);
         out_ctx[keys::core::PROGRESS_ENABLE] = static_cast<uint32_t>((flags & 0x02) ? 1 : 0);
         out_ctx[keys::tas::DISC_ID6] = id6;
+        out_ctx[keys::tas::CKPT_EVERY_VI] = ckpt_every_vi;
+        out_ctx[keys::tas::CKPT_DIR] = ckpt_dir;
+        out_ctx[keys::tas::RESUME_STATE] = resume_state;
+
+        return true;
+    }
+
+    bool encode_buffer_payload(const BufferSpec& spec, std::vector<uint8_t>& out)
+    {
+        out.clear();
+        if (spec.id6.size() != 6 || spec.run_ms == 0) return false;
+        out.reserve(1 + 2 + 1 + 1 + 6 + 4 + 4 + 4 + 4 + spec.save_path.size());
+
+        out.push_back(PK_TasMovieBuffer);
+        put_u16(out, 1);
+
+        uint8_t flags = 0;
+        if (spec.save_on_fail)    flags |= 0x01;
+        if (spec.progress_enable) flags |= 0x02;
+        out.push_back(flags);
+        out.push_back(0);  // reserved
+
+        out.insert(out.end(), spec.id6.begin(), spec.id6.end());
+        put_u32(out, spec.run_ms);
+        put_u32(out, spec.vi_stall_ms);
+        put_u32(out, (uint32_t)spec.rtc_delta);
 
+        put_u32(out, (uint32_t)spec.save_path.size());
+        out.insert(out.end(), spec.save_path.begin(), spec.save_path.end());
+        return true;
+    }
+
+    bool decode_buffer_payload(const std::vector<uint8_t>& in, PSContext& out_ctx)
+    {
+        if (in.size() < 1 + 2 + 1 + 1 + 6 + 4 + 4 + 4 + 4) return false;
+        size_t off = 0;
+        if (in[off++] != PK_TasMovieBuffer) return false;
+        if (rd_u16(in.data(), off, in.size()) != 1) return false;
+
+        const uint8_t flags = in[off++];
+        off += 1; // reserved
+
+        const std::string id6(reinterpret_cast<const char*>(in.data() + off), 6);
+        off += 6;
+
+        const uint32_t run_ms = rd_u32(in.data(), off, in.size());
+        const uint32_t vi_stall_ms = rd_u32(in.data(), off, in.size());
+        const uint32_t rtc_delta = rd_u32(in.data(), off, in.size());
+
+        const uint32_t len_save = rd_u32(in.data(), off, in.size());
+        if (off + len_save != in.size()) return false;
+        const std::string save_path(reinterpret_cast<const char*>(in.data() + off), len_save);
+
+        out_ctx[keys::tas::RTC_DELTA] = rtc_delta;
+        out_ctx[keys::tas::SAVE_PATH] = save_path;
+        out_ctx[keys::core::RUN_MS] = run_ms;
+        out_ctx[keys::core::VI_STALL_MS] = vi_stall_ms;
+        out_ctx[keys::tas::SAVE_ON_FAIL] = static_cast<uint32_t>((flags & 1) ? 1 : 0);
+        out_ctx[keys::core::PROGRESS_ENABLE] = static_cast<uint32_t>((flags & 0x02) ? 1 : 0);
+        out_ctx[keys::tas::DISC_ID6] = id6;
         return true;
     }
 
@@ -22,6 +22,10 @@ namespace simcore::tasmovie {
     // [..]                : u32    vi_stall_ms
     // [..]                : u32    len_save_dir
     // [..]                : bytes  save_dir (directory path; worker derives final save_path = save_dir/<stem>.sav)
+    // version 2 appends checkpointed playback (Tas/DtmCheckpoints.h):
+    // [..]                : u32    checkpoint_every_vi (0 => no checkpoints)
+    // [..]                : u32    len_checkpoint_dir, bytes checkpoint_dir
+    // [..]                : u32    len_resume_state, bytes resume_state (empty => play from the start)
 
     struct EncodeSpec {
         std::string dtm_path;
@@ -30,8 +34,36 @@ namespace simcore::tasmovie {
         uint32_t    vi_stall_ms{ 2000 };
         bool        save_on_fail{ true };
         bool        progress_enable{ false };
+        std::string checkpoint_dir;              // where checkpoints are saved while the movie plays
+        uint32_t    checkpoint_every_vi{ 0 };
+        std::string resume_state;                // checkpoint on this movie's prefix to start from
     };
 
+    // PK_TasMovieBuffer: the base DTM reaches every worker once, as PSInit::shared_blob of set_program();
+    // a job only names its RTC patch and where the result state goes. No DTM file is written per job.
+    // [0]      : uint8  ProgramKind tag (== PK_TasMovieBuffer)
+    // [1..2]   : u16    version = 1
+    // [3]      : u8     flags (bit0: save_on_fail, bit1: progress_enable)
+    // [4]      : u8     reserved
+    // [5..10]  : 6      disc id6 (from the base DTM header)
+    // [..]     : u32    run_ms (required: the decoder never sees the movie)
+    // [..]     : u32    vi_stall_ms
+    // [..]     : s32    rtc_delta (seconds added to the header's recording start time)
+    // [..]     : u32    len_save_path
+    // [..]     : bytes  save_path (empty => no result state)
+    struct BufferSpec {
+        std::string id6;
+        int32_t     rtc_delta{ 0 };
+        std::string save_path;
+        uint32_t    run_ms{ 0 };
+        uint32_t    vi_stall_ms{ 2000 };
+        bool        save_on_fail{ true };
+        bool        progress_enable{ false };
+    };
+
+    bool encode_buffer_payload(const BufferSpec& spec, std::vector<uint8_t>& out);
+    bool decode_buffer_payload(const std::vector<uint8_t>& in, PSContext& out_ctx);
+
     // Build payload bytes (first byte PK_TasMovie). Returns true on success.
     bool encode_payload(const EncodeSpec& spec, std::vector<uint8_t>& out);
 
@@ -19,8 +19,10 @@ namespace simcore::tasmovie {
         // 1) Make sure the disc matches the movie.
         p.ops.push_back(OpRequireDiscGameIdFrom(keys::tas::DISC_ID6));
 
-        // 2) Start movie playback from the DTM path provided by the job.
-        p.ops.push_back(OpMoviePlayFrom(keys::tas::DTM_PATH));
+        // 2) Start movie playback from the DTM path provided by the job, from its resume checkpoint if it
+        //    names one, and save checkpoints along the way if it names a checkpoint dir.
+        p.ops.push_back(OpMovieResumeFrom(keys::tas::DTM_PATH, keys::tas::RESUME_STATE));
+        p.ops.push_back(OpMovieCheckpointsFrom(keys::tas::CKPT_DIR, keys::tas::CKPT_EVERY_VI));
 
         // 3) Set a per-job timeout derived from the DTM header.
         p.ops.push_back(OpSetTimeoutFromKey(keys::core::RUN_MS));
@@ -37,6 +39,22 @@ namespace simcore::tasmovie {
         return p;
     }
 
+    // Same flow as MakeTasMovieProgram, but the movie is PSInit::shared_blob patched by tas.rtc_delta.
+    inline PhaseScript MakeTasMovieBufferProgram()
+    {
+        PhaseScript p{};
+        p.canonical_bp_keys = { bp::prebattle::BeforeRandSeedSet };
+
+        p.ops.push_back(OpRequireDiscGameIdFrom(keys::tas::DISC_ID6));
+        p.ops.push_back(OpMoviePlaySharedFrom(keys::tas::RTC_DELTA));
+        p.ops.push_back(OpSetTimeoutFromKey(keys::core::RUN_MS));
+        p.ops.push_back(OpRunUntilBp());
+        p.ops.push_back(OpMovieStop());
+        p.ops.push_back(OpSaveSavestateFrom(keys::tas::SAVE_PATH));  // skipped when the job named no save path
+
+        return p;
+    }
+
 } // namespace simcore::tas_movie
 
 
@@ -1,12 +1,16 @@
 #include "ProgramRegistry.h"
 #include "SeedProbe/SeedProbePayload.h"
 #include "SeedProbe/SeedProbeScript.h"
+#include "SeedProbe/SeedSweepPayload.h"
+#include "SeedProbe/RngTracePayload.h"
 #include "PlayTasMovie/TasMoviePayload.h"
 #include "PlayTasMovie/TasMovieScript.h"
 #include "BattleRunner/BattleRunnerPayload.h"
 #include "BattleRunner/BattleRunnerScript.h"
 #include "BattleContext/BattleContextScript.h"
 #include "BattleContext/BattleContextPayload.h"
+#include "BranchTree/BranchTreePayload.h"
+#include "BranchTree/BranchTreeScript.h"
 #include "../../Runner/IPC/Wire.h"
 
 namespace simcore::programs {
@@ -17,13 +21,21 @@ namespace simcore::programs {
         case PK_SeedProbe:
             // SeedProbe fixed program should use APPLY_INPUT_FROM("seed.gc.input") etc.
             return seedprobe::MakeSeedProbeProgram();
+        case PK_SeedSweep:
+            return seedprobe::MakeSeedSweepProgram();
+        case PK_RngTrace:
+            return seedprobe::MakeRngTraceProgram();
         case PK_TasMovie:
             // TAS fixed program should use *_FROM("tas.*") keys (id6, dtm_path, run_ms, save_path)
             return tasmovie::MakeTasMovieProgram();
+        case PK_TasMovieBuffer:
+            return tasmovie::MakeTasMovieBufferProgram();
         case PK_BattleTurnRunner:
             return phase::battle::runner::MakeBattleRunnerProgram();
         case PK_BattleContextProbe:
             return phase::battle::ctx::MakeBattleContextProbeProgram();
+        case PK_BranchTree:
+            return branchtree::MakeBranchTreeProgram();
         default:
             return PhaseScript{};
         }
@@ -43,12 +55,78 @@ namespace simcore::programs {
         switch (active_program_kind) {
         case PK_SeedProbe:
             return seedprobe::decode_payload(payload, out_ctx);
+        case PK_SeedSweep:
+            return seedprobe::decode_sweep_payload(payload, out_ctx);
+        case PK_RngTrace:
+            return seedprobe::decode_rng_trace_payload(payload, out_ctx);
         case PK_TasMovie:
             return tasmovie::decode_payload(payload, out_ctx);
+        case PK_TasMovieBuffer:
+            return tasmovie::decode_buffer_payload(payload, out_ctx);
         case PK_BattleTurnRunner:          
             return phase::battle::runner::decode_payload(payload, out_ctx);
         case PK_BattleContextProbe:
             return phase::battle::ctx::decode_payload(payload, out_ctx);
+        case PK_BranchTree:
+            return branchtree::decode_branch_tree_payload(payload, out_ctx);
+        default:
+            return false;
+        }
+    }
+
+    bool result_identity_for(uint8_t program_kind,
+        const std::vector<uint8_t>& payload,
+        uint32_t& version_out,
+        std::vector<uint8_t>& key_out)
+    {
+        if (payload.empty() || payload[0] != program_kind) return false;
+
+        switch (program_kind) {
+        case PK_SeedProbe:
+        case PK_SeedSweep:
+        case PK_RngTrace:
+            return seedprobe::result_identity(payload, version_out, key_out);
+        case PK_BattleTurnRunner:
+            return phase::battle::runner::result_identity(payload, version_out, key_out);
+        case PK_BattleContextProbe:
+            return phase::battle::ctx::result_identity(payload, version_out, key_out);
+        case PK_BranchTree:
+            return branchtree::result_identity(payload, version_out, key_out);
+        case PK_TasMovie:
+        case PK_TasMovieBuffer:
+            // Both write a savestate (and checkpoints) and play a movie named by path or shared blob
+        default:
+            return false;
+        }
+    }
+
+    bool payload_for_remote(uint8_t program_kind,
+        const std::vector<uint8_t>& payload,
+        std::vector<uint8_t>& out)
+    {
+        if (payload.empty() || payload[0] != program_kind) return false;
+
+        switch (program_kind) {
+        case PK_SeedProbe:
+        case PK_SeedSweep:
+        case PK_RngTrace:
+        case PK_BattleContextProbe:
+        case PK_BranchTree:
+            out = payload;
+            return true;
+        case PK_BattleTurnRunner:
+            return phase::battle::runner::drop_turn_states(payload, out);
+        case PK_TasMovieBuffer: {
+            // The movie travels in the shared blob; only a result state would land on the wrong host
+            PSContext ctx;
+            if (!tasmovie::decode_buffer_payload(payload, ctx)) return false;
+            auto it = ctx.find(keys::tas::SAVE_PATH);
+            const std::string* save = it != ctx.end() ? std::get_if<std::string>(&it->second) : nullptr;
+            if (save && !save->empty()) return false;
+            out = payload;
+            return true;
+        }
+        case PK_TasMovie:   // reads the DTM by path, writes savestates and checkpoints
         default:
             return false;
         }
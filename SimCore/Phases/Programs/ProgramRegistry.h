@@ -16,4 +16,21 @@ namespace simcore::programs {
         const std::vector<uint8_t>& payload,
         PSContext& out_ctx);
 
+    // What identifies a job's result in the persistent result store, read with the program's own
+    // codec: its payload version, and the payload bytes the result depends on (paths that only say
+    // where files live are left out). False when the job must bypass the store: it writes files a
+    // stored result would skip, or depends on inputs the payload does not carry.
+    bool result_identity_for(uint8_t program_kind,
+        const std::vector<uint8_t>& payload,
+        uint32_t& version_out,
+        std::vector<uint8_t>& key_out);
+
+    // The payload as a worker on another host must receive it. References to files on this machine
+    // that only serve reuse (BattleRunner turn states) are dropped; the result is unchanged. False
+    // when the job cannot run remotely because it reads or writes files here (TAS movies,
+    // savestates and checkpoints).
+    bool payload_for_remote(uint8_t program_kind,
+        const std::vector<uint8_t>& payload,
+        std::vector<uint8_t>& out);
+
 } // namespace simcore::programs
@@ -0,0 +1,102 @@
+#include "RngTracePayload.h"
+
+#include <cstring>
+
+#include "../../../Runner/IPC/Wire.h"      // PK_RngTrace
+#include "../../../Runner/Script/KeyRegistry.h"
+
+namespace simcore::seedprobe {
+
+    static inline void put_u32(std::vector<uint8_t>& b, uint32_t v) {
+        b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8)); b.push_back(uint8_t(v >> 16)); b.push_back(uint8_t(v >> 24));
+    }
+    static inline void put_u16(std::vector<uint8_t>& b, uint16_t v) {
+        b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8));
+    }
+    static inline uint32_t rd_u32(const uint8_t* d, size_t& o, size_t n) {
+        if (o + 4 > n) return 0;
+        uint32_t v = uint32_t(d[o]) | (uint32_t(d[o + 1]) << 8) | (uint32_t(d[o + 2]) << 16) | (uint32_t(d[o + 3]) << 24);
+        o += 4; return v;
+    }
+    static inline uint16_t rd_u16(const uint8_t* d, size_t& o, size_t n) {
+        if (o + 2 > n) return 0;
+        uint16_t v = uint16_t(d[o]) | (uint16_t(d[o + 1]) << 8);
+        o += 2; return v;
+    }
+
+    static constexpr size_t kHeader = 1 + 2 + 4 + 4 + 4;
+
+    bool encode_rng_trace_payload(const RngTraceSpec& spec, std::vector<uint8_t>& out)
+    {
+        out.clear();
+        if (spec.reads == 0) return false;
+        out.reserve(kHeader + sizeof(GCInputFrame));
+
+        out.push_back(PK_RngTrace);         // ProgramKind
+        put_u16(out, 1);                    // version
+
+        put_u32(out, spec.run_ms);
+        put_u32(out, spec.vi_stall_ms);
+        put_u32(out, spec.reads);
+
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(&spec.frame);
+        out.insert(out.end(), p, p + sizeof(GCInputFrame));
+        return true;
+    }
+
+    bool decode_rng_trace_payload(const std::vector<uint8_t>& in, PSContext& out_ctx)
+    {
+        if (in.size() != kHeader + sizeof(GCInputFrame)) return false;
+
+        size_t off = 0;
+        if (in[off++] != PK_RngTrace) return false;
+
+        const uint16_t ver = rd_u16(in.data(), off, in.size());
+        if (ver != 1) return false;
+
+        const uint32_t run_ms = rd_u32(in.data(), off, in.size());
+        const uint32_t vi_stall_ms = rd_u32(in.data(), off, in.size());
+        const uint32_t reads = rd_u32(in.data(), off, in.size());
+        if (reads == 0) return false;
+
+        GCInputFrame frame{};
+        std::memcpy(&frame, in.data() + off, sizeof(GCInputFrame));
+
+        out_ctx[keys::seed::INPUT] = frame;
+        out_ctx[keys::seed::TRACE_COUNT] = reads;
+
+        if (run_ms != 0) {
+            out_ctx[keys::core::RUN_MS] = run_ms;
+        }
+        if (vi_stall_ms != 0) {
+            out_ctx[keys::core::VI_STALL_MS] = vi_stall_ms;
+        }
+
+        return true;
+    }
+
+    bool decode_rng_trace_result(const PSContext& ctx, std::vector<RngTraceRead>& out, uint32_t& stop_outcome)
+    {
+        out.clear();
+        stop_outcome = 0;
+        ctx.get<uint32_t>(keys::core::DW_RUN_OUTCOME_CODE, stop_outcome);
+
+        // A run that failed before the first read emits neither array
+        std::string seeds, bps;
+        const bool has_seeds = ctx.get<std::string>(keys::seed::TRACE_SEEDS, seeds);
+        const bool has_bps = ctx.get<std::string>(keys::seed::TRACE_BPS, bps);
+        if (has_seeds != has_bps || seeds.size() != bps.size() || seeds.size() % 4 != 0) return false;
+
+        const size_t n = seeds.size() / 4;
+        out.resize(n);
+        const auto* s = reinterpret_cast<const uint8_t*>(seeds.data());
+        const auto* b = reinterpret_cast<const uint8_t*>(bps.data());
+        for (size_t i = 0; i < n; ++i) {
+            size_t o1 = i * 4, o2 = i * 4;
+            out[i].seed = rd_u32(s, o1, seeds.size());
+            out[i].bp_key = rd_u32(b, o2, bps.size());
+        }
+        return true;
+    }
+
+} // namespace simcore::seedprobe
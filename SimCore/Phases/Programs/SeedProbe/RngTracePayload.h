@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../../Runner/Script/PhaseScriptVM.h"   // PSContext
+
+namespace simcore::seedprobe {
+
+	// RngTrace: read RNG_SEED at successive BP hits of one run, for validating the host RNG model
+	// (Core/Memory/Soa/SoaRng.h) against the emulator.
+	//
+	// On-wire layout (little-endian):
+	//
+	// [0]      : u8   ProgramKind tag (== PK_RngTrace)
+	// [1..2]   : u16  version = 1
+	// [3..6]   : u32  run_ms (0 => use VM defaults), applies to each BP-to-BP segment
+	// [7..10]  : u32  vi_stall_ms (0 => disabled)
+	// [11..14] : u32  reads (max BP hits to record, >= 1)
+	// [15.. ]  : raw GCInputFrame bytes, applied once after loading the snapshot
+	//
+	// Result: seed.trace.seeds and seed.trace.bps, one u32 per read (the seed and the BP key that
+	// stopped the run), and core.run.outcome_code of the last run (0 when all reads were taken).
+
+	struct RngTraceSpec {
+		GCInputFrame frame{};
+		uint32_t reads{ 16 };
+		uint32_t run_ms{ 0 };
+		uint32_t vi_stall_ms{ 0 };
+	};
+
+	struct RngTraceRead {
+		uint32_t bp_key{ 0 };
+		uint32_t seed{ 0 };
+	};
+
+	// Parent-side: build payload bytes (first byte = PK_RngTrace).
+	bool encode_rng_trace_payload(const RngTraceSpec& spec, std::vector<uint8_t>& out);
+
+	// Worker-side: frame -> seed.input, reads -> seed.trace.count, run knobs -> core keys.
+	bool decode_rng_trace_payload(const std::vector<uint8_t>& in, PSContext& out_ctx);
+
+	// Parent-side: the reads taken, in order; stop_outcome is the outcome of the run that ended the
+	// trace early (0 if it completed). false if the arrays are missing or differ in length.
+	bool decode_rng_trace_result(const PSContext& ctx, std::vector<RngTraceRead>& out, uint32_t& stop_outcome);
+
+} // namespace simcore::seedprobe
@@ -74,4 +74,13 @@ namespace simcore::seedprobe {
         return true;
     }
 
+    bool result_identity(const std::vector<uint8_t>& in, uint32_t& version_out, std::vector<uint8_t>& key_out)
+    {
+        if (in.size() < 3) return false;
+        size_t off = 1;
+        version_out = rd_u16(in.data(), off, in.size());
+        key_out = in;
+        return true;
+    }
+
 } // namespace simcore::seedprobe
@@ -33,4 +33,8 @@ namespace simcore::seedprobe {
 	//   - core.input.run_ms / core.input.vi_stall_ms (if nonzero)
 	bool decode_payload(const std::vector<uint8_t>& in, PSContext& out_ctx);
 
+	// Result-store identity for the seed programs (SeedProbe, SeedSweep, RngTrace all open with
+	// tag + u16 version): the version, and the whole payload as key bytes.
+	bool result_identity(const std::vector<uint8_t>& in, uint32_t& version_out, std::vector<uint8_t>& key_out);
+
 } // namespace simcore::seedprobe
@@ -40,4 +40,79 @@ namespace simcore::seedprobe {
         return ps;
     }
 
+    static const std::string LabelSweepNext = "SWEEP_NEXT";
+    static const std::string LabelSweepRecord = "SWEEP_RECORD";
+    static const std::string LabelSweepDone = "SWEEP_DONE";
+
+    // SeedProbe over a packed frame array (SeedSweepPayload.h): the same probe per sample, looped in
+    // the worker, appending each sample's seed and run outcome. A failed sample does not end the job.
+    inline PhaseScript MakeSeedSweepProgram()
+    {
+        PhaseScript ps{};
+        ps.canonical_bp_keys = { bp::prebattle::AfterRandSeedSet };
+
+        ps.ops.push_back(OpArmPhaseBps());
+        ps.ops.push_back(OpSetU32(keys::seed::SWEEP_INDEX, 0));
+
+        ps.ops.push_back(OpLabel(LabelSweepNext));
+        ps.ops.push_back(OpGotoIfKeys(keys::seed::SWEEP_INDEX, PSCmp::GE, keys::seed::SWEEP_COUNT, LabelSweepDone));
+        ps.ops.push_back(OpLoadSnapshot());
+        ps.ops.push_back(OpSetU32(keys::core::RUN_HIT_BP_KEY, 0));   // every sample is a fresh segment for the timeout model
+        ps.ops.push_back(OpSetU32(keys::seed::RNG_SEED, 0));
+        ps.ops.push_back(OpApplyInputAt(keys::seed::SWEEP_INPUTS, keys::seed::SWEEP_INDEX));
+        ps.ops.push_back(OpRunUntilBp());
+        ps.ops.push_back(OpGotoIf(DW_Outcome, PSCmp::NE, 0, LabelSweepRecord));
+        ps.ops.push_back(OpReadU32(addr::Registry::base(addr::core::RNG_SEED), keys::seed::RNG_SEED));
+
+        ps.ops.push_back(OpLabel(LabelSweepRecord));
+        ps.ops.push_back(OpAppendU32From(keys::seed::SWEEP_SEEDS, keys::seed::RNG_SEED));
+        ps.ops.push_back(OpAppendU32From(keys::seed::SWEEP_STATUS, DW_Outcome));
+        ps.ops.push_back(OpAddU32(keys::seed::SWEEP_INDEX, 1));
+        ps.ops.push_back(OpGoto(LabelSweepNext));
+
+        ps.ops.push_back(OpLabel(LabelSweepDone));
+        ps.ops.push_back(OpEmitResult(keys::seed::SWEEP_SEEDS));
+        ps.ops.push_back(OpEmitResult(keys::seed::SWEEP_STATUS));
+        ps.ops.push_back(OpEmitResult(keys::core::RUN_SEGMENTS));
+
+        return ps;
+    }
+
+    static const std::string LabelTraceNext = "TRACE_NEXT";
+    static const std::string LabelTraceDone = "TRACE_DONE";
+
+    // RngTrace (RngTracePayload.h): one run from the snapshot with the payload's input, reading
+    // RNG_SEED at every hit of the armed BPs until seed.trace.count reads or a run error. Each
+    // read appends the seed and the BP key that stopped the run.
+    inline PhaseScript MakeRngTraceProgram()
+    {
+        PhaseScript ps{};
+        ps.canonical_bp_keys = { bp::prebattle::AfterRandSeedSet, bp::battle::TurnIsReady,
+                                 bp::battle::EndAction, bp::battle::EndTurn };
+
+        ps.ops.push_back(OpArmPhaseBps());
+        ps.ops.push_back(OpSetU32(keys::seed::TRACE_INDEX, 0));
+        ps.ops.push_back(OpLoadSnapshot());
+        ps.ops.push_back(OpSetU32(keys::core::RUN_HIT_BP_KEY, 0));
+        ps.ops.push_back(OpApplyInputFrom(keys::seed::INPUT));
+
+        ps.ops.push_back(OpLabel(LabelTraceNext));
+        ps.ops.push_back(OpGotoIfKeys(keys::seed::TRACE_INDEX, PSCmp::GE, keys::seed::TRACE_COUNT, LabelTraceDone));
+        ps.ops.push_back(OpRunUntilBp());
+        ps.ops.push_back(OpGotoIf(DW_Outcome, PSCmp::NE, 0, LabelTraceDone));
+        ps.ops.push_back(OpReadU32(addr::Registry::base(addr::core::RNG_SEED), keys::seed::RNG_SEED));
+        ps.ops.push_back(OpAppendU32From(keys::seed::TRACE_SEEDS, keys::seed::RNG_SEED));
+        ps.ops.push_back(OpAppendU32From(keys::seed::TRACE_BPS, keys::core::RUN_HIT_BP_KEY));
+        ps.ops.push_back(OpAddU32(keys::seed::TRACE_INDEX, 1));
+        ps.ops.push_back(OpGoto(LabelTraceNext));
+
+        ps.ops.push_back(OpLabel(LabelTraceDone));
+        ps.ops.push_back(OpEmitResult(keys::seed::TRACE_SEEDS));
+        ps.ops.push_back(OpEmitResult(keys::seed::TRACE_BPS));
+        ps.ops.push_back(OpEmitResult(DW_Outcome));
+        ps.ops.push_back(OpEmitResult(keys::core::RUN_SEGMENTS));
+
+        return ps;
+    }
+
 } // namespace simcore
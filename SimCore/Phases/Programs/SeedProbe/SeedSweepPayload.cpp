@@ -0,0 +1,94 @@
+#include "SeedSweepPayload.h"
+
+#include <cstring>
+
+#include "../../../Runner/IPC/Wire.h"      // PK_SeedSweep
+#include "../../../Runner/Script/KeyRegistry.h"
+
+namespace simcore::seedprobe {
+
+    static inline void put_u32(std::vector<uint8_t>& b, uint32_t v) {
+        b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8)); b.push_back(uint8_t(v >> 16)); b.push_back(uint8_t(v >> 24));
+    }
+    static inline void put_u16(std::vector<uint8_t>& b, uint16_t v) {
+        b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8));
+    }
+    static inline uint32_t rd_u32(const uint8_t* d, size_t& o, size_t n) {
+        if (o + 4 > n) return 0;
+        uint32_t v = uint32_t(d[o]) | (uint32_t(d[o + 1]) << 8) | (uint32_t(d[o + 2]) << 16) | (uint32_t(d[o + 3]) << 24);
+        o += 4; return v;
+    }
+    static inline uint16_t rd_u16(const uint8_t* d, size_t& o, size_t n) {
+        if (o + 2 > n) return 0;
+        uint16_t v = uint16_t(d[o]) | (uint16_t(d[o + 1]) << 8);
+        o += 2; return v;
+    }
+
+    static constexpr size_t kHeader = 1 + 2 + 4 + 4 + 4;
+
+    bool encode_sweep_payload(const SweepSpec& spec, std::vector<uint8_t>& out)
+    {
+        out.clear();
+        if (spec.frames.empty()) return false;
+        out.reserve(kHeader + spec.frames.size() * sizeof(GCInputFrame));
+
+        out.push_back(PK_SeedSweep);        // ProgramKind
+        put_u16(out, 1);                    // version
+
+        put_u32(out, spec.run_ms);
+        put_u32(out, spec.vi_stall_ms);
+        put_u32(out, (uint32_t)spec.frames.size());
+
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(spec.frames.data());
+        out.insert(out.end(), p, p + spec.frames.size() * sizeof(GCInputFrame));
+        return true;
+    }
+
+    bool decode_sweep_payload(const std::vector<uint8_t>& in, PSContext& out_ctx)
+    {
+        if (in.size() < kHeader) return false;
+
+        size_t off = 0;
+        if (in[off++] != PK_SeedSweep) return false;
+
+        const uint16_t ver = rd_u16(in.data(), off, in.size());
+        if (ver != 1) return false;
+
+        const uint32_t run_ms = rd_u32(in.data(), off, in.size());
+        const uint32_t vi_stall_ms = rd_u32(in.data(), off, in.size());
+        const uint32_t count = rd_u32(in.data(), off, in.size());
+        if (count == 0 || in.size() - off != size_t(count) * sizeof(GCInputFrame)) return false;
+
+        out_ctx[keys::seed::SWEEP_INPUTS] = std::string(reinterpret_cast<const char*>(in.data() + off), in.size() - off);
+        out_ctx[keys::seed::SWEEP_COUNT] = count;
+
+        if (run_ms != 0) {
+            out_ctx[keys::core::RUN_MS] = run_ms;
+        }
+        if (vi_stall_ms != 0) {
+            out_ctx[keys::core::VI_STALL_MS] = vi_stall_ms;
+        }
+
+        return true;
+    }
+
+    bool decode_sweep_result(const PSContext& ctx, size_t expected, std::vector<SweepSample>& out)
+    {
+        out.clear();
+        std::string seeds, status;
+        if (!ctx.get<std::string>(keys::seed::SWEEP_SEEDS, seeds) || !ctx.get<std::string>(keys::seed::SWEEP_STATUS, status))
+            return false;
+        if (seeds.size() != expected * 4 || status.size() != expected * 4) return false;
+
+        out.resize(expected);
+        const auto* s = reinterpret_cast<const uint8_t*>(seeds.data());
+        const auto* t = reinterpret_cast<const uint8_t*>(status.data());
+        for (size_t i = 0; i < expected; ++i) {
+            size_t o1 = i * 4, o2 = i * 4;
+            out[i].seed = rd_u32(s, o1, seeds.size());
+            out[i].status = rd_u32(t, o2, status.size());
+        }
+        return true;
+    }
+
+} // namespace simcore::seedprobe
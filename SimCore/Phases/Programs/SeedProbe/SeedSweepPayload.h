@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../../Runner/Script/PhaseScriptVM.h"   // PSContext
+
+namespace simcore::seedprobe {
+
+	// SeedSweep: one job probes many input frames. The worker loops load snapshot -> apply frame[i]
+	// -> run until the seed BP -> read seed, so a grid costs one round trip per chunk instead of per sample.
+	//
+	// On-wire layout (little-endian):
+	//
+	// [0]      : u8   ProgramKind tag (== PK_SeedSweep)
+	// [1..2]   : u16  version = 1
+	// [3..6]   : u32  run_ms (0 => use VM defaults), applies to each sample
+	// [7..10]  : u32  vi_stall_ms (0 => disabled)
+	// [11..14] : u32  count
+	// [15.. ]  : count * raw GCInputFrame bytes
+	//
+	// Result: seed.sweep.seeds and seed.sweep.status, count u32 each; status is the sample's
+	// RunToBpOutcome (0 = hit) and its seed is 0 when status != 0.
+
+	struct SweepSpec {
+		std::vector<GCInputFrame> frames;
+		uint32_t run_ms{ 0 };
+		uint32_t vi_stall_ms{ 0 };
+	};
+
+	struct SweepSample {
+		uint32_t seed{ 0 };
+		uint32_t status{ 0 };
+		bool ok() const { return status == 0; }
+	};
+
+	// Parent-side: build payload bytes (first byte = PK_SeedSweep).
+	bool encode_sweep_payload(const SweepSpec& spec, std::vector<uint8_t>& out);
+
+	// Worker-side: frames -> seed.sweep.inputs (packed), count -> seed.sweep.count, run knobs -> core keys.
+	bool decode_sweep_payload(const std::vector<uint8_t>& in, PSContext& out_ctx);
+
+	// Parent-side: unpack a finished job's per-sample results. false if the arrays are missing or short.
+	bool decode_sweep_result(const PSContext& ctx, size_t expected, std::vector<SweepSample>& out);
+
+} // namespace simcore::seedprobe
@@ -11,13 +11,19 @@
 #include <tuple>
 #include <numeric>
 #include <random>
+#include <functional>
+#include <filesystem>
 
 #include "../Utils/Log.h"
 #include "../Runner/Script/PhaseScriptVM.h"                // PSJob/PSResult
 #include "Programs/SeedProbe/SeedProbeScript.h"     // MakeSeedProbeProgram
 #include "Programs/SeedProbe/SeedProbePayload.h"
+#include "Programs/SeedProbe/SeedSweepPayload.h"
 #include "../Runner/IPC/Wire.h"
 #include "../Utils/MultiProgress.h"
+#include "SeedDeltaSolver.h"
+#include "SeedDeltaAtlas.h"
+#include "../Runner/Parallel/ResultStore.h"   // HashFileContents
 
 using simcore::utils::MultiProgress;
 using simcore::utils::MPBarSpec;
@@ -50,13 +56,14 @@ namespace simcore {
         return out;
     }
 
-    static std::vector<GCInputFrame> build_grid_trig(int n, int minv, int maxv, bool cap_top) {
+    // Top of the trigger range: one short of max_value with cap_trigger_top, so no sample is a full press
+    static int trigger_max(const RngSeedDeltaArgs& args) {
+        return args.cap_trigger_top ? std::max(args.min_value, args.max_value - 1) : args.max_value;
+    }
+
+    static std::vector<GCInputFrame> build_grid_trig(int n, int minv, int maxv) {
         auto ls = linspace_u8(n, minv, maxv);
         auto rs = linspace_u8(n, minv, maxv);
-        if (cap_top) {
-            if (!ls.empty()) ls.back() = std::min<uint8_t>(ls.back(), 0xFF);
-            if (!rs.empty()) rs.back() = std::min<uint8_t>(rs.back(), 0xFF);
-        }
         std::vector<GCInputFrame> out; out.reserve((size_t)n * (size_t)n);
         for (auto r : rs) for (auto l : ls) { GCInputFrame f{}; f.trig_l = l; f.trig_r = r; out.push_back(f); }
         return out;
@@ -71,37 +78,257 @@ namespace simcore {
         return std::string(buf);
     }
 
-    RandSeedProbeResult RunRngSeedDeltaMap(ParallelPhaseScriptRunner& runner, const RngSeedDeltaArgs& args)
+    static GCInputFrame make_singleton_frame(SeedFamily fam, uint8_t x, uint8_t y)
     {
-        PSInit init{};
-        init.savestate_path = args.savestate_path;      // keep using your existing savestate for this phase
-        init.default_timeout_ms = args.run_timeout_ms;
+        GCInputFrame f{};
+        switch (fam) {
+        case SeedFamily::Main:     f.main_x = x; f.main_y = y; break;
+        case SeedFamily::CStick:   f.c_x = x; f.c_y = y; break;
+        case SeedFamily::Triggers: f.trig_l = x; f.trig_r = y; break;
+        case SeedFamily::Neutral:  default: /* all neutral */   break;
+        }
+        return f;
+    }
+
+    static constexpr uint32_t SWEEP_JOB_FAILED = 0xFFFFFFFFu;  // SweepSample::status of samples in a failed job
 
-        SCLOGI("[seedmap] Setting program ...");
+    // Runs `frames` as one sweep batch, one chunk per worker: each job loops load -> apply -> run ->
+    // read in the worker. on_chunk(first, n) is called as chunks complete. false on a failed job;
+    // its samples are left with status SWEEP_JOB_FAILED.
+    static bool run_sweep_batch(ParallelPhaseScriptRunner& runner, const std::vector<GCInputFrame>& frames, uint32_t run_ms,
+        std::vector<seedprobe::SweepSample>& results, const std::function<void(size_t, size_t)>& on_chunk)
+    {
+        results.assign(frames.size(), seedprobe::SweepSample{ 0, SWEEP_JOB_FAILED });
+        if (frames.empty()) return true;
+
+        const size_t W = std::max<uint32_t>(1, runner.worker_count());
+        const size_t chunk = (frames.size() + W - 1) / W;
+
+        // job_id -> first sample index of its chunk
+        std::unordered_map<uint64_t, std::pair<size_t, size_t>> lookup;
+        for (size_t first = 0; first < frames.size(); first += chunk) {
+            seedprobe::SweepSpec spec{};
+            spec.frames.assign(frames.begin() + first, frames.begin() + std::min(frames.size(), first + chunk));
+            spec.run_ms = run_ms;  // per sample
+            spec.vi_stall_ms = 0;
 
-        // No special INIT program for seed probe; main program is SeedProbe
-        if (!runner.set_program(/*init_kind=*/PK_None, /*main_kind=*/PK_SeedProbe, init)) {
-            SCLOGE("Failed to set program on workers.");
-            return {};
+            PSJob j{};
+            seedprobe::encode_sweep_payload(spec, j.payload);
+            lookup.emplace(runner.submit(j), std::make_pair(first, spec.frames.size()));
         }
+        SCLOGD("[seedmap] %zu samples in %zu sweep jobs of <=%zu", frames.size(), lookup.size(), chunk);
 
-        SCLOGI("[seedmap] Activating program ...");
+        bool ok = true;
+        while (!lookup.empty()) {
+            PRResult r{};
+            if (!runner.try_get_result(r)) {
+                if (!runner.has_active_workers()) {
+                    // Every worker is parked; the remaining chunks stay SWEEP_JOB_FAILED
+                    SCLOGE("[seedmap] no worker left; %zu sweep job(s) not run", lookup.size());
+                    return false;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(25));
+                continue;
+            }
+            auto it = lookup.find(r.job_id);
+            if (it == lookup.end()) continue;
+            const auto [first, n] = it->second;
+            lookup.erase(it);
+
+            std::vector<seedprobe::SweepSample> got;
+            if (!r.ps.ok || !seedprobe::decode_sweep_result(r.ps.ctx, n, got)) {
+                SCLOGE("[seedmap] Sweep job %llu (samples %zu..%zu) failed. w_err:%d",
+                    (unsigned long long)r.job_id, first, first + n - 1, r.ps.w_err);
+                ok = false;
+                continue;
+            }
+            std::copy(got.begin(), got.end(), results.begin() + first);
+            if (on_chunk) on_chunk(first, n);
+            SCLOGT("[Result] sweep job=%llu worker=%zu samples=%zu", (unsigned long long)r.job_id, r.worker_id, n);
+        }
+        return ok;
+    }
+
+    // Atlas identity: savestate contents, salted with the probe point.
+    static uint64_t atlas_key(const std::string& savestate_path)
+    {
+        const uint64_t h = HashFileContents(savestate_path);
+        if (h == 0) return 0;
+        uint64_t k = h;
+        for (const char* c = "AfterRandSeedSet"; *c; ++c) { k ^= uint8_t(*c); k *= 1099511628211ull; }
+        return k;
+    }
 
-        // No init-once step for seed probe; go straight to main
-        if (!runner.activate_main()) {
-            SCLOGE("Failed to activate main program.");
-            return {};
+    // Answers frames from the savestate's seed atlas (SeedDeltaAtlas.h) and emulates only the misses.
+    // The sweep program is set up the first time something has to be emulated, so a fully cached
+    // run never touches the workers. save() merges the new samples back into the atlas.
+    class SeedSampler {
+    public:
+        SeedSampler(ParallelPhaseScriptRunner& runner, const RngSeedDeltaArgs& args)
+            : runner_(runner), args_(args)
+        {
+            if (args.atlas_dir.empty()) return;
+            key_ = atlas_key(args.savestate_path);
+            if (key_ == 0) {
+                SCLOGW("[seedatlas] Could not hash savestate %s; atlas disabled", args.savestate_path.c_str());
+                return;
+            }
+            path_ = SeedAtlasPath(args.atlas_dir, key_);
+            std::string err;
+            if (atlas_.open(path_, key_, &err))
+                SCLOGI("[seedatlas] %s: %zu samples", path_.c_str(), atlas_.size());
+            else if (std::filesystem::exists(path_))
+                SCLOGW("[seedatlas] Ignoring %s: %s", path_.c_str(), err.c_str());
         }
 
-        SCLOGI("[seedmap] Building Jobs ...");
+        const SeedDeltaAtlas& atlas() const { return atlas_; }
+        uint32_t cached() const { return cached_; }
+        uint32_t emulated() const { return emulated_; }
+
+        // on_sample(i) as frames[i] completes, cached ones first.
+        bool run(const std::vector<GCInputFrame>& frames, std::vector<seedprobe::SweepSample>& results,
+            const std::function<void(size_t)>& on_sample)
+        {
+            results.assign(frames.size(), seedprobe::SweepSample{ 0, SWEEP_JOB_FAILED });
+            std::vector<size_t> miss;
+            for (size_t i = 0; i < frames.size(); ++i) {
+                uint32_t seed = 0;
+                if (atlas_.is_open() && atlas_.find(frames[i], seed)) {
+                    results[i] = seedprobe::SweepSample{ seed, 0 };
+                    ++cached_;
+                    if (on_sample) on_sample(i);
+                }
+                else miss.push_back(i);
+            }
+            if (miss.empty()) return true;
+            if (!ensure_program()) return false;
+
+            std::vector<GCInputFrame> todo;
+            todo.reserve(miss.size());
+            for (size_t i : miss) todo.push_back(frames[i]);
+            std::vector<seedprobe::SweepSample> got;
+            const bool ok = run_sweep_batch(runner_, todo, args_.run_timeout_ms, got, [&](size_t first, size_t n) {
+                for (size_t j = first; j < first + n; ++j) if (on_sample) on_sample(miss[j]);
+                });
+            for (size_t j = 0; j < miss.size(); ++j) {
+                results[miss[j]] = got[j];
+                if (got[j].ok()) fresh_.push_back(SeedAtlasSample{ todo[j], got[j].seed });
+            }
+            emulated_ += (uint32_t)miss.size();
+            return ok;
+        }
+
+        void save(bool has_base, uint32_t base_seed)
+        {
+            if (path_.empty() || fresh_.empty()) return;
+            std::string err;
+            if (atlas_.save_merged(path_, key_, has_base, base_seed, fresh_, &err))
+                SCLOGI("[seedatlas] +%zu samples -> %s (%zu total)", fresh_.size(), path_.c_str(), atlas_.size());
+            else
+                SCLOGW("[seedatlas] Could not save: %s", err.c_str());
+            fresh_.clear();
+        }
+
+    private:
+        bool ensure_program()
+        {
+            if (program_ready_) return true;
+            PSInit init{};
+            init.savestate_path = args_.savestate_path;      // keep using your existing savestate for this phase
+            init.default_timeout_ms = args_.run_timeout_ms;
+
+            SCLOGI("[seedmap] Setting program ...");
+            // No special INIT program; main program is the in-worker sweep over packed frames
+            if (!runner_.set_program(/*init_kind=*/PK_None, /*main_kind=*/PK_SeedSweep, init)) {
+                SCLOGE("Failed to set program on workers.");
+                return false;
+            }
+            SCLOGI("[seedmap] Activating program ...");
+            // No init-once step for seed probe; go straight to main
+            if (!runner_.activate_main()) {
+                SCLOGE("Failed to activate main program.");
+                return false;
+            }
+            program_ready_ = true;
+            return true;
+        }
+
+        ParallelPhaseScriptRunner& runner_;
+        const RngSeedDeltaArgs& args_;
+        SeedDeltaAtlas atlas_;
+        uint64_t key_{ 0 };
+        std::string path_;
+        std::vector<SeedAtlasSample> fresh_;
+        uint32_t cached_{ 0 }, emulated_{ 0 };
+        bool program_ready_{ false };
+    };
+
+    static void push_entry(RandSeedProbeResult& out, int grid_n, SeedFamily fam, const GCInputFrame& in, const seedprobe::SweepSample& s)
+    {
+        uint8_t vx = 0, vy = 0;
+        const char* title = "";
+        switch (fam) {
+        case SeedFamily::Main:     vx = in.main_x;   vy = in.main_y;   title = "JStick";   break;
+        case SeedFamily::CStick:   vx = in.c_x;      vy = in.c_y;      title = "CStick";   break;
+        case SeedFamily::Triggers: vx = in.trig_l;   vy = in.trig_r;   title = "Triggers"; break;
+        case SeedFamily::Neutral:  vx = 0;           vy = 0;           title = "Neutral";  break;
+        }
+        if (!s.ok())
+            SCLOGW("[seedmap] %s(%02X,%02X) did not reach the seed BP (outcome %u)", title, int(vx), int(vy), s.status);
+
+        out.entries.push_back(RandSeedProbeEntry{
+            grid_n, fam, vx, vy,
+            s.seed,
+            signed_delta(s.seed, out.base_seed),
+            s.ok(),
+            make_label(title, uint8_t(vx), uint8_t(vy))
+            });
+    }
+
+    static void sort_entries(RandSeedProbeResult& out)
+    {
+        std::sort(out.entries.begin(), out.entries.end(), [](const RandSeedProbeEntry& a, const RandSeedProbeEntry& b) {
+            if (a.family != b.family) return a.family < b.family;
+            if (a.y == b.y) return a.x < b.x;
+            return a.y < b.y;
+            });
+    }
+
+    static MultiProgress::Options progress_options()
+    {
+        MultiProgress::Options mpopt;
+        mpopt.use_stdout = true;
+        mpopt.use_vt = true;
+        mpopt.bar_width = 40;
+        return mpopt;
+    }
+
+    static size_t family_index(SeedFamily fam)
+    {
+        switch (fam) {
+        case SeedFamily::Neutral:  return 0;
+        case SeedFamily::Main:     return 1;
+        case SeedFamily::CStick:   return 2;
+        case SeedFamily::Triggers: return 3;
+        }
+        return 0;
+    }
 
+    // Fixed lattice: samples_per_axis^2 points per family in one batch.
+    static RandSeedProbeResult run_lattice(SeedSampler& sampler, const RngSeedDeltaArgs& args)
+    {
         RandSeedProbeResult out{};
 
-        std::vector<std::pair<SeedFamily, std::vector<GCInputFrame>>> batches;
-        batches.emplace_back(SeedFamily::Neutral, std::vector<GCInputFrame>{ neutral_frame() });
-        batches.emplace_back(SeedFamily::Main, build_grid_main(args.samples_per_axis, args.min_value, args.max_value));
-        batches.emplace_back(SeedFamily::CStick, build_grid_cstick(args.samples_per_axis, args.min_value, args.max_value));
-        batches.emplace_back(SeedFamily::Triggers, build_grid_trig(args.samples_per_axis, args.min_value, args.max_value, args.cap_trigger_top));
+        // One flat list of samples; family order is kept so Neutral (the base seed) is sample 0
+        std::vector<SeedFamily> fams;
+        std::vector<GCInputFrame> frames;
+        auto add = [&](SeedFamily fam, const std::vector<GCInputFrame>& fs) {
+            for (const auto& f : fs) { fams.push_back(fam); frames.push_back(f); }
+            };
+        add(SeedFamily::Neutral, { neutral_frame() });
+        add(SeedFamily::Main, build_grid_main(args.samples_per_axis, args.min_value, args.max_value));
+        add(SeedFamily::CStick, build_grid_cstick(args.samples_per_axis, args.min_value, args.max_value));
+        add(SeedFamily::Triggers, build_grid_trig(args.samples_per_axis, args.min_value, trigger_max(args)));
 
         std::vector<MPBarSpec> specs;
         specs.push_back({ "Neutral", 1 });
@@ -109,502 +336,236 @@ namespace simcore {
         specs.push_back({ "CStick",  (uint64_t)args.samples_per_axis * args.samples_per_axis });
         specs.push_back({ "Triggers",(uint64_t)args.samples_per_axis * args.samples_per_axis });
 
-
         SCLOGI("[seedmap] Sending Jobs ...");
 
-        MultiProgress::Options mpopt;
-        mpopt.use_stdout = true;
-        mpopt.use_vt = true;
-        mpopt.bar_width = 40;
-
         MultiProgress mp;
-        mp.init(specs, mpopt);
+        mp.init(specs, progress_options());
         mp.start();
 
-        // When building and dispatching each batch, keep the family index:
-        auto family_index = [&](SeedFamily fam)->size_t {
-            switch (fam) {
-            case SeedFamily::Neutral:  return 0;
-            case SeedFamily::Main:     return 1;
-            case SeedFamily::CStick:   return 2;
-            case SeedFamily::Triggers: return 3;
-            }
-            return 0;
-            };
+        std::vector<seedprobe::SweepSample> results;
+        const bool ok = sampler.run(frames, results, [&](size_t i) { mp.tick(family_index(fams[i])); });
+        mp.finish();
+        if (!ok) return out;
 
-        for (auto& [fam, inputs] : batches) {
-            
-            const size_t fi = family_index(fam);
+        if (!results[0].ok()) {
+            SCLOGE("[seedmap] Neutral sample failed (outcome %u); no base seed.", results[0].status);
+            return out;
+        }
+        out.base_seed = results[0].seed;
 
-            // Prepare jobs
-            std::vector<PSJob> jobs;
-            jobs.reserve(inputs.size());
+        for (size_t i = 0; i < frames.size(); ++i)
+            push_entry(out, args.samples_per_axis, fams[i], frames[i], results[i]);
+        sort_entries(out);
+        return out;
+    }
 
-            // We'll keep a lookup from job_id -> GCInputFrame for labeling later
-            std::unordered_map<uint64_t, GCInputFrame> lookup;
-            lookup.reserve(inputs.size());
+    // Adaptive: every family starts from the same lattice and each round samples only the corners of
+    // cells that still need splitting. The three families share each round's batch.
+    static RandSeedProbeResult run_adaptive(SeedSampler& sampler, const RngSeedDeltaArgs& args)
+    {
+        RandSeedProbeResult out{};
 
-            for (const auto& f : inputs) {
-                simcore::seedprobe::EncodeSpec spec{};
-                spec.frame = f;
-                spec.run_ms = args.run_timeout_ms; // per-job timeout using VMCoreKeys (optional: rely on PSInit otherwise)
-                spec.vi_stall_ms = 0;                   // you can set a small stall window if you like (e.g., 500-2000ms)
+        const SeedFamily fams[3] = { SeedFamily::Main, SeedFamily::CStick, SeedFamily::Triggers };
+        std::vector<SeedDeltaRefiner> ref;
+        for (int i = 0; i < 3; ++i)
+            ref.emplace_back(args.min_value, fams[i] == SeedFamily::Triggers ? trigger_max(args) : args.max_value, args.samples_per_axis);
 
-                PSJob j{};
-                simcore::seedprobe::encode_payload(spec, j.payload);
+        std::vector<MPBarSpec> specs{ { "Neutral", 1 }, { "Main", 1 }, { "CStick", 1 }, { "Triggers", 1 } };
+        MultiProgress mp;
+        mp.init(specs, progress_options());
+        mp.start();
 
-                const uint64_t id = runner.submit(j);
-                lookup.emplace(id, f);
+        SCLOGI("[seedmap] Sending Jobs (adaptive) ...");
+
+        bool have_base = false;
+        for (size_t round = 0;; ++round) {
+            // Frame list for this round: Neutral first in round 0, then each family's pending points
+            std::vector<SeedFamily> owner;
+            std::vector<GCInputFrame> frames;
+            if (!have_base) { owner.push_back(SeedFamily::Neutral); frames.push_back(neutral_frame()); }
+            for (int i = 0; i < 3; ++i) {
+                for (const auto& p : ref[i].pending()) { owner.push_back(fams[i]); frames.push_back(make_singleton_frame(fams[i], p.x, p.y)); }
+                mp.setTotal(family_index(fams[i]), ref[i].samples() + ref[i].pending().size());
             }
-
-            // Drain results for this batch
-            size_t done = 0, total = inputs.size();
-            while (done < total) {
-                PRResult r{};
-                if (runner.try_get_result(r)) {
-                    if (!r.ps.ok) 
-                    {
-                        mp.finish();
-                        uint32_t run_outcome;
-                        r.ps.ctx.get(keys::core::DW_RUN_OUTCOME_CODE, run_outcome);
-                        SCLOGE("[seedmap] Result recieved not okay. w_err:%d ps_err:%d", r.ps.w_err, run_outcome);
-                        return out;
-                    }
-
-                    ++done;
-                    mp.tick(fi);
-
-                    // Seed comes back in the ProcessWorker reader under key "seed"
-                    // (see ProcessWorker::reader_thread MSG_RESULT handling) :contentReference[oaicite:1]{index=1}
-                    uint32_t seed;
-                    r.ps.ctx.get(keys::seed::RNG_SEED, seed);
-
-                    if (fam == SeedFamily::Neutral)  out.base_seed = seed;
-
-
-                    const auto& in = lookup.find(r.job_id)->second;
-                    uint8_t vx = 0, vy = 0;
-                    const char* title = "";
-                    switch (fam) {
-                    case SeedFamily::Main:     vx = in.main_x;   vy = in.main_y;   title = "JStick";   break;
-                    case SeedFamily::CStick:   vx = in.c_x;      vy = in.c_y;      title = "CStick";   break;
-                    case SeedFamily::Triggers: vx = in.trig_l;   vy = in.trig_r;   title = "Triggers"; break;
-                    case SeedFamily::Neutral:  vx = 0;           vy = 0;           title = "Neutral";  break;
-                    }
-
-                    out.entries.push_back(RandSeedProbeEntry{
-                        args.samples_per_axis, fam, vx, vy,
-                        seed,
-                        signed_delta(seed, out.base_seed),
-                        r.ps.ok,
-                        make_label(title, uint8_t(vx), uint8_t(vy))
-                        });
-
-                    uint32_t last_pc;
-                    r.ps.ctx.get(keys::core::RUN_HIT_PC, last_pc);
-                    SCLOGT("[Result] job=%llu worker=%zu accepted=%d ok=%d pc=%08X seed=0x%08X",
-                        (unsigned long long)r.job_id, r.worker_id,
-                        int(r.accepted), int(r.ps.ok), last_pc, seed);
-                }
-                else {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+            if (frames.empty()) break;
+
+            std::vector<seedprobe::SweepSample> results;
+            const bool ok = sampler.run(frames, results, [&](size_t i) { mp.tick(family_index(owner[i])); });
+            if (!ok) { mp.finish(); return out; }
+
+            size_t i0 = 0;
+            if (!have_base) {
+                if (!results[0].ok()) {
+                    mp.finish();
+                    SCLOGE("[seedmap] Neutral sample failed (outcome %u); no base seed.", results[0].status);
+                    return out;
                 }
+                out.base_seed = results[0].seed;
+                push_entry(out, 0, SeedFamily::Neutral, frames[0], results[0]);
+                have_base = true;
+                i0 = 1;
+            }
+            for (size_t i = i0; i < frames.size(); ++i) {
+                const size_t k = family_index(owner[i]) - 1;
+                const auto& f = frames[i];
+                const uint8_t x = k == 0 ? f.main_x : k == 1 ? f.c_x : f.trig_l;
+                const uint8_t y = k == 0 ? f.main_y : k == 1 ? f.c_y : f.trig_r;
+                ref[k].record(x, y, results[i].ok(), (int32_t)signed_delta(results[i].seed, out.base_seed));
+                push_entry(out, 0, owner[i], f, results[i]);
             }
-        }
 
+            size_t added = 0;
+            for (auto& r : ref) added += r.refine();
+            SCLOGD("[seedmap] round %zu: %zu samples, %zu new points", round + 1, frames.size(), added);
+        }
         mp.finish();
 
-        std::sort(out.entries.begin(), out.entries.end(), [](const RandSeedProbeEntry& a, const RandSeedProbeEntry& b) {
-            if (a.family != b.family) return a.family < b.family;
-            if (a.y == b.y) return a.x < b.x;
-            return a.y < b.y;
-            });
+        uint32_t total = 1;
+        uint64_t dense = 1;
+        for (int i = 0; i < 3; ++i) {
+            out.maps.push_back(RandSeedFamilyMap{ fams[i], ref[i].build_map() });
+            const auto& m = out.maps.back().map;
+            total += m.samples;
+            dense += uint64_t(m.side()) * uint64_t(m.side());
+            static const char* names[3] = { "JStick", "CStick", "Triggers" };
+            SCLOGI("[seedmap] %s: %u samples, %zu regions over %dx%d", names[i], m.samples, m.regions.size(), m.side(), m.side());
+        }
+        SCLOGI("[seedmap] adaptive map: %u emulator samples (dense sweep: %llu)", total, (unsigned long long)dense);
 
+        sort_entries(out);
         return out;
     }
 
-    static inline uint64_t mix64(uint64_t x) {
-        x ^= x >> 33; x *= 0xff51afd7ed558ccdULL;
-        x ^= x >> 33; x *= 0xc4ceb9fe1a85ec53ULL;
-        x ^= x >> 33; return x;
-    }
-    static inline size_t coprime_stride(size_t n, uint64_t seed) {
-        if (n <= 1) return 1;
-        size_t cand = size_t(seed % (n - 1)) + 1;
-        for (size_t k = 0; k < n; ++k) {
-            size_t s = (cand + k) % n; if (s == 0) continue;
-            if (std::gcd(s, n) == 1) return s;
-        }
-        return 1;
-    }
-
-    static GCInputFrame make_singleton_frame(SeedFamily fam, uint8_t x, uint8_t y)
+    RandSeedProbeResult RunRngSeedDeltaMap(ParallelPhaseScriptRunner& runner, const RngSeedDeltaArgs& args)
     {
-        GCInputFrame f{};
-        switch (fam) {
-        case SeedFamily::Main:     f.main_x = x; f.main_y = y; break;
-        case SeedFamily::CStick:   f.c_x = x; f.c_y = y; break;
-        case SeedFamily::Triggers: f.trig_l = x; f.trig_r = y; break;
-        case SeedFamily::Neutral:  default: /* all neutral */   break;
-        }
-        return f;
+        SeedSampler sampler(runner, args);
+
+        SCLOGI("[seedmap] Building Jobs ...");
+        RandSeedProbeResult out = args.adaptive ? run_adaptive(sampler, args) : run_lattice(sampler, args);
+
+        SCLOGI("[seedmap] %u samples from the atlas, %u emulated", sampler.cached(), sampler.emulated());
+        if (!out.entries.empty()) sampler.save(true, out.base_seed);
+        return out;
     }
 
     RandSeedComboResult RunFindSeedDeltaCombos(ParallelPhaseScriptRunner& runner,
         const RngSeedDeltaArgs& args,
         const RandSeedProbeResult& grid)
     {
-        PSInit init{};
-        init.savestate_path = args.savestate_path;
-        init.default_timeout_ms = args.run_timeout_ms;
-
-        SCLOGI("[seedcombos] Setting program ...");
-        if (!runner.set_program(/*init_kind=*/PK_None, /*main_kind=*/PK_SeedProbe, init)) {
-            SCLOGE("Failed to set program on workers.");
-            return {};
-        }
-        SCLOGI("[seedcombos] Activating program ...");
-        if (!runner.activate_main()) {
-            SCLOGE("Failed to activate main program.");
-            return {};
-        }
-
         RandSeedComboResult out{};
         out.base_seed = grid.base_seed;
 
-        // Inverse maps and singleton set
-        std::unordered_set<int32_t> singletons{ 0 };
-        std::unordered_map<int32_t, std::vector<std::array<uint8_t, 2>>> j_map, c_map, t_map;
-        for (const auto& e : grid.entries) {
-            singletons.insert(static_cast<int32_t>(e.delta));
-            if (e.family == SeedFamily::Main)      j_map[static_cast<int32_t>(e.delta)].push_back({ e.x, e.y });
-            else if (e.family == SeedFamily::CStick) c_map[static_cast<int32_t>(e.delta)].push_back({ e.x, e.y });
-            else if (e.family == SeedFamily::Triggers) t_map[static_cast<int32_t>(e.delta)].push_back({ e.x, e.y });
-        }
-        if (j_map.empty() || c_map.empty() || t_map.empty()) {
-            SCLOGW("[seedcombos] Missing element deltas; aborting.");
-            return out;
-        }
-
-        // Helpers
+        // Plan first: no emulator time is spent on targets the grid cannot reach
+        const SeedComboPlan plan = PlanSeedDeltaCombos(grid, args.combos_attempts_per_target);
+        out.targets = (uint32_t)plan.targets.size();
 
-        auto make_frame = [](std::array<uint8_t, 2> j, std::array<uint8_t, 2> c, std::array<uint8_t, 2> t) {
-            GCInputFrame f{};
-            f.main_x = j[0]; f.main_y = j[1];
-            f.c_x = c[0]; f.c_y = c[1];
-            f.trig_l = t[0]; f.trig_r = t[1];
-            return f;
-            };
-        auto make_label = [](int32_t t, std::array<uint8_t, 2> j, std::array<uint8_t, 2> c, std::array<uint8_t, 2> tr) {
-            char buf[96];
-            std::snprintf(buf, sizeof(buf), "delta=%d J(%02X,%02X) C(%02X,%02X) T(%02X,%02X)",
-                t, int(j[0]), int(j[1]), int(c[0]), int(c[1]), int(tr[0]), int(tr[1]));
-            return std::string(buf);
-            };
-
-        // Catalog (observed delta -> whether we have stored a representative)
-        std::unordered_set<int32_t> have_catalog;
-        have_catalog.insert(0);
-
-        // Ensure we store exactly one representative per observed delta from the probe
+        // Catalog: one representative per delta the probe already observed
+        std::unordered_set<int32_t> have_catalog{ 0 };
         for (const auto& e : grid.entries) {
             const int32_t d = static_cast<int32_t>(e.delta);
-            if (have_catalog.count(d)) continue;           // already have a representative
-            if (!e.ok) continue;                           // skip bad probe entries
+            if (!e.ok || have_catalog.count(d)) continue;
 
-            GCInputFrame f = make_singleton_frame(e.family, e.x, e.y);
             RandSeedComboEntry ce{};
-            ce.input = f;
+            ce.input = make_singleton_frame(e.family, e.x, e.y);
             ce.seed = e.seed;
             ce.delta = e.delta;
             ce.ok = true;
-            ce.label = e.label; // reuse the probe label if you like
-
+            ce.label = e.label;
             out.entries.push_back(ce);
             have_catalog.insert(d);
         }
 
-        // Dedupe of concrete attempts
-        struct TripleKey { uint8_t jx, jy, cx, cy, tl, tr; };
-        struct TKHash {
-            size_t operator()(const TripleKey& k) const noexcept {
-                uint64_t v = 0; v |= uint64_t(k.jx) << 0; v |= uint64_t(k.jy) << 8; v |= uint64_t(k.cx) << 16;
-                v |= uint64_t(k.cy) << 24; v |= uint64_t(k.tl) << 32; v |= uint64_t(k.tr) << 40;
-                return std::hash<uint64_t>{}(v);
-            }
-        };
-        struct TKEq {
-            bool operator()(const TripleKey& a, const TripleKey& b) const noexcept {
-                return std::memcmp(&a, &b, sizeof(TripleKey)) == 0;
-            }
-        };
-        std::unordered_set<TripleKey, TKHash, TKEq> tried;
-
-        struct TripleState {
-            // deltas
-            int32_t jd = 0, cd = 0, td = 0;
-            // vectors realizing the deltas
-            const std::vector<std::array<uint8_t, 2>>* J = nullptr;
-            const std::vector<std::array<uint8_t, 2>>* C = nullptr;
-            const std::vector<std::array<uint8_t, 2>>* T = nullptr;
-            // sizes
-            size_t nJ = 0, nC = 0, nT = 0;
-            // indices (start offsets)
-            size_t iJ = 0, iC = 0, iT = 0;
-            // strides (coprime)
-            size_t sJ = 1, sC = 1, sT = 1;
-            // axis cursor: 0=J,1=C,2=T
-            uint8_t axis = 0;
-            // accounting
-            uint64_t emitted = 0;      // how many concrete combos emitted (seen or not)
-            uint64_t total = 0;        // nJ * nC * nT
-            bool exhausted = false;
-
-            inline void advance_axis() {
-                // advance current axis by stride, skip axes of size 1
-                for (int step = 0; step < 3; ++step) {
-                    if (axis == 0) { if (nJ > 1) { iJ = (iJ + sJ) % nJ; axis = 1; break; } axis = 1; }
-                    else if (axis == 1) { if (nC > 1) { iC = (iC + sC) % nC; axis = 2; break; } axis = 2; }
-                    else { if (nT > 1) { iT = (iT + sT) % nT; axis = 0; break; } axis = 0; }
-                }
-            }
-        };
-
-        struct FairComboIterator {
-            int32_t target = 0;
-            std::vector<TripleState> triples; // all (delta_j,delta_c,delta_t) that sum to target
-            size_t cur = 0;
-
-            bool next(std::array<uint8_t, 2>& J, std::array<uint8_t, 2>& C, std::array<uint8_t, 2>& T,
-                std::unordered_set<TripleKey, TKHash, TKEq>& tried, uint32_t inner_try_cap)
-            {
-                if (triples.empty()) return false;
-                const size_t N = triples.size();
-                size_t checked = 0;
-
-                while (checked < N) {
-                    TripleState& ts = triples[cur];
-                    if (!ts.exhausted) {
-                        uint32_t inner = 0;
-                        while (inner < inner_try_cap && !ts.exhausted) {
-                            const auto& jv = (*ts.J)[ts.iJ];
-                            const auto& cv = (*ts.C)[ts.iC];
-                            const auto& tv = (*ts.T)[ts.iT];
-                            TripleKey key{ jv[0], jv[1], cv[0], cv[1], tv[0], tv[1] };
-
-                            // Prepare next state now (fair axis cycle)
-                            ts.advance_axis();
-                            ++ts.emitted;
-                            if (ts.emitted >= ts.total) ts.exhausted = true;
-
-                            ++inner;
-                            if (tried.insert(key).second) {
-                                J = jv; C = cv; T = tv;
-                                // move to next triple next time
-                                cur = (cur + 1) % N;
-                                return true;
-                            }
-                        }
-                    }
-                    // move to next triple
-                    cur = (cur + 1) % N;
-                    ++checked;
-                }
-                return false;
-            }
-        };
-
-        struct TargetState {
-            int32_t t = 0;
-            bool satisfied = false;
-            uint32_t attempts = 0;
-            uint32_t in_flight = 0;
-            FairComboIterator it;
-        };
-
-        // Pre-sort delta key lists for stable ordering
-        std::vector<int32_t> j_keys, c_keys, t_keys;
-        j_keys.reserve(j_map.size()); c_keys.reserve(c_map.size()); t_keys.reserve(t_map.size());
-        for (auto& kv : j_map) j_keys.push_back(kv.first);
-        for (auto& kv : c_map) c_keys.push_back(kv.first);
-        for (auto& kv : t_map) t_keys.push_back(kv.first);
-        std::sort(j_keys.begin(), j_keys.end());
-        std::sort(c_keys.begin(), c_keys.end());
-        std::sort(t_keys.begin(), t_keys.end());
-
-        // Targets = all triple sums - singletons
-        std::unordered_set<int32_t> tset;
-        for (int32_t jd : j_keys)
-            for (int32_t cd : c_keys)
-                for (int32_t td : t_keys) {
-                    const int32_t s = jd + cd + td;
-                    if (!singletons.count(s)) tset.insert(s);
-                }
-        std::vector<int32_t> targets{ tset.begin(), tset.end() };
-        std::sort(targets.begin(), targets.end());
-
-        std::vector<TargetState> states;
-        states.reserve(targets.size());
-
-        if (targets.empty()) {
+        if (plan.targets.empty()) {
             SCLOGI("[seedcombos] No targets to discover.");
             return out;
         }
+        uint64_t triples = 0;
+        for (const auto& t : plan.targets) triples += t.delta_triples;
+        SCLOGI("[seedcombos] %zu targets from %llu delta triples; verifying up to %u ranked candidates each",
+            plan.targets.size(), (unsigned long long)triples, args.combos_attempts_per_target);
 
-        for (int32_t t : targets) {
-            TargetState S{};
-            S.t = t;
-            FairComboIterator it{};
-            it.target = t;
-
-            // enumerate all (delta_j,delta_c,delta_t) with delta_j+delta_c+delta_t == t
-            for (int32_t jd : j_keys) {
-                for (int32_t cd : c_keys) {
-                    const int32_t need = t - jd - cd;
-                    auto itT = t_map.find(need);
-                    if (itT == t_map.end()) continue;
-
-                    TripleState ts{};
-                    ts.jd = jd; ts.cd = cd; ts.td = need;
-                    ts.J = &j_map[jd]; ts.C = &c_map[cd]; ts.T = &itT->second;
-                    ts.nJ = ts.J->size(); ts.nC = ts.C->size(); ts.nT = ts.T->size();
-                    ts.total = uint64_t(ts.nJ) * uint64_t(ts.nC) * uint64_t(ts.nT);
-                    if (ts.total == 0) { ts.exhausted = true; }
-
-                    // deterministic strides/offsets per triple
-                    const uint64_t seed = mix64((uint64_t(uint32_t(t)) << 32) ^
-                        (uint64_t(uint32_t(jd)) << 21) ^
-                        (uint64_t(uint32_t(cd)) << 10) ^
-                        uint64_t(uint32_t(need)));
-
-                    if (ts.nJ > 0) { ts.iJ = size_t(seed % ts.nJ); ts.sJ = coprime_stride(ts.nJ, mix64(seed ^ 0x9E3779B185EBCA87ULL)); }
-                    if (ts.nC > 0) { ts.iC = size_t((seed >> 7) % ts.nC); ts.sC = coprime_stride(ts.nC, mix64(seed ^ 0xC2B2AE3D27D4EB4FULL)); }
-                    if (ts.nT > 0) { ts.iT = size_t((seed >> 13) % ts.nT); ts.sT = coprime_stride(ts.nT, mix64(seed ^ 0x165667B19E3779F9ULL)); }
-
-                    // start axis chosen deterministically
-                    ts.axis = uint8_t((seed >> 3) % 3);
-
-                    it.triples.push_back(std::move(ts));
-                }
-            }
-
-            // stable ordering across triples (optional: sort by (jd,cd,td))
-            std::sort(it.triples.begin(), it.triples.end(), [](const TripleState& a, const TripleState& b) {
-                if (a.jd != b.jd) return a.jd < b.jd;
-                if (a.cd != b.cd) return a.cd < b.cd;
-                return a.td < b.td;
-                });
-
-            S.it = std::move(it);
-            states.push_back(std::move(S));
-        }
-
-        struct JobMeta { int32_t target; GCInputFrame frame; };
-        std::unordered_map<uint64_t, JobMeta> jobs; jobs.reserve(2048);
-
-        auto enqueue_for = [&](TargetState& S)->bool {
-            if (S.satisfied) return false;
-            if (S.attempts >= args.combos_attempts_per_target) return false;
-
-            std::array<uint8_t, 2> J{}, C{}, T{};
-            // Try to get next fair candidate; dedupe is passed via 'tried'
-            if (!S.it.next(J, C, T, tried, args.combos_sampler_tries)) return false;
-
-            GCInputFrame f{};
-            f.main_x = J[0]; f.main_y = J[1];
-            f.c_x = C[0]; f.c_y = C[1];
-            f.trig_l = T[0]; f.trig_r = T[1];
-
-            seedprobe::EncodeSpec spec{};
-            spec.frame = f;
-            spec.run_ms = args.run_timeout_ms;
-            spec.vi_stall_ms = 0;
-
-            PSJob j{};
-            seedprobe::encode_payload(spec, j.payload);
-
-            const uint64_t id = runner.submit(j);
-            jobs.emplace(id, JobMeta{ S.t, f });
-
-            ++S.attempts;
-            ++S.in_flight;
-
-            SCLOGT("[seedcombos] submit t=%d (attempt %u) delta=(%d, %d, %d) J(%02X,%02X) C(%02X,%02X) T(%02X,%02X)",
-                S.t, S.attempts,
-                int32_t(J[0]) /*placeholder for logging*/, int32_t(C[0]), int32_t(T[0]),
-                int(J[0]), int(J[1]), int(C[0]), int(C[1]), int(T[0]), int(T[1]));
-            return true;
+        auto make_label = [](int32_t t, const GCInputFrame& f) {
+            char buf[96];
+            std::snprintf(buf, sizeof(buf), "delta=%d J(%02X,%02X) C(%02X,%02X) T(%02X,%02X)",
+                t, int(f.main_x), int(f.main_y), int(f.c_x), int(f.c_y), int(f.trig_l), int(f.trig_r));
+            return std::string(buf);
             };
 
-        auto all_satisfied = [&]() { for (auto& s : states) if (!s.satisfied) return false; return true; };
-
-        // Initial wave: one per target
-        for (auto& S : states) (void)enqueue_for(S);
-
-        const uint32_t W = std::max<uint32_t>(1, runner.worker_count());
-        auto inflight = [&]() { uint32_t s = 0; for (auto& t : states) s += t.in_flight; return s; };
-
-        while (!all_satisfied() && inflight() > 0) {
-
-            PRResult r{};
-            if (!runner.try_get_result(r)) { std::this_thread::sleep_for(std::chrono::milliseconds(10)); continue; }
-
-            auto it = jobs.find(r.job_id);
-            if (it == jobs.end()) { SCLOGW("[seedcombos] Unknown job id=%llu", (unsigned long long)r.job_id); continue; }
-
-            // mark inflight--
-            auto* S_ptr = [&]()->TargetState* {
-                for (auto& s : states) if (s.t == it->second.target) return &s; return nullptr;
-                }();
-            if (S_ptr && S_ptr->in_flight) --S_ptr->in_flight;
+        // Targets an earlier session already realized are answered by the atlas's delta index
+        SeedSampler sampler(runner, args);
+        const SeedDeltaAtlas& atlas = sampler.atlas();
+        if (atlas.is_open() && atlas.has_base() && atlas.base_seed() == grid.base_seed) {
+            uint32_t known = 0;
+            for (const auto& t : plan.targets) {
+                if (have_catalog.count(t.target)) continue;
+                const auto fs = atlas.frames_for_delta(t.target, 1);
+                if (fs.empty()) continue;
+                RandSeedComboEntry ce{};
+                ce.input = fs.front();
+                ce.seed = uint32_t(int64_t(int32_t(grid.base_seed)) + t.target);
+                ce.delta = t.target;
+                ce.ok = true;
+                ce.label = make_label(t.target, ce.input);
+                out.entries.push_back(ce);
+                have_catalog.insert(t.target);
+                ++known;
+            }
+            SCLOGI("[seedcombos] %u/%zu targets answered by the atlas", known, plan.targets.size());
+        }
 
-            if (!r.ps.ok) {
-                uint32_t oc = 0; r.ps.ctx.get(keys::core::DW_RUN_OUTCOME_CODE, oc);
-                SCLOGE("[seedcombos] VM error t=%d w_err=%d ps=%u", it->second.target, r.ps.w_err, oc);
-                jobs.erase(it);
+        // Round r verifies the r-th candidate of every still-unsatisfied target, all in one sweep
+        // batch split across the workers. A frame whose observed delta is any open target satisfies it.
+        std::unordered_set<uint64_t> tried;
+        for (size_t round = 0; round < args.combos_attempts_per_target; ++round) {
+            std::vector<GCInputFrame> frames;
+            for (const auto& t : plan.targets) {
+                if (have_catalog.count(t.target) || round >= t.candidates.size()) continue;
+                const GCInputFrame& f = t.candidates[round].input;
+                if (tried.insert(SeedAtlasFrameKey(f)).second) frames.push_back(f);
+            }
+            if (frames.empty()) {
+                bool more = false;
+                for (const auto& t : plan.targets) more |= !have_catalog.count(t.target) && round + 1 < t.candidates.size();
+                if (!more) break;
                 continue;
             }
 
-            uint32_t seed = 0; r.ps.ctx.get(keys::seed::RNG_SEED, seed);
-            const long long obs = signed_delta(seed, out.base_seed);
-
-            if (!have_catalog.count(int32_t(obs))) {
-                RandSeedComboEntry ce{}; ce.input = it->second.frame; ce.seed = seed; ce.delta = obs; ce.ok = true;
-                char lab[64]; std::snprintf(lab, sizeof(lab), "obs delta=%lld", obs); ce.label = lab;
+            std::vector<seedprobe::SweepSample> got;
+            if (!sampler.run(frames, got, {}))
+                SCLOGE("[seedcombos] some sweep jobs of round %zu failed", round + 1);
+
+            for (size_t i = 0; i < frames.size(); ++i) {
+                if (!got[i].ok()) continue;
+                const long long obs = signed_delta(got[i].seed, out.base_seed);
+                if (have_catalog.count(int32_t(obs))) continue;
+
+                RandSeedComboEntry ce{};
+                ce.input = frames[i];
+                ce.seed = got[i].seed;
+                ce.delta = obs;
+                ce.ok = true;
+                ce.label = make_label(int32_t(obs), ce.input);
                 out.entries.push_back(ce);
                 have_catalog.insert(int32_t(obs));
-                SCLOGI("[seedcombos] Catalog add delta=%lld (job=%llu worker=%zu)", obs, (unsigned long long)r.job_id, r.worker_id);
-            }
-
-            if (S_ptr && obs == S_ptr->t) {
-                S_ptr->satisfied = true;
-                SCLOGI("[seedcombos] Satisfied target delta=%d", S_ptr->t);
-            }
-            if (S_ptr && !S_ptr->satisfied && S_ptr->attempts >= args.combos_attempts_per_target) {
-                SCLOGT("[seedcombos] Target delta=%d hit cap (%u)", S_ptr->t, S_ptr->attempts);
+                SCLOGT("[seedcombos] Catalog add %s", ce.label.c_str());
             }
 
-            jobs.erase(it);
-
-            // Top up to W using unsatisfied targets
-            while (inflight() < W) {
-                bool any = false;
-                for (auto& S : states) {
-                    if (S.satisfied) continue;
-                    if (S.attempts >= args.combos_attempts_per_target) continue;
-                    if (enqueue_for(S)) { any = true; break; }
-                }
-                if (!any) break;
-            }
+            uint32_t open = 0;
+            for (const auto& t : plan.targets) open += !have_catalog.count(t.target);
+            SCLOGI("[seedcombos] round %zu: %zu frames verified, %u/%zu targets open",
+                round + 1, frames.size(), open, plan.targets.size());
+            if (open == 0) break;
         }
 
-        for (auto s : states) {
-            if (!s.satisfied) SCLOGI("[seedcombos] delta not found:%d tries=%d", s.t, s.attempts);
+        for (const auto& t : plan.targets) {
+            if (have_catalog.count(t.target)) ++out.satisfied;
+            else SCLOGI("[seedcombos] delta not found:%d candidates=%zu", t.target, t.candidates.size());
         }
-
+        out.verified_runs = sampler.emulated();
+        SCLOGI("[seedcombos] %u/%u targets satisfied with %u emulator runs (%u frames from the atlas)",
+            out.satisfied, out.targets, out.verified_runs, sampler.cached());
+        sampler.save(true, grid.base_seed);
         return out;
     }
 
-
-
 } // namespace simcore
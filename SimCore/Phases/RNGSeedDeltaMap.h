@@ -6,6 +6,7 @@
 #include "../Boot/Boot.h"
 #include "../Core/Input/InputPlan.h"
 #include "../Runner/Parallel/ParallelPhaseScriptRunner.h"
+#include "SeedDeltaRefiner.h"
 
 namespace simcore {
 
@@ -22,9 +23,15 @@ namespace simcore {
         std::string label;
     };
 
+    struct RandSeedFamilyMap {
+        SeedFamily family = SeedFamily::Neutral;
+        SeedRegionMap map;
+    };
+
     struct RandSeedProbeResult {
         uint32_t base_seed = 0;
-        std::vector<RandSeedProbeEntry> entries;
+        std::vector<RandSeedProbeEntry> entries;     // every sample taken (grid_n = 0 in adaptive mode)
+        std::vector<RandSeedFamilyMap> maps;         // adaptive mode: complete Main/CStick/Triggers maps
     };
 
     struct RandSeedComboEntry {
@@ -38,18 +45,22 @@ namespace simcore {
     struct RandSeedComboResult {
         uint32_t base_seed = 0;
         std::vector<RandSeedComboEntry> entries;
+        uint32_t targets = 0;         // reachable sums the grid did not already realize
+        uint32_t satisfied = 0;       // targets observed by some verified frame
+        uint32_t verified_runs = 0;   // emulator samples spent
     };
 
     struct RngSeedDeltaArgs {
         BootPlan boot;
         std::string savestate_path;
-        int samples_per_axis = 5;
+        int samples_per_axis = 5;                   // lattice size; adaptive mode starts from it
+        bool adaptive = false;                      // refine cells with differing corners down to unit steps (SeedDeltaRefiner.h)
         int min_value = 0;
         int max_value = 255;
-        bool cap_trigger_top = true;
+        bool cap_trigger_top = true;                // triggers stop one short of max_value (no full press) in both modes
         uint32_t run_timeout_ms = 10000;
-        uint32_t combos_attempts_per_target = 256;  // max dispatches per target
-        uint32_t combos_sampler_tries = 8;   // attempts to construct a triple that sums to target
+        uint32_t combos_attempts_per_target = 8;    // ranked candidates verified per target (SeedDeltaSolver.h)
+        std::string atlas_dir;                      // per-savestate seed atlas (SeedDeltaAtlas.h); empty = always emulate
     };
 
     RandSeedProbeResult RunRngSeedDeltaMap(ParallelPhaseScriptRunner& runner, const RngSeedDeltaArgs& args);
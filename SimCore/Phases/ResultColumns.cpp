@@ -0,0 +1,471 @@
+#include "ResultColumns.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "../Core/Input/SoaBattle/ActionPlanSerializer.h"
+#include "../Utils/Log.h"
+
+namespace simcore::battleexplorer {
+
+    using namespace cols;
+
+    static constexpr uint64_t FNV_OFFSET = 1469598103934665603ull;
+    static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t GROUP_FIXED = 4 + 4 + 4 + 2 + 2 + 8 + 8;
+    static constexpr size_t DIR_ENTRY = 8;
+    static constexpr size_t GROUP_HEADER = GROUP_FIXED + DIR_ENTRY * Count;
+
+    // Fixed column widths in bytes; 0 = blob.
+    static constexpr uint8_t WIDTH[Count] = { 8, 2, 1, 1, 2, 4, 4, 4, 4, 0 };
+
+    static inline uint64_t fnv1a(uint64_t h, const uint8_t* p, size_t n) {
+        for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= FNV_PRIME; }
+        return h;
+    }
+
+    static inline void put_u16(std::vector<uint8_t>& b, uint16_t v) { b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8)); }
+    static inline void put_u32(std::vector<uint8_t>& b, uint32_t v) {
+        b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8)); b.push_back(uint8_t(v >> 16)); b.push_back(uint8_t(v >> 24));
+    }
+    static inline void put_u64(std::vector<uint8_t>& b, uint64_t v) { put_u32(b, uint32_t(v)); put_u32(b, uint32_t(v >> 32)); }
+    static inline uint16_t rd_u16(const uint8_t* d) { return uint16_t(d[0]) | (uint16_t(d[1]) << 8); }
+    static inline uint32_t rd_u32(const uint8_t* d) {
+        return uint32_t(d[0]) | (uint32_t(d[1]) << 8) | (uint32_t(d[2]) << 16) | (uint32_t(d[3]) << 24);
+    }
+    static inline uint64_t rd_u64(const uint8_t* d) { return uint64_t(rd_u32(d)) | (uint64_t(rd_u32(d + 4)) << 32); }
+
+    static bool write_at(HANDLE h, uint64_t off, const void* p, size_t n) {
+        const BYTE* b = static_cast<const BYTE*>(p);
+        while (n) {
+            OVERLAPPED ov{}; ov.Offset = DWORD(off); ov.OffsetHigh = DWORD(off >> 32);
+            DWORD w = 0;
+            if (!WriteFile(h, b, (DWORD)std::min(n, (size_t)0x7FFFFFFF), &w, &ov) || w == 0) return false;
+            b += w; n -= w; off += w;
+        }
+        return true;
+    }
+
+    static bool read_at(HANDLE h, uint64_t off, void* p, size_t n) {
+        BYTE* b = static_cast<BYTE*>(p);
+        while (n) {
+            OVERLAPPED ov{}; ov.Offset = DWORD(off); ov.OffsetHigh = DWORD(off >> 32);
+            DWORD r = 0;
+            if (!ReadFile(h, b, (DWORD)std::min(n, (size_t)0x7FFFFFFF), &r, &ov) || r == 0) return false;
+            b += r; n -= r; off += r;
+        }
+        return true;
+    }
+
+    // Column vectors hold host-order values; the format is little-endian, as is every target we build for.
+    template <class T>
+    static inline void put_col(std::vector<uint8_t>& out, const std::vector<T>& v) {
+        const auto* p = reinterpret_cast<const uint8_t*>(v.data());
+        out.insert(out.end(), p, p + v.size() * sizeof(T));
+    }
+
+    // --- path blob ---
+
+    void EncodePathBlob(const GCInputFrame& initial, const soa::battle::actions::BattlePath& path, std::vector<uint8_t>& out)
+    {
+        out.clear();
+        const auto* f = reinterpret_cast<const uint8_t*>(&initial);
+        out.insert(out.end(), f, f + sizeof(GCInputFrame));
+        const uint8_t turns = (uint8_t)std::min<size_t>(path.size(), 0xFF);
+        out.push_back(turns);
+        for (uint8_t t = 0; t < turns; ++t) put_u32(out, path[t].fake_attack_count);
+        std::vector<uint8_t> plans;
+        if (turns == path.size()) soa::battle::actions::encode_turn_plans_to_buffer(path, plans);
+        else soa::battle::actions::encode_turn_plans_to_buffer(soa::battle::actions::BattlePath(path.begin(), path.begin() + turns), plans);
+        out.insert(out.end(), plans.begin(), plans.end());
+    }
+
+    bool DecodePathBlob(const uint8_t* p, size_t n, GCInputFrame& initial, soa::battle::actions::BattlePath& path)
+    {
+        if (n < sizeof(GCInputFrame) + 1) return false;
+        std::memcpy(&initial, p, sizeof(GCInputFrame));
+        size_t off = sizeof(GCInputFrame);
+        const uint8_t turns = p[off++];
+        if (n < off + size_t(turns) * 4) return false;
+        std::vector<uint32_t> fake(turns);
+        for (uint8_t t = 0; t < turns; ++t, off += 4) fake[t] = rd_u32(p + off);
+        if (!soa::battle::actions::decode_turn_plans_from_buffer(std::span<const uint8_t>(p + off, n - off), path)) return false;
+        if (path.size() != turns) return false;
+        for (uint8_t t = 0; t < turns; ++t) path[t].fake_attack_count = fake[t];
+        return true;
+    }
+
+    // --- writer ---
+
+    ColumnarResultWriter::~ColumnarResultWriter() { close(); }
+
+    bool ColumnarResultWriter::open(const std::string& path, uint32_t rows_per_group, std::string* error_out)
+    {
+        close();
+        path_ = path;
+        rows_per_group_ = std::max<uint32_t>(rows_per_group, 1);
+        rows_total_ = 0;
+        group_offsets_.clear();
+
+        h_ = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (h_ == INVALID_HANDLE_VALUE) {
+            if (error_out) *error_out = "Could not create result file: " + path;
+            return false;
+        }
+
+        std::vector<uint8_t> hdr;
+        put_u32(hdr, FILE_MAGIC); put_u16(hdr, FILE_VERSION); put_u16(hdr, (uint16_t)Count); put_u64(hdr, 0);
+        if (!write_at(h_, 0, hdr.data(), hdr.size())) {
+            if (error_out) *error_out = "Could not write result file: " + path;
+            CloseHandle(h_); h_ = INVALID_HANDLE_VALUE;
+            return false;
+        }
+        end_ = hdr.size();
+
+        c_path_id_.reserve(rows_per_group_); c_outcome_.reserve(rows_per_group_);
+        c_status_.reserve(rows_per_group_); c_w_err_.reserve(rows_per_group_); c_turn_.reserve(rows_per_group_);
+        c_pred_.reserve(rows_per_group_); c_hit_pc_.reserve(rows_per_group_); c_elapsed_.reserve(rows_per_group_);
+        c_worker_.reserve(rows_per_group_); c_blob_off_.reserve(size_t(rows_per_group_) + 1);
+        reset_group();
+        return true;
+    }
+
+    void ColumnarResultWriter::reset_group()
+    {
+        rows_ = 0;
+        outcome_mask_ = 0;
+        min_turn_ = 0xFFFF; max_turn_ = 0;
+        c_path_id_.clear(); c_outcome_.clear(); c_status_.clear(); c_w_err_.clear(); c_turn_.clear();
+        c_pred_.clear(); c_hit_pc_.clear(); c_elapsed_.clear(); c_worker_.clear();
+        c_blob_off_.assign(1, 0);
+        c_blob_.clear();
+    }
+
+    void ColumnarResultWriter::append(const ResultRow& r)
+    {
+        if (h_ == INVALID_HANDLE_VALUE) return;
+        c_path_id_.push_back(r.path_id);
+        c_outcome_.push_back(r.outcome);
+        c_status_.push_back(r.status);
+        c_w_err_.push_back(r.w_err);
+        c_turn_.push_back(r.turn);
+        c_pred_.push_back(r.pred_failed);
+        c_hit_pc_.push_back(r.hit_pc);
+        c_elapsed_.push_back(r.elapsed_ms);
+        c_worker_.push_back(r.worker_id);
+        c_blob_.insert(c_blob_.end(), r.path.begin(), r.path.end());
+        c_blob_off_.push_back((uint32_t)c_blob_.size());
+
+        outcome_mask_ |= OutcomeBit(r.outcome);
+        min_turn_ = std::min(min_turn_, r.turn);
+        max_turn_ = std::max(max_turn_, r.turn);
+        ++rows_;
+        ++rows_total_;
+        if (rows_ >= rows_per_group_) flush_group();
+    }
+
+    void ColumnarResultWriter::on_result(const JobResult& r)
+    {
+        const auto& ctx = r.pr.ps.ctx;
+        ResultRow row{};
+        row.path_id = r.job_id;
+        row.outcome = (uint16_t)r.outcome;
+        row.status = uint8_t((r.pr.accepted ? 1u : 0u) | (r.pr.ps.ok ? 2u : 0u));
+        row.w_err = (uint8_t)r.pr.ps.w_err;
+        uint32_t v = 0;
+        if (ctx.get<uint32_t>(keys::battle::ACTIVE_TURN, v)) row.turn = (uint16_t)std::min<uint32_t>(v, 0xFFFF);
+        if (r.outcome == battle::Outcome::PredFailure && ctx.get<uint32_t>(keys::core::PRED_FIRST_FAILED, v)) row.pred_failed = v;
+        if (ctx.get<uint32_t>(keys::core::RUN_HIT_PC, v)) row.hit_pc = v;
+        if (ctx.get<uint32_t>(keys::core::ELAPSED_MS, v)) row.elapsed_ms = v;
+        row.worker_id = (uint32_t)r.pr.worker_id;
+
+        // One encode buffer for the whole run instead of an allocation per row
+        EncodePathBlob(r.spec.initial, r.spec.path, scratch_);
+        row.path.swap(scratch_);
+        append(row);
+        row.path.swap(scratch_);
+    }
+
+    bool ColumnarResultWriter::flush_group()
+    {
+        if (h_ == INVALID_HANDLE_VALUE || rows_ == 0) return true;
+
+        std::vector<uint8_t> payload;
+        payload.reserve(size_t(rows_) * 30 + c_blob_off_.size() * 4 + c_blob_.size());
+        uint32_t bytes[Count]{};
+        auto mark = [&](Column c, size_t before) { bytes[c] = (uint32_t)(payload.size() - before); };
+        size_t b;
+        b = payload.size(); put_col(payload, c_path_id_); mark(PathId, b);
+        b = payload.size(); put_col(payload, c_outcome_); mark(Outcome, b);
+        b = payload.size(); put_col(payload, c_status_);  mark(Status, b);
+        b = payload.size(); put_col(payload, c_w_err_);   mark(WorkerErr, b);
+        b = payload.size(); put_col(payload, c_turn_);    mark(Turn, b);
+        b = payload.size(); put_col(payload, c_pred_);    mark(PredFailed, b);
+        b = payload.size(); put_col(payload, c_hit_pc_);  mark(HitPc, b);
+        b = payload.size(); put_col(payload, c_elapsed_); mark(ElapsedMs, b);
+        b = payload.size(); put_col(payload, c_worker_);  mark(WorkerId, b);
+        b = payload.size(); put_col(payload, c_blob_off_); put_col(payload, c_blob_); mark(Path, b);
+
+        std::vector<uint8_t> hdr;
+        hdr.reserve(GROUP_HEADER);
+        put_u32(hdr, GROUP_MAGIC);
+        put_u32(hdr, rows_);
+        put_u32(hdr, outcome_mask_);
+        put_u16(hdr, min_turn_);
+        put_u16(hdr, max_turn_);
+        put_u64(hdr, payload.size());
+        put_u64(hdr, fnv1a(FNV_OFFSET, payload.data(), payload.size()));
+        for (uint8_t c = 0; c < Count; ++c) {
+            hdr.push_back(c);
+            hdr.push_back(WIDTH[c]);
+            put_u16(hdr, 0);
+            put_u32(hdr, bytes[c]);
+        }
+
+        const bool ok = write_at(h_, end_, hdr.data(), hdr.size())
+            && write_at(h_, end_ + hdr.size(), payload.data(), payload.size());
+        if (!ok) {
+            SCLOGW("[results] write failed, dropping %u rows: %s", rows_, path_.c_str());
+            reset_group();
+            return false;
+        }
+        group_offsets_.push_back(end_);
+        end_ += hdr.size() + payload.size();
+        reset_group();
+        return true;
+    }
+
+    void ColumnarResultWriter::close()
+    {
+        if (h_ == INVALID_HANDLE_VALUE) return;
+        flush_group();
+
+        std::vector<uint8_t> idx;
+        put_u32(idx, INDEX_MAGIC);
+        put_u32(idx, (uint32_t)group_offsets_.size());
+        for (uint64_t o : group_offsets_) put_u64(idx, o);
+        put_u64(idx, end_);
+        put_u32(idx, FILE_MAGIC);
+        if (write_at(h_, end_, idx.data(), idx.size())) end_ += idx.size();
+
+        FlushFileBuffers(h_);
+        CloseHandle(h_);
+        h_ = INVALID_HANDLE_VALUE;
+        SCLOGI("[results] %s: %llu rows in %zu groups, %llu bytes", path_.c_str(),
+            (unsigned long long)rows_total_, group_offsets_.size(), (unsigned long long)end_);
+    }
+
+    // --- reader ---
+
+    ColumnarResultReader::~ColumnarResultReader() { close(); }
+
+    void ColumnarResultReader::close()
+    {
+        if (h_ != INVALID_HANDLE_VALUE) CloseHandle(h_);
+        h_ = INVALID_HANDLE_VALUE;
+        groups_.clear();
+        rows_ = 0;
+        complete_ = false;
+    }
+
+    bool ColumnarResultReader::read_group_header(uint64_t off, uint64_t file_size, Group& g, uint64_t& next, bool verify)
+    {
+        if (off + GROUP_HEADER > file_size) return false;
+        uint8_t h[GROUP_HEADER];
+        if (!read_at(h_, off, h, sizeof(h)) || rd_u32(h) != GROUP_MAGIC) return false;
+
+        g = Group{};
+        g.offset = off;
+        g.rows = rd_u32(h + 4);
+        g.outcome_mask = rd_u32(h + 8);
+        g.min_turn = rd_u16(h + 12);
+        g.max_turn = rd_u16(h + 14);
+        const uint64_t payload = rd_u64(h + 16);
+        const uint64_t sum = rd_u64(h + 24);
+        if (off + GROUP_HEADER + payload > file_size) return false;
+
+        uint64_t col_off = off + GROUP_HEADER, total = 0;
+        for (size_t c = 0; c < Count; ++c) {
+            const uint8_t* d = h + GROUP_FIXED + c * DIR_ENTRY;
+            if (d[0] != c || d[1] != WIDTH[c]) return false;
+            ColDir& cd = g.cols[c];
+            cd.id = d[0];
+            cd.width = d[1];
+            cd.bytes = rd_u32(d + 4);
+            cd.offset = col_off;
+            if (cd.width && cd.bytes != uint64_t(cd.width) * g.rows) return false;
+            if (!cd.width && cd.bytes < (uint64_t(g.rows) + 1) * 4) return false;
+            col_off += cd.bytes;
+            total += cd.bytes;
+        }
+        if (total != payload) return false;
+
+        if (verify) {
+            std::vector<uint8_t> buf(static_cast<size_t>(payload));
+            if (!read_at(h_, off + GROUP_HEADER, buf.data(), buf.size())) return false;
+            if (fnv1a(FNV_OFFSET, buf.data(), buf.size()) != sum) return false;
+        }
+        next = off + GROUP_HEADER + payload;
+        return true;
+    }
+
+    bool ColumnarResultReader::open(const std::string& path, std::string* error_out)
+    {
+        close();
+        h_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (h_ == INVALID_HANDLE_VALUE) {
+            if (error_out) *error_out = "Could not open result file: " + path;
+            return false;
+        }
+
+        LARGE_INTEGER sz{};
+        uint8_t hdr[HEADER_SIZE];
+        if (!GetFileSizeEx(h_, &sz) || uint64_t(sz.QuadPart) < HEADER_SIZE || !read_at(h_, 0, hdr, sizeof(hdr))
+            || rd_u32(hdr) != FILE_MAGIC || rd_u16(hdr + 4) != FILE_VERSION || rd_u16(hdr + 6) != Count) {
+            if (error_out) *error_out = "Not a result file (or another version): " + path;
+            close();
+            return false;
+        }
+        const uint64_t size = uint64_t(sz.QuadPart);
+
+        // Footer first; a crashed writer leaves none, then walk and verify the groups.
+        uint8_t tail[12];
+        if (size >= HEADER_SIZE + 8 + sizeof(tail) && read_at(h_, size - sizeof(tail), tail, sizeof(tail))
+            && rd_u32(tail + 8) == FILE_MAGIC) {
+            const uint64_t foff = rd_u64(tail);
+            uint8_t fh[8];
+            if (foff + 8 <= size && read_at(h_, foff, fh, sizeof(fh)) && rd_u32(fh) == INDEX_MAGIC
+                && foff + 8 + uint64_t(rd_u32(fh + 4)) * 8 + sizeof(tail) == size) {
+                std::vector<uint8_t> offs(size_t(rd_u32(fh + 4)) * 8);
+                if (offs.empty() || read_at(h_, foff + 8, offs.data(), offs.size())) {
+                    bool ok = true;
+                    for (size_t i = 0; ok && i < offs.size() / 8; ++i) {
+                        Group g; uint64_t next = 0;
+                        ok = read_group_header(rd_u64(offs.data() + i * 8), foff, g, next, false);
+                        if (ok) { rows_ += g.rows; groups_.push_back(g); }
+                    }
+                    if (ok) { complete_ = true; return true; }
+                    groups_.clear(); rows_ = 0;
+                }
+            }
+        }
+
+        uint64_t off = HEADER_SIZE;
+        for (;;) {
+            Group g; uint64_t next = 0;
+            if (!read_group_header(off, size, g, next, true)) break;
+            rows_ += g.rows;
+            groups_.push_back(g);
+            off = next;
+        }
+        if (off != size)
+            SCLOGW("[results] %s has no index; read %zu groups, ignoring %llu trailing bytes", path.c_str(),
+                groups_.size(), (unsigned long long)(size - off));
+        return true;
+    }
+
+    bool ColumnarResultReader::read_column(const Group& g, Column c, std::vector<uint8_t>& out)
+    {
+        out.resize(g.cols[c].bytes);
+        bytes_read_ += out.size();
+        return out.empty() || read_at(h_, g.cols[c].offset, out.data(), out.size());
+    }
+
+    bool ColumnarResultReader::scan(const ResultFilter& f, const std::function<bool(const ResultRow&)>& fn, uint32_t columns)
+    {
+        if (h_ == INVALID_HANDLE_VALUE) return false;
+
+        // Row tests only for the parts of the filter that can reject a row
+        const bool by_outcome = f.outcome_mask != 0xFFFFFFFFu;
+        const bool by_turn = f.min_turn > 0 || f.max_turn < 0xFFFF;
+        const uint32_t filter = (by_outcome ? bit(Outcome) : 0) | (by_turn ? bit(Turn) : 0)
+            | (f.ok_only ? bit(Status) : 0) | (f.pred_failed ? bit(PredFailed) : 0) | (f.hit_pc ? bit(HitPc) : 0);
+        const uint32_t read = columns | filter;
+
+        std::vector<uint8_t> c[Count];
+        std::vector<uint32_t> hits;
+        for (const Group& g : groups_) {
+            if (!(g.outcome_mask & f.outcome_mask) || g.max_turn < f.min_turn || g.min_turn > f.max_turn) continue;
+
+            // Filter columns first; the rest only for groups with a match.
+            for (uint8_t k = 0; k < Count; ++k)
+                if ((filter & bit(Column(k))) && !read_column(g, Column(k), c[k])) return false;
+
+            hits.clear();
+            for (uint32_t i = 0; i < g.rows; ++i) {
+                if (by_outcome && !(OutcomeBit(rd_u16(c[Outcome].data() + i * 2)) & f.outcome_mask)) continue;
+                if (by_turn) {
+                    const uint16_t turn = rd_u16(c[Turn].data() + i * 2);
+                    if (turn < f.min_turn || turn > f.max_turn) continue;
+                }
+                if (f.ok_only && !(c[Status][i] & 2)) continue;
+                if (f.pred_failed && rd_u32(c[PredFailed].data() + i * 4) != *f.pred_failed) continue;
+                if (f.hit_pc && rd_u32(c[HitPc].data() + i * 4) != *f.hit_pc) continue;
+                hits.push_back(i);
+            }
+            if (hits.empty()) continue;
+
+            for (uint8_t k = 0; k < Count; ++k)
+                if ((columns & ~filter & bit(Column(k))) && !read_column(g, Column(k), c[k])) return false;
+
+            ResultRow row{};
+            for (uint32_t i : hits) {
+                if (read & bit(PathId)) row.path_id = rd_u64(c[PathId].data() + size_t(i) * 8);
+                if (read & bit(Outcome)) row.outcome = rd_u16(c[Outcome].data() + size_t(i) * 2);
+                if (read & bit(Status)) row.status = c[Status][i];
+                if (read & bit(WorkerErr)) row.w_err = c[WorkerErr][i];
+                if (read & bit(Turn)) row.turn = rd_u16(c[Turn].data() + size_t(i) * 2);
+                if (read & bit(PredFailed)) row.pred_failed = rd_u32(c[PredFailed].data() + size_t(i) * 4);
+                if (read & bit(HitPc)) row.hit_pc = rd_u32(c[HitPc].data() + size_t(i) * 4);
+                if (read & bit(ElapsedMs)) row.elapsed_ms = rd_u32(c[ElapsedMs].data() + size_t(i) * 4);
+                if (read & bit(WorkerId)) row.worker_id = rd_u32(c[WorkerId].data() + size_t(i) * 4);
+                if (read & bit(Path)) {
+                    const uint8_t* offs = c[Path].data();
+                    const uint32_t b = rd_u32(offs + size_t(i) * 4), e = rd_u32(offs + size_t(i + 1) * 4);
+                    const size_t base = (size_t(g.rows) + 1) * 4;
+                    if (b > e || base + e > c[Path].size()) return false;
+                    row.path.assign(offs + base + b, offs + base + e);
+                }
+                if (!fn(row)) return true;
+            }
+        }
+        return true;
+    }
+
+    ResultAggregate ColumnarResultReader::aggregate(const ResultFilter& f, ResultGroupBy by)
+    {
+        ResultAggregate a{};
+        for (const Group& g : groups_) {
+            a.rows_scanned += g.rows;
+            if (!(g.outcome_mask & f.outcome_mask) || g.max_turn < f.min_turn || g.min_turn > f.max_turn) ++a.groups_skipped;
+        }
+        uint32_t columns = bit(ElapsedMs);
+        switch (by) {
+        case ResultGroupBy::None: break;
+        case ResultGroupBy::Outcome: columns |= bit(Outcome); break;
+        case ResultGroupBy::Turn: columns |= bit(Turn); break;
+        case ResultGroupBy::PredFailed: columns |= bit(PredFailed); break;
+        case ResultGroupBy::HitPc: columns |= bit(HitPc); break;
+        case ResultGroupBy::OutcomeTurn: columns |= bit(Outcome) | bit(Turn); break;
+        }
+        scan(f, [&](const ResultRow& r) {
+            ++a.rows_matched;
+            a.elapsed_ms_sum += r.elapsed_ms;
+            uint64_t key = 0;
+            switch (by) {
+            case ResultGroupBy::None: return true;
+            case ResultGroupBy::Outcome: key = r.outcome; break;
+            case ResultGroupBy::Turn: key = r.turn; break;
+            case ResultGroupBy::PredFailed: key = r.pred_failed; break;
+            case ResultGroupBy::HitPc: key = r.hit_pc; break;
+            case ResultGroupBy::OutcomeTurn: key = (uint64_t(r.outcome) << 16) | r.turn; break;
+            }
+            ++a.counts[key];
+            return true;
+        }, columns);
+        return a;
+    }
+
+} // namespace simcore::battleexplorer
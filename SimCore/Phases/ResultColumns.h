@@ -0,0 +1,189 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include <windows.h>
+
+#include "BattleExplorer.h"
+
+namespace simcore::battleexplorer {
+
+    // Columnar result file for exploration runs (.sccr).
+    //
+    // Results are buffered into row groups of fixed-width columns plus one blob column for the
+    // path; a full group is appended to the file and its buffers are reused, so a writer's memory
+    // is bounded by rows_per_group regardless of run size. Queries read only the columns they
+    // touch and skip whole groups whose outcome mask / turn range cannot match.
+    //
+    // File layout (little-endian):
+    //   header : u32 magic 'SCCR', u16 version, u16 column count, u64 reserved
+    //   group  : u32 magic 'RGRP', u32 rows, u32 outcome_mask, u16 min_turn, u16 max_turn,
+    //            u64 payload_bytes, u64 fnv1a(payload),
+    //            column directory { u8 id, u8 width (0 = blob), u16 reserved, u32 bytes } x columns,
+    //            payload = column data in directory order
+    //            (blob column: u32 offsets[rows + 1], then the bytes)
+    //   footer : u32 magic 'RIDX', u32 groups, u64 group offsets[groups], u64 footer offset, u32 'SCCR'
+    //
+    // The footer is written by close(). A file without one (crashed run) is read by walking the
+    // groups from the header; a torn last group fails its checksum and is ignored.
+    namespace cols {
+        constexpr uint32_t FILE_MAGIC = 0x52434353u;   // 'SCCR'
+        constexpr uint32_t GROUP_MAGIC = 0x50524752u;  // 'RGRP'
+        constexpr uint32_t INDEX_MAGIC = 0x58444952u;  // 'RIDX'
+        constexpr uint16_t FILE_VERSION = 1;
+
+        enum Column : uint8_t {
+            PathId = 0,     // u64
+            Outcome,        // u16 battle::Outcome
+            Status,         // u8  bit0 accepted, bit1 ps.ok
+            WorkerErr,      // u8  ps.w_err
+            Turn,           // u16 battle.active_turn at the end of the run
+            PredFailed,     // u32 core.pred.first_failed, NO_PRED if none
+            HitPc,          // u32 core.run.hit_pc
+            ElapsedMs,      // u32 core.run.elapsed_ms
+            WorkerId,       // u32
+            Path,           // blob, see EncodePathBlob()
+            Count
+        };
+
+        constexpr uint32_t NO_PRED = 0xFFFFFFFFu;
+
+        // Column sets for ColumnarResultReader::scan
+        constexpr uint32_t bit(Column c) { return 1u << c; }
+        constexpr uint32_t ALL_FIXED = (1u << Path) - 1;   // every column but the path blob
+        constexpr uint32_t ALL = (1u << Count) - 1;
+    }
+
+    struct ResultRow {
+        uint64_t path_id{ 0 };
+        uint16_t outcome{ 0 };
+        uint8_t  status{ 0 };
+        uint8_t  w_err{ 0 };
+        uint16_t turn{ 0 };
+        uint32_t pred_failed{ cols::NO_PRED };
+        uint32_t hit_pc{ 0 };
+        uint32_t elapsed_ms{ 0 };
+        uint32_t worker_id{ 0 };
+        std::vector<uint8_t> path;
+    };  // a scan fills only the fields of the columns it reads; the rest keep these defaults
+
+    // Blob column content: GCInputFrame, u8 turns, u32 fake_attack_count per turn, encoded turn plans.
+    void EncodePathBlob(const GCInputFrame& initial, const soa::battle::actions::BattlePath& path, std::vector<uint8_t>& out);
+    bool DecodePathBlob(const uint8_t* p, size_t n, GCInputFrame& initial, soa::battle::actions::BattlePath& path);
+
+    class ColumnarResultWriter : public IResultSink {
+    public:
+        static constexpr uint32_t DEFAULT_ROWS_PER_GROUP = 16384;
+
+        ColumnarResultWriter() = default;
+        ~ColumnarResultWriter() override;
+
+        ColumnarResultWriter(const ColumnarResultWriter&) = delete;
+        ColumnarResultWriter& operator=(const ColumnarResultWriter&) = delete;
+
+        // Truncates `path`.
+        bool open(const std::string& path, uint32_t rows_per_group = DEFAULT_ROWS_PER_GROUP, std::string* error_out = nullptr);
+        void close();  // flushes the open group and writes the footer
+        bool is_open() const { return h_ != INVALID_HANDLE_VALUE; }
+
+        void append(const ResultRow& row);
+        bool flush_group();
+
+        void on_result(const JobResult& r) override;
+        void on_run_end() override { flush_group(); }
+
+        uint64_t rows_written() const { return rows_total_; }
+        uint64_t bytes_written() const { return end_; }
+
+    private:
+        void reset_group();
+
+        HANDLE h_{ INVALID_HANDLE_VALUE };
+        std::string path_;
+        uint64_t end_{ 0 };
+        uint32_t rows_per_group_{ DEFAULT_ROWS_PER_GROUP };
+        uint64_t rows_total_{ 0 };
+        std::vector<uint64_t> group_offsets_;
+
+        // current group, one vector per column
+        uint32_t rows_{ 0 };
+        uint32_t outcome_mask_{ 0 };
+        uint16_t min_turn_{ 0xFFFF }, max_turn_{ 0 };
+        std::vector<uint64_t> c_path_id_;
+        std::vector<uint16_t> c_outcome_;
+        std::vector<uint8_t>  c_status_, c_w_err_;
+        std::vector<uint16_t> c_turn_;
+        std::vector<uint32_t> c_pred_, c_hit_pc_, c_elapsed_, c_worker_;
+        std::vector<uint32_t> c_blob_off_;
+        std::vector<uint8_t>  c_blob_;
+        std::vector<uint8_t>  scratch_;
+    };
+
+    // Row predicate for scans. Unset fields match everything.
+    struct ResultFilter {
+        uint32_t outcome_mask{ 0xFFFFFFFFu };  // bit (outcome & 31); Unknown maps to bit 31
+        std::optional<uint32_t> pred_failed;
+        std::optional<uint32_t> hit_pc;
+        uint16_t min_turn{ 0 }, max_turn{ 0xFFFF };
+        bool ok_only{ false };
+    };
+
+    enum class ResultGroupBy : uint8_t { None, Outcome, Turn, PredFailed, HitPc, OutcomeTurn };
+
+    struct ResultAggregate {
+        uint64_t rows_scanned{ 0 };
+        uint64_t rows_matched{ 0 };
+        uint64_t groups_skipped{ 0 };
+        uint64_t elapsed_ms_sum{ 0 };
+        std::map<uint64_t, uint64_t> counts;  // group key -> matching rows (OutcomeTurn: outcome << 16 | turn)
+    };
+
+    class ColumnarResultReader {
+    public:
+        ColumnarResultReader() = default;
+        ~ColumnarResultReader();
+
+        ColumnarResultReader(const ColumnarResultReader&) = delete;
+        ColumnarResultReader& operator=(const ColumnarResultReader&) = delete;
+
+        bool open(const std::string& path, std::string* error_out = nullptr);
+        void close();
+
+        uint64_t rows() const { return rows_; }
+        size_t groups() const { return groups_.size(); }
+        bool complete() const { return complete_; }  // footer present
+        uint64_t bytes_read() const { return bytes_read_; }  // column data read since open()
+
+        // Calls `fn` for each matching row, in file order. `columns` (cols::bit mask) names the fields
+        // `fn` needs. The columns the filter tests are read for every group its header does not rule
+        // out; the other requested ones only for groups with a match. `fn` returning false stops.
+        bool scan(const ResultFilter& f, const std::function<bool(const ResultRow&)>& fn, uint32_t columns = cols::ALL_FIXED);
+
+        ResultAggregate aggregate(const ResultFilter& f, ResultGroupBy by = ResultGroupBy::None);
+
+    private:
+        struct ColDir { uint8_t id; uint8_t width; uint32_t bytes; uint64_t offset; };
+        struct Group {
+            uint64_t offset{ 0 };
+            uint32_t rows{ 0 };
+            uint32_t outcome_mask{ 0 };
+            uint16_t min_turn{ 0 }, max_turn{ 0 };
+            ColDir cols[cols::Count]{};
+        };
+
+        bool read_group_header(uint64_t off, uint64_t file_size, Group& g, uint64_t& next, bool verify);
+        bool read_column(const Group& g, cols::Column c, std::vector<uint8_t>& out);
+
+        HANDLE h_{ INVALID_HANDLE_VALUE };
+        std::vector<Group> groups_;
+        uint64_t rows_{ 0 };
+        uint64_t bytes_read_{ 0 };
+        bool complete_{ false };
+    };
+
+    inline uint32_t OutcomeBit(uint16_t outcome) { return outcome == 0xFFFFu ? (1u << 31) : (1u << (outcome & 31u)); }
+
+} // namespace simcore::battleexplorer
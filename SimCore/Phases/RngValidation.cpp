@@ -0,0 +1,124 @@
+#include "RngValidation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <thread>
+#include <unordered_map>
+
+#include "../Utils/Log.h"
+#include "../Runner/IPC/Wire.h"
+
+namespace simcore {
+
+    void ScoreRngTraces(const soa::rng::Lcg& model, uint32_t max_steps, RngValidationResult& r)
+    {
+        r.pairs = r.explained = 0;
+        r.segments.clear();
+
+        std::map<std::pair<uint32_t, uint32_t>, RngSegmentStats> seg;
+        for (const auto& t : r.traces) {
+            std::vector<uint32_t> seq;
+            seq.reserve(t.size());
+            for (const auto& rd : t) seq.push_back(rd.seed);
+
+            const auto steps = soa::rng::StepsBetween(model, seq, max_steps);
+            for (size_t i = 0; i < steps.size(); ++i) {
+                ++r.pairs;
+                if (steps[i] < 0) {
+                    SCLOGD("[rngval] %08X (bp %u) -> %08X (bp %u): not within %u steps",
+                        t[i].seed, t[i].bp_key, t[i + 1].seed, t[i + 1].bp_key, max_steps);
+                    continue;
+                }
+                ++r.explained;
+                const uint32_t k = (uint32_t)steps[i];
+                auto [it, fresh] = seg.try_emplace({ t[i].bp_key, t[i + 1].bp_key });
+                RngSegmentStats& s = it->second;
+                if (fresh) { s.from_bp = t[i].bp_key; s.to_bp = t[i + 1].bp_key; s.min_steps = k; s.max_steps = k; }
+                ++s.count;
+                s.min_steps = std::min(s.min_steps, k);
+                s.max_steps = std::max(s.max_steps, k);
+                s.sum_steps += k;
+            }
+        }
+        for (auto& [key, s] : seg) r.segments.push_back(s);
+    }
+
+    RngValidationResult RunRngValidation(ParallelPhaseScriptRunner& runner, const RngValidationArgs& args)
+    {
+        RngValidationResult out{};
+        if (args.inputs.empty()) return out;
+
+        PSInit init{};
+        init.savestate_path = args.savestate_path;
+        init.default_timeout_ms = args.run_timeout_ms;
+        if (!runner.set_program(/*init_kind=*/PK_None, /*main_kind=*/PK_RngTrace, init)) {
+            SCLOGE("[rngval] Failed to set program on workers.");
+            return out;
+        }
+        if (!runner.activate_main()) {
+            SCLOGE("[rngval] Failed to activate main program.");
+            return out;
+        }
+
+        std::unordered_map<uint64_t, size_t> lookup;
+        for (size_t i = 0; i < args.inputs.size(); ++i) {
+            seedprobe::RngTraceSpec spec{};
+            spec.frame = args.inputs[i];
+            spec.reads = std::max<uint32_t>(2, args.reads_per_trace);
+            spec.run_ms = args.run_timeout_ms;
+            PSJob j{};
+            seedprobe::encode_rng_trace_payload(spec, j.payload);
+            lookup.emplace(runner.submit(j), i);
+        }
+
+        out.traces.resize(args.inputs.size());
+        while (!lookup.empty()) {
+            PRResult r{};
+            if (!runner.try_get_result(r)) {
+                if (!runner.has_active_workers()) {
+                    // Every worker is parked; the remaining traces stay empty and are not scored
+                    SCLOGE("[rngval] no worker left; %zu trace(s) not run", lookup.size());
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+            auto it = lookup.find(r.job_id);
+            if (it == lookup.end()) continue;
+            const size_t idx = it->second;
+            lookup.erase(it);
+
+            uint32_t stop = 0;
+            auto& trace = out.traces[idx];
+            if (!r.ps.ok || !seedprobe::decode_rng_trace_result(r.ps.ctx, trace, stop)) {
+                SCLOGE("[rngval] trace job %llu failed. w_err:%d", (unsigned long long)r.job_id, r.ps.w_err);
+                trace.clear();
+                continue;
+            }
+            if (stop != 0)
+                SCLOGW("[rngval] trace %zu ended after %zu reads (outcome %u)", idx, trace.size(), stop);
+        }
+
+        ScoreRngTraces(args.model, args.max_steps, out);
+        SCLOGI("[rngval] model mul=%08X add=%08X: %u/%u read pairs explained", args.model.mul, args.model.add, out.explained, out.pairs);
+        for (const auto& s : out.segments)
+            SCLOGI("[rngval]   bp %u -> %u: %u pairs, %u..%u steps (avg %.1f)", s.from_bp, s.to_bp, s.count,
+                s.min_steps, s.max_steps, double(s.sum_steps) / double(s.count));
+
+        if (!out.model_ok()) {
+            for (const auto& t : out.traces) {
+                std::vector<uint32_t> seq;
+                for (const auto& rd : t) seq.push_back(rd.seed);
+                soa::rng::Lcg fit{};
+                if (!soa::rng::FitLcg(seq, fit, args.model)) continue;
+                out.fitted = true;
+                out.fit = fit;
+                SCLOGI("[rngval] reads fit mul=%08X add=%08X; rescore with it to confirm", fit.mul, fit.add);
+                break;
+            }
+        }
+        return out;
+    }
+
+} // namespace simcore
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../Core/Input/InputPlan.h"
+#include "../Core/Memory/Soa/SoaRng.h"
+#include "../Runner/Parallel/ParallelPhaseScriptRunner.h"
+#include "Programs/SeedProbe/RngTracePayload.h"
+
+namespace simcore {
+
+    // Validation harness for the host RNG model (Core/Memory/Soa/SoaRng.h).
+    //
+    // Every input runs once from the savestate as an RngTrace job, reading RNG_SEED at successive
+    // hits of the seed/turn/action BPs. Each consecutive pair of reads must be a whole number of
+    // model steps apart; the step counts per BP segment (e.g. EndAction -> EndAction) are the rolls
+    // that stretch of game code consumes. If any pair is unexplained and the reads happen to be
+    // single steps apart, FitLcg proposes the constants that would explain them.
+
+    struct RngValidationArgs {
+        std::string savestate_path;
+        std::vector<GCInputFrame> inputs{ GCInputFrame{} };  // one trace per input
+        uint32_t reads_per_trace{ 16 };
+        uint32_t max_steps{ 100000 };        // model steps searched between two reads
+        uint32_t run_timeout_ms{ 10000 };    // per BP-to-BP segment
+        soa::rng::Lcg model{ soa::rng::kMslRand };
+    };
+
+    struct RngSegmentStats {
+        uint32_t from_bp{ 0 }, to_bp{ 0 };
+        uint32_t count{ 0 };
+        uint32_t min_steps{ 0 }, max_steps{ 0 };
+        uint64_t sum_steps{ 0 };
+    };
+
+    struct RngValidationResult {
+        std::vector<std::vector<seedprobe::RngTraceRead>> traces;   // per input, empty if its job failed
+        uint32_t pairs{ 0 };
+        uint32_t explained{ 0 };
+        std::vector<RngSegmentStats> segments;   // explained pairs by (from_bp, to_bp), sorted
+        bool fitted{ false };
+        soa::rng::Lcg fit{};                     // only when the model failed and a trace was fittable
+
+        bool model_ok() const { return pairs > 0 && explained == pairs; }
+    };
+
+    // Scores r.traces against `model` (pairs, explained, segments). Resets the previous score.
+    void ScoreRngTraces(const soa::rng::Lcg& model, uint32_t max_steps, RngValidationResult& r);
+
+    // Sets PK_RngTrace on the runner, runs one trace per input and scores them.
+    RngValidationResult RunRngValidation(ParallelPhaseScriptRunner& runner, const RngValidationArgs& args);
+
+} // namespace simcore
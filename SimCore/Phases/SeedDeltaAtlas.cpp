@@ -0,0 +1,327 @@
+#include "SeedDeltaAtlas.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace simcore {
+
+    static constexpr uint64_t FNV_OFFSET = 1469598103934665603ull;
+    static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+    static constexpr size_t HEADER_SIZE = 56;
+    static constexpr size_t RECORD_SIZE = 16;
+    static constexpr size_t DELTA_SIZE = 8;
+    static constexpr uint32_t FLAG_BASE = 1u;
+
+    static inline uint64_t fnv1a(uint64_t h, const uint8_t* p, size_t n) {
+        for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= FNV_PRIME; }
+        return h;
+    }
+
+    static inline void put_u16(std::vector<uint8_t>& b, uint16_t v) { b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8)); }
+    static inline void put_u32(std::vector<uint8_t>& b, uint32_t v) {
+        b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8)); b.push_back(uint8_t(v >> 16)); b.push_back(uint8_t(v >> 24));
+    }
+    static inline void put_u64(std::vector<uint8_t>& b, uint64_t v) { put_u32(b, uint32_t(v)); put_u32(b, uint32_t(v >> 32)); }
+    static inline uint16_t rd_u16(const uint8_t* d) { return uint16_t(d[0]) | (uint16_t(d[1]) << 8); }
+    static inline uint32_t rd_u32(const uint8_t* d) {
+        return uint32_t(d[0]) | (uint32_t(d[1]) << 8) | (uint32_t(d[2]) << 16) | (uint32_t(d[3]) << 24);
+    }
+    static inline uint64_t rd_u64(const uint8_t* d) { return uint64_t(rd_u32(d)) | (uint64_t(rd_u32(d + 4)) << 32); }
+
+    static inline long long signed_delta(uint32_t a, uint32_t b) {
+        return (long long)(int32_t)a - (long long)(int32_t)b;
+    }
+
+    uint64_t SeedAtlasFrameKey(const GCInputFrame& f)
+    {
+        return uint64_t(f.main_x) | (uint64_t(f.main_y) << 8) | (uint64_t(f.c_x) << 16) | (uint64_t(f.c_y) << 24)
+            | (uint64_t(f.trig_l) << 32) | (uint64_t(f.trig_r) << 40) | (uint64_t(f.buttons) << 48);
+    }
+
+    GCInputFrame SeedAtlasFrameFromKey(uint64_t k)
+    {
+        GCInputFrame f{};
+        f.main_x = uint8_t(k);       f.main_y = uint8_t(k >> 8);
+        f.c_x = uint8_t(k >> 16);    f.c_y = uint8_t(k >> 24);
+        f.trig_l = uint8_t(k >> 32); f.trig_r = uint8_t(k >> 40);
+        f.buttons = uint16_t(k >> 48);
+        return f;
+    }
+
+    std::string SeedAtlasPath(const std::string& dir, uint64_t key)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.scsa", (unsigned long long)key);
+        return (std::filesystem::path(dir) / name).string();
+    }
+
+    void BuildSeedAtlasImage(uint64_t key, bool has_base, uint32_t base_seed,
+        const std::vector<SeedAtlasSample>& samples, std::vector<uint8_t>& out)
+    {
+        std::map<uint64_t, uint32_t> by_key;
+        for (const auto& s : samples) by_key[SeedAtlasFrameKey(s.input)] = s.seed;
+
+        std::vector<uint8_t> body;
+        body.reserve(by_key.size() * (RECORD_SIZE + DELTA_SIZE));
+        std::vector<std::pair<int32_t, uint32_t>> index;
+        uint32_t i = 0;
+        for (const auto& [k, seed] : by_key) {
+            const int32_t d = has_base ? (int32_t)signed_delta(seed, base_seed) : 0;
+            put_u64(body, k);
+            put_u32(body, seed);
+            put_u32(body, uint32_t(d));
+            if (has_base) index.emplace_back(d, i);
+            ++i;
+        }
+        std::sort(index.begin(), index.end());
+        for (const auto& [d, r] : index) { put_u32(body, uint32_t(d)); put_u32(body, r); }
+
+        out.clear();
+        out.reserve(HEADER_SIZE + body.size());
+        put_u32(out, SEED_ATLAS_MAGIC);
+        put_u16(out, SEED_ATLAS_VERSION);
+        put_u16(out, uint16_t(HEADER_SIZE));
+        put_u64(out, key);
+        put_u32(out, base_seed);
+        put_u32(out, has_base ? FLAG_BASE : 0u);
+        put_u32(out, uint32_t(by_key.size()));
+        put_u32(out, uint32_t(index.size()));
+        put_u64(out, body.size());
+        put_u64(out, fnv1a(FNV_OFFSET, body.data(), body.size()));
+        put_u64(out, 0);
+        out.insert(out.end(), body.begin(), body.end());
+    }
+
+    SeedDeltaAtlas::~SeedDeltaAtlas() { close(); }
+
+    bool SeedDeltaAtlas::attach(const uint8_t* data, size_t size, uint64_t expected_key, std::string* error_out)
+    {
+        auto fail = [&](const char* why) {
+            if (error_out) *error_out = why;
+            data_ = nullptr; size_ = 0; records_ = deltas_ = 0;
+            return false;
+        };
+        if (!data || size < HEADER_SIZE || rd_u32(data) != SEED_ATLAS_MAGIC) return fail("not a seed atlas");
+        if (rd_u16(data + 4) != SEED_ATLAS_VERSION || rd_u16(data + 6) != HEADER_SIZE) return fail("seed atlas of another version");
+
+        const uint64_t key = rd_u64(data + 8);
+        if (expected_key && key != expected_key) return fail("seed atlas belongs to another savestate");
+
+        const uint32_t records = rd_u32(data + 24), deltas = rd_u32(data + 28);
+        const uint64_t body = rd_u64(data + 32);
+        if (body != uint64_t(records) * RECORD_SIZE + uint64_t(deltas) * DELTA_SIZE || HEADER_SIZE + body != size)
+            return fail("seed atlas size mismatch");
+        if (fnv1a(FNV_OFFSET, data + HEADER_SIZE, size_t(body)) != rd_u64(data + 40))
+            return fail("seed atlas checksum mismatch");
+
+        data_ = data;
+        size_ = size;
+        key_ = key;
+        base_seed_ = rd_u32(data + 16);
+        has_base_ = (rd_u32(data + 20) & FLAG_BASE) != 0;
+        records_ = records;
+        deltas_ = deltas;
+        rec_ = data + HEADER_SIZE;
+        idx_ = rec_ + size_t(records) * RECORD_SIZE;
+        return true;
+    }
+
+#if defined(_WIN32)
+
+    bool SeedDeltaAtlas::open(const std::string& path, uint64_t expected_key, std::string* error_out)
+    {
+        close();
+        HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, NULL);
+        if (f == INVALID_HANDLE_VALUE) {
+            if (error_out) *error_out = "Could not open seed atlas: " + path;
+            return false;
+        }
+        LARGE_INTEGER sz{};
+        if (!GetFileSizeEx(f, &sz) || sz.QuadPart <= 0) {
+            CloseHandle(f);
+            if (error_out) *error_out = "Empty seed atlas: " + path;
+            return false;
+        }
+        HANDLE m = CreateFileMappingA(f, NULL, PAGE_READONLY, 0, 0, NULL);
+        const void* v = m ? MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!v) {
+            if (m) CloseHandle(m);
+            CloseHandle(f);
+            if (error_out) *error_out = "Could not map seed atlas: " + path;
+            return false;
+        }
+        file_ = f;
+        map_ = m;
+        if (!attach(static_cast<const uint8_t*>(v), size_t(sz.QuadPart), expected_key, error_out)) {
+            UnmapViewOfFile(v);
+            unmap();
+            return false;
+        }
+        return true;
+    }
+
+    void SeedDeltaAtlas::unmap()
+    {
+        if (map_ && data_) UnmapViewOfFile(data_);
+        if (map_) CloseHandle((HANDLE)map_);
+        if (file_) CloseHandle((HANDLE)file_);
+        map_ = nullptr;
+        file_ = nullptr;
+    }
+
+#else
+
+    bool SeedDeltaAtlas::open(const std::string& path, uint64_t expected_key, std::string* error_out)
+    {
+        close();
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            if (error_out) *error_out = "Could not open seed atlas: " + path;
+            return false;
+        }
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            if (error_out) *error_out = "Empty seed atlas: " + path;
+            return false;
+        }
+        void* v = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (v == MAP_FAILED) {
+            if (error_out) *error_out = "Could not map seed atlas: " + path;
+            return false;
+        }
+        map_ = v;
+        file_ = reinterpret_cast<void*>(uintptr_t(st.st_size));
+        if (!attach(static_cast<const uint8_t*>(v), size_t(st.st_size), expected_key, error_out)) {
+            unmap();
+            return false;
+        }
+        return true;
+    }
+
+    void SeedDeltaAtlas::unmap()
+    {
+        if (map_) munmap(map_, size_t(uintptr_t(file_)));
+        map_ = nullptr;
+        file_ = nullptr;
+    }
+
+#endif
+
+    void SeedDeltaAtlas::close()
+    {
+        unmap();
+        data_ = nullptr;
+        size_ = 0;
+        key_ = 0;
+        has_base_ = false;
+        base_seed_ = 0;
+        records_ = deltas_ = 0;
+        rec_ = idx_ = nullptr;
+    }
+
+    bool SeedDeltaAtlas::find(const GCInputFrame& f, uint32_t& seed) const
+    {
+        const uint64_t k = SeedAtlasFrameKey(f);
+        size_t lo = 0, hi = records_;
+        while (lo < hi) {
+            const size_t mid = (lo + hi) / 2;
+            const uint64_t mk = rd_u64(rec_ + mid * RECORD_SIZE);
+            if (mk < k) lo = mid + 1;
+            else hi = mid;
+        }
+        if (lo >= records_ || rd_u64(rec_ + lo * RECORD_SIZE) != k) return false;
+        seed = rd_u32(rec_ + lo * RECORD_SIZE + 8);
+        return true;
+    }
+
+    std::vector<GCInputFrame> SeedDeltaAtlas::frames_for_delta(int32_t delta, size_t max_frames) const
+    {
+        std::vector<GCInputFrame> out;
+        size_t lo = 0, hi = deltas_;
+        while (lo < hi) {
+            const size_t mid = (lo + hi) / 2;
+            if ((int32_t)rd_u32(idx_ + mid * DELTA_SIZE) < delta) lo = mid + 1;
+            else hi = mid;
+        }
+        for (size_t i = lo; i < deltas_ && out.size() < max_frames; ++i) {
+            if ((int32_t)rd_u32(idx_ + i * DELTA_SIZE) != delta) break;
+            const uint32_t r = rd_u32(idx_ + i * DELTA_SIZE + 4);
+            if (r < records_) out.push_back(SeedAtlasFrameFromKey(rd_u64(rec_ + size_t(r) * RECORD_SIZE)));
+        }
+        return out;
+    }
+
+    bool SeedDeltaAtlas::has_delta(int32_t delta) const
+    {
+        return !frames_for_delta(delta, 1).empty();
+    }
+
+    std::vector<int32_t> SeedDeltaAtlas::deltas() const
+    {
+        std::vector<int32_t> out;
+        for (size_t i = 0; i < deltas_; ++i) {
+            const int32_t d = (int32_t)rd_u32(idx_ + i * DELTA_SIZE);
+            if (out.empty() || out.back() != d) out.push_back(d);
+        }
+        return out;
+    }
+
+    void SeedDeltaAtlas::samples(std::vector<SeedAtlasSample>& out) const
+    {
+        out.reserve(out.size() + records_);
+        for (size_t i = 0; i < records_; ++i) {
+            const uint8_t* r = rec_ + i * RECORD_SIZE;
+            out.push_back(SeedAtlasSample{ SeedAtlasFrameFromKey(rd_u64(r)), rd_u32(r + 8) });
+        }
+    }
+
+    bool SeedDeltaAtlas::save_merged(const std::string& path, uint64_t key, bool has_base, uint32_t base_seed,
+        const std::vector<SeedAtlasSample>& fresh, std::string* error_out)
+    {
+        std::vector<SeedAtlasSample> all;
+        if (is_open() && key_ == key) samples(all);
+        if (!has_base && is_open() && has_base_) { has_base = true; base_seed = base_seed_; }
+        all.insert(all.end(), fresh.begin(), fresh.end());
+
+        std::vector<uint8_t> image;
+        BuildSeedAtlasImage(key, has_base, base_seed, all, image);
+        close();  // a mapped file cannot be replaced on Windows
+
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        const fs::path dst(path), tmp(path + ".tmp");
+        if (dst.has_parent_path()) fs::create_directories(dst.parent_path(), ec);
+        {
+            std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+            f.write(reinterpret_cast<const char*>(image.data()), std::streamsize(image.size()));
+            if (!f.good()) {
+                if (error_out) *error_out = "Could not write seed atlas: " + tmp.string();
+                return false;
+            }
+        }
+        fs::rename(tmp, dst, ec);
+        if (ec) {
+            fs::remove(tmp, ec);
+            if (error_out) *error_out = "Could not replace seed atlas: " + path;
+            return false;
+        }
+        return open(path, key, error_out);
+    }
+
+} // namespace simcore
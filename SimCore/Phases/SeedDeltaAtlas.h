@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../Core/Input/InputPlan.h"
+
+namespace simcore {
+
+    // Persisted frame -> seed samples for one savestate (.scsa).
+    //
+    // The seed read at AfterRandSeedSet is a pure function of the savestate and the input frame, so
+    // every successful probe (grid, adaptive or combo) is kept and later sessions only emulate the
+    // frames the atlas does not answer. The file is read through a read-only mapping; lookups are
+    // binary searches over the mapped arrays and nothing is copied on open.
+    //
+    // File layout (little-endian, fixed width):
+    //   header  : u32 magic 'SCSA', u16 version, u16 header bytes, u64 savestate key,
+    //             u32 base_seed, u32 flags (bit0: base_seed valid), u32 records, u32 deltas,
+    //             u64 body bytes, u64 fnv1a(body), u64 reserved
+    //   records : { u64 frame key, u32 seed, s32 delta } x records, sorted by frame key
+    //   deltas  : { s32 delta, u32 record } x deltas, sorted by (delta, record)
+    //
+    // delta is the signed seed difference to base_seed; without a base there is no delta index.
+    // Writes go to "<path>.tmp" and are renamed over the old file, so a reader never sees a torn one.
+
+    constexpr uint32_t SEED_ATLAS_MAGIC = 0x41534353u;   // 'SCSA'
+    constexpr uint16_t SEED_ATLAS_VERSION = 1;
+
+    struct SeedAtlasSample {
+        GCInputFrame input{};
+        uint32_t seed{ 0 };
+    };
+
+    // buttons << 48 | main_x, main_y, c_x, c_y, trig_l, trig_r from the low byte up.
+    uint64_t SeedAtlasFrameKey(const GCInputFrame& f);
+    GCInputFrame SeedAtlasFrameFromKey(uint64_t key);
+
+    // "<dir>/<key as 16 hex digits>.scsa"; the key is the caller's savestate identity.
+    std::string SeedAtlasPath(const std::string& dir, uint64_t key);
+
+    // Serializes `samples` (later duplicates win) into a complete file image.
+    void BuildSeedAtlasImage(uint64_t key, bool has_base, uint32_t base_seed,
+        const std::vector<SeedAtlasSample>& samples, std::vector<uint8_t>& out);
+
+    class SeedDeltaAtlas {
+    public:
+        SeedDeltaAtlas() = default;
+        ~SeedDeltaAtlas();
+
+        SeedDeltaAtlas(const SeedDeltaAtlas&) = delete;
+        SeedDeltaAtlas& operator=(const SeedDeltaAtlas&) = delete;
+
+        // Maps `path` and validates it against `expected_key` (0: accept any key).
+        bool open(const std::string& path, uint64_t expected_key, std::string* error_out = nullptr);
+
+        // Validates an image already in memory; `data` must outlive the atlas.
+        bool attach(const uint8_t* data, size_t size, uint64_t expected_key, std::string* error_out = nullptr);
+
+        void close();
+        bool is_open() const { return data_ != nullptr; }
+
+        uint64_t key() const { return key_; }
+        bool has_base() const { return has_base_; }
+        uint32_t base_seed() const { return base_seed_; }
+        size_t size() const { return records_; }
+
+        bool find(const GCInputFrame& f, uint32_t& seed) const;
+
+        // Frames whose seed is base_seed + delta, in frame key order; at most `max_frames`.
+        std::vector<GCInputFrame> frames_for_delta(int32_t delta, size_t max_frames = SIZE_MAX) const;
+        bool has_delta(int32_t delta) const;
+
+        // Every distinct delta, sorted.
+        std::vector<int32_t> deltas() const;
+
+        void samples(std::vector<SeedAtlasSample>& out) const;
+
+        // Merges `fresh` into the atlas at `path` (written atomically) and reopens it.
+        bool save_merged(const std::string& path, uint64_t key, bool has_base, uint32_t base_seed,
+            const std::vector<SeedAtlasSample>& fresh, std::string* error_out = nullptr);
+
+    private:
+        void unmap();
+
+        const uint8_t* data_{ nullptr };
+        size_t size_{ 0 };
+        void* map_{ nullptr };      // platform mapping handle / base, null when attached
+        void* file_{ nullptr };
+
+        uint64_t key_{ 0 };
+        bool has_base_{ false };
+        uint32_t base_seed_{ 0 };
+        uint32_t records_{ 0 };
+        uint32_t deltas_{ 0 };
+        const uint8_t* rec_{ nullptr };
+        const uint8_t* idx_{ nullptr };
+    };
+
+} // namespace simcore
@@ -0,0 +1,168 @@
+#include "SeedDeltaRefiner.h"
+
+#include <algorithm>
+
+namespace simcore {
+
+    bool SeedRegionMap::at(int x, int y, int32_t& out) const
+    {
+        if (!contains(x, y)) return false;
+        const size_t i = size_t(y - minv) * size_t(side()) + size_t(x - minv);
+        if (i >= ok.size() || !ok[i]) return false;
+        out = delta[i];
+        return true;
+    }
+
+    SeedDeltaRefiner::SeedDeltaRefiner(int minv, int maxv, int initial_per_axis)
+    {
+        minv_ = std::clamp(std::min(minv, maxv), 0, 255);
+        maxv_ = std::clamp(std::max(minv, maxv), 0, 255);
+        side_ = maxv_ - minv_ + 1;
+        state_.assign(size_t(side_) * size_t(side_), Unknown);
+        delta_.assign(state_.size(), 0);
+
+        // Same spacing as the fixed lattice, so an adaptive run starts from the points a dense one samples
+        const int n = std::clamp(initial_per_axis, 2, side_ < 2 ? 2 : side_);
+        std::vector<uint8_t> at;
+        for (int i = 0; i < n; ++i) {
+            const int v = minv_ + (int)((int64_t)(maxv_ - minv_) * i / (n - 1));
+            if (at.empty() || at.back() != v) at.push_back(uint8_t(v));
+        }
+        if (at.size() == 1) at.push_back(at.front());
+
+        for (size_t j = 0; j + 1 < at.size(); ++j)
+            for (size_t i = 0; i + 1 < at.size(); ++i) {
+                const Cell c{ at[i], at[j], at[i + 1], at[j + 1] };
+                open_.push_back(c);
+                request(c.x0, c.y0); request(c.x1, c.y0);
+                request(c.x0, c.y1); request(c.x1, c.y1);
+            }
+    }
+
+    void SeedDeltaRefiner::request(int x, int y)
+    {
+        uint8_t& s = state_[idx(x, y)];
+        if (s != Unknown) return;
+        s = Requested;
+        pending_.push_back(SeedPoint{ uint8_t(x), uint8_t(y) });
+    }
+
+    void SeedDeltaRefiner::record(uint8_t x, uint8_t y, bool ok, int32_t delta)
+    {
+        if (x < minv_ || x > maxv_ || y < minv_ || y > maxv_) return;
+        const size_t i = idx(x, y);
+        if (state_[i] != Ok && state_[i] != Failed) ++samples_;
+        state_[i] = ok ? Ok : Failed;
+        delta_[i] = ok ? delta : 0;
+    }
+
+    bool SeedDeltaRefiner::same(int ax, int ay, int bx, int by) const
+    {
+        const size_t a = idx(ax, ay), b = idx(bx, by);
+        return state_[a] == state_[b] && delta_[a] == delta_[b];
+    }
+
+    bool SeedDeltaRefiner::edges_agree(const Cell& c) const
+    {
+        for (int x = c.x0; x <= c.x1; ++x) {
+            if (known(x, c.y0) && !same(x, c.y0, c.x0, c.y0)) return false;
+            if (known(x, c.y1) && !same(x, c.y1, c.x0, c.y0)) return false;
+        }
+        for (int y = c.y0 + 1; y < c.y1; ++y) {
+            if (known(c.x0, y) && !same(c.x0, y, c.x0, c.y0)) return false;
+            if (known(c.x1, y) && !same(c.x1, y, c.x0, c.y0)) return false;
+        }
+        return true;
+    }
+
+    size_t SeedDeltaRefiner::refine()
+    {
+        pending_.erase(std::remove_if(pending_.begin(), pending_.end(),
+            [&](const SeedPoint& p) { return known(p.x, p.y); }), pending_.end());
+        const size_t before = pending_.size();
+
+        std::vector<Cell> work;
+        work.swap(open_);
+
+        // A neighbour refined since these were classified may have sampled a disagreeing edge point
+        auto keep = std::partition(uniform_.begin(), uniform_.end(), [&](const Cell& c) { return edges_agree(c); });
+        work.insert(work.end(), keep, uniform_.end());
+        uniform_.erase(keep, uniform_.end());
+
+        while (!work.empty()) {
+            const Cell c = work.back();
+            work.pop_back();
+
+            if (!known(c.x0, c.y0) || !known(c.x1, c.y0) || !known(c.x0, c.y1) || !known(c.x1, c.y1)) {
+                open_.push_back(c);
+                continue;
+            }
+            // Failed corners say nothing about the points between them, so they never make a cell uniform
+            if (state_[idx(c.x0, c.y0)] == Ok
+                && same(c.x1, c.y0, c.x0, c.y0) && same(c.x0, c.y1, c.x0, c.y0) && same(c.x1, c.y1, c.x0, c.y0)
+                && edges_agree(c)) {
+                uniform_.push_back(c);
+                continue;
+            }
+
+            const bool sx = c.x1 - c.x0 > 1, sy = c.y1 - c.y0 > 1;
+            if (!sx && !sy) {
+                exact_.push_back(c);
+                continue;
+            }
+            const uint8_t xm = sx ? uint8_t((c.x0 + c.x1) / 2) : c.x1;
+            const uint8_t ym = sy ? uint8_t((c.y0 + c.y1) / 2) : c.y1;
+            Cell kids[4];
+            size_t k = 0;
+            kids[k++] = Cell{ c.x0, c.y0, xm, ym };
+            if (sx) kids[k++] = Cell{ xm, c.y0, c.x1, ym };
+            if (sy) kids[k++] = Cell{ c.x0, ym, xm, c.y1 };
+            if (sx && sy) kids[k++] = Cell{ xm, ym, c.x1, c.y1 };
+            for (size_t i = 0; i < k; ++i) {
+                const Cell& n = kids[i];
+                request(n.x0, n.y0); request(n.x1, n.y0);
+                request(n.x0, n.y1); request(n.x1, n.y1);
+                work.push_back(n);
+            }
+        }
+        return pending_.size() - before;
+    }
+
+    SeedRegionMap SeedDeltaRefiner::build_map() const
+    {
+        SeedRegionMap m{};
+        m.minv = minv_;
+        m.maxv = maxv_;
+        m.samples = samples_;
+        m.delta.assign(state_.size(), 0);
+        m.ok.assign(state_.size(), 0);
+
+        for (const Cell& c : uniform_) {
+            const size_t i0 = idx(c.x0, c.y0);
+            const bool ok = state_[i0] == Ok;
+            m.regions.push_back(SeedRegion{ c.x0, c.y0, c.x1, c.y1, delta_[i0], ok, true });
+            for (int y = c.y0; y <= c.y1; ++y)
+                for (int x = c.x0; x <= c.x1; ++x) {
+                    m.delta[idx(x, y)] = delta_[i0];
+                    m.ok[idx(x, y)] = ok;
+                }
+        }
+        for (const Cell& c : exact_) {
+            const size_t i0 = idx(c.x0, c.y0);
+            m.regions.push_back(SeedRegion{ c.x0, c.y0, c.x1, c.y1, delta_[i0], state_[i0] == Ok, false });
+        }
+        // Samples are ground truth, including edge points shared with a uniform neighbour
+        for (size_t i = 0; i < state_.size(); ++i) {
+            if (state_[i] != Ok && state_[i] != Failed) continue;
+            m.delta[i] = delta_[i];
+            m.ok[i] = state_[i] == Ok;
+        }
+
+        std::sort(m.regions.begin(), m.regions.end(), [](const SeedRegion& a, const SeedRegion& b) {
+            if (a.y0 != b.y0) return a.y0 < b.y0;
+            return a.x0 < b.x0;
+            });
+        return m;
+    }
+
+} // namespace simcore
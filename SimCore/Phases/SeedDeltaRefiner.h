@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace simcore {
+
+    // Adaptive refinement of one input family's seed response over [minv, maxv]^2.
+    //
+    // The response to a stick/trigger position is piecewise constant, so a cell whose four corners
+    // produced the same delta is taken to be uniform and is not sampled further. A cell with
+    // differing corners, or with a corner that failed to reach the seed read, is split at its
+    // midpoints (only along axes longer than one step) until it is unit sized, at which point every
+    // position inside it has been sampled. The refiner starts from
+    // an initial_per_axis lattice and hands out batches of positions: sample every pending() point,
+    // record() each outcome, refine(), repeat until pending() is empty. Uniform cells are re-checked
+    // against samples that later land on their edges (by a refined neighbour) and reopened if one
+    // disagrees.
+
+    struct SeedPoint {
+        uint8_t x{ 0 }, y{ 0 };
+    };
+
+    // One leaf cell, bounds inclusive. Leaves of a map share their edges.
+    struct SeedRegion {
+        uint8_t x0{ 0 }, y0{ 0 }, x1{ 0 }, y1{ 0 };
+        int32_t delta{ 0 };
+        bool ok{ false };       // false: the first corner did not reach the seed read (unit cells only)
+        bool uniform{ false };  // false: unit cell with differing or failed corners, every point is a sample
+    };
+
+    // Complete map of one family: a delta for every position in [minv, maxv]^2.
+    struct SeedRegionMap {
+        int minv{ 0 }, maxv{ 0 };
+        std::vector<SeedRegion> regions;
+        std::vector<int32_t> delta;   // (maxv - minv + 1)^2, row-major by y
+        std::vector<uint8_t> ok;
+        uint32_t samples{ 0 };        // emulator runs spent on this family
+
+        int side() const { return maxv - minv + 1; }
+        bool contains(int x, int y) const { return x >= minv && x <= maxv && y >= minv && y <= maxv; }
+        bool at(int x, int y, int32_t& out) const;  // false outside the range or where the sample failed
+    };
+
+    class SeedDeltaRefiner {
+    public:
+        SeedDeltaRefiner(int minv, int maxv, int initial_per_axis);
+
+        const std::vector<SeedPoint>& pending() const { return pending_; }
+        bool done() const { return pending_.empty(); }
+
+        // Outcome of a pending point; points outside the range are ignored.
+        void record(uint8_t x, uint8_t y, bool ok, int32_t delta);
+
+        // Classifies every cell whose corners are known and returns the number of new pending points.
+        // Unrecorded pending points stay pending.
+        size_t refine();
+
+        uint32_t samples() const { return samples_; }
+
+        // Leaves and the dense map. Only meaningful once done().
+        SeedRegionMap build_map() const;
+
+    private:
+        enum : uint8_t { Unknown = 0, Requested, Ok, Failed };
+        struct Cell { uint8_t x0, y0, x1, y1; };
+
+        size_t idx(int x, int y) const { return size_t(y - minv_) * size_t(side_) + size_t(x - minv_); }
+        bool known(int x, int y) const { const uint8_t s = state_[idx(x, y)]; return s == Ok || s == Failed; }
+        bool same(int ax, int ay, int bx, int by) const;
+        bool edges_agree(const Cell& c) const;
+        void request(int x, int y);
+
+        int minv_{ 0 }, maxv_{ 0 }, side_{ 0 };
+        std::vector<uint8_t> state_;
+        std::vector<int32_t> delta_;
+        std::vector<Cell> open_;       // corners not all known yet
+        std::vector<Cell> uniform_;    // leaves with agreeing corners
+        std::vector<Cell> exact_;      // unit leaves with differing corners
+        std::vector<SeedPoint> pending_;
+        uint32_t samples_{ 0 };
+    };
+
+} // namespace simcore
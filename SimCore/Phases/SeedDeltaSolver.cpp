@@ -0,0 +1,167 @@
+#include "SeedDeltaSolver.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+
+namespace simcore {
+
+    namespace {
+
+        using Point = std::array<uint8_t, 2>;
+
+        // One family's delta -> points, points ordered by distance to their centroid
+        struct FamilyTable {
+            std::map<int32_t, std::vector<Point>> by_delta;
+
+            const std::vector<Point>* find(int32_t d) const {
+                auto it = by_delta.find(d);
+                return it == by_delta.end() ? nullptr : &it->second;
+            }
+            uint32_t support(int32_t d) const {
+                const auto* v = find(d);
+                return v ? (uint32_t)v->size() : 0u;
+            }
+        };
+
+        FamilyTable build_table(const RandSeedProbeResult& grid, SeedFamily fam)
+        {
+            FamilyTable t{};
+            for (const auto& e : grid.entries) {
+                if (e.family != fam || !e.ok) continue;
+                t.by_delta[(int32_t)e.delta].push_back({ e.x, e.y });
+            }
+            for (auto& [d, pts] : t.by_delta) {
+                double cx = 0, cy = 0;
+                for (const auto& p : pts) { cx += p[0]; cy += p[1]; }
+                cx /= double(pts.size()); cy /= double(pts.size());
+                std::stable_sort(pts.begin(), pts.end(), [&](const Point& a, const Point& b) {
+                    const double da = (a[0] - cx) * (a[0] - cx) + (a[1] - cy) * (a[1] - cy);
+                    const double db = (b[0] - cx) * (b[0] - cx) + (b[1] - cy) * (b[1] - cy);
+                    return da < db;
+                    });
+            }
+            // A zero delta is always available as the neutral value, grid point or not
+            t.by_delta.emplace(0, std::vector<Point>{});
+            return t;
+        }
+
+        struct DeltaTriple {
+            int32_t jd, cd, td;
+            uint32_t nonzero;
+            uint32_t min_support;
+            uint64_t magnitude;
+        };
+
+        bool better(const DeltaTriple& a, const DeltaTriple& b)
+        {
+            if (a.nonzero != b.nonzero) return a.nonzero < b.nonzero;
+            if (a.min_support != b.min_support) return a.min_support > b.min_support;
+            if (a.magnitude != b.magnitude) return a.magnitude < b.magnitude;
+            return std::tie(a.jd, a.cd, a.td) < std::tie(b.jd, b.cd, b.td);
+        }
+
+        void set_component(GCInputFrame& f, SeedFamily fam, const Point& p)
+        {
+            switch (fam) {
+            case SeedFamily::Main:     f.main_x = p[0]; f.main_y = p[1]; break;
+            case SeedFamily::CStick:   f.c_x = p[0];    f.c_y = p[1];    break;
+            case SeedFamily::Triggers: f.trig_l = p[0]; f.trig_r = p[1]; break;
+            default: break;
+            }
+        }
+
+        uint64_t frame_key(const GCInputFrame& f)
+        {
+            return uint64_t(f.main_x) | (uint64_t(f.main_y) << 8) | (uint64_t(f.c_x) << 16) | (uint64_t(f.c_y) << 24)
+                | (uint64_t(f.trig_l) << 32) | (uint64_t(f.trig_r) << 40);
+        }
+
+    } // namespace
+
+    SeedComboPlan PlanSeedDeltaCombos(const RandSeedProbeResult& grid, uint32_t max_candidates_per_target)
+    {
+        SeedComboPlan plan{};
+        const FamilyTable J = build_table(grid, SeedFamily::Main);
+        const FamilyTable C = build_table(grid, SeedFamily::CStick);
+        const FamilyTable T = build_table(grid, SeedFamily::Triggers);
+
+        std::set<int32_t> singletons{ 0 };
+        for (const auto& e : grid.entries)
+            if (e.ok) singletons.insert((int32_t)e.delta);
+        plan.singletons.assign(singletons.begin(), singletons.end());
+
+        // J+C sums, built once
+        std::unordered_map<int32_t, std::vector<std::pair<int32_t, int32_t>>> jc;
+        for (const auto& [jd, jp] : J.by_delta)
+            for (const auto& [cd, cp] : C.by_delta)
+                jc[jd + cd].emplace_back(jd, cd);
+
+        std::set<int32_t> targets;
+        for (const auto& [s, pairs] : jc)
+            for (const auto& [td, tp] : T.by_delta)
+                if (!singletons.count(s + td)) targets.insert(s + td);
+
+        const uint32_t cap = std::max<uint32_t>(1, max_candidates_per_target);
+        auto support_of = [](const FamilyTable& f, int32_t d) { return d == 0 ? ~0u : f.support(d); };
+
+        plan.targets.reserve(targets.size());
+        for (int32_t t : targets) {
+            SeedComboTarget out{};
+            out.target = t;
+
+            // Two-sum join: t = (dJ + dC) + dT; keep the best `cap` delta triples
+            std::vector<DeltaTriple> best;
+            for (const auto& [td, tp] : T.by_delta) {
+                auto it = jc.find(t - td);
+                if (it == jc.end()) continue;
+                for (const auto& [jd, cd] : it->second) {
+                    ++out.delta_triples;
+                    DeltaTriple d{ jd, cd, td,
+                        uint32_t(jd != 0) + uint32_t(cd != 0) + uint32_t(td != 0),
+                        std::min({ support_of(J, jd), support_of(C, cd), support_of(T, td) }),
+                        uint64_t(std::llabs(jd)) + uint64_t(std::llabs(cd)) + uint64_t(std::llabs(td)) };
+                    if (best.size() < cap) {
+                        best.push_back(d);
+                        std::push_heap(best.begin(), best.end(), better);   // worst on top
+                    }
+                    else if (better(d, best.front())) {
+                        std::pop_heap(best.begin(), best.end(), better);
+                        best.back() = d;
+                        std::push_heap(best.begin(), best.end(), better);
+                    }
+                }
+            }
+            std::sort_heap(best.begin(), best.end(), better);
+
+            // Concrete frames: rank r uses each component's r-th closest-to-centroid point
+            std::set<uint64_t> seen;
+            for (size_t r = 0; out.candidates.size() < cap; ++r) {
+                bool any = false;
+                for (const auto& d : best) {
+                    if (out.candidates.size() >= cap) break;
+                    const auto* jp = J.find(d.jd);
+                    const auto* cp = C.find(d.cd);
+                    const auto* tp = T.find(d.td);
+                    const size_t depth = std::max({ d.jd ? jp->size() : 0, d.cd ? cp->size() : 0, d.td ? tp->size() : 0 });
+                    if (r >= std::max<size_t>(depth, 1)) continue;
+                    any = true;
+
+                    SeedComboCandidate c{ d.jd, d.cd, d.td, GCInputFrame{} };
+                    if (d.jd) set_component(c.input, SeedFamily::Main, (*jp)[std::min(r, jp->size() - 1)]);
+                    if (d.cd) set_component(c.input, SeedFamily::CStick, (*cp)[std::min(r, cp->size() - 1)]);
+                    if (d.td) set_component(c.input, SeedFamily::Triggers, (*tp)[std::min(r, tp->size() - 1)]);
+                    if (seen.insert(frame_key(c.input)).second) out.candidates.push_back(c);
+                }
+                if (!any) break;
+            }
+            plan.targets.push_back(std::move(out));
+        }
+        return plan;
+    }
+
+} // namespace simcore
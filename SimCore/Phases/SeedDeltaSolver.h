@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "RNGSeedDeltaMap.h"
+
+namespace simcore {
+
+    // Exact planning for RunFindSeedDeltaCombos.
+    //
+    // From the probe grid each family (J = main stick, C = C-stick, T = triggers) gets a table
+    // delta -> grid points realizing it. Every J+C sum goes into a hash table once; a target t is
+    // then joined against it as t - dT for each trigger delta (two-sum), which yields every
+    // (dJ, dC, dT) that predicts t under additivity, without sampling. Candidates are ranked so the
+    // most likely additive combinations are verified first:
+    //   1. fewer non-zero components (a zero component stays at its neutral value),
+    //   2. larger support: the rarest component delta is realized by more grid points,
+    //   3. smaller |dJ| + |dC| + |dT|.
+    // A component's concrete coordinates are the realizing point closest to the centroid of its
+    // region; later ranks reuse delta triples with the next-closest points.
+
+    struct SeedComboCandidate {
+        int32_t jd{ 0 }, cd{ 0 }, td{ 0 };
+        GCInputFrame input{};
+    };
+
+    struct SeedComboTarget {
+        int32_t target{ 0 };
+        uint64_t delta_triples{ 0 };                  // all (dJ, dC, dT) summing to target
+        std::vector<SeedComboCandidate> candidates;   // best first, at most max_candidates
+    };
+
+    struct SeedComboPlan {
+        std::vector<int32_t> singletons;          // deltas the grid already realizes (incl. 0), sorted
+        std::vector<SeedComboTarget> targets;     // every reachable sum that is not a singleton, sorted
+    };
+
+    SeedComboPlan PlanSeedDeltaCombos(const RandSeedProbeResult& grid, uint32_t max_candidates_per_target);
+
+} // namespace simcore
@@ -0,0 +1,107 @@
+#include "TasMovieVariants.h"
+
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <unordered_map>
+
+#include "../Utils/Log.h"
+#include "../Runner/IPC/Wire.h"
+#include "../Tas/DtmCheckpoints.h"
+#include "Programs/PlayTasMovie/TasMoviePayload.h"
+
+namespace simcore::tas_movie {
+
+    // Submits items [first, last), each resuming from the deepest checkpoint now on disk, and waits for them.
+    static void run_wave(ParallelPhaseScriptRunner& runner, const VariantArgs& args, VariantResult& out, size_t first, size_t last)
+    {
+        tas::DtmCheckpointIndex index;
+        if (!args.checkpoint_dir.empty()) index.scan(args.checkpoint_dir);
+
+        std::unordered_map<uint64_t, size_t> lookup;
+        for (size_t i = first; i < last; ++i) {
+            VariantItem& it = out.items[i];
+
+            tasmovie::EncodeSpec spec{};
+            spec.dtm_path = it.dtm_path;
+            spec.save_dir = args.out_dir;
+            spec.vi_stall_ms = args.vi_stall_ms;
+            spec.save_on_fail = args.save_on_fail;
+            spec.checkpoint_dir = args.checkpoint_dir;
+            spec.checkpoint_every_vi = args.checkpoint_dir.empty() ? 0 : args.checkpoint_every_vi;
+
+            tas::DtmFile movie;
+            tas::DtmCheckpoint c{};
+            if (index.size() && movie.load(it.dtm_path) && index.find_resume(movie, c)) {
+                spec.resume_state = c.path;
+                it.resumed_from = c.path;
+                it.resumed_frame = c.frame;
+            }
+
+            PSJob job{};
+            if (!tasmovie::encode_payload(spec, job.payload)) {
+                SCLOGW("[tas] skip %s: payload encode failed", it.dtm_path.c_str());
+                continue;
+            }
+            it.job_id = runner.submit(job);
+            lookup.emplace(it.job_id, i);
+        }
+
+        while (!lookup.empty()) {
+            PRResult r{};
+            if (!runner.try_get_result(r)) {
+                if (!runner.has_active_workers()) {
+                    // Every worker is parked; the rest keep ok=false
+                    SCLOGE("[tas] no worker left; %zu movie(s) not run", lookup.size());
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                continue;
+            }
+            auto f = lookup.find(r.job_id);
+            if (f == lookup.end()) continue;
+            VariantItem& it = out.items[f->second];
+            lookup.erase(f);
+
+            it.ok = r.ps.ok;
+            it.ctx = std::move(r.ps.ctx);
+            if (!it.ok) continue;
+            ++out.succeeded;
+            if (!it.resumed_from.empty()) {
+                ++out.resumed;
+                out.frames_skipped += it.resumed_frame;
+            }
+        }
+    }
+
+    VariantResult RunTasMovieVariants(ParallelPhaseScriptRunner& runner, const VariantArgs& args)
+    {
+        VariantResult out{};
+        if (args.dtms.empty()) return out;
+
+        PSInit init{};
+        init.savestate_path = "";
+        init.default_timeout_ms = 600000;
+        if (!runner.set_program(/*init_kind=*/PK_None, /*main_kind=*/PK_TasMovie, init)) { SCLOGE("[tas] set_program failed"); return out; }
+        if (!runner.activate_main()) { SCLOGE("[tas] activate_main failed"); return out; }
+
+        std::error_code ec;
+        std::filesystem::create_directories(args.out_dir, ec);
+
+        out.items.resize(args.dtms.size());
+        for (size_t i = 0; i < args.dtms.size(); ++i) {
+            out.items[i].dtm_path = args.dtms[i];
+            out.items[i].save_path = tasmovie::derive_save_path(args.dtms[i], args.out_dir);
+        }
+
+        // The seed run has to finish before its checkpoints can be resumed from
+        const size_t seed = args.checkpoint_dir.empty() ? 0 : 1;
+        if (seed) run_wave(runner, args, out, 0, 1);
+        run_wave(runner, args, out, seed, out.items.size());
+
+        SCLOGI("[tas] %zu/%zu movies ok, %zu resumed from checkpoints (%llu frames skipped)",
+            out.succeeded, out.items.size(), out.resumed, (unsigned long long)out.frames_skipped);
+        return out;
+    }
+
+} // namespace simcore::tas_movie
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../Runner/Parallel/ParallelPhaseScriptRunner.h"
+
+namespace simcore::tas_movie {
+
+    // Input-variant sweeps over PK_TasMovie with checkpointed playback (Tas/DtmCheckpoints.h).
+    //
+    // The first movie runs alone and leaves a savestate every checkpoint_every_vi frames in
+    // checkpoint_dir; every other movie then resumes from the deepest checkpoint on its own input
+    // prefix (if any) and adds checkpoints of its own past that point. Checkpoints persist across
+    // calls, so a later sweep over the same movies starts with them.
+
+    struct VariantArgs {
+        std::vector<std::string> dtms;         // the first one seeds the checkpoints
+        std::string out_dir;                   // result states, <stem>.sav
+        std::string checkpoint_dir;            // empty => plain playback from the start
+        uint32_t checkpoint_every_vi{ 600 };
+        uint32_t vi_stall_ms{ 2000 };
+        bool save_on_fail{ true };
+    };
+
+    struct VariantItem {
+        std::string dtm_path;
+        std::string save_path;
+        std::string resumed_from;              // checkpoint the job started from, empty if none
+        uint64_t resumed_frame{ 0 };
+        uint64_t job_id{ 0 };
+        bool ok{ false };
+        PSContext ctx;
+    };
+
+    struct VariantResult {
+        std::vector<VariantItem> items;        // in args.dtms order
+        size_t succeeded{ 0 };
+        size_t resumed{ 0 };
+        uint64_t frames_skipped{ 0 };          // movie frames not re-emulated thanks to checkpoints
+    };
+
+    VariantResult RunTasMovieVariants(ParallelPhaseScriptRunner& runner, const VariantArgs& args);
+
+} // namespace simcore::tas_movie
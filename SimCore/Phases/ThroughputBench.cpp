@@ -0,0 +1,114 @@
+#include "ThroughputBench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "../Utils/Log.h"
+#include "../Runner/IPC/Wire.h"
+#include "Programs/SeedProbe/SeedProbePayload.h"
+
+namespace simcore {
+
+    static ViBenchRow run_pass(const ViBenchArgs& a, size_t n, bool pinned)
+    {
+        ViBenchRow row{};
+        row.workers = n;
+        row.pinned = pinned;
+
+        BootPlan boot = a.boot;
+        boot.agents.clear();
+        boot.affinity = pinned ? a.affinity : cpu::AffinityPolicy{};
+
+        ParallelPhaseScriptRunner runner{ n };
+        const auto tb = std::chrono::steady_clock::now();
+        if (!runner.start(boot)) {
+            row.boot_ok = false;
+            return row;
+        }
+        row.dedicated = runner.placement().dedicated;
+        for (;;) {
+            const auto st = runner.status();
+            const auto waited = std::chrono::steady_clock::now() - tb;
+            if (st.ready_workers >= st.running_workers || waited > std::chrono::minutes(2)) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        row.boot_ms = (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - tb).count();
+
+        PSInit init{};
+        init.savestate_path = a.savestate_path;
+        init.default_timeout_ms = a.run_timeout_ms;
+        if (!runner.set_program(PK_None, PK_SeedProbe, init) || !runner.activate_main()) {
+            SCLOGE("[bench] program setup failed (%zu workers)", n);
+            row.boot_ok = false;
+            runner.stop();
+            return row;
+        }
+
+        // Distinct inputs so no layer can answer a job from an earlier one
+        const size_t total = n * std::max<uint32_t>(a.jobs_per_worker, 1);
+        auto submit = [&](size_t i) {
+            seedprobe::EncodeSpec spec{};
+            spec.frame.main_x = uint8_t(0x30 + (i % 0xA0));
+            spec.frame.main_y = uint8_t(0x30 + ((i / 0xA0) % 0xA0));
+            spec.run_ms = a.run_timeout_ms;
+            PSJob j{};
+            seedprobe::encode_payload(spec, j.payload);
+            runner.submit(j);
+        };
+
+        runner.reset_tail_stats();
+        const auto t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < total; ++i) submit(i);
+
+        size_t done = 0;
+        while (done < total) {
+            PRResult r{};
+            if (!runner.try_get_result(r)) {
+                if (!runner.has_active_workers()) {
+                    SCLOGE("[bench] no worker left; %zu job(s) not run", total - done);
+                    row.jobs_failed += total - done;
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                continue;
+            }
+            ++done;
+            uint32_t vi0 = 0, vi1 = 0;
+            if (r.accepted && r.ps.ok && r.ps.ctx.get<uint32_t>(keys::core::VI_FIRST, vi0)
+                && r.ps.ctx.get<uint32_t>(keys::core::VI_LAST, vi1) && vi1 >= vi0) {
+                ++row.jobs_ok;
+                row.vi_fields += vi1 - vi0;
+            }
+            else ++row.jobs_failed;
+        }
+        row.wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        const auto ts = runner.tail_stats();
+        row.p50_ms = ts.p50_ms;
+        row.p99_ms = ts.p99_ms;
+        runner.stop();
+
+        if (row.wall_s > 0.0) {
+            row.vi_per_s = double(row.vi_fields) / row.wall_s;
+            row.vi_per_s_per_worker = row.vi_per_s / double(n);
+        }
+        SCLOGI("[bench] workers=%zu pinned=%d dedicated=%u boot=%ums jobs=%llu/%zu vi=%llu wall=%.2fs -> %.0f VI/s (%.0f per worker)",
+            n, pinned ? 1 : 0, row.dedicated, row.boot_ms, (unsigned long long)row.jobs_ok, total,
+            (unsigned long long)row.vi_fields, row.wall_s, row.vi_per_s, row.vi_per_s_per_worker);
+        return row;
+    }
+
+    std::vector<ViBenchRow> RunViThroughputBench(const ViBenchArgs& args, const std::function<void(const ViBenchRow&)>& on_row)
+    {
+        std::vector<ViBenchRow> rows;
+        for (size_t n : args.worker_counts) {
+            if (n == 0) continue;
+            for (int pass = args.compare_unpinned ? 0 : 1; pass < 2; ++pass) {
+                rows.push_back(run_pass(args, n, pass == 1));
+                if (on_row) on_row(rows.back());
+            }
+        }
+        return rows;
+    }
+
+} // namespace simcore
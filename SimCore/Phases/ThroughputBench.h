@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../Runner/Parallel/ParallelPhaseScriptRunner.h"
+
+namespace simcore {
+
+    // Emulation throughput of a local worker pool: for each worker count (and, optionally, with and
+    // without CPU placement) a fresh pool runs jobs_per_worker SeedProbe jobs per worker from the
+    // savestate, and the emulated VI fields (VI_LAST - VI_FIRST of every job) are divided by the
+    // wall time of the batch. Pool boot and program setup are outside the timed window; boot is
+    // reported separately as the time until every worker is READY.
+    struct ViBenchArgs {
+        BootPlan boot;                        // iso / Dolphin base / user dir / shared_user_base; agents and affinity are ignored
+        std::string savestate_path;
+        std::vector<size_t> worker_counts{ 1, 2, 4, 8 };
+        bool compare_unpinned{ true };        // also run every count without placement
+        cpu::AffinityPolicy affinity{ true }; // placement for the pinned passes
+        uint32_t jobs_per_worker{ 8 };
+        uint32_t run_timeout_ms{ 10000 };
+    };
+
+    struct ViBenchRow {
+        size_t workers{ 0 };
+        bool pinned{ false };
+        uint32_t dedicated{ 0 };     // workers that got their own core
+        uint32_t boot_ms{ 0 };       // start() until all workers READY
+        uint64_t jobs_ok{ 0 };
+        uint64_t jobs_failed{ 0 };
+        uint64_t vi_fields{ 0 };
+        double wall_s{ 0.0 };
+        double vi_per_s{ 0.0 };
+        double vi_per_s_per_worker{ 0.0 };
+        uint32_t p50_ms{ 0 };
+        uint32_t p99_ms{ 0 };
+        bool boot_ok{ true };
+    };
+
+    // Rows in (worker count, unpinned, pinned) order; on_row is called as each pass finishes.
+    std::vector<ViBenchRow> RunViThroughputBench(const ViBenchArgs& args,
+        const std::function<void(const ViBenchRow&)>& on_row = {});
+
+} // namespace simcore
@@ -3,42 +3,29 @@
 
 namespace bp {
 
-    static const BPRec kAll[] = {
-    #define ROW(ns, NAME, ID, PC, STR) { static_cast<BPKey>(ID), static_cast<uint32_t>(PC), STR },
-    BP_TABLE_ALL(ROW)
-    #undef ROW
-    };
-
-    std::span<const BPRec> BPRegistry::all() {
-        return std::span<const BPRec>(kAll, sizeof(kAll) / sizeof(kAll[0]));
-    }
-
-    const BPRec* BPRegistry::find(BPKey k) {
-        for (const auto& r : kAll) if (r.key == k) return &r;
-        return nullptr;
-    }
-
-    std::optional<BPKey> BPRegistry::match(uint32_t pc) {
-        for (const auto& r : kAll) if (r.pc == pc) return r.key;
-        return std::nullopt;
-    }
-
-    const char* BPRegistry::name(BPKey k) {
-        if (auto* r = find(k)) return r->name;
-        return "";
-    }
-
-    uint32_t BPRegistry::pc(BPKey k) {
-        if (auto* r = find(k)) return r->pc;
-        return 0u;
+    // find/match answer from the constexpr indexes; check them against plain scans once, at build time.
+    static constexpr bool indexes_match_scans() {
+        for (const auto& r : detail::kAll) {
+            const BPRec* first_key = nullptr;
+            const BPRec* first_pc = nullptr;
+            for (const auto& x : detail::kAll) {
+                if (!first_key && x.key == r.key) first_key = &x;
+                if (!first_pc && x.pc == r.pc) first_pc = &x;
+            }
+            if (BPRegistry::find(r.key) != first_key) return false;
+            if (BPRegistry::match(r.pc) != first_pc->key) return false;
+        }
+        return !BPRegistry::find(0) && !BPRegistry::match(0xFFFFFFFFu);
     }
+    static_assert(indexes_match_scans(), "BPRegistry indexes disagree with the table");
 
     BreakpointMap BPRegistry::as_map() {
         BreakpointMap m;
-        m.addrs.reserve(sizeof(kAll) / sizeof(kAll[0]));
-        for (const auto& r : kAll) m.addrs.push_back(BPAddr{ r.key, r.pc, r.name });
+        m.addrs.reserve(detail::kCount);
+        for (const auto& r : detail::kAll) m.addrs.push_back(BPAddr{ r.key, r.pc, r.name });
         m.start_key = 0;  // leave to caller if they need it
         m.terminal_key = 0;
+        m.reindex();
         return m;
     }
 
@@ -100,6 +87,7 @@ namespace bp {
                 }
             }
         }
+        base.reindex();
         return base;
     }
 
@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <cstdint>
 #include <optional>
 #include <string_view>
@@ -6,6 +7,7 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <unordered_map>
 
 #include "BP.def.h"
 
@@ -25,14 +27,45 @@ struct BreakpointMap
     BPKey start_key{ 0 };
     BPKey terminal_key{ 0 };
 
+    // Key -> slot and PC -> slot indexes over `addrs`, built by reindex() (as_map() and load_bpmap_file()
+    // call it). After editing `addrs` by hand call reindex() again; until then a lookup the index misses,
+    // or whose slot no longer fits, falls back to scanning, so an entry edited in place is still found.
+    // A PC shared by several keys resolves to the first, as before.
+    void reindex() {
+        key_slot_.clear();
+        pc_slot_.clear();
+        pc_slot_.reserve(addrs.size());
+        for (size_t i = 0; i < addrs.size(); ++i) {
+            const BPKey k = addrs[i].key;
+            if (k >= key_slot_.size()) key_slot_.resize(size_t(k) + 1, kNoSlot);
+            if (key_slot_[k] == kNoSlot) key_slot_[k] = static_cast<uint16_t>(i);
+            pc_slot_.emplace(addrs[i].pc, static_cast<uint16_t>(i));
+        }
+        indexed_ = addrs.size();
+    }
+
     const BPAddr* find(BPKey k) const {
+        if (indexed_ == addrs.size()) {
+            const uint16_t s = k < key_slot_.size() ? key_slot_[k] : kNoSlot;
+            if (s != kNoSlot && addrs[s].key == k) return &addrs[s];
+        }
         for (const auto& a : addrs) if (a.key == k) return &a;
         return nullptr;
     }
     std::optional<BPKey> match(uint32_t pc) const {
+        if (indexed_ == addrs.size()) {
+            const auto it = pc_slot_.find(pc);
+            if (it != pc_slot_.end() && addrs[it->second].pc == pc) return addrs[it->second].key;
+        }
         for (const auto& a : addrs) if (a.pc == pc) return a.key;
         return std::nullopt;
     }
+
+private:
+    static constexpr uint16_t kNoSlot = 0xFFFF;
+    std::vector<uint16_t> key_slot_;
+    std::unordered_map<uint32_t, uint16_t> pc_slot_;
+    size_t indexed_{ SIZE_MAX };
 };
 
 // Central, X-macro driven dataset
@@ -50,13 +83,59 @@ namespace bp {
         return BPDomain::Unknown;
     }
 
+    namespace detail {
+        inline constexpr BPRec kAll[] = {
+#define ROW(ns, NAME, ID, PC, STR) { static_cast<BPKey>(ID), static_cast<uint32_t>(PC), STR },
+            BP_TABLE_ALL(ROW)
+#undef ROW
+        };
+        inline constexpr size_t kCount = sizeof(kAll) / sizeof(kAll[0]);
+        inline constexpr uint8_t kNoRow = 0xFF;
+        static_assert(kCount < kNoRow, "row indexes are stored as u8");
+
+        constexpr size_t max_key() {
+            size_t m = 0;
+            for (const auto& r : kAll) m = r.key > m ? r.key : m;
+            return m;
+        }
+
+        // key -> row, kNoRow where no breakpoint has that id (keys are sparse but small)
+        inline constexpr auto kKeyRow = [] {
+            std::array<uint8_t, max_key() + 1> t{};
+            for (auto& v : t) v = kNoRow;
+            for (size_t i = 0; i < kCount; ++i) if (t[kAll[i].key] == kNoRow) t[kAll[i].key] = static_cast<uint8_t>(i);
+            return t;
+        }();
+
+        // Open-addressed PC -> row table, load factor <= 1/2; the first row with a PC wins, as in a scan.
+        inline constexpr size_t kPcBuckets = [] { size_t n = 16; while (n < kCount * 2) n <<= 1; return n; }();
+        constexpr size_t pc_bucket(uint32_t pc) { return size_t(((pc >> 2) * 0x9E3779B1u) >> 7) & (kPcBuckets - 1); }
+        inline constexpr auto kPcRow = [] {
+            std::array<uint8_t, kPcBuckets> t{};
+            for (auto& v : t) v = kNoRow;
+            for (size_t i = 0; i < kCount; ++i) {
+                size_t b = pc_bucket(kAll[i].pc);
+                while (t[b] != kNoRow && kAll[t[b]].pc != kAll[i].pc) b = (b + 1) & (kPcBuckets - 1);
+                if (t[b] == kNoRow) t[b] = static_cast<uint8_t>(i);
+            }
+            return t;
+        }();
+    }
+
     class BPRegistry {
     public:
-        static std::span<const BPRec> all();
-        static const BPRec* find(BPKey k);
-        static std::optional<BPKey> match(uint32_t pc);
-        static const char* name(BPKey k);
-        static uint32_t pc(BPKey k);
+        static constexpr std::span<const BPRec> all() { return std::span<const BPRec>(detail::kAll, detail::kCount); }
+        static constexpr const BPRec* find(BPKey k) {
+            if (k >= detail::kKeyRow.size() || detail::kKeyRow[k] == detail::kNoRow) return nullptr;
+            return &detail::kAll[detail::kKeyRow[k]];
+        }
+        static constexpr std::optional<BPKey> match(uint32_t pc) {
+            for (size_t b = detail::pc_bucket(pc); detail::kPcRow[b] != detail::kNoRow; b = (b + 1) & (detail::kPcBuckets - 1))
+                if (detail::kAll[detail::kPcRow[b]].pc == pc) return detail::kAll[detail::kPcRow[b]].key;
+            return std::nullopt;
+        }
+        static constexpr const char* name(BPKey k) { const auto* r = find(k); return r ? r->name : ""; }
+        static constexpr uint32_t pc(BPKey k) { const auto* r = find(k); return r ? r->pc : 0u; }
         static BreakpointMap as_map();
     };
 
@@ -91,6 +91,14 @@ namespace simcore::pred {
         void set_turn(const uint8_t turn) {if ( turn > 0 && turn <= 32) turn_mask = turn_mask | (1 << (turn - 1)); }
     };
 
+    // Turn gating shared by the VM and the explorer: bit (t-1) selects battle turn t (1..32).
+    // Turn 0 (run-up to the first input window) and turns past 32 only see every-turn predicates.
+    inline constexpr bool applies_to_turn(uint32_t turn_mask, uint32_t turn) {
+        const uint32_t m = turn_mask ? turn_mask : 0xFFFFFFFFu;
+        if (turn >= 1 && turn <= 32) return (m & (1u << (turn - 1))) != 0;
+        return m == 0xFFFFFFFFu;
+    }
+
     // One-and-done builder: fills records and returns packed program blob.
     bool BuildTable(const std::vector<Spec>& specs,
         std::vector<PredicateRecord>& out_records,
@@ -0,0 +1,105 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Coordinator <-> SimCoreWorkerAgent protocol (TCP, little-endian, packed).
+//
+// Every message is an AgentFrame followed by `len` body bytes. An agent hosts `slots` worker
+// processes; SLOT_DATA carries the unmodified Wire.h byte stream of one slot in either direction,
+// so SimCoreWorker and ProcessWorker's protocol handling are the same as for local pipes.
+// Files the workers need (ISO, savestates) travel by content hash: the coordinator asks the agent
+// to STAGE a hash, the agent FETCHes it in chunks unless its cache already has it, then reports
+// the local path that the coordinator substitutes into the worker-facing message.
+
+namespace simcore {
+
+    constexpr uint32_t AGENT_MAGIC = 0x54474153u;  // 'SAGT'
+    constexpr uint16_t AGENT_PROTO_VERSION = 1;
+    constexpr uint16_t AGENT_DEFAULT_PORT = 47710;
+    constexpr uint32_t AGENT_FILE_CHUNK = 1u << 20;
+
+    enum : uint8_t {
+        AG_HELLO = 0x01,        // agent -> coord, on connect: AgentHello
+        AG_HEARTBEAT = 0x02,    // both ways, empty body; any frame counts as liveness
+        AG_OPEN_SLOT = 0x10,    // coord -> agent: AgentOpenSlot; (re)spawns the slot's worker
+        AG_CLOSE_SLOT = 0x11,   // coord -> agent: empty; kills the slot's worker
+        AG_SLOT_STATUS = 0x12,  // agent -> coord: AgentSlotStatus
+        AG_SLOT_DATA = 0x13,    // both ways: raw Wire.h bytes for `slot`
+        AG_STAGE_FILE = 0x20,   // coord -> agent: AgentStageFile
+        AG_FILE_READY = 0x21,   // agent -> coord: AgentFileReady
+        AG_FETCH = 0x22,        // agent -> coord: AgentFetch
+        AG_FILE_DATA = 0x23,    // coord -> agent: AgentFileData + bytes
+    };
+
+    enum : uint8_t {
+        AGSLOT_Opened = 1,
+        AGSLOT_OpenFailed = 2,
+        AGSLOT_Exited = 3,      // worker process ended; code = exit code
+    };
+
+#pragma pack(push, 1)
+    struct AgentFrame {
+        uint8_t  tag;
+        uint8_t  reserved[3];
+        uint32_t slot;          // slot index for slot messages, request id for file messages
+        uint32_t len;           // body bytes following
+    };
+    static_assert(sizeof(AgentFrame) == 12, "AgentFrame must be 12 bytes");
+
+    struct AgentHello {
+        uint32_t magic;         // AGENT_MAGIC
+        uint16_t version;       // AGENT_PROTO_VERSION
+        uint16_t slots;
+        char     name[64];      // host name, for logs
+    };
+
+    struct AgentOpenSlot {
+        uint32_t worker_id;     // coordinator-wide id, used for the agent-side user dir and logs
+        uint64_t iso_hash;      // staged beforehand with AG_STAGE_FILE
+        uint32_t seq;           // echoed in AgentSlotStatus; reports for older incarnations are ignored
+    };
+
+    // Sent for an open (Opened/OpenFailed) and when a worker ends on its own (Exited); a worker
+    // retired by OPEN_SLOT/CLOSE_SLOT is not reported. SLOT_DATA of a slot is only valid after Opened.
+    struct AgentSlotStatus {
+        uint8_t  state;         // AGSLOT_*
+        uint32_t code;
+        uint32_t seq;
+    };
+
+    struct AgentStageFile {
+        uint64_t hash;          // HashFileContents() of the coordinator's file
+        uint64_t size;
+        char     ext[16];       // extension kept on the cached copy (".iso", ".sav"); see agent_ext_ok
+    };
+
+    struct AgentFileReady {
+        uint64_t hash;
+        uint8_t  ok;
+        char     path[260];     // agent-local path of the cached copy
+    };
+
+    struct AgentFetch {
+        uint64_t hash;
+        uint64_t offset;
+    };
+
+    struct AgentFileData {
+        uint64_t hash;
+        uint64_t offset;
+        uint8_t  ok;            // 0: coordinator cannot serve this hash (len == sizeof(AgentFileData))
+    };
+#pragma pack(pop)
+
+    // AgentStageFile::ext ends up in an agent-side file name: empty, or '.' plus up to 8 alphanumerics.
+    inline bool agent_ext_ok(const char* ext, size_t n) {
+        if (n == 0) return true;
+        if (n < 2 || n > 9 || ext[0] != '.') return false;
+        for (size_t i = 1; i < n; ++i) {
+            const char c = ext[i];
+            if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))) return false;
+        }
+        return true;
+    }
+
+} // namespace simcore
@@ -0,0 +1,195 @@
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include "TcpSocket.h"
+#include <mutex>
+#include <algorithm>
+#include "../../Utils/Log.h"
+
+#pragma comment(lib, "Ws2_32.lib")
+
+namespace simcore {
+
+    static bool ensure_wsa() {
+        static std::once_flag once;
+        static bool ok = false;
+        std::call_once(once, [] {
+            WSADATA wsa{};
+            ok = WSAStartup(MAKEWORD(2, 2), &wsa) == 0;
+            if (!ok) SCLOGE("[net] WSAStartup failed");
+        });
+        return ok;
+    }
+
+    static std::string wsa_error(const char* what) {
+        return std::string(what) + " failed (wsa=" + std::to_string(WSAGetLastError()) + ")";
+    }
+
+    static void set_common_opts(SOCKET s) {
+        BOOL one = TRUE;
+        setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&one), sizeof(one));  // small control frames
+        setsockopt(s, SOL_SOCKET, SO_KEEPALIVE, reinterpret_cast<const char*>(&one), sizeof(one));
+    }
+
+    TcpSocket& TcpSocket::operator=(TcpSocket&& o) noexcept
+    {
+        if (this != &o) {
+            close();
+            s_ = o.s_;
+            o.s_ = INVALID;
+        }
+        return *this;
+    }
+
+    bool TcpSocket::connect(const std::string& host, uint16_t port, uint32_t timeout_ms, std::string* error_out)
+    {
+        close();
+        if (!ensure_wsa()) { if (error_out) *error_out = "WSAStartup failed"; return false; }
+
+        addrinfo hints{};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_protocol = IPPROTO_TCP;
+        addrinfo* res = nullptr;
+        if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &res) != 0 || !res) {
+            if (error_out) *error_out = "cannot resolve " + host;
+            return false;
+        }
+
+        SOCKET s = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+        if (s == INVALID_SOCKET) { freeaddrinfo(res); if (error_out) *error_out = wsa_error("socket"); return false; }
+
+        // Non-blocking connect so an unreachable agent costs timeout_ms, not the OS default (~20 s)
+        u_long nb = 1;
+        ioctlsocket(s, FIONBIO, &nb);
+        int rc = ::connect(s, res->ai_addr, (int)res->ai_addrlen);
+        freeaddrinfo(res);
+        if (rc == SOCKET_ERROR && WSAGetLastError() != WSAEWOULDBLOCK) {
+            if (error_out) *error_out = wsa_error("connect");
+            closesocket(s);
+            return false;
+        }
+        if (rc == SOCKET_ERROR) {
+            fd_set wr; FD_ZERO(&wr); FD_SET(s, &wr);
+            fd_set ex; FD_ZERO(&ex); FD_SET(s, &ex);
+            timeval tv{ (long)(timeout_ms / 1000), (long)((timeout_ms % 1000) * 1000) };
+            rc = select(0, nullptr, &wr, &ex, &tv);
+            if (rc <= 0 || FD_ISSET(s, &ex)) {
+                if (error_out) *error_out = rc == 0 ? "connect timed out" : "connection refused";
+                closesocket(s);
+                return false;
+            }
+        }
+        nb = 0;
+        ioctlsocket(s, FIONBIO, &nb);
+
+        set_common_opts(s);
+        s_ = (Handle)s;
+        return true;
+    }
+
+    bool TcpSocket::listen(uint16_t port, bool loopback_only, std::string* error_out)
+    {
+        close();
+        if (!ensure_wsa()) { if (error_out) *error_out = "WSAStartup failed"; return false; }
+
+        SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (s == INVALID_SOCKET) { if (error_out) *error_out = wsa_error("socket"); return false; }
+
+        BOOL excl = TRUE;
+        setsockopt(s, SOL_SOCKET, SO_EXCLUSIVEADDRUSE, reinterpret_cast<const char*>(&excl), sizeof(excl));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(loopback_only ? INADDR_LOOPBACK : INADDR_ANY);
+        if (bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR) {
+            if (error_out) *error_out = wsa_error("bind");
+            closesocket(s);
+            return false;
+        }
+        if (::listen(s, SOMAXCONN) == SOCKET_ERROR) {
+            if (error_out) *error_out = wsa_error("listen");
+            closesocket(s);
+            return false;
+        }
+        s_ = (Handle)s;
+        return true;
+    }
+
+    bool TcpSocket::accept(TcpSocket& out, uint32_t timeout_ms)
+    {
+        if (!valid()) return false;
+        if (timeout_ms && !wait_readable(timeout_ms)) return false;
+
+        SOCKET c = ::accept((SOCKET)s_, nullptr, nullptr);
+        if (c == INVALID_SOCKET) return false;
+        set_common_opts(c);
+        out = TcpSocket((Handle)c);
+        return true;
+    }
+
+    bool TcpSocket::send_all(const void* p, size_t n)
+    {
+        const char* b = static_cast<const char*>(p);
+        while (n) {
+            const int w = send((SOCKET)s_, b, (int)std::min<size_t>(n, 1u << 30), 0);
+            if (w == SOCKET_ERROR || w == 0) return false;
+            b += w; n -= (size_t)w;
+        }
+        return true;
+    }
+
+    bool TcpSocket::recv_all(void* p, size_t n)
+    {
+        char* b = static_cast<char*>(p);
+        while (n) {
+            const int r = recv((SOCKET)s_, b, (int)std::min<size_t>(n, 1u << 30), 0);
+            if (r == SOCKET_ERROR || r == 0) return false;
+            b += r; n -= (size_t)r;
+        }
+        return true;
+    }
+
+    bool TcpSocket::wait_readable(uint32_t timeout_ms)
+    {
+        if (!valid()) return false;
+        fd_set rd; FD_ZERO(&rd); FD_SET((SOCKET)s_, &rd);
+        timeval tv{ (long)(timeout_ms / 1000), (long)((timeout_ms % 1000) * 1000) };
+        return select(0, &rd, nullptr, nullptr, &tv) > 0;
+    }
+
+    void TcpSocket::shutdown()
+    {
+        if (valid()) ::shutdown((SOCKET)s_, SD_BOTH);
+    }
+
+    void TcpSocket::close()
+    {
+        if (!valid()) return;
+        closesocket((SOCKET)s_);
+        s_ = INVALID;
+    }
+
+    std::string TcpSocket::peer() const
+    {
+        sockaddr_in a{}; int len = sizeof(a);
+        if (!valid() || getpeername((SOCKET)s_, reinterpret_cast<sockaddr*>(&a), &len) != 0) return "?";
+        char buf[INET_ADDRSTRLEN]{};
+        inet_ntop(AF_INET, &a.sin_addr, buf, sizeof(buf));
+        return std::string(buf) + ":" + std::to_string(ntohs(a.sin_port));
+    }
+
+    bool ParseEndpoint(const std::string& s, std::string& host, uint16_t& port)
+    {
+        const size_t colon = s.rfind(':');
+        if (colon == std::string::npos || colon == 0 || colon + 1 >= s.size()) return false;
+        unsigned long p = 0;
+        try { p = std::stoul(s.substr(colon + 1)); }
+        catch (...) { return false; }
+        if (p == 0 || p > 65535) return false;
+        host = s.substr(0, colon);
+        port = (uint16_t)p;
+        return true;
+    }
+
+} // namespace simcore
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace simcore {
+
+    // Blocking TCP stream (Winsock). Move-only; closes on destruction.
+    // Reads/writes loop until the full length is transferred, like the pipe helpers in ProcessWorker.
+    // winsock2.h stays out of this header: it must precede windows.h, which most of SimCore includes first.
+    class TcpSocket {
+    public:
+        using Handle = uintptr_t;  // SOCKET
+        static constexpr Handle INVALID = ~Handle(0);
+
+        TcpSocket() = default;
+        explicit TcpSocket(Handle s) : s_(s) {}
+        ~TcpSocket() { close(); }
+
+        TcpSocket(TcpSocket&& o) noexcept : s_(o.s_) { o.s_ = INVALID; }
+        TcpSocket& operator=(TcpSocket&& o) noexcept;
+        TcpSocket(const TcpSocket&) = delete;
+        TcpSocket& operator=(const TcpSocket&) = delete;
+
+        // Resolves host (name or dotted quad) and connects, giving up after timeout_ms.
+        bool connect(const std::string& host, uint16_t port, uint32_t timeout_ms, std::string* error_out = nullptr);
+        // Binds and listens on all interfaces (or loopback only).
+        bool listen(uint16_t port, bool loopback_only, std::string* error_out = nullptr);
+        // Waits up to timeout_ms (0: forever) for a connection; false on timeout or error.
+        bool accept(TcpSocket& out, uint32_t timeout_ms);
+
+        bool send_all(const void* p, size_t n);
+        bool recv_all(void* p, size_t n);
+        // Waits until data is readable (true) or timeout_ms elapses / the socket fails (false).
+        bool wait_readable(uint32_t timeout_ms);
+
+        // Unblocks a recv()/accept() in another thread; the socket stays allocated until close().
+        void shutdown();
+        void close();
+
+        bool valid() const { return s_ != INVALID; }
+        std::string peer() const;
+
+    private:
+        Handle s_{ INVALID };
+    };
+
+    // "host:port" -> parts; false when malformed.
+    bool ParseEndpoint(const std::string& s, std::string& host, uint16_t& port);
+
+} // namespace simcore
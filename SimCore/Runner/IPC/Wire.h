@@ -10,6 +10,7 @@ namespace simcore {
         MSG_JOB = 0x02,
         MSG_RESULT = 0x03,
         MSG_PROGRESS = 0x04,
+        MSG_CANCEL = 0x05,      // parent -> worker: abort job_id if it is running (or queued)
         // control-mode (program lifecycle):
         MSG_SET_PROGRAM = 0x10,
         MSG_RUN_INIT_ONCE = 0x11,
@@ -28,6 +29,9 @@ namespace simcore {
         WERR_NoProgramLoaded = 5,
         WERR_DecodePayloadFail = 7,
         WERR_EncodePayloadFail = 8,
+        WERR_Cancelled = 9,
+        WERR_WorkerCrashed = 10,  // host-side: the job took down its worker too often, never sent on the wire
+        WERR_NeedsLocalFiles = 11, // host-side: the job uses files on this host and only remote workers run
     };
 
     enum : uint8_t {
@@ -41,6 +45,10 @@ namespace simcore {
         PK_TasMovie = 2,
         PK_BattleTurnRunner = 3, 
         PK_BattleContextProbe = 4,
+        PK_SeedSweep = 5,
+        PK_RngTrace = 6,
+        PK_TasMovieBuffer = 7,
+        PK_BranchTree = 8,
     };
 
     // Payload used for TAS jobs (paths are NUL-terminated, Windows MAX_PATH safe)
@@ -114,6 +122,7 @@ namespace simcore {
         uint8_t _pad0;
         uint32_t timeout_ms;
         char     savestate_path[260]; // empty => start from boot
+        uint32_t shared_len;          // bytes of PSInit::shared_blob that follow the struct
     };
 
     struct WireAck {
@@ -123,13 +132,52 @@ namespace simcore {
         uint16_t _pad0;
     };
 
+#pragma pack(push, 1)
+    struct WireCancel {
+        uint32_t tag;      // MSG_CANCEL
+        uint64_t job_id;
+        uint32_t epoch;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(WireCancel) == 16, "WireCancel must be 16 bytes");
+
     struct WireJobHeader {
         uint32_t tag;      // MSG_JOB
         uint64_t job_id;
         uint32_t epoch;
         uint32_t payload_len;  // number of bytes that follow immediately
+        uint32_t timeouts_len; // WireTimeoutEntry[] bytes after the payload (learned timeouts; 0 => none)
     };
 
+#pragma pack(push, 1)
+    // Learned per-segment budget, keyed by the breakpoint the segment starts from (0 => job start).
+    // The VM applies it on top of RUN_MS / VI_STALL_MS (the smaller value wins); a VI_STALL_MS the
+    // script set to 0 keeps stall detection off.
+    struct WireTimeoutEntry {
+        uint16_t from_bp;
+        uint16_t _pad0;
+        uint32_t run_ms;
+        uint32_t vi_stall_ms;  // 0 => keep the job's own
+    };
+
+    // One RUN_UNTIL_BP as recorded by the VM (appended to keys::core::RUN_SEGMENTS).
+    struct WireRunSegment {
+        uint16_t from_bp;
+        uint16_t to_bp;            // 0 when nothing was hit
+        uint32_t elapsed_ms;
+        uint32_t max_vi_gap_ms;
+        uint32_t run_ms;           // budget used
+        uint32_t run_ms_default;   // budget without learned timeouts
+        uint32_t vi_stall_ms;
+        uint32_t vi_stall_ms_default;
+        uint8_t  outcome;          // RunToBpOutcome
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(WireTimeoutEntry) == 12, "WireTimeoutEntry size drift");
+    static_assert(sizeof(WireRunSegment) == 33, "WireRunSegment size drift");
+
 #pragma pack(push,1)
     struct WireActionPlan {
         uint8_t actor_slot;
@@ -0,0 +1,471 @@
+#include "AgentLink.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#include "../IPC/AgentWire.h"
+#include "../../Utils/Log.h"
+#include "../../Utils/ThreadName.h"
+#include "ResultStore.h"  // HashFileContents
+
+namespace simcore {
+
+    static int64_t now_ms() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static void close_h(HANDLE& h) {
+        if (h) { CloseHandle(h); h = NULL; }
+    }
+
+    AgentLink::AgentLink(AgentEndpoint ep, AgentLinkOptions opt) : ep_(std::move(ep)), opt_(opt) {}
+
+    AgentLink::~AgentLink() { stop(); }
+
+    bool AgentLink::handshake(TcpSocket& s, std::string* error_out)
+    {
+        AgentFrame f{};
+        AgentHello h{};
+        if (!s.wait_readable(opt_.connect_timeout_ms) || !s.recv_all(&f, sizeof(f))
+            || f.tag != AG_HELLO || f.len != sizeof(h) || !s.recv_all(&h, sizeof(h))) {
+            if (error_out) *error_out = "no HELLO from agent";
+            return false;
+        }
+        if (h.magic != AGENT_MAGIC || h.version != AGENT_PROTO_VERSION) {
+            if (error_out) *error_out = "agent protocol mismatch (version " + std::to_string(h.version) + ")";
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lk(m_);
+        name_.assign(h.name, strnlen(h.name, sizeof(h.name)));
+        if (slots_ == 0) {
+            slots_ = h.slots;
+            slots_v_ = std::vector<Slot>(slots_);
+        }
+        else if (h.slots != slots_) {
+            // Worker count is fixed at runner start; extra slots stay unused, missing ones fail to open
+            SCLOGW("[agent %s] now reports %u slots (was %u)", endpoint().c_str(), h.slots, slots_);
+        }
+        return true;
+    }
+
+    bool AgentLink::connect(std::string* error_out)
+    {
+        TcpSocket s;
+        if (!s.connect(ep_.host, ep_.port, opt_.connect_timeout_ms, error_out)) return false;
+        if (!handshake(s, error_out)) return false;
+        if (slots_ == 0) {
+            if (error_out) *error_out = "agent has no worker slots";
+            return false;
+        }
+
+        sock_ = std::move(s);
+        const uint64_t gen = gen_.fetch_add(1) + 1;
+        last_rx_ms_.store(now_ms());
+        up_.store(true);
+        reader_th_ = std::thread(&AgentLink::reader_loop, this, gen);
+        link_th_ = std::thread(&AgentLink::link_loop, this);
+
+        SCLOGI("[agent %s] connected to '%s' (%u slots)", endpoint().c_str(), name_.c_str(), slots_);
+        return true;
+    }
+
+    void AgentLink::stop()
+    {
+        if (stop_.exchange(true)) return;
+        drop_link("stopping");
+        if (link_th_.joinable()) link_th_.join();
+        if (reader_th_.joinable()) reader_th_.join();
+        sock_.close();
+
+        for (auto& s : slots_v_) {
+            {
+                std::lock_guard<std::mutex> lk(m_);
+                fail_slot_locked(s, 0);
+            }
+            // ProcessWorker::stop() normally ends the pump by closing its pipe end; don't hang if it didn't
+            if (s.pump.joinable()) CancelSynchronousIo(s.pump.native_handle());
+            teardown_slot(s);
+        }
+    }
+
+    bool AgentLink::send_frame(uint8_t tag, uint32_t slot, const void* body, uint32_t len, const void* extra, uint32_t extra_len)
+    {
+        AgentFrame f{};
+        f.tag = tag;
+        f.slot = slot;
+        f.len = len + extra_len;
+
+        std::lock_guard<std::mutex> lk(send_m_);
+        if (!sock_.valid()) return false;
+        if (!sock_.send_all(&f, sizeof(f))) return false;
+        if (len && !sock_.send_all(body, len)) return false;
+        if (extra_len && !sock_.send_all(extra, extra_len)) return false;
+        return true;
+    }
+
+    bool AgentLink::wait_up(std::unique_lock<std::mutex>& lk, uint32_t timeout_ms)
+    {
+        cv_.wait_for(lk, std::chrono::milliseconds(timeout_ms), [&] { return up_.load() || stop_.load(); });
+        return up_.load() && !stop_.load();
+    }
+
+    void AgentLink::link_loop()
+    {
+        set_this_thread_name_utf8(("AgentLink-" + endpoint()).c_str());
+
+        uint32_t backoff_ms = 500;
+        while (!stop_.load()) {
+            if (up_.load()) {
+                Sleep(opt_.heartbeat_ms);
+                if (stop_.load() || !up_.load()) continue;
+                if (now_ms() - last_rx_ms_.load() > (int64_t)opt_.dead_after_ms) { drop_link("heartbeat timeout"); continue; }
+                if (!send_frame(AG_HEARTBEAT, 0, nullptr, 0)) drop_link("heartbeat send failed");
+                continue;
+            }
+
+            // Down: reap the old connection, then reconnect with backoff
+            if (reader_th_.joinable()) reader_th_.join();
+            {
+                std::lock_guard<std::mutex> lk(send_m_);
+                sock_.close();
+            }
+
+            TcpSocket s;
+            std::string err;
+            if (s.connect(ep_.host, ep_.port, opt_.connect_timeout_ms, &err) && handshake(s, &err)) {
+                {
+                    std::lock_guard<std::mutex> lk(send_m_);
+                    sock_ = std::move(s);
+                }
+                const uint64_t gen = gen_.fetch_add(1) + 1;
+                last_rx_ms_.store(now_ms());
+                reader_th_ = std::thread(&AgentLink::reader_loop, this, gen);
+                {
+                    std::lock_guard<std::mutex> lk(m_);
+                    up_.store(true);
+                }
+                cv_.notify_all();
+                reconnects_.fetch_add(1);
+                backoff_ms = 500;
+                SCLOGI("[agent %s] reconnected", endpoint().c_str());
+                continue;
+            }
+
+            SCLOGD("[agent %s] reconnect failed: %s", endpoint().c_str(), err.c_str());
+            for (uint32_t waited = 0; waited < backoff_ms && !stop_.load(); waited += 50) Sleep(50);
+            backoff_ms = std::min<uint32_t>(backoff_ms * 2, 10000);
+        }
+    }
+
+    void AgentLink::drop_link(const char* why)
+    {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            if (!up_.exchange(false)) return;
+            for (auto& s : slots_v_) fail_slot_locked(s, 0xFFFFFFFFu);
+            for (auto& [id, st] : stages_) { st.done = true; st.ok = false; }
+        }
+        cv_.notify_all();
+        sock_.shutdown();  // wakes the reader; link_loop closes and reconnects
+        if (!stop_.load()) SCLOGW("[agent %s] link down: %s", endpoint().c_str(), why);
+    }
+
+    void AgentLink::fail_slot_locked(Slot& s, uint32_t code)
+    {
+        if (!s.open) return;
+        s.open = false;
+        s.status = AGSLOT_Exited;
+        s.code = code;
+        close_h(s.out_wr);           // ProcessWorker's reader sees EOF, as when a local child dies
+        if (s.exited) SetEvent(s.exited);
+    }
+
+    void AgentLink::teardown_slot(Slot& s)
+    {
+        if (s.pump.joinable()) s.pump.join();
+        close_h(s.in_rd);
+        close_h(s.out_wr);
+        close_h(s.exited);
+    }
+
+    void AgentLink::reader_loop(uint64_t gen)
+    {
+        set_this_thread_name_utf8(("AgentReader-" + endpoint()).c_str());
+
+        std::vector<uint8_t> body;
+        for (;;) {
+            AgentFrame f{};
+            if (!sock_.recv_all(&f, sizeof(f))) break;
+            body.resize(f.len);
+            if (f.len && !sock_.recv_all(body.data(), f.len)) break;
+            last_rx_ms_.store(now_ms());
+
+            switch (f.tag) {
+            case AG_HEARTBEAT:
+                break;
+
+            case AG_SLOT_DATA: {
+                std::lock_guard<std::mutex> lk(m_);
+                if (f.slot >= slots_v_.size()) break;
+                Slot& s = slots_v_[f.slot];
+                if (!s.open || s.status != AGSLOT_Opened || !s.out_wr) break;  // stale bytes of a retired worker
+                const uint8_t* p = body.data();
+                size_t n = body.size();
+                while (n) {
+                    DWORD w = 0;
+                    if (!WriteFile(s.out_wr, p, (DWORD)n, &w, NULL) || w == 0) break;  // reader gone; slot is being replaced
+                    p += w; n -= w;
+                }
+                break;
+            }
+
+            case AG_SLOT_STATUS: {
+                if (f.len < sizeof(AgentSlotStatus)) break;
+                AgentSlotStatus st{};
+                std::memcpy(&st, body.data(), sizeof(st));
+                {
+                    std::lock_guard<std::mutex> lk(m_);
+                    if (f.slot >= slots_v_.size()) break;
+                    Slot& s = slots_v_[f.slot];
+                    if (st.seq != s.seq) break;
+                    if (st.state == AGSLOT_Exited) {
+                        SCLOGW("[agent %s] slot %u worker exited (code=0x%08X)", endpoint().c_str(), f.slot, st.code);
+                        fail_slot_locked(s, st.code);
+                    }
+                    else {
+                        s.status = st.state;
+                        s.code = st.code;
+                    }
+                }
+                cv_.notify_all();
+                break;
+            }
+
+            case AG_FILE_READY: {
+                if (f.len < sizeof(AgentFileReady)) break;
+                AgentFileReady fr{};
+                std::memcpy(&fr, body.data(), sizeof(fr));
+                {
+                    std::lock_guard<std::mutex> lk(m_);
+                    auto it = stages_.find(f.slot);
+                    if (it == stages_.end()) break;
+                    it->second.done = true;
+                    it->second.ok = fr.ok != 0;
+                    it->second.path.assign(fr.path, strnlen(fr.path, sizeof(fr.path)));
+                }
+                cv_.notify_all();
+                break;
+            }
+
+            case AG_FETCH:
+                serve_fetch(f.slot, body.data(), f.len);
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        if (gen == gen_.load()) drop_link("connection lost");
+    }
+
+    void AgentLink::serve_fetch(uint32_t req, const uint8_t* body, uint32_t len)
+    {
+        if (len < sizeof(AgentFetch)) return;
+        AgentFetch fe{};
+        std::memcpy(&fe, body, sizeof(fe));
+
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            auto it = served_.find(fe.hash);
+            if (it != served_.end()) path = it->second;
+        }
+
+        AgentFileData fd{};
+        fd.hash = fe.hash;
+        fd.offset = fe.offset;
+
+        std::vector<uint8_t> chunk;
+        HANDLE h = path.empty() ? INVALID_HANDLE_VALUE
+            : CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (h != INVALID_HANDLE_VALUE) {
+            chunk.resize(AGENT_FILE_CHUNK);
+            OVERLAPPED ov{};
+            ov.Offset = (DWORD)(fe.offset & 0xFFFFFFFFu);
+            ov.OffsetHigh = (DWORD)(fe.offset >> 32);
+            DWORD got = 0;
+            const bool ok = ReadFile(h, chunk.data(), (DWORD)chunk.size(), &got, &ov) || GetLastError() == ERROR_HANDLE_EOF;
+            CloseHandle(h);
+            chunk.resize(ok ? got : 0);
+            fd.ok = ok ? 1 : 0;
+        }
+        if (!fd.ok) SCLOGW("[agent %s] cannot serve %016llx (%s)", endpoint().c_str(), (unsigned long long)fe.hash, path.empty() ? "unknown hash" : path.c_str());
+
+        if (send_frame(AG_FILE_DATA, req, &fd, sizeof(fd), chunk.data(), (uint32_t)chunk.size()))
+            bytes_served_.fetch_add(chunk.size());
+    }
+
+    std::string AgentLink::stage_file(const std::string& local_path, std::string* error_out)
+    {
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        const uint64_t size = fs::file_size(local_path, ec);
+        if (ec) { if (error_out) *error_out = "cannot stat " + local_path; return {}; }
+        const int64_t mtime = (int64_t)fs::last_write_time(local_path, ec).time_since_epoch().count();
+
+        uint64_t hash = 0;
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            auto it = hashed_.find(local_path);
+            if (it != hashed_.end() && it->second.size == size && it->second.mtime == mtime) hash = it->second.hash;
+        }
+        if (hash == 0) {
+            hash = HashFileContents(local_path);
+            if (hash == 0) { if (error_out) *error_out = "cannot read " + local_path; return {}; }
+            std::lock_guard<std::mutex> lk(m_);
+            hashed_[local_path] = HashedFile{ size, mtime, hash };
+        }
+
+        AgentStageFile sf{};
+        sf.hash = hash;
+        sf.size = size;
+        const std::string ext = fs::path(local_path).extension().string();
+        if (agent_ext_ok(ext.data(), ext.size())) std::strncpy(sf.ext, ext.c_str(), sizeof(sf.ext) - 1);  // else cached bare
+
+        std::unique_lock<std::mutex> lk(m_);
+        served_[hash] = local_path;
+        if (!wait_up(lk, opt_.reconnect_wait_ms)) { if (error_out) *error_out = "agent " + endpoint() + " is down"; return {}; }
+        const uint32_t req = next_req_++;
+        stages_[req] = Stage{};
+        lk.unlock();
+
+        if (!send_frame(AG_STAGE_FILE, req, &sf, sizeof(sf))) {
+            lk.lock();
+            stages_.erase(req);
+            if (error_out) *error_out = "send to agent failed";
+            return {};
+        }
+
+        lk.lock();
+        cv_.wait_for(lk, std::chrono::milliseconds(opt_.stage_timeout_ms), [&] { return stages_[req].done || stop_.load(); });
+        const Stage st = stages_[req];
+        stages_.erase(req);
+        if (!st.done || !st.ok) {
+            if (error_out) *error_out = !st.done ? "staging timed out" : "agent could not stage " + local_path;
+            return {};
+        }
+        return st.path;
+    }
+
+    bool AgentLink::open_slot(uint32_t slot, uint32_t worker_id, const std::string& iso_path,
+        HANDLE& in_wr, HANDLE& out_rd, HANDLE& exited, std::string* error_out)
+    {
+        if (slot >= slots_) { if (error_out) *error_out = "no such slot"; return false; }
+
+        // The ISO travels by hash like any other file; the agent keeps it cached across respawns
+        if (stage_file(iso_path, error_out).empty()) return false;
+        uint64_t iso_hash = 0;
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            iso_hash = hashed_[iso_path].hash;
+        }
+
+        // Previous incarnation: ProcessWorker::stop() closed its pipe end, so the pump has ended
+        Slot& s = slots_v_[slot];
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            fail_slot_locked(s, s.code);
+        }
+        teardown_slot(s);
+
+        HANDLE their_in = NULL, their_out = NULL, ev = NULL, their_ev = NULL;
+        HANDLE in_rd = NULL, out_wr = NULL;
+        if (!CreatePipe(&in_rd, &their_in, NULL, 0) || !CreatePipe(&their_out, &out_wr, NULL, 0)
+            || !(ev = CreateEventA(NULL, TRUE, FALSE, NULL))
+            || !DuplicateHandle(GetCurrentProcess(), ev, GetCurrentProcess(), &their_ev, 0, FALSE, DUPLICATE_SAME_ACCESS)) {
+            close_h(in_rd); close_h(their_in); close_h(their_out); close_h(out_wr); close_h(ev);
+            if (error_out) *error_out = "CreatePipe/CreateEvent failed";
+            return false;
+        }
+
+        AgentOpenSlot os{};
+        os.worker_id = worker_id;
+        os.iso_hash = iso_hash;
+
+        std::unique_lock<std::mutex> lk(m_);
+        if (!wait_up(lk, opt_.reconnect_wait_ms)) {
+            lk.unlock();
+            close_h(in_rd); close_h(their_in); close_h(their_out); close_h(out_wr); close_h(ev); close_h(their_ev);
+            if (error_out) *error_out = "agent " + endpoint() + " is down";
+            return false;
+        }
+        s.in_rd = in_rd;
+        s.out_wr = out_wr;
+        s.exited = ev;
+        s.status = 0;
+        s.code = 0;
+        s.seq = os.seq = s.seq + 1;
+        s.open = true;
+        lk.unlock();
+
+        bool ok = send_frame(AG_OPEN_SLOT, slot, &os, sizeof(os));
+        lk.lock();
+        if (ok) cv_.wait_for(lk, std::chrono::milliseconds(opt_.open_timeout_ms), [&] { return s.status != 0 || !s.open || stop_.load(); });
+        ok = ok && s.open && s.status == AGSLOT_Opened;
+        if (!ok) {
+            const bool refused = s.status == AGSLOT_OpenFailed;
+            fail_slot_locked(s, s.code);
+            lk.unlock();
+            teardown_slot(s);
+            close_h(their_in); close_h(their_out); close_h(their_ev);
+            if (error_out) *error_out = refused ? "agent failed to spawn a worker" : "agent did not answer OPEN_SLOT";
+            return false;
+        }
+        s.pump = std::thread(&AgentLink::pump_loop, this, slot, s.in_rd);
+        lk.unlock();
+
+        in_wr = their_in;
+        out_rd = their_out;
+        exited = their_ev;
+        return true;
+    }
+
+    void AgentLink::pump_loop(uint32_t slot, HANDLE in_rd)
+    {
+        set_this_thread_name_utf8(("AgentPump-" + endpoint() + "-" + std::to_string(slot)).c_str());
+
+        std::vector<uint8_t> buf(64 * 1024);
+        for (;;) {
+            DWORD got = 0;
+            if (!ReadFile(in_rd, buf.data(), (DWORD)buf.size(), &got, NULL) || got == 0) break;
+            (void)send_frame(AG_SLOT_DATA, slot, buf.data(), got);  // a failed send downs the link, which fails the slot
+        }
+
+        // ProcessWorker closed its end (stop/respawn): retire the remote worker and end the local stream,
+        // the way a local child exits when its stdin closes.
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            fail_slot_locked(slots_v_[slot], 0);
+        }
+        if (up_.load()) (void)send_frame(AG_CLOSE_SLOT, slot, nullptr, 0);
+    }
+
+    void AgentLink::close_slot(uint32_t slot)
+    {
+        if (slot >= slots_v_.size()) return;
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            fail_slot_locked(slots_v_[slot], 1);
+        }
+        if (up_.load()) (void)send_frame(AG_CLOSE_SLOT, slot, nullptr, 0);
+    }
+
+    uint32_t AgentLink::slot_exit_code(uint32_t slot) const
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        return slot < slots_v_.size() ? slots_v_[slot].code : 0;
+    }
+
+} // namespace simcore
@@ -0,0 +1,126 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <windows.h>
+
+#include "../IPC/TcpSocket.h"
+
+namespace simcore {
+
+    struct AgentEndpoint {
+        std::string host;
+        uint16_t port{ 0 };
+    };
+
+    struct AgentLinkOptions {
+        uint32_t connect_timeout_ms{ 5000 };
+        uint32_t heartbeat_ms{ 1000 };
+        uint32_t dead_after_ms{ 6000 };     // no frame from the agent for this long => link down
+        uint32_t reconnect_wait_ms{ 30000 }; // open_slot()/stage_file() wait this long for a link that is down
+        uint32_t open_timeout_ms{ 120000 };  // agent spawning a worker (first use may include the ISO transfer)
+        uint32_t stage_timeout_ms{ 600000 };
+    };
+
+    // Coordinator side of one SimCoreWorkerAgent (see AgentWire.h).
+    //
+    // Each agent slot is exposed to ProcessWorker as a pair of local anonymous pipes plus a
+    // manual-reset event that stands in for the process handle: a pump thread forwards what
+    // ProcessWorker writes as SLOT_DATA, incoming SLOT_DATA is written to the read pipe, and a
+    // worker exit or a lost link closes that pipe and signals the event. The runner's crash
+    // handling (exited() -> re-queue -> respawn) therefore covers remote slots unchanged;
+    // respawning a slot while the link is down waits up to reconnect_wait_ms for the
+    // background reconnect.
+    class AgentLink {
+    public:
+        AgentLink(AgentEndpoint ep, AgentLinkOptions opt = {});
+        ~AgentLink();
+
+        AgentLink(const AgentLink&) = delete;
+        AgentLink& operator=(const AgentLink&) = delete;
+
+        // First connection + HELLO. On success the heartbeat/reconnect thread keeps the link up until stop().
+        bool connect(std::string* error_out = nullptr);
+        void stop();
+
+        bool up() const { return up_.load(); }
+        uint32_t slots() const { return slots_; }
+        const std::string& name() const { return name_; }
+        std::string endpoint() const { return ep_.host + ":" + std::to_string(ep_.port); }
+
+        // (Re)spawns the worker of `slot` on the agent. On success the caller owns the three handles
+        // (stdin write end, stdout read end, exit event) exactly like SpawnWorkerProcess()'s.
+        bool open_slot(uint32_t slot, uint32_t worker_id, const std::string& iso_path,
+            HANDLE& in_wr, HANDLE& out_rd, HANDLE& exited, std::string* error_out = nullptr);
+        void close_slot(uint32_t slot);  // agent closes the worker's stdin, then kills it
+        uint32_t slot_exit_code(uint32_t slot) const;
+
+        // Makes a coordinator file available on the agent by content hash; returns the agent-local
+        // path, or "" on failure. Hashes are cached per (path, size, mtime).
+        std::string stage_file(const std::string& local_path, std::string* error_out = nullptr);
+
+        uint64_t bytes_served() const { return bytes_served_.load(); }
+        uint32_t reconnects() const { return reconnects_.load(); }
+
+    private:
+        struct Slot {
+            HANDLE in_rd{ NULL };   // ProcessWorker -> pump
+            HANDLE out_wr{ NULL };  // agent data -> ProcessWorker
+            HANDLE exited{ NULL };
+            std::thread pump;
+            bool open{ false };
+            uint8_t status{ 0 };    // AGSLOT_* of the last open/exit report
+            uint32_t code{ 0 };
+            uint32_t seq{ 0 };      // AgentOpenSlot::seq of the current incarnation
+        };
+
+        struct Stage {
+            bool done{ false };
+            bool ok{ false };
+            std::string path;
+        };
+
+        bool handshake(TcpSocket& s, std::string* error_out);
+        bool send_frame(uint8_t tag, uint32_t slot, const void* body, uint32_t len, const void* extra = nullptr, uint32_t extra_len = 0);
+        bool wait_up(std::unique_lock<std::mutex>& lk, uint32_t timeout_ms);
+        void link_loop();
+        void reader_loop(uint64_t gen);
+        void drop_link(const char* why);
+        void fail_slot_locked(Slot& s, uint32_t code);
+        void teardown_slot(Slot& s);
+        void pump_loop(uint32_t slot, HANDLE in_rd);
+        void serve_fetch(uint32_t req, const uint8_t* body, uint32_t len);
+
+        AgentEndpoint ep_;
+        AgentLinkOptions opt_;
+        std::string name_;
+        uint32_t slots_{ 0 };
+
+        TcpSocket sock_;
+        std::mutex send_m_;  // one writer at a time on sock_
+        std::thread link_th_, reader_th_;
+        std::atomic<bool> stop_{ false };
+        std::atomic<bool> up_{ false };
+        std::atomic<uint64_t> gen_{ 0 };
+        std::atomic<int64_t> last_rx_ms_{ 0 };
+        std::atomic<uint64_t> bytes_served_{ 0 };
+        std::atomic<uint32_t> reconnects_{ 0 };
+
+        mutable std::mutex m_;  // slots_v_, stages_, served_, hash cache; cv_ waits
+        std::condition_variable cv_;
+        std::vector<Slot> slots_v_;
+        std::unordered_map<uint32_t, Stage> stages_;  // request id -> reply
+        uint32_t next_req_{ 1 };
+        std::unordered_map<uint64_t, std::string> served_;  // hash -> coordinator path
+        struct HashedFile { uint64_t size; int64_t mtime; uint64_t hash; };
+        std::unordered_map<std::string, HashedFile> hashed_;
+    };
+
+} // namespace simcore
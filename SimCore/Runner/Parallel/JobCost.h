@@ -0,0 +1,16 @@
+#pragma once
+#include "../Script/PhaseScriptVM.h"  // PSJob
+
+namespace simcore {
+
+    // Pluggable cost model for ParallelPhaseScriptRunner's job queue: jobs with a higher estimate are
+    // dispatched first (longest expected job first), which keeps long jobs from trailing the batch.
+    // Units are arbitrary but should be comparable across jobs of one program (expected ms is natural).
+    // Called from submit() on the caller's thread; must be thread-safe if submit() is.
+    class IJobCostEstimator {
+    public:
+        virtual ~IJobCostEstimator() = default;
+        virtual double estimate(const PSJob& job) const = 0;
+    };
+
+} // namespace simcore
@@ -10,7 +10,10 @@ namespace simcore {
 		uint64_t epoch{ 0 };
 		size_t queued_jobs{ 0 };
 		size_t running_workers{ 0 };
+		size_t ready_workers{ 0 };      // running and past READY
 		size_t workers{ 0 };
+		uint64_t worker_restarts{ 0 };  // respawns after a worker process died
+		uint64_t jobs_requeued{ 0 };    // in-flight jobs put back on the queue by those respawns
 	};
 
 	// Cross-thread/process job result
@@ -19,9 +22,48 @@ namespace simcore {
 		uint64_t epoch{ 0 };
 		size_t worker_id{ 0 };
 		bool accepted{ false };
+		bool from_store{ false };  // answered by the attached ResultStore, no worker ran it
 		PSResult ps;               // from PhaseScriptVM
 	};
 
+	// Straggler mitigation: at the tail of a batch (queue empty, some workers idle), the longest-running
+	// in-flight jobs are re-queued so an idle worker runs a copy. The first result wins; the other copy
+	// is cancelled in its worker (MSG_CANCEL) and its result is dropped by try_get_result().
+	struct SpeculationPolicy {
+		bool     enabled{ false };
+		uint32_t min_elapsed_ms{ 5000 };  // never duplicate a job that has run for less than this
+		double   slow_factor{ 2.0 };      // ...or for less than slow_factor x median latency so far
+		uint32_t max_copies{ 1 };         // extra copies per job
+		uint32_t poll_ms{ 50 };
+		bool     measure_baseline{ false }; // let losing originals finish (not cancelled) to time the tail without speculation
+	};
+
+	// Worker crash recovery. A worker whose process exits while the runner is up is respawned with the
+	// same ProcStartParams, brought back to the current program (set_program/run_init_once/activate_main)
+	// and epoch, and the job it was running is re-queued. A job that has taken down max_job_crashes
+	// workers is answered with accepted=true, ps.ok=false, ps.w_err=WERR_WorkerCrashed instead.
+	struct RespawnPolicy {
+		bool     enabled{ true };
+		uint32_t max_consecutive{ 3 };     // respawns without a finished job in between before parking the worker
+		uint32_t max_job_crashes{ 2 };
+		uint32_t backoff_ms{ 500 };        // x attempt number
+		uint32_t ready_timeout_ms{ 120000 };
+	};
+
+	// Latency of the jobs collected since the last reset (ms, dispatch -> first result).
+	struct PRTailStats {
+		uint64_t jobs{ 0 };
+		uint32_t p50_ms{ 0 };
+		uint32_t p99_ms{ 0 };
+		uint32_t max_ms{ 0 };
+		uint32_t tail_ms{ 0 };          // last original dispatch (queue drained) -> last result
+		uint32_t tail_ms_no_spec{ 0 };  // same, up to when the slowest original copy finished
+		bool     no_spec_exact{ true }; // false: some originals were cancelled, tail_ms_no_spec is a lower bound
+		uint64_t speculated{ 0 };       // copies queued
+		uint64_t spec_wins{ 0 };        // jobs answered by a copy
+		uint64_t cancelled{ 0 };        // MSG_CANCEL sent
+	};
+
 	struct PRProgress
 	{
 		size_t    worker_id{ 0 };
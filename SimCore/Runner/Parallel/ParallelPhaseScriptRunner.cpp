@@ -1,9 +1,13 @@
 #include "ParallelPhaseScriptRunner.h"
 #include <tlhelp32.h>
+#include <algorithm>
+#include <limits>
 
 
+#include "../../Utils/SharedUserBase.h"
 #include "../../Utils/ThreadName.h"
 #include "../IPC/Wire.h"
+#include "../../Phases/Programs/ProgramRegistry.h"
 
 namespace simcore {
 
@@ -40,32 +44,37 @@ namespace simcore {
 
     ParallelPhaseScriptRunner::ParallelPhaseScriptRunner(size_t n)
     {
-        jobs_.reset(new TSQueue<CmdJob>());
+        jobs_.reset(new JobQueue());
+        local_jobs_.reset(new JobQueue());
         out_.reset(new TSQueue<PRResult>());
         ctrls_.reserve(n);
         workers_.reserve(n);
-        for (size_t i = 0; i < n; ++i) {
-            auto w = std::make_unique<Worker>();
-            w->id = i;
-            w->proc = std::make_unique<ProcessWorker>();
-
-            auto pq = new TSQueue<PRProgress>();
-            w->proc->set_progress_queue(pq);
-
-            // Spawn a thread to drain progress and update last_progress_
-            std::thread([this, pq, wid = w->id] {
-                PRProgress p;
-                while (pq->pop_wait(p)) {
-                    std::lock_guard<std::mutex> lk(progress_m_);
-                    last_progress_[wid] = std::move(p);
-                }
-                delete pq;
-                }).detach();
+        for (size_t i = 0; i < n; ++i) add_worker();
+    }
 
-            w->jobs = jobs_.get();
-            w->out = out_.get();
-            workers_.push_back(std::move(w));
-        }
+    ParallelPhaseScriptRunner::Worker& ParallelPhaseScriptRunner::add_worker()
+    {
+        auto w = std::make_unique<Worker>();
+        w->id = workers_.size();
+        w->proc = std::make_unique<ProcessWorker>();
+
+        auto pq = new TSQueue<PRProgress>();
+        w->proc->set_progress_queue(pq);
+
+        // Spawn a thread to drain progress and update last_progress_
+        std::thread([this, pq, wid = w->id] {
+            PRProgress p;
+            while (pq->pop_wait(p)) {
+                std::lock_guard<std::mutex> lk(progress_m_);
+                last_progress_[wid] = std::move(p);
+            }
+            delete pq;
+            }).detach();
+
+        w->jobs = jobs_.get();
+        w->out = out_.get();
+        workers_.push_back(std::move(w));
+        return *workers_.back();
     }
 
     ParallelPhaseScriptRunner::~ParallelPhaseScriptRunner() { stop(); }
@@ -78,6 +87,7 @@ namespace simcore {
 
         const uint64_t e = 1;
         epoch_.store(e);
+        const auto t_start = std::chrono::steady_clock::now();
 
         char exePath[MAX_PATH]{};
         GetModuleFileNameA(NULL, exePath, MAX_PATH);
@@ -86,17 +96,62 @@ namespace simcore {
         base = (pos == std::string::npos) ? "." : base.substr(0, pos);
         std::string workerExe = base + "\\SimCoreWorker.exe";
 
-        SCLOGI("[runner] Starting workers...");
+        // Remote pools. Workers are only ever appended, and no worker thread runs yet.
+        const size_t local_workers = workers_.size();
+        local_workers_ = local_workers;
+        for (const auto& ep : boot.agents) {
+            auto link = std::make_shared<AgentLink>(ep, boot.agent_options);
+            std::string err;
+            if (!link->connect(&err)) {
+                SCLOGW("[runner] agent %s:%u unavailable: %s", ep.host.c_str(), ep.port, err.c_str());
+                continue;
+            }
+            for (uint32_t slot = 0; slot < link->slots(); ++slot) {
+                Worker& w = add_worker();
+                w.params.agent = link;
+                w.params.agent_slot = slot;
+            }
+            agents_.push_back(std::move(link));
+        }
+
+        SCLOGI("[runner] Starting workers (%zu local, %zu remote)...", local_workers, workers_.size() - local_workers);
+
+        placement_ = cpu::PlanPlacement(boot.affinity.enabled ? cpu::QueryTopology() : cpu::Topology{}, local_workers, boot.affinity);
+        if (boot.affinity.enabled) {
+            SCLOGI("[runner] CPU placement: %u/%zu workers on dedicated cores, parent threads on %s",
+                placement_.dedicated, local_workers, placement_.parent.empty() ? "any core" : placement_.parent.to_string().c_str());
+            if (placement_.dedicated < local_workers)
+                SCLOGW("[runner] %zu workers left unpinned: not enough physical cores", local_workers - placement_.dedicated);
+        }
+
+        std::string user_base;
+        if (boot.shared_user_base && local_workers > 0) {
+            const auto t0 = std::chrono::steady_clock::now();
+            std::filesystem::path snap;
+            std::string err;
+            if (PrepareUserBaseSnapshot(boot.boot.dolphin_qt_base / "User", boot.boot.user_dir / "base", snap, &err)) {
+                user_base = snap.string();
+                SCLOGI("[runner] shared User base %s ready in %lld ms", user_base.c_str(),
+                    (long long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count());
+            }
+            else SCLOGW("[runner] shared User base unavailable, workers copy the Qt base: %s", err.c_str());
+        }
 
         size_t launched = 0;
         for (auto& w : workers_) {
             ProcStartParams ps{};
+            ps.agent = w->params.agent;
+            ps.agent_slot = w->params.agent_slot;
             ps.worker_id = w->id;
             ps.exe_path = workerExe;
             ps.iso_path = boot.iso_path;
             ps.qt_base_dir = boot.boot.dolphin_qt_base.string();
             ps.user_dir = (boot.boot.user_dir / ("runner-" + std::to_string(w->id)) / "User").string();
+            if (!ps.agent) ps.user_base = user_base;
             ps.vm_control = true;
+            if (w->id < placement_.workers.size() && !ps.agent) ps.placement = placement_.workers[w->id];
+            ps.parent_cpus = placement_.parent;
+            w->params = ps;
 
             if (!w->proc->start(ps, out_.get())) {
                 SCLOGE("[Runner %zu] failed to launch SimCoreWorker process", w->id);
@@ -108,52 +163,11 @@ namespace simcore {
             w->epoch = e;
 
             // Start dispatcher thread NOW; it will sleep until proc->is_ready()
-            w->th = std::thread([this, w = w.get()] {
-                set_this_thread_name_utf8((std::string("Dispatcher-") + std::to_string(w->id)).c_str());
-
-                // Wait until the worker signals READY(ok=true) or is stopped
-                for (;;) {
-                    if (!w->running.load()) return;
-                    if (w->proc->is_ready()) break;
-                    if (w->proc->is_failed())  return;// This worker will never accept jobs; just park this dispatcher.
-                    Sleep(5);
-                }
-
-                // Now accept and send jobs
-                for (;;) {
-                    if (!w->running.load()) break;
-
-                    // Acquire this worker's single slot; if busy, wait
-                    while (w->running.load() && !w->proc->try_acquire_slot()) {
-                        Sleep(1);
-                    }
-                    if (!w->running.load()) break;
-
-                    // Now we own the slot; pop exactly one job
-                    CmdJob j{};
-                    if (!w->jobs->pop_wait(j)) {
-                        // queue closed; release slot and exit
-                        w->proc->release_slot();            // in case we acquired but got closed
-                        break;
-                    }
-                    if (j.epoch != w->epoch) {
-                        // wrong epoch; free slot and NACK
-                        w->proc->release_slot();
-                        PRResult rr{}; rr.job_id = j.job_id; rr.epoch = j.epoch; rr.worker_id = w->id; rr.accepted = false;
-                        out_->push(std::move(rr));
-                        continue;
-                    }
-
-                    // Send one job. Slot stays held until reader_thread() sees the result.
-                    if (!w->proc->send_job(j.job_id, j.epoch, j.job)) {
-                        // send failed -> slot was released inside send_job(); mark this worker failed
-                        SCLOGE("[Runner %zu] send_job failed (worker pipe)", w->id);
-                        break;
-                    }
-                }
-            });
+            w->th = std::thread([this, w = w.get()] { dispatcher_loop(w); });
         }
 
+        spec_th_ = std::thread([this] { speculator_loop(); });
+
         // If nothing even launched, fail fast
         if (launched == 0) {
             SCLOGE("ParallelPhaseScriptRunner.start(): no worker processes launched.");
@@ -213,14 +227,237 @@ namespace simcore {
             return false;
         }
 
+        SCLOGI("[runner] first of %zu workers ready after %lld ms", launched,
+            (long long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t_start).count());
         return true; // at least one worker is ready; others will join as they become ready
     }
 
+    void ParallelPhaseScriptRunner::dispatcher_loop(Worker* w)
+    {
+        set_this_thread_name_utf8((std::string("Dispatcher-") + std::to_string(w->id)).c_str());
+        cpu::PinCurrentThread(placement_.parent);
+
+        for (;;) {
+            // Wait until the worker signals READY(ok=true) or is stopped
+            for (;;) {
+                if (!w->running.load()) return;
+                if (w->proc->is_ready()) break;
+                if (w->proc->is_failed()) return;  // This worker will never accept jobs; just park this dispatcher.
+                if (w->proc->exited()) break;      // died before READY; respawned below
+                Sleep(5);
+            }
+
+            // Now accept and send jobs
+            bool unsent = false;
+            for (;;) {
+                if (!w->running.load()) return;
+                if (w->proc->exited()) break;
+
+                // Acquire this worker's single slot; if busy, wait
+                while (w->running.load() && !w->proc->exited() && !w->proc->try_acquire_slot()) {
+                    Sleep(1);
+                }
+                if (!w->running.load()) return;
+                if (w->proc->exited()) break;  // the reader frees the slot when the child dies
+
+                // Now we own the slot; pop exactly one job
+                CmdJob j{};
+                if (!pop_job(*w, j)) {
+                    // queue closed; release slot and exit
+                    w->proc->release_slot();            // in case we acquired but got closed
+                    return;
+                }
+                if (j.epoch != w->epoch) {
+                    // wrong epoch; free slot and NACK
+                    w->proc->release_slot();
+                    PRResult rr{}; rr.job_id = j.job_id; rr.epoch = j.epoch; rr.worker_id = w->id; rr.accepted = false;
+                    out_->push(std::move(rr));
+                    continue;
+                }
+
+                // A worker on another host cannot reach this machine's files: send the job without
+                // them, or hand it to the local workers' own queue and take the next one
+                if (w->proc->is_remote()) {
+                    std::vector<uint8_t> remote;
+                    if (programs::payload_for_remote(main_kind_, j.job.payload, remote)) {
+                        j.job.payload = std::move(remote);
+                    }
+                    else if (has_active_local_workers()) {
+                        w->proc->release_slot();
+                        local_jobs_->push(std::move(j));
+                        w->jobs->kick();  // local dispatchers wait on the shared queue
+                        continue;
+                    }
+                    else {
+                        w->proc->release_slot();
+                        SCLOGE("[Runner %zu] job %llu uses local files and no local worker runs; failing it", w->id, (unsigned long long)j.job_id);
+                        PRResult rr{};
+                        rr.job_id = j.job_id; rr.epoch = j.epoch; rr.worker_id = w->id; rr.accepted = true;
+                        rr.ps.ok = false;
+                        rr.ps.w_err = WERR_NeedsLocalFiles;
+                        out_->push(std::move(rr));
+                        continue;
+                    }
+                }
+
+                // A speculative copy whose job was answered while it sat in the queue
+                if (!note_dispatch(j.job_id, w->id)) {
+                    w->proc->release_slot();
+                    continue;
+                }
+
+                // Send one job. Slot stays held until reader_thread() sees the result.
+                const std::vector<uint8_t> budgets = j.job.learned_timeouts ? timeouts_.table(main_kind_) : std::vector<uint8_t>{};
+                w->last_sent = std::move(j);
+                if (!w->proc->send_job(w->last_sent.job_id, w->last_sent.epoch, w->last_sent.job, budgets)) {
+                    // send failed -> slot was released inside send_job(); the pipe is gone, treat as a crash
+                    SCLOGE("[Runner %zu] send_job failed (worker pipe)", w->id);
+                    unsent = true;
+                    break;
+                }
+            }
+
+            if (!recover_worker(*w, unsent)) return;
+        }
+    }
+
+    bool ParallelPhaseScriptRunner::pop_job(Worker& w, CmdJob& out)
+    {
+        if (w.proc->is_remote()) return w.jobs->pop_wait(out);
+        for (;;) {
+            if (local_jobs_->try_pop(out)) return true;
+            if (w.jobs->pop_wait_unless(out, [this] { return local_jobs_->size() != 0; })) return true;
+            if (w.jobs->closed()) return false;
+        }
+    }
+
+    bool ParallelPhaseScriptRunner::recover_worker(Worker& w, bool unsent)
+    {
+        if (!w.running.load() || stop_.load()) return false;  // shutting down, not a crash
+
+        const RespawnPolicy pol = respawn_policy();
+        {
+            // Once set, note_result() leaves the process alone, so no cancel writes to the pipes that
+            // stop()/start() close and reopen below.
+            std::lock_guard<std::mutex> lk(w.proc_m);
+            w.respawning.store(true);
+        }
+
+        if (!w.proc->exited()) w.proc->kill();  // pipe broken but still alive
+        SCLOGW("[Runner %zu] worker process exited (code=0x%08X)%s", w.id, w.proc->exit_code(),
+            pol.enabled ? "; respawning" : "");
+
+        requeue_lost_job(w, unsent);
+        w.proc->stop();
+
+        if (!pol.enabled) {
+            w.running.store(false);
+            return false;
+        }
+
+        for (;;) {
+            const uint32_t attempt = w.consecutive_respawns.fetch_add(1) + 1;
+            if (attempt > pol.max_consecutive) {
+                SCLOGE("[Runner %zu] %u respawns without a finished job; parking this worker", w.id, pol.max_consecutive);
+                w.running.store(false);
+                size_t alive = 0;
+                for (auto& o : workers_) if (o->running.load()) ++alive;
+                if (alive == 0) SCLOGE("[runner] no workers left; queued jobs will not complete");
+                return false;
+            }
+
+            Sleep(pol.backoff_ms * attempt);
+            if (!w.running.load() || stop_.load()) return false;
+
+            if (!w.proc->start(w.params, out_.get())) {
+                SCLOGE("[Runner %zu] respawn %u: failed to launch SimCoreWorker process", w.id, attempt);
+                continue;
+            }
+
+            const auto deadline = clock::now() + std::chrono::milliseconds(pol.ready_timeout_ms);
+            while (w.running.load() && !w.proc->is_ready() && !w.proc->is_failed() && !w.proc->exited()
+                && clock::now() < deadline)
+                Sleep(5);
+            if (!w.running.load() || stop_.load()) { w.proc->stop(); return false; }
+            if (!w.proc->is_ready()) {
+                SCLOGE("[Runner %zu] respawn %u: %s", w.id, attempt,
+                    w.proc->is_failed() ? "init failed" : w.proc->exited() ? "exited before READY" : "READY timed out");
+                if (!w.proc->exited()) w.proc->kill();
+                w.proc->stop();
+                continue;
+            }
+
+            // Bring it to the current program and epoch. Under prog_m_ so a concurrent set_program()
+            // either is replayed here or reaches this worker in its own broadcast, never neither.
+            bool ok = true;
+            {
+                std::lock_guard<std::mutex> lk(prog_m_);
+                if (program_.set) ok = w.proc->ctl_set_program(program_.init_kind, program_.main_kind, program_.init);
+                if (ok && program_.init_ran) ok = w.proc->ctl_run_init_once();
+                if (ok && program_.main_active) ok = w.proc->ctl_activate_main();
+                if (ok) {
+                    w.epoch = epoch_.load();
+                    std::lock_guard<std::mutex> plk(w.proc_m);
+                    w.respawning.store(false);
+                }
+            }
+            if (!ok) {
+                SCLOGE("[Runner %zu] respawn %u: replaying the program failed", w.id, attempt);
+                if (!w.proc->exited()) w.proc->kill();
+                w.proc->stop();
+                continue;
+            }
+
+            restarts_.fetch_add(1);
+            SCLOGI("[Runner %zu] respawned (attempt %u)", w.id, attempt);
+            return true;
+        }
+    }
+
+    void ParallelPhaseScriptRunner::requeue_lost_job(Worker& w, bool unsent)
+    {
+        const uint64_t lost = unsent ? w.last_sent.job_id : w.proc->in_flight_job();
+        if (lost == 0 || lost != w.last_sent.job_id) return;  // idle, or its result already arrived
+
+        CmdJob j = std::move(w.last_sent);
+        w.last_sent = CmdJob{};
+
+        switch (note_worker_lost(j.job_id, w.id, !unsent)) {
+        case LostJob::Requeue:
+            SCLOGW("[Runner %zu] re-queuing job %llu", w.id, (unsigned long long)j.job_id);
+            requeued_.fetch_add(1);
+            jobs_->push(std::move(j));
+            break;
+        case LostJob::Poisoned: {
+            SCLOGE("[Runner %zu] job %llu crashed its worker too often; failing it", w.id, (unsigned long long)j.job_id);
+            PRResult rr{};
+            rr.job_id = j.job_id; rr.epoch = j.epoch; rr.worker_id = w.id; rr.accepted = true;
+            rr.ps.ok = false;
+            rr.ps.w_err = WERR_WorkerCrashed;
+            out_->push(std::move(rr));
+            break;
+        }
+        case LostJob::Drop:
+            break;
+        }
+    }
+
     bool ParallelPhaseScriptRunner::set_program(uint8_t init_kind, uint8_t main_kind, const PSInit& init)
     {
+        std::lock_guard<std::mutex> lk(prog_m_);
+        program_ = ProgramState{ true, init_kind, main_kind, init };
+
+        main_kind_ = main_kind;
+        if (store_) {
+            state_hash_ = HashFileContents(init.savestate_path);
+            if (!init.savestate_path.empty() && state_hash_ == 0)
+                SCLOGW("[runner] could not hash savestate '%s'; cached results keyed as boot", init.savestate_path.c_str());
+            if (!init.shared_blob.empty()) state_hash_ = HashBytes(init.shared_blob, state_hash_);
+        }
+
         size_t ok = 0;
         for (auto& w : workers_) {
-            if (!w->running.load()) continue;
+            if (!w->running.load() || w->respawning.load()) continue;
             if (w->proc->ctl_set_program(init_kind, main_kind, init)) ++ok;
         }
         return ok > 0;
@@ -228,9 +465,11 @@ namespace simcore {
 
     bool ParallelPhaseScriptRunner::run_init_once()
     {
+        std::lock_guard<std::mutex> lk(prog_m_);
+        program_.init_ran = true;
         size_t ok = 0;
         for (auto& w : workers_) {
-            if (!w->running.load()) continue;
+            if (!w->running.load() || w->respawning.load()) continue;
             if (w->proc->ctl_run_init_once()) ++ok;
         }
         return ok > 0;
@@ -238,9 +477,11 @@ namespace simcore {
 
     bool ParallelPhaseScriptRunner::activate_main()
     {
+        std::lock_guard<std::mutex> lk(prog_m_);
+        program_.main_active = true;
         size_t ok = 0;
         for (auto& w : workers_) {
-            if (!w->running.load()) continue;
+            if (!w->running.load() || w->respawning.load()) continue;
             if (w->proc->ctl_activate_main()) ++ok;
         }
         return ok > 0;
@@ -249,42 +490,322 @@ namespace simcore {
     uint64_t ParallelPhaseScriptRunner::submit(const PSJob& job)
     {
         const uint64_t id = job_seq_.fetch_add(1) + 1;
+
+        ResultKey key;
+        if (store_ && MakeResultKey(state_hash_, main_kind_, job.payload, key)) {
+            PRResult cached{};
+            if (store_->lookup(key, cached.ps)) {
+                cached.job_id = id;
+                cached.epoch = epoch_.load();
+                cached.accepted = true;
+                cached.from_store = true;
+                out_->push(std::move(cached));
+                return id;
+            }
+            std::lock_guard<std::mutex> lk(store_m_);
+            pending_keys_[id] = std::move(key);
+        }
+
         CmdJob cj{ id, epoch_.load(), job };
+        {
+            std::lock_guard<std::mutex> lk(cost_m_);
+            if (cost_) cj.cost = cost_->estimate(job);
+        }
+        {
+            std::lock_guard<std::mutex> lk(spec_m_);
+            InFlight& f = inflight_[id];
+            f.epoch = cj.epoch;
+            if (spec_.enabled) f.job = job;
+            if (timeouts_.policy().enabled) f.timeout_key = HashBytes(job.payload, main_kind_);
+            f.learned_timeouts = job.learned_timeouts;
+        }
         jobs_->push(std::move(cj));
         return id;
     }
 
+    void ParallelPhaseScriptRunner::reset_job_ids()
+    {
+        job_seq_.store(0);
+        {
+            std::lock_guard<std::mutex> lk(store_m_);
+            pending_keys_.clear();
+        }
+        std::lock_guard<std::mutex> lk(spec_m_);
+        inflight_.clear();
+        resolved_.clear();
+        latencies_ms_.clear();
+        counters_ = PRTailStats{};
+        last_orig_dispatch_ = last_result_ = orig_end_ = clock::time_point{};
+    }
+
+    void ParallelPhaseScriptRunner::reset_tail_stats()
+    {
+        std::lock_guard<std::mutex> lk(spec_m_);
+        latencies_ms_.clear();
+        counters_ = PRTailStats{};
+        last_orig_dispatch_ = last_result_ = orig_end_ = clock::time_point{};
+    }
+
+    bool ParallelPhaseScriptRunner::note_dispatch(uint64_t job_id, size_t worker_id)
+    {
+        std::lock_guard<std::mutex> lk(spec_m_);
+        if (resolved_.count(job_id)) return false;
+
+        auto it = inflight_.find(job_id);
+        if (it == inflight_.end()) return true;  // untracked (ids reset while queued)
+
+        InFlight& f = it->second;
+        if (f.workers.empty() && f.original_worker == SIZE_MAX) {
+            const auto now = clock::now();
+            if (f.dispatched == clock::time_point{}) f.dispatched = now;  // a crash re-run keeps its first dispatch time
+            f.original_worker = worker_id;
+            last_orig_dispatch_ = now;
+        }
+        f.workers.push_back(worker_id);
+        return true;
+    }
+
+    ParallelPhaseScriptRunner::LostJob ParallelPhaseScriptRunner::note_worker_lost(uint64_t job_id, size_t worker_id, bool crashed)
+    {
+        std::lock_guard<std::mutex> lk(spec_m_);
+        if (resolved_.count(job_id)) return LostJob::Drop;  // a losing copy; the job was answered
+
+        auto it = inflight_.find(job_id);
+        if (it == inflight_.end()) return LostJob::Requeue;  // untracked (ids reset while queued)
+
+        InFlight& f = it->second;
+        f.workers.erase(std::remove(f.workers.begin(), f.workers.end(), worker_id), f.workers.end());
+        if (crashed) ++f.crashes;
+        if (!f.workers.empty()) return LostJob::Drop;  // a speculative copy is still running elsewhere
+
+        if (f.original_worker == worker_id) f.original_worker = SIZE_MAX;  // the re-run becomes the original
+        if (crashed && f.crashes >= respawn_.max_job_crashes) return LostJob::Poisoned;
+        return LostJob::Requeue;
+    }
+
+    bool ParallelPhaseScriptRunner::note_result(const PRResult& r)
+    {
+        std::vector<size_t> losers;
+        uint64_t epoch = 0;
+        {
+            std::lock_guard<std::mutex> lk(spec_m_);
+            const auto now = clock::now();
+
+            if (auto rs = resolved_.find(r.job_id); rs != resolved_.end()) {
+                // Losing copy. With measure_baseline the original was left running to time the no-speculation tail.
+                if (rs->second == r.worker_id && r.ps.w_err != WERR_Cancelled) orig_end_ = std::max(orig_end_, now);
+                return false;
+            }
+
+            auto it = inflight_.find(r.job_id);
+            if (it == inflight_.end()) return true;
+            InFlight f = std::move(it->second);
+            inflight_.erase(it);
+
+            if (f.dispatched != clock::time_point{}) {
+                latencies_ms_.push_back((uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - f.dispatched).count());
+                last_result_ = std::max(last_result_, now);
+            }
+
+            const bool copy_won = f.original_worker != SIZE_MAX && r.worker_id != f.original_worker;
+            if (copy_won) ++counters_.spec_wins;
+            if (!copy_won || !spec_.measure_baseline) orig_end_ = std::max(orig_end_, now);
+            if (copy_won && !spec_.measure_baseline) counters_.no_spec_exact = false;
+
+            for (size_t wid : f.workers) {
+                if (wid == r.worker_id) continue;
+                if (copy_won && wid == f.original_worker && spec_.measure_baseline) continue;
+                losers.push_back(wid);
+            }
+            if (f.copies > 0) resolved_.emplace(r.job_id, f.original_worker);
+            counters_.cancelled += losers.size();
+            epoch = f.epoch;
+        }
+
+        for (size_t wid : losers) {
+            // Under the worker's process lock: its dispatcher may be replacing the process. A worker
+            // being respawned already lost the copy, so there is nothing to cancel.
+            Worker& w = *workers_.at(wid);
+            std::lock_guard<std::mutex> lk(w.proc_m);
+            if (w.respawning.load()) continue;
+            if (!w.proc->send_cancel(r.job_id, epoch))
+                SCLOGW("[runner] cancel of job %llu on worker %zu failed", (unsigned long long)r.job_id, wid);
+        }
+        return true;
+    }
+
+    void ParallelPhaseScriptRunner::speculator_loop()
+    {
+        set_this_thread_name_utf8("Speculator");
+        cpu::PinCurrentThread(placement_.parent);
+
+        while (!stop_.load()) {
+            SpeculationPolicy pol = speculation();
+            Sleep(pol.poll_ms ? pol.poll_ms : 50);
+            if (!pol.enabled || jobs_->size() != 0 || local_jobs_->size() != 0) continue;
+
+            size_t idle = 0;
+            for (auto& w : workers_)
+                if (w->running.load() && !w->respawning.load() && w->proc->is_ready() && w->proc->has_slot()) ++idle;
+            if (idle == 0) continue;
+
+            std::vector<CmdJob> copies;
+            {
+                std::lock_guard<std::mutex> lk(spec_m_);
+                uint32_t median = 0;
+                if (!latencies_ms_.empty()) {
+                    std::vector<uint32_t> l = latencies_ms_;
+                    std::nth_element(l.begin(), l.begin() + l.size() / 2, l.end());
+                    median = l[l.size() / 2];
+                }
+                const auto threshold = std::chrono::milliseconds(
+                    std::max<uint64_t>(pol.min_elapsed_ms, (uint64_t)(pol.slow_factor * median)));
+
+                // Longest-running first
+                const auto now = clock::now();
+                std::vector<std::pair<clock::duration, uint64_t>> cand;
+                for (auto& [id, f] : inflight_) {
+                    if (f.workers.empty() || f.copies >= pol.max_copies || f.epoch != epoch_.load()) continue;
+                    if (f.job.payload.empty()) continue;  // submitted before speculation was enabled
+                    const auto el = now - f.dispatched;
+                    if (el >= threshold) cand.emplace_back(el, id);
+                }
+                std::sort(cand.begin(), cand.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+                if (cand.size() > idle) cand.resize(idle);
+
+                for (auto& [el, id] : cand) {
+                    InFlight& f = inflight_[id];
+                    ++f.copies;
+                    ++counters_.speculated;
+                    copies.push_back(CmdJob{ id, f.epoch, f.job, std::numeric_limits<double>::infinity() });  // ahead of anything queued
+                    SCLOGI("[runner] speculative copy of job %llu after %lld ms",
+                        (unsigned long long)id, (long long)std::chrono::duration_cast<std::chrono::milliseconds>(el).count());
+                }
+            }
+            for (auto& c : copies) jobs_->push(std::move(c));
+        }
+    }
+
+    PRTailStats ParallelPhaseScriptRunner::tail_stats() const
+    {
+        std::lock_guard<std::mutex> lk(spec_m_);
+        PRTailStats t = counters_;
+        t.jobs = latencies_ms_.size();
+        if (!latencies_ms_.empty()) {
+            std::vector<uint32_t> l = latencies_ms_;
+            std::sort(l.begin(), l.end());
+            t.p50_ms = l[l.size() / 2];
+            t.p99_ms = l[std::min(l.size() - 1, (l.size() * 99) / 100)];
+            t.max_ms = l.back();
+        }
+        auto span = [&](clock::time_point end) -> uint32_t {
+            if (last_orig_dispatch_ == clock::time_point{} || end < last_orig_dispatch_) return 0;
+            return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(end - last_orig_dispatch_).count();
+        };
+        t.tail_ms = span(last_result_);
+        t.tail_ms_no_spec = span(std::max(orig_end_, last_result_));
+        return t;
+    }
+
     bool ParallelPhaseScriptRunner::try_get_result(PRResult& outv)
     {
-        bool popped = out_->try_pop(outv);
-        if (popped) workers_.at(outv.worker_id)->jobs_done++;  // WARNING: to keep this in sync, never remove a worker from this vector, only add new ones.
-        return popped;
+        // A losing speculative copy is dropped and the next result tried, so a ready winner
+        // queued behind it is not reported as "nothing yet".
+        for (;;) {
+            if (!out_->try_pop(outv)) return false;
+            if (outv.from_store) return true;
+
+            Worker& w = *workers_.at(outv.worker_id);  // WARNING: to keep this in sync, never remove a worker from this vector, only add new ones.
+            w.jobs_done++;
+            if (outv.accepted && outv.ps.w_err != WERR_WorkerCrashed) w.consecutive_respawns.store(0);
+
+            if (outv.accepted) {
+                uint64_t tkey = 0;
+                bool learned = true;
+                {
+                    std::lock_guard<std::mutex> lk(spec_m_);
+                    if (auto it = inflight_.find(outv.job_id); it != inflight_.end()) {
+                        tkey = it->second.timeout_key;
+                        learned = it->second.learned_timeouts;
+                    }
+                }
+                timeouts_.observe(main_kind_, outv.ps.ctx, tkey, learned);
+            }
+            if (!note_result(outv)) continue;  // losing speculative copy; the winner was already delivered
+
+            if (store_) {
+                ResultKey key;
+                {
+                    std::lock_guard<std::mutex> lk(store_m_);
+                    auto it = pending_keys_.find(outv.job_id);
+                    if (it == pending_keys_.end()) return true;
+                    key = std::move(it->second);
+                    pending_keys_.erase(it);
+                }
+                // Only completed runs are memoized; NACKs and worker-side errors must be retried.
+                if (outv.accepted && outv.ps.ok && outv.ps.w_err == WERR_None)
+                    (void)store_->append(key, outv.ps);
+            }
+            return true;
+        }
     }
 
     PRStatus ParallelPhaseScriptRunner::status() const
     {
         PRStatus s{};
         s.epoch = epoch_.load();
-        s.queued_jobs = jobs_->size();
+        s.queued_jobs = jobs_->size() + local_jobs_->size();
         size_t rw = 0;
-        for (auto& w : workers_) if (w->running.load()) ++rw;
+        size_t ready = 0;
+        for (auto& w : workers_) {
+            if (!w->running.load()) continue;
+            ++rw;
+            if (w->proc && w->proc->is_ready()) ++ready;
+        }
         s.running_workers = rw;
+        s.ready_workers = ready;
         s.workers = workers_.size();
+        s.worker_restarts = restarts_.load();
+        s.jobs_requeued = requeued_.load();
         return s;
     }
 
+    bool ParallelPhaseScriptRunner::has_active_workers() const
+    {
+        for (auto& w : workers_) {
+            if (!w->running.load()) continue;
+            if (w->proc && w->proc->is_failed() && !w->respawning.load()) continue;
+            return true;
+        }
+        return false;
+    }
+
+    bool ParallelPhaseScriptRunner::has_active_local_workers() const
+    {
+        for (size_t i = 0; i < local_workers_ && i < workers_.size(); ++i) {
+            const auto& w = workers_[i];
+            if (!w->running.load()) continue;
+            if (w->proc && w->proc->is_failed() && !w->respawning.load()) continue;
+            return true;
+        }
+        return false;
+    }
+
     void ParallelPhaseScriptRunner::stop()
     {
         if (stop_.exchange(true)) return;
+        local_jobs_->close();
         jobs_->close();
+        for (auto& w : workers_) w->running.store(false);
+        // Dispatchers first: one may be respawning its process, and only it may touch that ProcessWorker then.
         for (auto& w : workers_) {
-            if (w->running.exchange(false)) {
-                if (w->proc) w->proc->stop();
-            }
+            if (w->th.joinable()) w->th.join();
         }
         for (auto& w : workers_) {
-            if (w->th.joinable()) w->th.join();
+            if (w->proc) w->proc->stop();
         }
+        for (auto& a : agents_) a->stop();
+        if (spec_th_.joinable()) spec_th_.join();
     }
 
 } // namespace simcore
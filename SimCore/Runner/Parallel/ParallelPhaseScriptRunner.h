@@ -4,6 +4,8 @@
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <chrono>
+#include <unordered_map>
 
 #include "../Script/PhaseScriptVM.h"
 #include "../Breakpoints/BPRegistry.h"
@@ -11,12 +13,30 @@
 #include "TSQueue.h"
 #include "PRTypes.h"
 #include "ProcessWorker.h"
+#include "ResultStore.h"
+#include "TimeoutModel.h"
+#include "JobCost.h"
+#include "AgentLink.h"
 
 namespace simcore {
 
     struct BootPlan {
         simboot::BootOptions boot;  // user_dir, dolphin_qt_base, force_p1_standard_pad, etc.
         std::string iso_path;       // game disc to load (no changes after start)
+
+        // Remote pools: every slot of every reachable SimCoreWorkerAgent becomes an extra worker after the
+        // local ones. The ISO and savestates are staged on the agents by content hash on first use.
+        std::vector<AgentEndpoint> agents;
+        AgentLinkOptions agent_options;
+
+        // CPU placement of the local workers (off by default): one physical core per worker with the
+        // emulated CPU thread on its primary logical processor and the worker's other threads on the
+        // SMT siblings; dispatcher, reader and speculator threads stay on the reserved parent cores.
+        cpu::AffinityPolicy affinity;
+
+        // Local workers link their User dirs from one snapshot of the Qt base's User under
+        // <user_dir>/base instead of each copying the whole tree (see SharedUserBase.h).
+        bool shared_user_base{ true };
     };
 
     class ParallelPhaseScriptRunner {
@@ -29,6 +49,9 @@ namespace simcore {
         uint64_t submit(const PSJob& job); // enqueues with current epoch, returns job_id
         bool try_get_result(PRResult& out);
         PRStatus status() const;
+        // False once no worker can take jobs: each one is stopped, parked after too many respawns, or
+        // failed its init. Jobs still queued then never complete; collectors use this to stop waiting.
+        bool has_active_workers() const;
         void stop();
 
         bool set_program(uint8_t init_kind, uint8_t main_kind, const PSInit&);  // MSG_SET_PROGRAM to all
@@ -36,9 +59,38 @@ namespace simcore {
         bool activate_main();                                                   // MSG_ACTIVATE_MAIN to all
 
         inline void increment_epoch() { epoch_.fetch_add(1); for (auto& w : workers_) w->epoch = epoch_.load(); }
-        inline void reset_job_ids() { job_seq_.store(0); }
+        void reset_job_ids();
+
+        // Speculative duplicate execution of stragglers (off by default). Safe to change between batches.
+        void set_speculation(const SpeculationPolicy& p) { std::lock_guard<std::mutex> lk(spec_m_); spec_ = p; }
+        SpeculationPolicy speculation() const { std::lock_guard<std::mutex> lk(spec_m_); return spec_; }
+
+        // Latency/tail numbers for the jobs collected since the last reset_tail_stats()/reset_job_ids().
+        PRTailStats tail_stats() const;
+        void reset_tail_stats();
+
+        // Memoization: when a store is attached, submit() answers jobs whose (savestate, program, payload)
+        // key is already recorded by pushing a from_store result straight to the result queue, and
+        // successful worker results are appended as they are drained by try_get_result().
+        // The savestate hash is taken at set_program(), so attach the store before calling it.
+        void attach_result_store(std::shared_ptr<ResultStore> store) { store_ = std::move(store); }
+        ResultStore* result_store() const { return store_.get(); }
+
+        // Crash recovery (on by default); see RespawnPolicy. Safe to change between batches.
+        void set_respawn_policy(const RespawnPolicy& p) { std::lock_guard<std::mutex> lk(spec_m_); respawn_ = p; }
+        RespawnPolicy respawn_policy() const { std::lock_guard<std::mutex> lk(spec_m_); return respawn_; }
+
+        // Learned per-segment timeouts (TimeoutModel::set_policy to enable). Every worker result feeds the
+        // model; jobs with PSJob::learned_timeouts get the current budgets for the active main program.
+        TimeoutModel& timeout_model() { return timeouts_; }
+
+        // Queue order: jobs of older epochs first (they are only NACKed), then highest estimated cost,
+        // then submission order. Without an estimator every job costs 0, i.e. plain FIFO.
+        void set_cost_estimator(std::shared_ptr<IJobCostEstimator> est) { std::lock_guard<std::mutex> lk(cost_m_); cost_ = std::move(est); }
 
         inline uint32_t worker_count() { return static_cast<uint32_t>(workers_.size()); }
+        const std::vector<std::shared_ptr<AgentLink>>& agents() const { return agents_; }
+        const cpu::PlacementPlan& placement() const { return placement_; }  // as planned by start()
 
         bool try_get_progress(size_t worker_id, PRProgress& out) const {
             std::lock_guard<std::mutex> lk(progress_m_);
@@ -49,7 +101,15 @@ namespace simcore {
         }
 
     private:
-        struct CmdJob { uint64_t job_id; uint64_t epoch; PSJob job; };
+        struct CmdJob { uint64_t job_id; uint64_t epoch; PSJob job; double cost{ 0.0 }; };
+        struct CmdJobOrder {
+            bool operator()(const CmdJob& a, const CmdJob& b) const {  // true => b dispatches before a
+                if (a.epoch != b.epoch) return a.epoch > b.epoch;
+                if (a.cost != b.cost) return a.cost < b.cost;
+                return a.job_id > b.job_id;
+            }
+        };
+        using JobQueue = TSPriorityQueue<CmdJob, CmdJobOrder>;
         enum class CtrlType { Start, Reconfigure, Shutdown };
         struct CtrlStart { uint64_t epoch; BootPlan boot; PSInit init; PhaseScript program; };
         struct CtrlReconfig { uint64_t epoch; PSInit init; PhaseScript program; };
@@ -63,21 +123,94 @@ namespace simcore {
             std::thread th;
             uint64_t epoch{ 0 };
             std::atomic<bool> running{ false };
+            std::atomic<bool> respawning{ false };      // process being replaced; skipped by broadcasts
+            std::mutex proc_m;                          // flips `respawning` vs. cancels sent from the collector
+            std::atomic<uint32_t> consecutive_respawns{ 0 };
             std::atomic<uint64_t> jobs_done{ 0 };
-            TSQueue<CmdJob>* jobs{ nullptr };
+            ProcStartParams params;                     // kept to respawn the process as it was started
+            CmdJob last_sent{};                         // dispatcher-owned copy of the job on the wire
+            JobQueue* jobs{ nullptr };
             TSQueue<PRResult>* out{ nullptr };
         };
 
         std::vector<std::unique_ptr<TSQueue<CtrlCmd>>> ctrls_;
-        std::unique_ptr<TSQueue<CmdJob>> jobs_;
+        std::unique_ptr<JobQueue> jobs_;
+        std::unique_ptr<JobQueue> local_jobs_;  // jobs that need this host's files; only local workers pop it
         std::unique_ptr<TSQueue<PRResult>> out_;
         std::vector<std::unique_ptr<Worker>> workers_;
+        std::vector<std::shared_ptr<AgentLink>> agents_;
+        size_t local_workers_{ 0 };             // workers_[0, local_workers_) run on this host
+        cpu::PlacementPlan placement_;
         std::atomic<bool> stop_{ false };
         std::atomic<uint64_t> job_seq_{ 0 };
         std::atomic<uint64_t> epoch_{ 0 };
 
+        std::shared_ptr<ResultStore> store_;
+        uint64_t state_hash_{ 0 };
+        uint8_t main_kind_{ 0 };
+        std::unordered_map<uint64_t, ResultKey> pending_keys_;  // job_id -> key, for jobs sent to workers
+        std::mutex store_m_;
+
+        // What every (re)started worker must replay to reach the current program
+        struct ProgramState {
+            bool set{ false };
+            uint8_t init_kind{ 0 };
+            uint8_t main_kind{ 0 };
+            PSInit init;
+            bool init_ran{ false };
+            bool main_active{ false };
+        };
+        ProgramState program_;
+        std::mutex prog_m_;  // held across broadcasts and respawn replays so both see one program
+
+        Worker& add_worker();
+        void dispatcher_loop(Worker* w);
+        bool recover_worker(Worker& w, bool unsent);  // false => worker parked, dispatcher exits
+        bool pop_job(Worker& w, CmdJob& out);         // false => queues closed
+        bool has_active_local_workers() const;
+        void requeue_lost_job(Worker& w, bool unsent);
+
+        enum class LostJob { Requeue, Drop, Poisoned };
+        LostJob note_worker_lost(uint64_t job_id, size_t worker_id, bool crashed);
+
+        RespawnPolicy respawn_;
+        std::atomic<uint64_t> restarts_{ 0 };
+        std::atomic<uint64_t> requeued_{ 0 };
+
         std::unordered_map<size_t, PRProgress> last_progress_;
         mutable std::mutex progress_m_;
+
+        // --- in-flight tracking (latency + speculation) ---
+        using clock = std::chrono::steady_clock;
+        struct InFlight {
+            uint64_t epoch{ 0 };
+            PSJob job;                       // kept to re-queue a copy
+            clock::time_point dispatched{};  // first send to a worker
+            std::vector<size_t> workers;     // workers running a copy
+            size_t original_worker{ SIZE_MAX };
+            uint32_t copies{ 0 };
+            uint32_t crashes{ 0 };           // workers that died running it
+            uint64_t timeout_key{ 0 };       // payload hash the TimeoutModel matches retries on (0 => policy off)
+            bool learned_timeouts{ true };
+        };
+
+        bool note_dispatch(uint64_t job_id, size_t worker_id);  // false => job already answered, skip it
+        bool note_result(const PRResult& r);                    // false => losing copy, drop it
+        void speculator_loop();
+
+        TimeoutModel timeouts_;
+
+        std::shared_ptr<IJobCostEstimator> cost_;
+        std::mutex cost_m_;
+
+        SpeculationPolicy spec_;
+        std::unordered_map<uint64_t, InFlight> inflight_;
+        std::unordered_map<uint64_t, size_t> resolved_;  // job_id -> original worker, for copies still out
+        std::vector<uint32_t> latencies_ms_;
+        clock::time_point last_orig_dispatch_{}, last_result_{}, orig_end_{};
+        PRTailStats counters_{};
+        mutable std::mutex spec_m_;
+        std::thread spec_th_;
     };
 
 } // namespace simcore
@@ -4,10 +4,11 @@
 #include "../../Utils/ThreadName.h"
 #include "../Script/KeyRegistry.h"
 #include "../Script/PSContextCodec.h"
+#include "AgentLink.h"
 
 namespace simcore {
 
-    static bool CreateChild(const ProcStartParams& p,
+    bool SpawnWorkerProcess(const ProcStartParams& p,
         HANDLE& hInWrite, HANDLE& hOutRead,
         HANDLE& hProcess, HANDLE& hThread,
         unsigned long& dwProcessId)
@@ -35,8 +36,14 @@ namespace simcore {
             << " --id " << p.worker_id
             << " --iso \"" << p.iso_path << "\""
             << " --qtbase \"" << p.qt_base_dir << "\""
-            << " --userdir \"" << p.user_dir << "\""
+            << " --userdir \"" << p.user_dir << "\"";
+        if (!p.user_base.empty())
+            cmd << " --userbase \"" << p.user_base << "\"";
+        cmd
             << " --vmctrl";
+        if (p.placement.pinned())
+            cmd << " --cpu-emu " << p.placement.emu.to_string()
+                << " --cpu-aux " << p.placement.aux.to_string();
 
         PROCESS_INFORMATION pi{};
         std::string cmdline = cmd.str();
@@ -66,13 +73,26 @@ namespace simcore {
     {
         out_ = outq;
         id_ = p.worker_id;
-        if (!CreateChild(p, hChildStd_IN_Wr, hChildStd_OUT_Rd, hProcess, hThread, dwProcessId))
+        agent_ = p.agent;
+        agent_slot_ = p.agent_slot;
+        parent_cpus_ = p.parent_cpus;
+        if (agent_) {
+            std::string err;
+            if (!agent_->open_slot(agent_slot_, (uint32_t)p.worker_id, p.iso_path, hChildStd_IN_Wr, hChildStd_OUT_Rd, hProcess, &err)) {
+                SCLOGE("[worker %zu] agent %s slot %u: %s", id_, agent_->endpoint().c_str(), agent_slot_, err.c_str());
+                return false;
+            }
+            hThread = NULL;
+            dwProcessId = 0;
+        }
+        else if (!SpawnWorkerProcess(p, hChildStd_IN_Wr, hChildStd_OUT_Rd, hProcess, hThread, dwProcessId))
             return false;
 
         running_.store(true);
         ready_received_.store(false);
         ready_ok_.store(false);
         ready_error_.store(0);
+        inflight_job_.store(0);
         busy_.store(false);
 
         reader_ = std::thread(&ProcessWorker::reader_thread, this);
@@ -105,18 +125,23 @@ namespace simcore {
     static bool write_job_envelope(HANDLE h,
         uint64_t job_id,
         uint64_t epoch,
-        const std::vector<uint8_t>& payload)
+        const std::vector<uint8_t>& payload,
+        const std::vector<uint8_t>& timeouts)
     {
         WireJobHeader hdr{};
         hdr.tag = MSG_JOB;
         hdr.job_id = job_id;
         hdr.epoch = static_cast<uint32_t>(epoch);
         hdr.payload_len = static_cast<uint32_t>(payload.size());
+        hdr.timeouts_len = static_cast<uint32_t>(timeouts.size());
         if (!write_all(h, &hdr.tag, sizeof(hdr.tag))) return false;
         if (!write_all(h, &hdr, sizeof(hdr))) return false;
         if (hdr.payload_len) {
             if (!write_all(h, payload.data(), payload.size())) return false;
         }
+        if (hdr.timeouts_len) {
+            if (!write_all(h, timeouts.data(), timeouts.size())) return false;
+        }
         return true;
     }
 
@@ -137,19 +162,34 @@ namespace simcore {
         sp.main_kind = main_kind;
         sp.timeout_ms = init.default_timeout_ms;
         sp.buff_kind = (uint8_t)init.derived_buffer_type;
+        sp.shared_len = (uint32_t)init.shared_blob.size();
+
+        // A remote worker gets the agent's cached copy of the savestate
+        std::string savestate = init.savestate_path;
+        if (agent_ && !savestate.empty()) {
+            std::string err;
+            savestate = agent_->stage_file(init.savestate_path, &err);
+            if (savestate.empty()) {
+                SCLOGE("[worker %zu] staging savestate on agent failed: %s", id_, err.c_str());
+                return false;
+            }
+        }
 
         std::memset(sp.savestate_path, 0, sizeof(sp.savestate_path));
-        if (!init.savestate_path.empty()) {
-            if (!copy_cstr_nt(sp.savestate_path, init.savestate_path)) {
+        if (!savestate.empty()) {
+            if (!copy_cstr_nt(sp.savestate_path, savestate)) {
                 SCLOGW("[worker %zu] savestate_path truncated", id_);
             }
         }
 
         ack_.request('S');
-        if (!write_all(hChildStd_IN_Wr, &sp, sizeof(sp))) {
+        std::unique_lock<std::mutex> wl(wr_m_);
+        if (!write_all(hChildStd_IN_Wr, &sp, sizeof(sp)) ||
+            (sp.shared_len && !write_all(hChildStd_IN_Wr, init.shared_blob.data(), init.shared_blob.size()))) {
             ack_.cancel_all();
             return false;
         }
+        wl.unlock();
         // wait for MSG_ACK(code='S') by reader_thread
         return ack_.wait_for(init.default_timeout_ms ? init.default_timeout_ms : 10000);
     }
@@ -157,9 +197,12 @@ namespace simcore {
     bool ProcessWorker::ctl_run_init_once() {
         const uint32_t tag = MSG_RUN_INIT_ONCE;
         ack_.request('I');
-        if (!write_all(hChildStd_IN_Wr, &tag, sizeof(tag))) {
-            ack_.cancel_all();
-            return false;
+        {
+            std::lock_guard<std::mutex> wl(wr_m_);
+            if (!write_all(hChildStd_IN_Wr, &tag, sizeof(tag))) {
+                ack_.cancel_all();
+                return false;
+            }
         }
         return ack_.wait_for(10000);
     }
@@ -167,19 +210,24 @@ namespace simcore {
     bool ProcessWorker::ctl_activate_main() {
         const uint32_t tag = MSG_ACTIVATE_MAIN;
         ack_.request('A');
-        if (!write_all(hChildStd_IN_Wr, &tag, sizeof(tag))) {
-            ack_.cancel_all();
-            return false;
+        {
+            std::lock_guard<std::mutex> wl(wr_m_);
+            if (!write_all(hChildStd_IN_Wr, &tag, sizeof(tag))) {
+                ack_.cancel_all();
+                return false;
+            }
         }
         return ack_.wait_for(10000);
     }
 
-    bool ProcessWorker::send_job(uint64_t job_id, uint64_t epoch, const PSJob& job)
+    bool ProcessWorker::send_job(uint64_t job_id, uint64_t epoch, const PSJob& job, const std::vector<uint8_t>& timeouts)
     {
         if (!running_.load()) return false;
 
         // PSJob now owns the already-encoded payload bytes (first byte == PK_*)
-        if (!write_job_envelope(hChildStd_IN_Wr, job_id, epoch, job.payload))
+        std::lock_guard<std::mutex> wl(wr_m_);
+        inflight_job_.store(job_id);
+        if (!write_job_envelope(hChildStd_IN_Wr, job_id, epoch, job.payload, timeouts))
         {
             release_slot();
             return false;
@@ -187,6 +235,19 @@ namespace simcore {
         return true;
     }
 
+    bool ProcessWorker::send_cancel(uint64_t job_id, uint64_t epoch)
+    {
+        if (!running_.load()) return false;
+
+        WireCancel wc{};
+        wc.tag = MSG_CANCEL;
+        wc.job_id = job_id;
+        wc.epoch = static_cast<uint32_t>(epoch);
+
+        std::lock_guard<std::mutex> wl(wr_m_);
+        return write_all(hChildStd_IN_Wr, &wc, sizeof(wc));
+    }
+
     bool ProcessWorker::wait_ready(uint32_t timeout_ms)
     {
         const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms ? timeout_ms : 10000);
@@ -194,6 +255,7 @@ namespace simcore {
             if (ready_received_.load()) {
                 return ready_ok_.load();
             }
+            if (!running_.load()) return false;  // child exited before READY
             std::this_thread::sleep_for(std::chrono::milliseconds(5));
         }
         return false;
@@ -202,6 +264,7 @@ namespace simcore {
     void ProcessWorker::reader_thread()
     {
         set_this_thread_name_utf8((std::string("WorkerReader-") + std::to_string(id_)).c_str());
+        cpu::PinCurrentThread(parent_cpus_);
 
         for (;;) {
             uint8_t tag = 0;
@@ -241,6 +304,8 @@ namespace simcore {
                     break; 
                 }
 
+                uint64_t expected = wr.job_id;
+                inflight_job_.compare_exchange_strong(expected, 0);
                 release_slot();
 
                 PRResult r{};
@@ -301,10 +366,30 @@ namespace simcore {
         running_.store(false);
     }
 
+    uint32_t ProcessWorker::exit_code() const
+    {
+        if (agent_) return agent_->slot_exit_code(agent_slot_);
+        DWORD code = 0;
+        if (!hProcess || !GetExitCodeProcess(hProcess, &code)) return 0;
+        return code;
+    }
+
+    void ProcessWorker::kill()
+    {
+        if (agent_) agent_->close_slot(agent_slot_);
+        else if (hProcess) TerminateProcess(hProcess, 1);
+    }
+
     void ProcessWorker::stop()
     {
-        if (!running_.exchange(false)) return;
-        if (hChildStd_IN_Wr) { CloseHandle(hChildStd_IN_Wr); hChildStd_IN_Wr = NULL; }
+        // The reader clears running_ when the child's pipe breaks, so also tear down on that path;
+        // only a fully stopped worker (no reader, no process handle) is a no-op.
+        const bool was_running = running_.exchange(false);
+        if (!was_running && !reader_.joinable() && !hProcess) return;
+        {
+            std::lock_guard<std::mutex> wl(wr_m_);  // send_cancel() may be writing from another thread
+            if (hChildStd_IN_Wr) { CloseHandle(hChildStd_IN_Wr); hChildStd_IN_Wr = NULL; }
+        }
         if (reader_.joinable()) reader_.join();
         if (hChildStd_OUT_Rd) { CloseHandle(hChildStd_OUT_Rd); hChildStd_OUT_Rd = NULL; }
         if (hThread) { CloseHandle(hThread); hThread = NULL; }
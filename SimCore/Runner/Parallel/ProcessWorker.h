@@ -4,25 +4,41 @@
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
+#include <memory>
 #include <windows.h>
 #include "../../Core/Input/InputPlan.h"
 #include "../Script/PhaseScriptVM.h"  // for PSResult
 #include "TSQueue.h"
 #include "PRTypes.h"
 #include "../Breakpoints/BPRegistry.h"
+#include "../../Utils/CpuAffinity.h"
 
 
 namespace simcore {
 
+	class AgentLink;
+
 	struct ProcStartParams {
 		size_t worker_id{ 0 };
 		std::string exe_path;     // path to SimCoreSandbox.exe
 		std::string iso_path;
 		std::string qt_base_dir;
 		std::string user_dir;     // unique per worker
+		std::string user_base;    // shared User snapshot to link user_dir from; empty => copy the Qt base
 		bool vm_control{ false };
+		std::shared_ptr<AgentLink> agent;  // set: run in slot agent_slot of a SimCoreWorkerAgent instead of locally
+		uint32_t agent_slot{ 0 };
+		cpu::WorkerPlacement placement;    // local workers only; passed as --cpu-emu/--cpu-aux
+		cpu::CpuMask parent_cpus;          // where this worker's reader thread runs in the coordinator
 	};
 
+	// Launches `p.exe_path --worker ...` with its stdin/stdout on anonymous pipes (parent ends returned).
+	// Used by ProcessWorker and by SimCoreWorkerAgent for its local slots.
+	bool SpawnWorkerProcess(const ProcStartParams& p,
+		HANDLE& hInWrite, HANDLE& hOutRead,
+		HANDLE& hProcess, HANDLE& hThread,
+		unsigned long& dwProcessId);
+
 	struct AckWait
 	{
 		std::mutex m;
@@ -70,7 +86,8 @@ namespace simcore {
 		~ProcessWorker();
 
 		bool start(ProcStartParams& p, TSQueue<PRResult>* out_queue);
-		bool send_job(uint64_t job_id, uint64_t epoch, const PSJob& job);
+		bool send_job(uint64_t job_id, uint64_t epoch, const PSJob& job, const std::vector<uint8_t>& timeouts = {});
+		bool send_cancel(uint64_t job_id, uint64_t epoch);  // MSG_CANCEL; the result still arrives (WERR_Cancelled)
 		void stop();
 
 		bool ctl_set_program(uint8_t init_kind, uint8_t main_kind, const PSInit& init);
@@ -82,6 +99,15 @@ namespace simcore {
 		uint32_t ready_error() const { return ready_error_.load(); }
 		HANDLE process_handle() const { return hProcess; }
 
+		// True once the child process has terminated (crash, kill, or stop()). For an agent slot,
+		// hProcess is an event the AgentLink signals when the remote worker or the link goes away.
+		bool exited() const { return !hProcess || WaitForSingleObject(hProcess, 0) == WAIT_OBJECT_0; }
+		uint32_t exit_code() const;
+		void kill();  // TerminateProcess, or retire the agent slot
+		bool is_remote() const { return agent_ != nullptr; }
+		// Job sent and not yet answered (0: none). Still set after the child died mid-job.
+		uint64_t in_flight_job() const { return inflight_job_.load(); }
+
 		bool try_acquire_slot() {
 			bool expected = false;
 			return busy_.compare_exchange_strong(expected, true, std::memory_order_acq_rel);
@@ -113,14 +139,19 @@ namespace simcore {
 		std::thread reader_;
 		TSQueue<PRResult>* out_{ nullptr };
 		size_t id_{ 0 };
+		std::shared_ptr<AgentLink> agent_;
+		uint32_t agent_slot_{ 0 };
+		cpu::CpuMask parent_cpus_;
 		std::atomic<bool> running_{ false };
 		
 		std::atomic<bool> busy_{ false };           // true if a job is in-flight
 		std::atomic<bool> ready_received_{ false }; // we saw MSG_READY
 		std::atomic<bool> ready_ok_{ false };       // MSG_READY.ok
 		std::atomic<uint32_t> ready_error_{ 0 };    // MSG_READY.error
+		std::atomic<uint64_t> inflight_job_{ 0 };
 
 		AckWait ack_;
+		std::mutex wr_m_;  // serializes writes to the child's stdin (dispatcher vs. cancel)
 
 		// Progress storage (per worker, last only)
 		mutable std::mutex progress_m_;
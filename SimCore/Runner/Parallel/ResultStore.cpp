@@ -0,0 +1,296 @@
+#include "ResultStore.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "../Script/PSContextCodec.h"
+#include "../../Phases/Programs/ProgramRegistry.h"
+#include "../../Utils/Log.h"
+
+namespace simcore {
+
+    static constexpr uint64_t FNV_OFFSET = 1469598103934665603ull;
+    static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+    static inline uint64_t fnv1a(uint64_t h, const uint8_t* p, size_t n) {
+        for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= FNV_PRIME; }
+        return h;
+    }
+
+    static inline void put_u16(std::vector<uint8_t>& b, uint16_t v) {
+        b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8));
+    }
+    static inline void put_u32(std::vector<uint8_t>& b, uint32_t v) {
+        b.push_back(uint8_t(v)); b.push_back(uint8_t(v >> 8)); b.push_back(uint8_t(v >> 16)); b.push_back(uint8_t(v >> 24));
+    }
+    static inline void put_u64(std::vector<uint8_t>& b, uint64_t v) {
+        put_u32(b, uint32_t(v)); put_u32(b, uint32_t(v >> 32));
+    }
+    static inline uint16_t rd_u16(const uint8_t* d) { return uint16_t(d[0]) | (uint16_t(d[1]) << 8); }
+    static inline uint32_t rd_u32(const uint8_t* d) {
+        return uint32_t(d[0]) | (uint32_t(d[1]) << 8) | (uint32_t(d[2]) << 16) | (uint32_t(d[3]) << 24);
+    }
+    static inline uint64_t rd_u64(const uint8_t* d) { return uint64_t(rd_u32(d)) | (uint64_t(rd_u32(d + 4)) << 32); }
+
+    // Positional I/O on a synchronous handle (OVERLAPPED carries the offset).
+    static bool pread_all(HANDLE h, uint64_t off, void* p, size_t n) {
+        BYTE* b = static_cast<BYTE*>(p);
+        while (n) {
+            OVERLAPPED ov{}; ov.Offset = DWORD(off); ov.OffsetHigh = DWORD(off >> 32);
+            DWORD r = 0;
+            if (!ReadFile(h, b, (DWORD)std::min(n, (size_t)0x7FFFFFFF), &r, &ov) || r == 0) return false;
+            b += r; n -= r; off += r;
+        }
+        return true;
+    }
+
+    static bool pwrite_all(HANDLE h, uint64_t off, const void* p, size_t n) {
+        const BYTE* b = static_cast<const BYTE*>(p);
+        while (n) {
+            OVERLAPPED ov{}; ov.Offset = DWORD(off); ov.OffsetHigh = DWORD(off >> 32);
+            DWORD w = 0;
+            if (!WriteFile(h, b, (DWORD)std::min(n, (size_t)0x7FFFFFFF), &w, &ov) || w == 0) return false;
+            b += w; n -= w; off += w;
+        }
+        return true;
+    }
+
+    static uint64_t file_size(HANDLE h) {
+        LARGE_INTEGER sz{};
+        return GetFileSizeEx(h, &sz) ? uint64_t(sz.QuadPart) : 0;
+    }
+
+    // Whole-file exclusive lock, held only for the duration of an append.
+    struct FileLockGuard {
+        HANDLE h; OVERLAPPED ov{}; bool ok;
+        explicit FileLockGuard(HANDLE hh) : h(hh) {
+            ok = LockFileEx(h, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &ov) != 0;
+        }
+        ~FileLockGuard() { if (ok) UnlockFileEx(h, 0, MAXDWORD, MAXDWORD, &ov); }
+    };
+
+    uint64_t ResultKey::digest() const
+    {
+        uint8_t hdr[11];
+        std::memcpy(hdr, &state_hash, 8);
+        hdr[8] = program_kind;
+        hdr[9] = uint8_t(program_version); hdr[10] = uint8_t(program_version >> 8);
+        uint64_t h = fnv1a(FNV_OFFSET, hdr, sizeof(hdr));
+        return fnv1a(h, payload.data(), payload.size());
+    }
+
+    bool MakeResultKey(uint64_t state_hash, uint8_t program_kind, const std::vector<uint8_t>& payload, ResultKey& out)
+    {
+        uint32_t version = 0;
+        out = ResultKey{};
+        if (!programs::result_identity_for(program_kind, payload, version, out.payload)) return false;
+        if (version > 0xFFFF) return false;
+        out.state_hash = state_hash;
+        out.program_kind = program_kind;
+        out.program_version = uint16_t(version);
+        return true;
+    }
+
+    uint64_t HashFileContents(const std::string& path)
+    {
+        if (path.empty()) return 0;
+        std::ifstream f(path, std::ios::binary);
+        if (!f) return 0;
+        uint64_t h = FNV_OFFSET;
+        std::vector<char> buf(1 << 20);
+        while (f) {
+            f.read(buf.data(), std::streamsize(buf.size()));
+            const auto got = f.gcount();
+            if (got <= 0) break;
+            h = fnv1a(h, reinterpret_cast<const uint8_t*>(buf.data()), size_t(got));
+        }
+        return f.bad() ? 0 : h;
+    }
+
+    uint64_t HashBytes(const std::vector<uint8_t>& bytes, uint64_t seed)
+    {
+        return fnv1a(seed ? seed : FNV_OFFSET, bytes.data(), bytes.size());
+    }
+
+    ResultStore::~ResultStore() { close(); }
+
+    bool ResultStore::open(const std::string& path, std::string* error_out)
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        if (h_ != INVALID_HANDLE_VALUE) { CloseHandle(h_); h_ = INVALID_HANDLE_VALUE; }
+        index_.clear();
+        indexed_to_ = 0;
+        path_ = path;
+
+        h_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+            FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (h_ == INVALID_HANDLE_VALUE) {
+            if (error_out) *error_out = "Could not open result store: " + path;
+            return false;
+        }
+
+        // Write the header exactly once, even if several sessions open a fresh file together.
+        {
+            FileLockGuard lock(h_);
+            if (file_size(h_) == 0) {
+                std::vector<uint8_t> hdr;
+                put_u32(hdr, FILE_MAGIC); put_u16(hdr, FILE_VERSION); put_u16(hdr, 0);
+                if (!pwrite_all(h_, 0, hdr.data(), hdr.size())) {
+                    if (error_out) *error_out = "Could not write result store header: " + path;
+                    CloseHandle(h_); h_ = INVALID_HANDLE_VALUE;
+                    return false;
+                }
+                FlushFileBuffers(h_);
+            }
+        }
+
+        uint8_t hdr[8]{};
+        if (!pread_all(h_, 0, hdr, sizeof(hdr)) || rd_u32(hdr) != FILE_MAGIC || rd_u16(hdr + 4) != FILE_VERSION) {
+            if (error_out) *error_out = "Not a result store (or unsupported version): " + path;
+            CloseHandle(h_); h_ = INVALID_HANDLE_VALUE;
+            return false;
+        }
+        indexed_to_ = sizeof(hdr);
+
+        (void)refresh_index_locked(/*truncate_torn_tail=*/false);
+        SCLOGI("[ResultStore] opened %s (%zu records)", path.c_str(), index_.size());
+        return true;
+    }
+
+    void ResultStore::close()
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        if (h_ != INVALID_HANDLE_VALUE) { CloseHandle(h_); h_ = INVALID_HANDLE_VALUE; }
+        index_.clear();
+        indexed_to_ = 0;
+    }
+
+    bool ResultStore::refresh_index_locked(bool truncate_torn_tail)
+    {
+        const uint64_t end = file_size(h_);
+        uint64_t off = indexed_to_;
+        while (off + 8 <= end) {
+            uint8_t rh[8 + 8];
+            if (off + sizeof(rh) > end || !pread_all(h_, off, rh, sizeof(rh))) break;
+            if (rd_u32(rh) != REC_MAGIC) break;
+            const uint32_t body_len = rd_u32(rh + 4);
+            const uint64_t rec_end = off + 8 + uint64_t(body_len) + 8;
+            if (body_len < 8 || rec_end > end) break;  // incomplete (being written, or torn)
+
+            std::vector<uint8_t> body(body_len);
+            uint8_t sum[8];
+            if (!pread_all(h_, off + 8, body.data(), body.size()) || !pread_all(h_, off + 8 + body_len, sum, 8)) break;
+            if (fnv1a(FNV_OFFSET, body.data(), body.size()) != rd_u64(sum)) break;
+
+            index_.emplace(rd_u64(body.data()), off);
+            off = rec_end;
+        }
+
+        if (off < end && truncate_torn_tail) {
+            // Only called while holding the file lock: nobody else can be mid-append.
+            SCLOGW("[ResultStore] truncating torn tail at %llu (size %llu)",
+                (unsigned long long)off, (unsigned long long)end);
+            LARGE_INTEGER pos{}; pos.QuadPart = LONGLONG(off);
+            if (!SetFilePointerEx(h_, pos, NULL, FILE_BEGIN) || !SetEndOfFile(h_)) return false;
+        }
+        indexed_to_ = off;
+        return true;
+    }
+
+    bool ResultStore::read_record_locked(uint64_t off, ResultKey& key, PSResult& res)
+    {
+        uint8_t rh[8];
+        if (!pread_all(h_, off, rh, sizeof(rh)) || rd_u32(rh) != REC_MAGIC) return false;
+        std::vector<uint8_t> body(rd_u32(rh + 4));
+        if (!pread_all(h_, off + 8, body.data(), body.size())) return false;
+
+        const uint8_t* d = body.data();
+        const size_t n = body.size();
+        size_t o = 8;  // skip digest
+        if (o + 8 + 1 + 2 + 1 + 1 + 4 > n) return false;
+        key.state_hash = rd_u64(d + o); o += 8;
+        key.program_kind = d[o++];
+        key.program_version = rd_u16(d + o); o += 2;
+        res.ok = d[o++] != 0;
+        res.w_err = d[o++];
+        const uint32_t pl = rd_u32(d + o); o += 4;
+        if (o + pl + 4 > n) return false;
+        key.payload.assign(d + o, d + o + pl); o += pl;
+        const uint32_t cl = rd_u32(d + o); o += 4;
+        if (o + cl > n) return false;
+        res.ctx.clear();
+        return cl == 0 || psctx::decode_numeric(d + o, cl, res.ctx);
+    }
+
+    bool ResultStore::find_locked(const ResultKey& key, PSResult* out)
+    {
+        auto [b, e] = index_.equal_range(key.digest());
+        for (auto it = b; it != e; ++it) {
+            ResultKey k{}; PSResult r{};
+            if (!read_record_locked(it->second, k, r)) continue;
+            if (!(k == key)) continue;  // digest collision
+            if (out) *out = std::move(r);
+            return true;
+        }
+        return false;
+    }
+
+    bool ResultStore::lookup(const ResultKey& key, PSResult& out)
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        if (h_ == INVALID_HANDLE_VALUE) return false;
+
+        if (file_size(h_) > indexed_to_) (void)refresh_index_locked(/*truncate_torn_tail=*/false);
+
+        if (find_locked(key, &out)) { ++hits_; return true; }
+        ++misses_;
+        return false;
+    }
+
+    bool ResultStore::append(const ResultKey& key, const PSResult& res)
+    {
+        std::vector<uint8_t> ctx;
+        if (!psctx::encode_numeric(res.ctx, ctx)) return false;
+
+        std::vector<uint8_t> body;
+        body.reserve(8 + 8 + 1 + 2 + 2 + 4 + key.payload.size() + 4 + ctx.size());
+        put_u64(body, key.digest());
+        put_u64(body, key.state_hash);
+        body.push_back(key.program_kind);
+        put_u16(body, key.program_version);
+        body.push_back(res.ok ? 1 : 0);
+        body.push_back(res.w_err);
+        put_u32(body, uint32_t(key.payload.size()));
+        body.insert(body.end(), key.payload.begin(), key.payload.end());
+        put_u32(body, uint32_t(ctx.size()));
+        body.insert(body.end(), ctx.begin(), ctx.end());
+
+        std::vector<uint8_t> rec;
+        rec.reserve(8 + body.size() + 8);
+        put_u32(rec, REC_MAGIC);
+        put_u32(rec, uint32_t(body.size()));
+        rec.insert(rec.end(), body.begin(), body.end());
+        put_u64(rec, fnv1a(FNV_OFFSET, body.data(), body.size()));
+
+        std::lock_guard<std::mutex> lk(m_);
+        if (h_ == INVALID_HANDLE_VALUE) return false;
+
+        FileLockGuard lock(h_);
+        if (!lock.ok) return false;
+
+        // Pick up records from other sessions first; another session may already have this one.
+        if (!refresh_index_locked(/*truncate_torn_tail=*/true)) return false;
+        if (find_locked(key, nullptr)) return true;
+
+        const uint64_t off = indexed_to_;
+        if (!pwrite_all(h_, off, rec.data(), rec.size())) {
+            SCLOGE("[ResultStore] append failed at %llu", (unsigned long long)off);
+            return false;
+        }
+        index_.emplace(key.digest(), off);
+        indexed_to_ = off + rec.size();
+        return true;
+    }
+
+} // namespace simcore
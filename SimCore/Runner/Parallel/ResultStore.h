@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+#include <windows.h>
+
+#include "../Script/PhaseScriptVM.h"  // PSResult
+
+namespace simcore {
+
+    // Canonical identity of a job: everything that determines its result.
+    //   state_hash      : content hash of the savestate the program starts from (0 => boot),
+    //                     folded with PSInit::shared_blob when the program has one
+    //   program_kind    : active main PK_*
+    //   program_version : payload version, read by the program's own codec
+    //   payload         : the payload bytes the result depends on (first byte == PK_*); see
+    //                     programs::result_identity_for
+    struct ResultKey {
+        uint64_t state_hash{ 0 };
+        uint8_t  program_kind{ 0 };
+        uint16_t program_version{ 0 };
+        std::vector<uint8_t> payload;
+
+        uint64_t digest() const;
+        bool operator==(const ResultKey& o) const {
+            return state_hash == o.state_hash && program_kind == o.program_kind
+                && program_version == o.program_version && payload == o.payload;
+        }
+    };
+
+    // Builds a key for `payload` against the runner's active program/savestate.
+    // False when the job must not use the store (it writes files, e.g. turn states or savestates).
+    bool MakeResultKey(uint64_t state_hash, uint8_t program_kind, const std::vector<uint8_t>& payload, ResultKey& out);
+
+    // FNV-1a over the file contents; returns 0 for an empty path, a missing file or a read error.
+    uint64_t HashFileContents(const std::string& path);
+
+    // FNV-1a over `bytes`, continuing from `seed` (0 => a fresh hash).
+    uint64_t HashBytes(const std::vector<uint8_t>& bytes, uint64_t seed = 0);
+
+    // Content-addressed, append-only store of finished job results.
+    //
+    // File layout (little-endian):
+    //   header : u32 magic 'SCRS', u16 version, u16 reserved
+    //   record : u32 magic 'RREC', u32 body_len, body[body_len], u64 fnv1a(body)
+    //   body   : u64 digest, u64 state_hash, u8 kind, u16 version, u8 ok, u8 w_err,
+    //            u32 payload_len, payload, u32 ctx_len, ctx (psctx::encode_numeric)
+    //
+    // The index (digest -> record offset) is rebuilt by scanning record headers on open and
+    // is refreshed from the last indexed offset whenever the file grows, so records appended
+    // by other sessions sharing the same file become visible without reopening.
+    // Appends take an exclusive byte-range lock (LockFileEx) on the file; a torn tail left by
+    // a crashed writer fails its checksum and is truncated by the next writer under that lock.
+    class ResultStore {
+    public:
+        static constexpr uint32_t FILE_MAGIC = 0x53524353u; // 'SCRS'
+        static constexpr uint32_t REC_MAGIC = 0x43455252u;  // 'RREC'
+        static constexpr uint16_t FILE_VERSION = 1;
+
+        ResultStore() = default;
+        ~ResultStore();
+
+        ResultStore(const ResultStore&) = delete;
+        ResultStore& operator=(const ResultStore&) = delete;
+
+        bool open(const std::string& path, std::string* error_out = nullptr);
+        void close();
+        bool is_open() const { return h_ != INVALID_HANDLE_VALUE; }
+
+        // Returns true and fills `out` when a record with an identical key exists.
+        bool lookup(const ResultKey& key, PSResult& out);
+
+        // Appends a record unless an identical key is already present (possibly from another session).
+        bool append(const ResultKey& key, const PSResult& res);
+
+        size_t size() const { std::lock_guard<std::mutex> lk(m_); return index_.size(); }
+        uint64_t hits() const { return hits_.load(); }
+        uint64_t misses() const { return misses_.load(); }
+
+    private:
+        bool refresh_index_locked(bool truncate_torn_tail);
+        bool read_record_locked(uint64_t off, ResultKey& key, PSResult& res);
+        bool find_locked(const ResultKey& key, PSResult* out);
+
+        HANDLE h_{ INVALID_HANDLE_VALUE };
+        std::string path_;
+        uint64_t indexed_to_{ 0 };
+        std::unordered_multimap<uint64_t, uint64_t> index_;
+        mutable std::mutex m_;
+        std::atomic<uint64_t> hits_{ 0 };
+        std::atomic<uint64_t> misses_{ 0 };
+    };
+
+} // namespace simcore
@@ -2,6 +2,8 @@
 #include <deque>
 #include <mutex>
 #include <condition_variable>
+#include <queue>
+#include <vector>
 
 template <class T>
 class TSQueue {
@@ -44,3 +46,69 @@ private:
     std::deque<T> q_;
     bool closed_{ false };
 };
+
+// Same interface as TSQueue, but pops the element that orders highest under Less
+// (std::priority_queue semantics: Less(a, b) == true => b pops before a).
+template <class T, class Less>
+class TSPriorityQueue {
+public:
+    void push(T v) {
+        { std::lock_guard<std::mutex> lk(m_); q_.push(std::move(v)); }
+        cv_.notify_one();
+    }
+
+    bool try_pop(T& out) {
+        std::lock_guard<std::mutex> lk(m_);
+        if (q_.empty()) return false;
+        out = std::move(const_cast<T&>(q_.top()));
+        q_.pop();
+        return true;
+    }
+
+    bool pop_wait(T& out) {
+        std::unique_lock<std::mutex> lk(m_);
+        cv_.wait(lk, [&] { return closed_ || !q_.empty(); });
+        if (q_.empty()) return false;
+        out = std::move(const_cast<T&>(q_.top()));
+        q_.pop();
+        return true;
+    }
+
+    // pop_wait that also returns false once wake() holds. wake() runs under the queue lock, so
+    // whoever makes it true must call kick() afterwards.
+    template <class Wake>
+    bool pop_wait_unless(T& out, Wake&& wake) {
+        std::unique_lock<std::mutex> lk(m_);
+        cv_.wait(lk, [&] { return closed_ || !q_.empty() || wake(); });
+        if (q_.empty()) return false;
+        out = std::move(const_cast<T&>(q_.top()));
+        q_.pop();
+        return true;
+    }
+
+    void kick() {
+        { std::lock_guard<std::mutex> lk(m_); }
+        cv_.notify_all();
+    }
+
+    void close() {
+        { std::lock_guard<std::mutex> lk(m_); closed_ = true; }
+        cv_.notify_all();
+    }
+
+    bool closed() const {
+        std::lock_guard<std::mutex> lk(m_);
+        return closed_;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lk(m_);
+        return q_.size();
+    }
+
+private:
+    mutable std::mutex m_;
+    std::condition_variable cv_;
+    std::priority_queue<T, std::vector<T>, Less> q_;
+    bool closed_{ false };
+};
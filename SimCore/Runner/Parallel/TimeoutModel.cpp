@@ -0,0 +1,143 @@
+#include "TimeoutModel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "../IPC/Wire.h"
+#include "../Script/KeyRegistry.h"
+
+namespace simcore {
+
+    static constexpr double kGrowth = 1.055;
+
+    uint32_t TimeoutModel::bucket_of(uint32_t ms)
+    {
+        if (ms <= 1) return 0;
+        const double i = std::ceil(std::log((double)ms) / std::log(kGrowth));
+        return (uint32_t)std::min<double>(i, kBuckets - 1);
+    }
+
+    uint32_t TimeoutModel::bucket_upper(uint32_t idx)
+    {
+        return (uint32_t)std::ceil(std::pow(kGrowth, (double)idx));
+    }
+
+    void TimeoutModel::Histogram::add(uint32_t ms)
+    {
+        ++b[bucket_of(ms)];
+        ++n;
+    }
+
+    uint32_t TimeoutModel::Histogram::quantile(double q) const
+    {
+        if (n == 0) return 0;
+        const uint64_t want = (uint64_t)std::ceil(q * (double)n);
+        uint64_t acc = 0;
+        for (uint32_t i = 0; i < kBuckets; ++i) {
+            acc += b[i];
+            if (acc >= want) return bucket_upper(i);
+        }
+        return bucket_upper(kBuckets - 1);
+    }
+
+    void TimeoutModel::observe(uint8_t program_kind, const PSContext& ctx, uint64_t job_key, bool learned)
+    {
+        std::string segs;
+        if (!ctx.get<std::string>(keys::core::RUN_SEGMENTS, segs) || segs.empty()) return;
+
+        std::lock_guard<std::mutex> lk(m_);
+        Pending cut{};
+        bool was_cut = false, failed = false;
+        for (size_t off = 0; off + sizeof(WireRunSegment) <= segs.size(); off += sizeof(WireRunSegment)) {
+            WireRunSegment s{};
+            std::memcpy(&s, segs.data() + off, sizeof(s));
+            ++report_.segments;
+            cut.elapsed_ms += s.elapsed_ms;
+
+            switch ((RunToBpOutcome)s.outcome) {
+            case RunToBpOutcome::Hit: {
+                Entry& e = hist_[Key{ program_kind, s.from_bp }];
+                e.run.add(s.elapsed_ms);
+                e.vi_gap.add(s.max_vi_gap_ms);
+                break;
+            }
+            case RunToBpOutcome::Timeout:
+                failed = true;
+                if (s.run_ms < s.run_ms_default) {
+                    ++report_.cut_short;
+                    was_cut = true;
+                    cut.saving_ms += s.run_ms_default - s.run_ms;
+                }
+                break;
+            case RunToBpOutcome::ViStalled:
+                failed = true;
+                if (s.vi_stall_ms_default == 0 || s.vi_stall_ms < s.vi_stall_ms_default) {
+                    // Without the learned window the stall would have run into the default stall window,
+                    // or all the way to the default run budget when stall detection was off.
+                    const uint32_t would = s.vi_stall_ms_default
+                        ? std::min(s.run_ms_default, s.elapsed_ms - std::min(s.elapsed_ms, s.vi_stall_ms) + s.vi_stall_ms_default)
+                        : s.run_ms_default;
+                    if (would > s.elapsed_ms) {
+                        ++report_.cut_short;
+                        was_cut = true;
+                        cut.saving_ms += would - s.elapsed_ms;
+                    }
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (job_key == 0) return;
+        if (learned) {
+            if (was_cut && pending_.size() < kMaxPending) pending_[job_key] = cut;
+            return;
+        }
+        // A default-budget run: settle the cut attempt it retried, if any
+        auto it = pending_.find(job_key);
+        if (it == pending_.end()) return;
+        if (failed) {
+            ++report_.confirmed;
+            report_.reclaimed_ms += (int64_t)it->second.saving_ms;
+        }
+        else {
+            ++report_.refuted;
+            report_.reclaimed_ms -= (int64_t)it->second.elapsed_ms;
+        }
+        pending_.erase(it);
+    }
+
+    std::vector<uint8_t> TimeoutModel::table(uint8_t program_kind) const
+    {
+        std::vector<uint8_t> out;
+        std::lock_guard<std::mutex> lk(m_);
+        if (!policy_.enabled) return out;
+
+        for (auto it = hist_.lower_bound(Key{ program_kind, 0 }); it != hist_.end() && it->first.kind == program_kind; ++it) {
+            const Entry& e = it->second;
+            if (e.run.n < policy_.min_samples) continue;
+
+            WireTimeoutEntry te{};
+            te.from_bp = it->first.from_bp;
+            te.run_ms = std::max(policy_.run_floor_ms, (uint32_t)(e.run.quantile(policy_.quantile) * policy_.margin));
+            te.vi_stall_ms = std::max(policy_.vi_floor_ms, (uint32_t)(e.vi_gap.quantile(policy_.quantile) * policy_.margin));
+
+            const size_t at = out.size();
+            out.resize(at + sizeof(te));
+            std::memcpy(out.data() + at, &te, sizeof(te));
+        }
+        return out;
+    }
+
+    TimeoutModel::Report TimeoutModel::report() const
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        Report r = report_;
+        r.learned_keys = 0;
+        for (const auto& [k, e] : hist_)
+            if (e.run.n >= policy_.min_samples) ++r.learned_keys;
+        return r;
+    }
+
+} // namespace simcore
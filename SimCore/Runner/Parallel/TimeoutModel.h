@@ -0,0 +1,87 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "../Script/PhaseScriptVM.h"  // PSContext
+
+namespace simcore {
+
+    struct TimeoutPolicy {
+        bool     enabled{ false };
+        double   quantile{ 0.999 };      // of observed segment durations
+        double   margin{ 1.5 };          // budget = quantile x margin
+        uint32_t min_samples{ 200 };     // per (program, from_bp) before anything is learned
+        uint32_t run_floor_ms{ 2000 };   // never tighten a run budget below this
+        uint32_t vi_floor_ms{ 1000 };    // ... or a VI stall window below this
+    };
+
+    // Learns per-segment budgets from the RUN_SEGMENTS logs workers return.
+    //
+    // A segment is one RUN_UNTIL_BP, keyed by (main program kind, breakpoint it started from). Durations
+    // and the longest VI gap of segments that hit a breakpoint go into log-bucketed histograms; once a
+    // key has min_samples, table() emits quantile x margin for it. Timed-out or stalled segments are
+    // not learned from, but are used to account the worker time the tighter budgets reclaimed.
+    //
+    // A job cut short by a learned budget is retried under the default budgets, and that retry may
+    // well hit. So a cut only counts once the retry of the same payload (job_key) has been observed:
+    // if the retry also timed out or stalled, the cut saved (default - learned); if it hit, the whole
+    // cut attempt was wasted and its elapsed time is taken off instead.
+    class TimeoutModel {
+    public:
+        struct Report {
+            uint64_t segments{ 0 };      // observed
+            uint64_t cut_short{ 0 };     // timeouts/stalls that fired earlier than the default budget would have
+            uint64_t confirmed{ 0 };     // cut jobs whose default-budget retry also timed out or stalled
+            uint64_t refuted{ 0 };       // cut jobs whose default-budget retry hit
+            int64_t  reclaimed_ms{ 0 };  // confirmed savings minus the elapsed time of refuted attempts; may be negative
+            uint64_t learned_keys{ 0 };  // (program, from_bp) pairs with a budget
+        };
+
+        void set_policy(const TimeoutPolicy& p) { std::lock_guard<std::mutex> lk(m_); policy_ = p; }
+        TimeoutPolicy policy() const { std::lock_guard<std::mutex> lk(m_); return policy_; }
+
+        // job_key identifies the payload across retries (0 => untracked: learned from, never credited);
+        // learned is whether the job ran with budgets from table().
+        void observe(uint8_t program_kind, const PSContext& ctx, uint64_t job_key, bool learned);
+
+        // Packed WireTimeoutEntry[] for the program; empty when disabled or nothing learned yet.
+        std::vector<uint8_t> table(uint8_t program_kind) const;
+
+        Report report() const;
+        void reset_report() { std::lock_guard<std::mutex> lk(m_); report_ = Report{}; }
+
+    private:
+        static constexpr size_t kBuckets = 256;  // geometric, ~5.5% wide, 1 ms .. ~15 min
+
+        struct Histogram {
+            std::array<uint32_t, kBuckets> b{};
+            uint64_t n{ 0 };
+            void add(uint32_t ms);
+            uint32_t quantile(double q) const;  // upper bound of the bucket holding q
+        };
+        struct Key {
+            uint8_t kind; uint16_t from_bp;
+            bool operator<(const Key& o) const { return kind != o.kind ? kind < o.kind : from_bp < o.from_bp; }
+        };
+        struct Entry { Histogram run, vi_gap; };
+        struct Pending {
+            uint64_t saving_ms{ 0 };   // what the cut saved if the default budget would also have failed
+            uint64_t elapsed_ms{ 0 };  // what the cut attempt cost
+        };
+        static constexpr size_t kMaxPending = 4096;  // cut jobs nobody retried are dropped past this
+
+        static uint32_t bucket_of(uint32_t ms);
+        static uint32_t bucket_upper(uint32_t idx);
+
+        mutable std::mutex m_;
+        TimeoutPolicy policy_{};
+        std::map<Key, Entry> hist_;
+        std::unordered_map<uint64_t, Pending> pending_;  // by job_key, awaiting their retry
+        Report report_{};
+    };
+
+} // namespace simcore
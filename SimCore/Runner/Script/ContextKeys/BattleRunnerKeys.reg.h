@@ -14,7 +14,12 @@ namespace simcore::keys::battle {
   X(NUM_TURN_PLANS,           0x0330, "battle.turnplan.count")     \
   X(TURN_PLANS,               0x0331, "battle.turnplan.plans") \
   X(LAST_TURN,                0x0332, "battle.turnplan.last_idx") \
-  X(PLAN_MATERIALIZE_ERR,     0x0333, "battle.turnplan.materialize_err")
+  X(PLAN_MATERIALIZE_ERR,     0x0333, "battle.turnplan.materialize_err") \
+  X(RESUME_FROM_STATE,        0x0340, "battle.resume.enabled") \
+  X(RESUME_TURN,              0x0341, "battle.resume.turn") \
+  X(RESUME_STATE_PATH,        0x0342, "battle.resume.state_path") \
+  X(TURN_STATE_PATHS,         0x0343, "battle.resume.save_paths") \
+  X(RESUME_LOAD_FAILED,       0x0344, "battle.resume.load_failed")
 
 #define DECL_KEY(NAME, ID, STR) inline constexpr simcore::keys::KeyId NAME = static_cast<simcore::keys::KeyId>(ID); \
 static_assert(NAME >= simcore::keys::BATTLE_MIN && NAME <= simcore::keys::BATTLE_MAX, "battle key out of range");
@@ -6,7 +6,16 @@ namespace simcore::keys::seed {
 
 #define SEED_KEYS(X) \
   X(INPUT,    0x0100, "seed.input") \
-  X(RNG_SEED, 0x0101, "seed.seed")
+  X(RNG_SEED, 0x0101, "seed.seed") \
+  X(SWEEP_INPUTS, 0x0102, "seed.sweep.inputs") \
+  X(SWEEP_COUNT,  0x0103, "seed.sweep.count") \
+  X(SWEEP_INDEX,  0x0104, "seed.sweep.index") \
+  X(SWEEP_SEEDS,  0x0105, "seed.sweep.seeds") \
+  X(SWEEP_STATUS, 0x0106, "seed.sweep.status") \
+  X(TRACE_COUNT,  0x0107, "seed.trace.count") \
+  X(TRACE_INDEX,  0x0108, "seed.trace.index") \
+  X(TRACE_SEEDS,  0x0109, "seed.trace.seeds") \
+  X(TRACE_BPS,    0x010A, "seed.trace.bps")
 
 #define DECL_KEY(NAME, ID, STR) \
   inline constexpr simcore::keys::KeyId NAME = static_cast<simcore::keys::KeyId>(ID); \
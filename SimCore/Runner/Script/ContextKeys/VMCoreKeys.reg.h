@@ -10,6 +10,7 @@ namespace simcore::keys::core {
   X(RUN_HIT_BP_KEY,    0x0001, "core.run.hit_bp")        \
   X(DW_RUN_OUTCOME_CODE,      0x0002, "core.run.outcome_code")  \
   X(ELAPSED_MS,        0x0003, "core.run.elapsed_ms")    \
+  X(RUN_SEGMENTS,      0x0004, "core.run.segments")      \
 \
   X(VI_FIRST,          0x0020, "core.metrics.vi_first")  \
   X(VI_LAST,           0x0021, "core.metrics.vi_last")   \
@@ -18,6 +19,7 @@ namespace simcore::keys::core {
   X(RUN_MS,            0x0040, "core.input.run_ms")      \
   X(VI_STALL_MS,       0x0041, "core.input.vi_stall_ms") \
   X(PROGRESS_ENABLE,   0x0042, "core.input.progress_enable") \
+  X(RUN_TIMEOUT_TABLE, 0x0043, "core.input.timeout_table") \
 \
   X(PLAN_FRAME_IDX,    0x0060, "core.plan.frame_idx")    \
   X(PLAN_DONE,         0x0061, "core.plan.done")         \
@@ -31,7 +33,15 @@ namespace simcore::keys::core {
   X(PRED_FIRST_FAILED, 0x0086, "core.pred.first_failed")   \
   X(PRED_FAILED_CMP_STR,   0x0087, "core.pred.failed_cmp")   \
 \
-  X(WORKER_ERROR,      0x00A0, "core.output.worker_err")
+  X(WORKER_ERROR,      0x00A0, "core.output.worker_err") \
+\
+  X(BRANCH_SPEC,       0x00C0, "core.branch.spec")       \
+  X(BRANCH_WATCH,      0x00C1, "core.branch.watch")      \
+  X(BRANCH_STEP_MS,    0x00C2, "core.branch.step_ms")    \
+  X(BRANCH_PATHS,      0x00C3, "core.branch.leaf_paths") \
+  X(BRANCH_VALUES,     0x00C4, "core.branch.leaf_values") \
+  X(BRANCH_FRAMES,     0x00C5, "core.branch.frames")     \
+  X(BRANCH_LEAVES,     0x00C6, "core.branch.leaves")
 
 // Emit KeyId constants + per-module range guards
 #define DECL_KEY(NAME, ID, STR) \
@@ -1,7 +1,11 @@
 #include "PhaseScriptVM.h"
 #include <algorithm>
+#include <filesystem>
+#include <random>
 
 #include "../../Phases/Programs/BattleRunner/BattleRunnerPayload.h"
+#include "../../Phases/Programs/BranchTree/BranchTreePayload.h"
+#include "../../Core/Branching/BranchExecutor.h"
 #include "../../Core/Memory/Soa/Battle/BattleContextCodec.h"
 #include "../../Core/Memory/MemView.h"
 #include "../../Core/Memory/Soa/SoaAddrProgram.h"
@@ -15,6 +19,8 @@
 #include "../../Core/Memory/Soa/Battle/DerivedBattleBuffer.h"
 #include "../../Core/Memory/KeyHostRouter.h"
 #include "../Breakpoints/BPRegistry.h"
+#include "../IPC/Wire.h"
+#include "../../Tas/DtmFile.h"
 
 namespace {
     inline bool read_via_addrprog(simcore::DolphinWrapper& host,
@@ -56,6 +62,26 @@ namespace {
             return false;
         }
     }
+
+    // Ops after which emulated memory may differ; anything cached from it is stale.
+    inline bool advances_emulation(simcore::PSOpCode c)
+    {
+        using simcore::PSOpCode;
+        switch (c) {
+        case PSOpCode::LOAD_SNAPSHOT:
+        case PSOpCode::STEP_FRAMES:
+        case PSOpCode::RUN_UNTIL_BP:
+        case PSOpCode::APPLY_BATTLE_INPUTPLAN_FRAMES:
+        case PSOpCode::MOVIE_PLAY_FROM:
+        case PSOpCode::MOVIE_PLAY_SHARED_FROM:
+        case PSOpCode::MOVIE_RESUME_FROM:
+        case PSOpCode::LOAD_TURN_STATE:
+        case PSOpCode::RUN_BRANCH_TREE:
+            return true;
+        default:
+            return false;
+        }
+    }
 }
 
 namespace simcore {
@@ -124,6 +150,12 @@ namespace simcore {
         return snapshot_ok;
     }
 
+    void PhaseScriptVM::stop_checkpoints()
+    {
+        host_.setMovieCheckpointSink(0, nullptr);
+        checkpoints_.end();
+    }
+
     PSResult PhaseScriptVM::run(const PSJob& job)
     {
         PSResult R{};
@@ -131,8 +163,11 @@ namespace simcore {
         predicate_bp_keys_.clear();
         std::string _section = "Entry Point";
 
+        stop_checkpoints();
+
         // Always start by restoring the pre-captured snapshot for each job
         if (!load_snapshot()) return R;
+        battle_view_.invalidate();
 
 
         if (derived_) derived_->on_init(ctx);
@@ -150,6 +185,15 @@ namespace simcore {
             const auto& op = prog_.ops[vm_pc];
             SCLOGT("[VM] running op: %s", get_psop_name(op.code).c_str());
 
+            // Cancelled by the parent (e.g. losing copy of a speculative duplicate): stop between ops.
+            if (host_.abortRequested()) {
+                ctx[keys::core::DW_RUN_OUTCOME_CODE] = static_cast<uint32_t>(RunToBpOutcome::Aborted);
+                R.ctx = std::move(ctx);
+                return R;
+            }
+
+            if (advances_emulation(op.code)) battle_view_.invalidate();
+
             switch (op.code) {
             case PSOpCode::ARM_PHASE_BPS_ONCE: 
             { arm_bps_once(); break; }
@@ -261,20 +305,12 @@ namespace simcore {
                     break;
                 }
 
-                // Get fresh BattleContext (already provided just before this op in your program)
-                soa::battle::ctx::BattleContext bc{};
-                {
-                    std::string blob;
-                    if (ctx.get<std::string>(keys::battle::CTX_BLOB, blob)) {
-                        soa::battle::ctx::codec::decode(blob, bc);
-                    }
-                }
-
+                // Targeting reads the live context at this stop; only the fields it asks for are fetched
                 const auto& turn_plan = bp[turn-1];
 
                 simcore::InputPlan plan;
                 auto err = soa::battle::actions::MaterializeErr::OK;
-                const bool ok = soa::battle::actions::ActionLibrary::generateTurnPlan(bc, turn_plan, plan, err);
+                const bool ok = soa::battle::actions::ActionLibrary::generateTurnPlan(battle_view_, turn_plan, plan, err);
                 if (!ok) {
                     ctx[keys::battle::PLAN_MATERIALIZE_ERR] = (uint32_t)err;
                     ctx[keys::core::PLAN_DONE] = (uint32_t)1;
@@ -351,13 +387,35 @@ namespace simcore {
                 ctx.get<uint32_t>(keys::core::RUN_MS, timeout_ms);
 
                 uint32_t vi_stall_ms = 0;
-                ctx.get<uint32_t>(keys::core::VI_STALL_MS, vi_stall_ms);
+                const bool vi_stall_set = ctx.get<uint32_t>(keys::core::VI_STALL_MS, vi_stall_ms);
+
+                // Learned budgets for the segment starting at the last hit BP tighten RUN_MS / VI_STALL_MS.
+                // An explicit VI_STALL_MS = 0 turns stall detection off and is never overridden.
+                uint32_t from_bp = 0; ctx.get<uint32_t>(keys::core::RUN_HIT_BP_KEY, from_bp);
+                const uint32_t timeout_default = timeout_ms, vi_stall_default = vi_stall_ms;
+                std::string table;
+                if (ctx.get<std::string>(keys::core::RUN_TIMEOUT_TABLE, table)) {
+                    for (size_t off = 0; off + sizeof(WireTimeoutEntry) <= table.size(); off += sizeof(WireTimeoutEntry)) {
+                        WireTimeoutEntry e{};
+                        std::memcpy(&e, table.data() + off, sizeof(e));
+                        if (e.from_bp != from_bp) continue;
+                        if (e.run_ms) timeout_ms = std::min(timeout_ms, e.run_ms);
+                        if (e.vi_stall_ms && (vi_stall_ms || !vi_stall_set))
+                            vi_stall_ms = vi_stall_ms ? std::min(vi_stall_ms, e.vi_stall_ms) : e.vi_stall_ms;
+                        break;
+                    }
+                }
 
                 const uint32_t poll_ms = host_.pickPollIntervalMs(timeout_ms);
                 const bool watch_movie = true;
 
                 // progress sink handled inside wrapper; host has per-job sink already
 
+                // VI_LAST - VI_FIRST = fields emulated by the job (throughput metrics). The wrapper's VI
+                // counter restarts with every run, so the job's total is accumulated run by run.
+                if (ctx.find(keys::core::VI_FIRST) == ctx.end())
+                    ctx[keys::core::VI_FIRST] = (uint32_t)0;
+
                 auto t0 = std::chrono::steady_clock::now();
                 auto rr = host_.runUntilBreakpointFlexible(timeout_ms, vi_stall_ms, watch_movie, poll_ms);
                 auto t1 = std::chrono::steady_clock::now();
@@ -369,6 +427,7 @@ namespace simcore {
                     if (std::strcmp(rr.reason, "timeout") == 0)     outcome = RunToBpOutcome::Timeout;
                     else if (std::strcmp(rr.reason, "vi_stalled") == 0)  outcome = RunToBpOutcome::ViStalled;
                     else if (std::strcmp(rr.reason, "movie_ended") == 0) outcome = RunToBpOutcome::MovieEnded;
+                    else if (std::strcmp(rr.reason, "aborted") == 0)     outcome = RunToBpOutcome::Aborted;
                     else outcome = RunToBpOutcome::Unknown;
                 }
 
@@ -376,7 +435,10 @@ namespace simcore {
                 ctx[keys::core::DW_RUN_OUTCOME_CODE] = static_cast<uint32_t>(outcome);
                 ctx[keys::core::ELAPSED_MS] = elapsed_ms;
                 ctx[keys::core::RUN_HIT_PC] = rr.hit ? (uint32_t)rr.pc : (uint32_t)0u;
-                ctx[keys::core::VI_LAST] = (uint32_t)(host_.getViFieldCountApprox() & 0xFFFFFFFFull);
+                {
+                    uint32_t vi_total = 0; ctx.get<uint32_t>(keys::core::VI_LAST, vi_total);
+                    ctx[keys::core::VI_LAST] = vi_total + (uint32_t)(host_.getViFieldCountApprox() & 0xFFFFFFFFull);
+                }
                 ctx[keys::core::POLL_MS] = poll_ms;
 
                 // derive hit BP id by matching PC
@@ -390,6 +452,23 @@ namespace simcore {
                     }
                 }
                 ctx[keys::core::RUN_HIT_BP_KEY] = hit_bp_key;
+
+                // Segment log for the parent's timeout model
+                {
+                    WireRunSegment seg{};
+                    seg.from_bp = (uint16_t)from_bp;
+                    seg.to_bp = (uint16_t)hit_bp_key;
+                    seg.elapsed_ms = elapsed_ms;
+                    seg.max_vi_gap_ms = host_.lastRunMaxViGapMs();
+                    seg.run_ms = timeout_ms;
+                    seg.run_ms_default = timeout_default;
+                    seg.vi_stall_ms = vi_stall_ms;
+                    seg.vi_stall_ms_default = vi_stall_default;
+                    seg.outcome = (uint8_t)outcome;
+                    std::string segs; ctx.get<std::string>(keys::core::RUN_SEGMENTS, segs);
+                    segs.append(reinterpret_cast<const char*>(&seg), sizeof(seg));
+                    ctx[keys::core::RUN_SEGMENTS] = std::move(segs);
+                }
                 // keep derived buffer in sync for this frame
                 if (derived_) derived_->update_on_bp(hit_bp_key, ctx, host_);
 
@@ -422,14 +501,12 @@ namespace simcore {
 
             case PSOpCode::GET_BATTLE_CONTEXT:
             {
-                std::string mem1;
-                if (!host_.getMem1(mem1)) { R.ok = false; break; }
-                simcore::MemView view(reinterpret_cast<const uint8_t*>(mem1.data()), mem1.size());
+                // Same fields extract_from_mem1 takes, read in place instead of through a 24 MiB MEM1 copy
                 soa::battle::ctx::BattleContext bc{};
-                if (!soa::battle::ctx::codec::extract_from_mem1(view, bc)) { R.ok = false; break; }
+                if (!battle_view_.materialize(bc)) { R.ok = false; break; }
                 std::string blob;
                 soa::battle::ctx::codec::encode(bc, blob);
-                ctx[simcore::keys::battle::CTX_BLOB] = blob;
+                ctx[simcore::keys::battle::CTX_BLOB] = std::move(blob);
                 break;
             }
 
@@ -460,6 +537,68 @@ namespace simcore {
                 break;
             }
 
+            case PSOpCode::APPLY_INPUT_AT: {
+                // Read the frame in place: these run once per sample, so copying the blob would be O(n^2)
+                uint32_t idx = 0;
+                auto it = ctx.find(op.kp.blob);
+                if (it == ctx.end() || !ctx.get<uint32_t>(op.kp.value, idx)) return R;
+                const std::string* frames = std::get_if<std::string>(&it->second);
+                if (!frames || (size_t(idx) + 1) * sizeof(GCInputFrame) > frames->size()) return R;
+                GCInputFrame f{};
+                std::memcpy(&f, frames->data() + size_t(idx) * sizeof(GCInputFrame), sizeof(f));
+                host_.setInput(f);
+                break;
+            }
+
+            case PSOpCode::APPEND_U32_FROM: {
+                uint32_t v = 0; ctx.get<uint32_t>(op.kp.value, v);
+                PSValue& slot = ctx[op.kp.blob];
+                std::string* blob = std::get_if<std::string>(&slot);
+                if (!blob) blob = &slot.emplace<std::string>();
+                const char b[4] = { char(v), char(v >> 8), char(v >> 16), char(v >> 24) };
+                blob->append(b, sizeof(b));
+                break;
+            }
+
+            case PSOpCode::RUN_BRANCH_TREE: {
+                std::string spec_blob, watch;
+                BranchSpec spec;
+                if (!ctx.get<std::string>(keys::core::BRANCH_SPEC, spec_blob) || !branchtree::decode_branch_spec(spec_blob, spec)) return R;
+                ctx.get<std::string>(keys::core::BRANCH_WATCH, watch);
+                uint32_t step_ms = 0; ctx.get<uint32_t>(keys::core::BRANCH_STEP_MS, step_ms);
+                branch_host_.set_step_timeout_ms(step_ms ? int(step_ms) : 1000);
+
+                // Per leaf: the option taken at each decision, then one u32 per watch address
+                std::string paths, values;
+                const auto append = [](std::string& s, uint32_t v) {
+                    const char b[4] = { char(v), char(v >> 8), char(v >> 16), char(v >> 24) };
+                    s.append(b, sizeof(b));
+                };
+                BranchTreeExecutor walk(std::move(spec));   // decode_branch_spec validated it
+                const BranchExecStats st = walk.run(branch_host_, [&](const BranchTreeExecutor::Path& chosen) {
+                    for (const auto& c : chosen) append(paths, uint32_t(c.second));
+                    for (size_t i = 0; i + 4 <= watch.size(); i += 4) {
+                        const auto* a = reinterpret_cast<const uint8_t*>(watch.data() + i);
+                        uint32_t v = 0;
+                        read_u32(uint32_t(a[0]) | (uint32_t(a[1]) << 8) | (uint32_t(a[2]) << 16) | (uint32_t(a[3]) << 24), v);
+                        append(values, v);
+                    }
+                    return true;
+                });
+                SCLOGD("[VM] branch tree: %llu leaves, %llu frames stepped (%llu replaying), %llu/%llu snapshots saved/loaded",
+                    (unsigned long long)st.leaves, (unsigned long long)st.frames_stepped, (unsigned long long)st.naive_frames,
+                    (unsigned long long)st.snapshots_saved, (unsigned long long)st.snapshots_loaded);
+                if (st.stopped) {
+                    SCLOGW("[VM] branch tree walk stopped by the host after %llu leaves", (unsigned long long)st.leaves);
+                    return R;
+                }
+                ctx[keys::core::BRANCH_PATHS] = std::move(paths);
+                ctx[keys::core::BRANCH_VALUES] = std::move(values);
+                ctx[keys::core::BRANCH_FRAMES] = (uint32_t)std::min<uint64_t>(st.frames_stepped, UINT32_MAX);
+                ctx[keys::core::BRANCH_LEAVES] = (uint32_t)st.leaves;
+                break;
+            }
+
             case PSOpCode::SET_TIMEOUT: 
             { ctx[keys::core::RUN_MS] = op.imm.v; break; }
 
@@ -477,9 +616,72 @@ namespace simcore {
                 break;
             }
 
+            case PSOpCode::MOVIE_PLAY_SHARED_FROM: {
+                uint32_t delta = 0;
+                ctx.get<uint32_t>(op.key.id, delta);
+                tas::DtmFile dtm;
+                if (!dtm.load(init_.shared_blob.data(), init_.shared_blob.size())) return R;
+                dtm.shift_recording_start_time((int32_t)delta);
+                if (!host_.startMoviePlaybackFromBuffer(dtm.bytes())) return R;
+                break;
+            }
+
+            case PSOpCode::MOVIE_RESUME_FROM: {
+                std::string path, checkpoint;
+                ctx.get<std::string>(op.kp.blob, path);
+                ctx.get<std::string>(op.kp.value, checkpoint);
+                if (!movie_.load(path)) return R;
+                movie_base_polls_ = movie_base_frame_ = 0;
+
+                if (checkpoint.empty()) {
+                    if (!host_.startMoviePlayback(path)) return R;
+                    break;
+                }
+
+                tas::DtmCheckpoint c{};
+                std::vector<uint8_t> tail;
+                if (!tas::ParseDtmCheckpointPath(checkpoint, c) || c.prefix_hash != tas::DtmPrefixHash(movie_, c.polls)
+                    || !tas::DtmTail(movie_, c.polls, c.frame, tail)) {
+                    SCLOGW("[VM] checkpoint %s does not fit %s", checkpoint.c_str(), path.c_str());
+                    return R;
+                }
+                if (!host_.loadSavestate(checkpoint)) return R;
+                if (!host_.startMoviePlaybackFromBuffer(tail)) return R;
+                movie_base_polls_ = c.polls;
+                movie_base_frame_ = c.frame;
+                break;
+            }
+
+            case PSOpCode::MOVIE_CHECKPOINTS_FROM: {
+                std::string dir;
+                uint32_t every_vi = 0;
+                ctx.get<std::string>(op.kp.blob, dir);
+                ctx.get<uint32_t>(op.kp.value, every_vi);
+                if (dir.empty() || every_vi == 0 || !movie_.valid()) break;
+
+                checkpoints_.begin(movie_, dir, movie_base_polls_, movie_base_frame_);
+                host_.setMovieCheckpointSink(every_vi, [this](uint64_t frame, uint64_t polls) {
+                    const std::string path = checkpoints_.target(frame, polls);
+                    if (path.empty()) return;
+                    // Save under a private name and rename, so a worker never sees another's half-written state
+                    const std::string tmp = path + "." + std::to_string(std::hash<std::string>{}(host_.GetUserDirectory().string())) + ".tmp";
+                    if (!host_.saveSavestateBlocking(tmp)) return;
+                    std::error_code ec;
+                    std::filesystem::rename(tmp, path, ec);
+                    if (ec) std::filesystem::remove(tmp, ec);
+                    else SCLOGD("[VM] movie checkpoint %s", path.c_str());
+                    std::filesystem::remove(tmp + ".dtm", ec);  // Dolphin's movie sibling; resume uses DtmTail instead
+                    });
+                break;
+            }
+
+            case PSOpCode::MOVIE_STOP:
+            { stop_checkpoints(); break; }  // playback itself ends with the next snapshot load
+
             case PSOpCode::SAVE_SAVESTATE_FROM: {
                 std::string path;
                 ctx.get<std::string>(op.key.id, path);
+                if (path.empty()) break;  // no save requested
                 if (!host_.saveSavestateBlocking(path)) return R;
                 break;
             }
@@ -595,6 +797,7 @@ namespace simcore {
                     const auto& r = rec[i];
                     if (!r.has_flag(PredFlag::Active)) continue;
                     if (r.required_bp && r.required_bp != hit) continue;
+                    if (!pred::applies_to_turn(r.turn_mask, cur_turn)) continue;
 
                     uint64_t lhs = 0, rhs = 0;
 
@@ -660,6 +863,47 @@ namespace simcore {
                 break;
             }
 
+            case PSOpCode::SAVE_TURN_STATE: {
+                // TURN_STATE_PATHS is a NUL-separated list indexed by turn boundary; empty entries are skipped.
+                uint32_t turn = 0; ctx.get<uint32_t>(keys::battle::ACTIVE_TURN, turn);
+                std::string list;
+                if (!ctx.get<std::string>(keys::battle::TURN_STATE_PATHS, list) || list.empty()) break;
+
+                size_t pos = 0;
+                for (uint32_t i = 0; i < turn && pos != std::string::npos; ++i) {
+                    pos = list.find('\0', pos);
+                    if (pos != std::string::npos) ++pos;
+                }
+                if (pos == std::string::npos || pos >= list.size()) break;
+                const std::string path = list.substr(pos, list.find('\0', pos) - pos);
+                if (path.empty()) break;
+
+                std::error_code ec;
+                if (std::filesystem::exists(path, ec)) break;  // another job already cached this prefix
+
+                // Write beside the target and rename so concurrent workers never expose a partial state.
+                const std::string tmp = path + ".tmp" + std::to_string(std::random_device{}());
+                if (!host_.saveSavestateBlocking(tmp)) { SCLOGW("[VM] turn state save failed: %s", tmp.c_str()); break; }
+                std::filesystem::rename(tmp, path, ec);
+                if (ec) std::filesystem::remove(tmp, ec);
+                break;
+            }
+
+            case PSOpCode::LOAD_TURN_STATE: {
+                std::string path;
+                uint32_t turn = 0;
+                if (!ctx.get<std::string>(keys::battle::RESUME_STATE_PATH, path) || path.empty()) return R;
+                ctx.get<uint32_t>(keys::battle::RESUME_TURN, turn);
+                if (!host_.loadSavestate(path)) {
+                    SCLOGW("[VM] resume state load failed: %s", path.c_str());
+                    R.ctx[keys::battle::RESUME_LOAD_FAILED] = (uint32_t)1;  // the parent reruns the job in full
+                    return R;
+                }
+                ctx[keys::battle::ACTIVE_TURN] = turn;
+                ctx[keys::core::RUN_HIT_BP_KEY] = (uint32_t)bp::battle::TurnInputs;  // boundary states sit at the input window
+                break;
+            }
+
             case PSOpCode::RECORD_PROGRESS_AT_BP: {
                 uint32_t tot = 0; ctx.get<uint32_t>(keys::core::PRED_TOTAL, tot);
                 if (tot) {
@@ -681,6 +925,12 @@ namespace simcore {
 
         }
 
+        // Throughput counters ride along with every completed job, emitted or not
+        for (auto k : { keys::core::VI_FIRST, keys::core::VI_LAST }) {
+            if (R.ctx.find(k) == R.ctx.end())
+                if (auto it = ctx.find(k); it != ctx.end()) R.ctx[k] = it->second;
+        }
+
         R.ok = true;
         return R;
     }
@@ -703,6 +953,9 @@ namespace simcore {
         case PSOpCode::EMIT_RESULT: return { "Emit result" };
         case PSOpCode::MOVIE_PLAY_FROM: return { "Play TAS Movie" };
         case PSOpCode::MOVIE_STOP: return { "Stop TAS Movie" };
+        case PSOpCode::MOVIE_PLAY_SHARED_FROM: return { "Play Shared TAS Movie" };
+        case PSOpCode::MOVIE_RESUME_FROM: return { "Resume TAS Movie" };
+        case PSOpCode::MOVIE_CHECKPOINTS_FROM: return { "Checkpoint TAS Movie" };
         case PSOpCode::SAVE_SAVESTATE_FROM: return { "Save Savestate" };
         case PSOpCode::REQUIRE_DISC_GAMEID_FROM: return { "Require Disc ID" };
         case PSOpCode::BUILD_TURN_INPUTPLAN_FROM_BATTLE_PATH: return { "Build Turn Input From Actions" };
@@ -717,6 +970,11 @@ namespace simcore {
         case PSOpCode::ARM_BPS_FROM_PRED_TABLE: return { "Arm Breakpoints from Predicate Table" };
         case PSOpCode::EVAL_PREDICATES_AT_HIT_BP: return { "Evaulate Predicates at Hit BP" };
         case PSOpCode::RECORD_PROGRESS_AT_BP: return { "Record Progress at Breakpoint" };
+        case PSOpCode::SAVE_TURN_STATE: return { "Save Turn Boundary State" };
+        case PSOpCode::LOAD_TURN_STATE: return { "Load Turn Boundary State" };
+        case PSOpCode::APPLY_INPUT_AT: return { "Apply Input At Index" };
+        case PSOpCode::APPEND_U32_FROM: return { "Append u32" };
+        case PSOpCode::RUN_BRANCH_TREE: return { "Run Branch Tree" };
         case PSOpCode::SET_U32: return { "Set a u32 Context Value" };
         case PSOpCode::ADD_U32: return { "Add to a u32 Context Value" };
         case PSOpCode::APPLY_BATTLE_INPUTPLAN_FRAMES : return { "Apply Inputplan Frame from Context" };
@@ -9,9 +9,13 @@
 #include "../Breakpoints/BPRegistry.h"    // BreakpointMap, BPKey
 #include "../Breakpoints/Predicate.h"
 #include "../../Core/DolphinWrapper.h"
+#include "../../Core/Branching/DolphinBranchHost.h"
 #include "../../Core/Input/InputPlan.h" // GCInputFrame
 #include "../../Core/Input/SoaBattle/Actiontypes.h"
 #include "../../Core/Memory/DerivedBase.h"
+#include "../../Core/Memory/KeyHostRouter.h"
+#include "../../Core/Memory/Soa/Battle/BattleContextView.h"
+#include "../../Tas/DtmCheckpoints.h"
 #include "Core/Common/Buffer.h"
 #include "KeyRegistry.h"
 #include "PSContext.h"
@@ -36,6 +40,9 @@ namespace simcore {
 
 		GC_SLOT_A_SET_FROM,        // key -> path
 		MOVIE_PLAY_FROM,           // key -> path
+		MOVIE_PLAY_SHARED_FROM,    // PSInit::shared_blob as a DTM, recording start time += (int32) ctx[key]
+		MOVIE_RESUME_FROM,         // DTM path key, checkpoint key -> load the checkpoint (if any) and play the rest
+		MOVIE_CHECKPOINTS_FROM,    // dir key, every-VI key -> save checkpoints of the playing movie during RUN_UNTIL_BP
 		MOVIE_STOP,
 		SAVE_SAVESTATE_FROM,       // key -> path
 		REQUIRE_DISC_GAMEID_FROM,  // key -> 6-char string
@@ -52,7 +59,12 @@ namespace simcore {
 		SET_U32,                    // ctx[key] = imm
 		ADD_U32,                    // ctx[key] += imm
 		APPLY_BATTLE_INPUTPLAN_FRAMES,   // plan_id = ctx[key]
-		BUILD_TURN_INPUTPLAN_FROM_BATTLE_PATH // build plan from actions
+		BUILD_TURN_INPUTPLAN_FROM_BATTLE_PATH, // build plan from actions
+		SAVE_TURN_STATE,            // save savestate for boundary ctx[ACTIVE_TURN] if TURN_STATE_PATHS names one
+		LOAD_TURN_STATE,            // load RESUME_STATE_PATH, ACTIVE_TURN = RESUME_TURN
+		APPLY_INPUT_AT,             // blob key of packed GCInputFrames, index key -> input
+		APPEND_U32_FROM,            // blob key += u32 ctx[value key] (little-endian)
+		RUN_BRANCH_TREE             // BranchTreeExecutor over core.branch.spec; leaves -> core.branch.leaf_*
 	};
 
 	static std::string get_psop_name(PSOpCode op);
@@ -82,6 +94,7 @@ namespace simcore {
 	struct PSArg_Plan { uint32_t id; };
 	struct PSArg_ImmU32 { uint32_t v; };
 	struct PSArg_KeyImm { simcore::keys::KeyId key; uint32_t imm; };
+	struct PSArg_KeyPair { simcore::keys::KeyId blob; simcore::keys::KeyId value; };
 
 	
 
@@ -98,6 +111,7 @@ namespace simcore {
 		PSArg_Plan       plan{};
 		PSArg_ImmU32     imm{};
 		PSArg_KeyImm     keyimm{};
+		PSArg_KeyPair    kp{};
 	};
 
 	inline PSOp OpLabel(const std::string& s) { PSOp o; o.code = PSOpCode::LABEL; o.label.name = s; return o; }
@@ -113,6 +127,11 @@ namespace simcore {
 	inline PSOp OpAddU32(simcore::keys::KeyId key, uint32_t v) { PSOp o; o.code = PSOpCode::ADD_U32; o.keyimm = { key,v }; return o; }
 	inline PSOp OpApplyPlanFrameFrom(simcore::keys::KeyId key) { PSOp o; o.code = PSOpCode::APPLY_BATTLE_INPUTPLAN_FRAMES; o.key = { key }; return o; }
 	inline PSOp OpBuildTurnInputFromActions() { PSOp o; o.code = PSOpCode::BUILD_TURN_INPUTPLAN_FROM_BATTLE_PATH; return o; }
+	inline PSOp OpSaveTurnState() { PSOp o; o.code = PSOpCode::SAVE_TURN_STATE; return o; }
+	inline PSOp OpLoadTurnState() { PSOp o; o.code = PSOpCode::LOAD_TURN_STATE; return o; }
+	inline PSOp OpApplyInputAt(simcore::keys::KeyId frames, simcore::keys::KeyId index) { PSOp o; o.code = PSOpCode::APPLY_INPUT_AT; o.kp = { frames, index }; return o; }
+	inline PSOp OpAppendU32From(simcore::keys::KeyId blob, simcore::keys::KeyId value) { PSOp o; o.code = PSOpCode::APPEND_U32_FROM; o.kp = { blob, value }; return o; }
+	inline PSOp OpRunBranchTree() { PSOp o; o.code = PSOpCode::RUN_BRANCH_TREE; return o; }
 
 
 	inline PSOp OpGcSlotASet(simcore::keys::KeyId k) { PSOp o; o.code = PSOpCode::GC_SLOT_A_SET_FROM; o.key.id = k; return o; }
@@ -120,6 +139,9 @@ namespace simcore {
 	inline PSOp OpSetTimeoutFromKey(simcore::keys::KeyId k) { PSOp o; o.code = PSOpCode::SET_TIMEOUT_FROM;   o.key.id = k; return o; }
 	inline PSOp OpSetTimeoutToMS(uint32_t ms) { PSOp o; o.code = PSOpCode::SET_TIMEOUT;   o.imm.v = ms; return o; }
 	inline PSOp OpMoviePlayFrom(simcore::keys::KeyId k) { PSOp o; o.code = PSOpCode::MOVIE_PLAY_FROM;    o.key.id = k; return o; }
+	inline PSOp OpMoviePlaySharedFrom(simcore::keys::KeyId k) { PSOp o; o.code = PSOpCode::MOVIE_PLAY_SHARED_FROM; o.key.id = k; return o; }
+	inline PSOp OpMovieResumeFrom(simcore::keys::KeyId dtm, simcore::keys::KeyId checkpoint) { PSOp o; o.code = PSOpCode::MOVIE_RESUME_FROM; o.kp = { dtm, checkpoint }; return o; }
+	inline PSOp OpMovieCheckpointsFrom(simcore::keys::KeyId dir, simcore::keys::KeyId every_vi) { PSOp o; o.code = PSOpCode::MOVIE_CHECKPOINTS_FROM; o.kp = { dir, every_vi }; return o; }
 	inline PSOp OpSaveSavestateFrom(simcore::keys::KeyId k) { PSOp o; o.code = PSOpCode::SAVE_SAVESTATE_FROM; o.key.id = k; return o; }
 	inline PSOp OpRequireDiscGameIdFrom(simcore::keys::KeyId k) { PSOp o; o.code = PSOpCode::REQUIRE_DISC_GAMEID_FROM; o.key.id = k; return o; }
 
@@ -157,11 +179,13 @@ namespace simcore {
 		std::string savestate_path;
 		uint32_t default_timeout_ms{ 10000 };
 		DBuf derived_buffer_type{ DBuf::DK_None };
+		std::vector<uint8_t> shared_blob;   // program-wide bytes sent once with MSG_SET_PROGRAM (e.g. the base DTM)
 	};
 
 	struct PSJob {
 		std::vector<uint8_t> payload;
 		PSContext ctx;
+		bool learned_timeouts{ true };  // runner may attach TimeoutModel budgets (clear on retries after a timeout)
 	};
 
 	struct PSResult {
@@ -175,7 +199,7 @@ namespace simcore {
 		Timeout = 1,  // wall-clock limit reached
 		ViStalled = 2,  // VI didn't advance for the configured stall window
 		MovieEnded = 3,  // movie playback ended before any breakpoint fired
-		Aborted = 4,  // reserved for future external aborts
+		Aborted = 4,  // DolphinWrapper::requestAbort() (job cancelled by the parent)
 		Unknown = 5,  // catch-all
 	};
 
@@ -202,6 +226,18 @@ namespace simcore {
 		bool armed_{ false };
 		Common::UniqueBuffer<u8> snapshot_;
 
+		// Movie of the current job as seen by MOVIE_RESUME_FROM, and where its playback started
+		tas::DtmFile movie_;
+		uint64_t movie_base_polls_{ 0 };
+		uint64_t movie_base_frame_{ 0 };
+		tas::DtmCheckpointRecorder checkpoints_;
+		void stop_checkpoints();
+
+		// Battle context at the current stop, read field by field from the paused core. Cached until
+		// an op advances emulation or reloads state (see advances_emulation in the .cpp).
+		DolphinGuestMemory guest_mem_{ &host_ };
+		soa::battle::ctx::BattleContextView battle_view_{ guest_mem_ };
+
 		// helpers
 		void arm_bps_once();
 		bool save_snapshot();
@@ -227,6 +263,9 @@ namespace simcore {
 		uint32_t last_plan_id_{ UINT32_MAX };
 
 		std::unique_ptr<simcore::IDerivedBuffer> derived_; // active derived buffer provider for this program
+
+		// RUN_BRANCH_TREE's snapshot slots, kept across jobs so a walk allocates once per depth
+		DolphinBranchHost branch_host_{ host_ };
 	};
 
 } // namespace simcore
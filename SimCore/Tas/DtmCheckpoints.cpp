@@ -0,0 +1,134 @@
+#include "DtmCheckpoints.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace simcore::tas {
+
+	static constexpr uint64_t FNV_OFFSET = 1469598103934665603ull;
+	static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+	static inline uint64_t fnv1a(uint64_t h, const uint8_t* p, size_t n) {
+		for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= FNV_PRIME; }
+		return h;
+	}
+
+	static inline void put_u64(uint8_t* p, uint64_t v) {
+		for (int i = 0; i < 8; ++i) p[i] = uint8_t(v >> (8 * i));
+	}
+
+	uint64_t DtmPrefixHash(const DtmFile& movie, uint64_t polls)
+	{
+		const size_t bpp = movie.bytes_per_poll();
+		if (!bpp || polls > movie.polls()) return 0;
+
+		// Everything from the frame count to the MD5 describes the recording, not the emulation
+		uint8_t hdr[DtmFile::kMinHeader];
+		std::copy_n(movie.bytes().data(), DtmFile::kMinHeader, hdr);
+		std::fill(hdr + DtmFile::kOffVICount, hdr + DtmFile::kOffMD5, uint8_t(0));
+		std::fill(hdr + DtmFile::kOffTickCount, hdr + DtmFile::kOffTickCount + 8, uint8_t(0));
+
+		const uint64_t h = fnv1a(FNV_OFFSET, hdr, sizeof(hdr));
+		return fnv1a(h, movie.bytes().data() + DtmFile::kMinHeader, size_t(polls) * bpp);
+	}
+
+	bool DtmTail(const DtmFile& movie, uint64_t polls, uint64_t frame, std::vector<uint8_t>& out)
+	{
+		const size_t bpp = movie.bytes_per_poll();
+		if (!bpp || polls >= movie.polls()) return false;
+
+		const auto info = movie.info();
+		const auto& in = movie.bytes();
+		out.assign(in.begin(), in.begin() + DtmFile::kMinHeader);
+		out.insert(out.end(), in.begin() + DtmFile::kMinHeader + size_t(polls) * bpp, in.end());
+
+		put_u64(out.data() + DtmFile::kOffVICount, info.vi_count > frame ? info.vi_count - frame : 0);
+		put_u64(out.data() + DtmFile::kOffInputCount, info.input_count > polls ? info.input_count - polls : 0);
+		put_u64(out.data() + DtmFile::kOffLagCount, 0);
+		return true;
+	}
+
+	std::string DtmCheckpointPath(const std::string& dir, uint64_t prefix_hash, uint64_t polls, uint64_t frame)
+	{
+		char name[64];
+		std::snprintf(name, sizeof(name), "%016" PRIx64 "_%" PRIu64 "_%" PRIu64 ".sav", prefix_hash, polls, frame);
+		return (fs::path(dir) / name).string();
+	}
+
+	bool ParseDtmCheckpointPath(const std::string& path, DtmCheckpoint& out)
+	{
+		const fs::path p(path);
+		if (p.extension() != ".sav") return false;
+		const std::string stem = p.stem().string();
+
+		unsigned long long h = 0, polls = 0, frame = 0;
+		int used = 0;
+		if (std::sscanf(stem.c_str(), "%16llx_%llu_%llu%n", &h, &polls, &frame, &used) != 3) return false;
+		if (used != (int)stem.size() || h == 0) return false;
+
+		out.prefix_hash = h;
+		out.polls = polls;
+		out.frame = frame;
+		out.path = path;
+		return true;
+	}
+
+	size_t DtmCheckpointIndex::scan(const std::string& dir)
+	{
+		all_.clear();
+		std::error_code ec;
+		for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+			DtmCheckpoint c{};
+			if (it->is_regular_file(ec) && ParseDtmCheckpointPath(it->path().string(), c)) all_.push_back(std::move(c));
+		}
+		std::sort(all_.begin(), all_.end(), [](const DtmCheckpoint& a, const DtmCheckpoint& b) { return a.polls > b.polls; });
+		return all_.size();
+	}
+
+	void DtmCheckpointIndex::add(const DtmCheckpoint& c)
+	{
+		auto at = std::find_if(all_.begin(), all_.end(), [&](const DtmCheckpoint& x) { return x.polls < c.polls; });
+		all_.insert(at, c);
+	}
+
+	bool DtmCheckpointIndex::find_resume(const DtmFile& movie, DtmCheckpoint& out) const
+	{
+		const uint64_t total = movie.polls();
+		std::unordered_map<uint64_t, uint64_t> hash_at;   // polls -> movie prefix hash, one pass per depth
+		for (const auto& c : all_) {
+			if (c.polls == 0 || c.polls >= total) continue;
+			auto it = hash_at.find(c.polls);
+			if (it == hash_at.end()) it = hash_at.emplace(c.polls, DtmPrefixHash(movie, c.polls)).first;
+			if (it->second != c.prefix_hash) continue;
+			out = c;
+			return true;
+		}
+		return false;
+	}
+
+	void DtmCheckpointRecorder::begin(const DtmFile& movie, const std::string& dir, uint64_t base_polls, uint64_t base_frame)
+	{
+		movie_ = movie;
+		dir_ = dir;
+		base_polls_ = base_polls;
+		base_frame_ = base_frame;
+		std::error_code ec;
+		if (!dir_.empty()) fs::create_directories(dir_, ec);
+	}
+
+	std::string DtmCheckpointRecorder::target(uint64_t frame, uint64_t polls) const
+	{
+		if (dir_.empty()) return {};
+		const uint64_t abs_polls = base_polls_ + polls;
+		const uint64_t h = DtmPrefixHash(movie_, abs_polls);
+		if (!h) return {};
+		const std::string path = DtmCheckpointPath(dir_, h, abs_polls, base_frame_ + frame);
+		std::error_code ec;
+		return fs::exists(path, ec) ? std::string{} : path;
+	}
+
+} // namespace simcore::tas
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "DtmFile.h"
+
+namespace simcore::tas {
+
+	// Checkpointed playback: savestates captured every N movie frames while a DTM plays, so a later job
+	// whose movie shares the same input prefix resumes from the deepest one instead of from the start.
+	//
+	// A checkpoint is keyed by the movie's prefix hash at the poll it was captured on: FNV-1a over the
+	// header (counts, author, backend names and tick count masked, so a variant with a different tail
+	// still matches) followed by the first `polls` input records. Files live flat in one directory:
+	//   <dir>/<hash:016x>_<polls>_<frame>.sav
+	// Resuming loads the state and plays DtmTail(movie, polls, frame) on top of it.
+
+	// 0 => Wii movie, or `polls` beyond the movie's input stream.
+	uint64_t DtmPrefixHash(const DtmFile& movie, uint64_t polls);
+
+	// The movie from poll `polls` / VI `frame` on: same header with shortened counts, input stream cut.
+	bool DtmTail(const DtmFile& movie, uint64_t polls, uint64_t frame, std::vector<uint8_t>& out);
+
+	struct DtmCheckpoint {
+		uint64_t prefix_hash{ 0 };
+		uint64_t polls{ 0 };    // input polls consumed when captured
+		uint64_t frame{ 0 };    // movie VI frame when captured
+		std::string path;
+	};
+
+	std::string DtmCheckpointPath(const std::string& dir, uint64_t prefix_hash, uint64_t polls, uint64_t frame);
+	bool ParseDtmCheckpointPath(const std::string& path, DtmCheckpoint& out);
+
+	class DtmCheckpointIndex {
+	public:
+		size_t scan(const std::string& dir);   // replaces the index with the checkpoints in `dir`
+		void add(const DtmCheckpoint& c);
+		size_t size() const { return all_.size(); }
+
+		// Deepest checkpoint on `movie`'s own input prefix that still leaves input to play.
+		bool find_resume(const DtmFile& movie, DtmCheckpoint& out) const;
+
+	private:
+		std::vector<DtmCheckpoint> all_;   // deepest first
+	};
+
+	// Worker side of capture: where the checkpoint for the playing movie's (frame, polls) goes.
+	// Frame and polls are counted from where playback started, i.e. relative to the resumed checkpoint.
+	class DtmCheckpointRecorder {
+	public:
+		void begin(const DtmFile& movie, const std::string& dir, uint64_t base_polls, uint64_t base_frame);
+		void end() { dir_.clear(); }
+		bool active() const { return !dir_.empty(); }
+
+		// "" if already on disk (another worker got there first) or the movie cannot be hashed there.
+		std::string target(uint64_t frame, uint64_t polls) const;
+
+	private:
+		DtmFile movie_;
+		std::string dir_;
+		uint64_t base_polls_{ 0 };
+		uint64_t base_frame_{ 0 };
+	};
+
+} // namespace simcore::tas
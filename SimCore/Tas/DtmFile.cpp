@@ -28,11 +28,16 @@ bool DtmFile::load(const std::string& path)
 	f.seekg(0, std::ios::end);
 	const auto sz = (size_t)f.tellg();
 	f.seekg(0, std::ios::beg);
-	m_bytes.resize(sz);
-	if (!f.read((char*)m_bytes.data(), m_bytes.size())) return false;
-	if (m_bytes.size() < kMinHeader) return false;
-	const uint8_t sig[4]{ 'D','T','M',0x1A };
-	if (memcmp(m_bytes.data() + kOffSignature, sig, 4) != 0) return false;
+	std::vector<uint8_t> buf(sz);
+	if (!f.read((char*)buf.data(), buf.size())) return false;
+	return load(buf.data(), buf.size());
+}
+
+bool DtmFile::load(const uint8_t* data, size_t size)
+{
+	m_bytes.clear(); m_valid = false;
+	if (!has_signature(data, size)) return false;
+	m_bytes.assign(data, data + size);
 	m_valid = true;
 	return true;
 }
@@ -46,25 +51,45 @@ bool DtmFile::save(const std::string& path) const
 	return (bool)f;
 }
 
+bool DtmFile::has_signature(const uint8_t* data, size_t size)
+{
+	if (!data || size < kMinHeader) return false;
+	const uint8_t sig[4]{ 'D','T','M',0x1A };
+	return memcmp(data + kOffSignature, sig, 4) == 0;
+}
+
 DtmInfo DtmFile::info() const
+{
+	if (!m_valid) return DtmInfo{};
+	return parse_info(m_bytes.data());
+}
+
+DtmInfo DtmFile::parse_info(const uint8_t* h)
 {
 	DtmInfo i{};
-	if (!m_valid) return i;
-	memcpy(i.game_id.data(), m_bytes.data() + kOffGameID, 6);
-	i.is_wii = m_bytes[kOffIsWii] != 0;
-	i.controllers = m_bytes[kOffControllers];
-	i.starts_from_savestate = m_bytes[kOffStartsFromSavestate] != 0;
-	i.vi_count = read_le<uint64_t>(m_bytes.data() + kOffVICount);
-	i.input_count = read_le<uint64_t>(m_bytes.data() + kOffInputCount);
-	i.lag_count = read_le<uint64_t>(m_bytes.data() + kOffLagCount);
-	i.rerecord_count = read_le<uint32_t>(m_bytes.data() + kOffRerecordCount);
-	memcpy(i.game_md5.data(), m_bytes.data() + kOffMD5, 16);
-	i.recording_start_time = read_le<uint64_t>(m_bytes.data() + kOffRecordingStartTime);
-	i.memcard_bits = m_bytes[kOffMemcardBits];
-	i.memcard_blank = m_bytes[kOffMemcardBlank] != 0;
+	memcpy(i.game_id.data(), h + kOffGameID, 6);
+	i.is_wii = h[kOffIsWii] != 0;
+	i.controllers = h[kOffControllers];
+	i.starts_from_savestate = h[kOffStartsFromSavestate] != 0;
+	i.vi_count = read_le<uint64_t>(h + kOffVICount);
+	i.input_count = read_le<uint64_t>(h + kOffInputCount);
+	i.lag_count = read_le<uint64_t>(h + kOffLagCount);
+	i.rerecord_count = read_le<uint32_t>(h + kOffRerecordCount);
+	memcpy(i.game_md5.data(), h + kOffMD5, 16);
+	i.recording_start_time = read_le<uint64_t>(h + kOffRecordingStartTime);
+	i.memcard_bits = h[kOffMemcardBits];
+	i.memcard_blank = h[kOffMemcardBlank] != 0;
 	return i;
 }
 
+size_t DtmFile::bytes_per_poll() const
+{
+	if (!m_valid || m_bytes[kOffIsWii] != 0) return 0;
+	size_t pads = 0;
+	for (int i = 0; i < 4; ++i) pads += (m_bytes[kOffControllers] >> i) & 1;
+	return pads * 8;
+}
+
 void DtmFile::set_recording_start_time(uint64_t unix_time)
 {
 	if (!m_valid) return;
@@ -32,20 +32,30 @@ namespace simcore::tas {
 		static constexpr size_t kOffInputCount = 0x015;
 		static constexpr size_t kOffLagCount = 0x01D;
 		static constexpr size_t kOffRerecordCount = 0x02D;
+		static constexpr size_t kOffAuthor = 0x031;
+		static constexpr size_t kOffVideoBackend = 0x051;     // + audio emulator name, up to kOffMD5
 		static constexpr size_t kOffMD5 = 0x071;
 		static constexpr size_t kOffRecordingStartTime = 0x081;
 		static constexpr size_t kOffMemcardBits = 0x097;
 		static constexpr size_t kOffMemcardBlank = 0x098;
-		static constexpr size_t kMinHeader = 0x100;
+		static constexpr size_t kOffTickCount = 0x0ED;
+		static constexpr size_t kMinHeader = 0x100;            // input stream starts here
 
 		bool load(const std::string& path);
+		bool load(const uint8_t* data, size_t size);   // copies; same validation as the file overload
 		bool save(const std::string& path) const;
 
 		bool valid() const { return m_valid; }
 		const std::vector<uint8_t>& bytes() const { return m_bytes; }
 
 		DtmInfo info() const;
+		static DtmInfo parse_info(const uint8_t* header);   // header: kMinHeader bytes, signature already checked
+		static bool has_signature(const uint8_t* data, size_t size);
+		// Input bytes per poll: 8 per GC controller plugged in; 0 for Wii movies (variable-size records).
+		size_t bytes_per_poll() const;
+		uint64_t polls() const { const size_t b = bytes_per_poll(); return b ? (m_bytes.size() - kMinHeader) / b : 0; }
 		void set_recording_start_time(uint64_t unix_time);
+		void shift_recording_start_time(int64_t delta_sec) { set_recording_start_time(info().recording_start_time + (uint64_t)delta_sec); }
 
 	private:
 		template <class T> static T read_le(const uint8_t* p);
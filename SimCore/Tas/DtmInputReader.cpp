@@ -0,0 +1,236 @@
+#include "DtmInputReader.h"
+#include <algorithm>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace simcore::tas {
+
+	// ControllerState bit layout (little-endian u16 over bytes 0..1)
+	static constexpr uint16_t kStart = 1u << 0, kA = 1u << 1, kB = 1u << 2, kX = 1u << 3, kY = 1u << 4, kZ = 1u << 5;
+	static constexpr uint16_t kDUp = 1u << 6, kDDown = 1u << 7, kDLeft = 1u << 8, kDRight = 1u << 9;
+	static constexpr uint16_t kL = 1u << 10, kR = 1u << 11, kConnected = 1u << 14;
+
+	static constexpr std::pair<uint16_t, uint16_t> kButtonMap[] = {
+		{ kStart, GC_START }, { kA, GC_A }, { kB, GC_B }, { kX, GC_X }, { kY, GC_Y }, { kZ, GC_Z },
+		{ kDUp, GC_DU }, { kDDown, GC_DD }, { kDLeft, GC_DL }, { kDRight, GC_DR },
+		{ kL, GC_L_BTN }, { kR, GC_R_BTN },
+	};
+
+	GCInputFrame DecodeGcPadRecord(const uint8_t* rec)
+	{
+		const uint16_t bits = uint16_t(rec[0] | (rec[1] << 8));
+		GCInputFrame f{};
+		for (const auto& [dtm, gc] : kButtonMap)
+			if (bits & dtm) f.buttons = uint16_t(f.buttons | gc);
+		f.trig_l = rec[2];
+		f.trig_r = rec[3];
+		f.main_x = rec[4];
+		f.main_y = rec[5];
+		f.c_x = rec[6];
+		f.c_y = rec[7];
+		return f;
+	}
+
+	void EncodeGcPadRecord(const GCInputFrame& f, uint8_t* rec)
+	{
+		uint16_t bits = kConnected;
+		for (const auto& [dtm, gc] : kButtonMap)
+			if (f.buttons & gc) bits = uint16_t(bits | dtm);
+		rec[0] = uint8_t(bits);
+		rec[1] = uint8_t(bits >> 8);
+		rec[2] = f.trig_l;
+		rec[3] = f.trig_r;
+		rec[4] = f.main_x;
+		rec[5] = f.main_y;
+		rec[6] = f.c_x;
+		rec[7] = f.c_y;
+	}
+
+	DtmInputReader::~DtmInputReader() { close(); }
+
+	bool DtmInputReader::attach(const uint8_t* data, size_t size, std::string* error_out)
+	{
+		if (!DtmFile::has_signature(data, size)) {
+			if (error_out) *error_out = "Not a DTM movie";
+			return false;
+		}
+		const DtmInfo info = DtmFile::parse_info(data);
+		if (info.is_wii) {
+			if (error_out) *error_out = "Wii movies have variable-size input records";
+			return false;
+		}
+		size_t pads = 0;
+		for (int i = 0; i < 4; ++i) pads += (info.controllers >> i) & 1;
+		if (!pads) {
+			if (error_out) *error_out = "Movie has no GC controller plugged in";
+			return false;
+		}
+
+		data_ = data;
+		size_ = size;
+		info_ = info;
+		stride_ = pads * kRecordSize;
+		polls_ = (size - DtmFile::kMinHeader) / stride_;
+		pos_ = 0;
+		port_ = -1;
+		for (int p = 0; p < 4 && port_ < 0; ++p) select_port(p);
+		return true;
+	}
+
+	bool DtmInputReader::select_port(int port)
+	{
+		if (!is_open() || port < 0 || port > 3 || !((info_.controllers >> port) & 1)) return false;
+		size_t before = 0;
+		for (int i = 0; i < port; ++i) before += (info_.controllers >> i) & 1;
+		port_ = port;
+		port_off_ = before * kRecordSize;
+		return true;
+	}
+
+	bool DtmInputReader::seek(uint64_t poll)
+	{
+		if (!is_open() || poll > polls_) return false;
+		pos_ = poll;
+		return true;
+	}
+
+	bool DtmInputReader::next(GCInputFrame& out)
+	{
+		if (!is_open() || pos_ >= polls_) return false;
+		out = DecodeGcPadRecord(data_ + DtmFile::kMinHeader + size_t(pos_) * stride_ + port_off_);
+		++pos_;
+		return true;
+	}
+
+	size_t DtmInputReader::read(InputPlan& out, uint64_t count)
+	{
+		if (!is_open()) return 0;
+		const size_t n = size_t(std::min<uint64_t>(count, polls_ - pos_));
+		out.reserve(out.size() + n);
+		const uint8_t* p = data_ + DtmFile::kMinHeader + size_t(pos_) * stride_ + port_off_;
+		for (size_t i = 0; i < n; ++i, p += stride_) out.push_back(DecodeGcPadRecord(p));
+		pos_ += n;
+		return n;
+	}
+
+#if defined(_WIN32)
+
+	bool DtmInputReader::open(const std::string& path, std::string* error_out)
+	{
+		close();
+		HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (f == INVALID_HANDLE_VALUE) {
+			if (error_out) *error_out = "Could not open DTM: " + path;
+			return false;
+		}
+		LARGE_INTEGER sz{};
+		if (!GetFileSizeEx(f, &sz) || sz.QuadPart <= 0) {
+			CloseHandle(f);
+			if (error_out) *error_out = "Empty DTM: " + path;
+			return false;
+		}
+		HANDLE m = CreateFileMappingA(f, NULL, PAGE_READONLY, 0, 0, NULL);
+		const void* v = m ? MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (!v) {
+			if (m) CloseHandle(m);
+			CloseHandle(f);
+			if (error_out) *error_out = "Could not map DTM: " + path;
+			return false;
+		}
+		file_ = f;
+		map_ = m;
+		if (!attach(static_cast<const uint8_t*>(v), size_t(sz.QuadPart), error_out)) {
+			UnmapViewOfFile(v);
+			unmap();
+			return false;
+		}
+		return true;
+	}
+
+	void DtmInputReader::unmap()
+	{
+		if (map_ && data_) UnmapViewOfFile(data_);
+		if (map_) CloseHandle((HANDLE)map_);
+		if (file_) CloseHandle((HANDLE)file_);
+		map_ = nullptr;
+		file_ = nullptr;
+	}
+
+#else
+
+	bool DtmInputReader::open(const std::string& path, std::string* error_out)
+	{
+		close();
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			if (error_out) *error_out = "Could not open DTM: " + path;
+			return false;
+		}
+		struct stat st {};
+		if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+			::close(fd);
+			if (error_out) *error_out = "Empty DTM: " + path;
+			return false;
+		}
+		void* v = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (v == MAP_FAILED) {
+			if (error_out) *error_out = "Could not map DTM: " + path;
+			return false;
+		}
+		madvise(v, size_t(st.st_size), MADV_SEQUENTIAL);
+		map_ = v;
+		file_ = reinterpret_cast<void*>(uintptr_t(st.st_size));
+		if (!attach(static_cast<const uint8_t*>(v), size_t(st.st_size), error_out)) {
+			unmap();
+			return false;
+		}
+		return true;
+	}
+
+	void DtmInputReader::unmap()
+	{
+		if (map_) munmap(map_, size_t(uintptr_t(file_)));
+		map_ = nullptr;
+		file_ = nullptr;
+	}
+
+#endif
+
+	void DtmInputReader::close()
+	{
+		unmap();
+		data_ = nullptr;
+		size_ = 0;
+		polls_ = pos_ = 0;
+		port_ = -1;
+	}
+
+	bool DtmReadPlan(const std::string& path, uint64_t first_poll, uint64_t count, InputPlan& out,
+		int port, std::string* error_out)
+	{
+		DtmInputReader r;
+		if (!r.open(path, error_out)) return false;
+		if (port >= 0 && !r.select_port(port)) {
+			if (error_out) *error_out = "Port " + std::to_string(port) + " is not plugged in: " + path;
+			return false;
+		}
+		if (!r.seek(first_poll)) {
+			if (error_out) *error_out = "Movie has only " + std::to_string(r.polls()) + " polls: " + path;
+			return false;
+		}
+		out.clear();
+		r.read(out, count);
+		return true;
+	}
+
+} // namespace simcore::tas
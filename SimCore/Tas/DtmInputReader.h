@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "DtmFile.h"
+#include "../Core/Input/InputPlan.h"
+
+namespace simcore::tas {
+
+	// Streaming decoder for the input stream of a GC movie.
+	//
+	// The file is memory-mapped rather than read, so opening a multi-hour movie costs nothing and
+	// only the pages actually walked are faulted in. Records are Dolphin's ControllerState, 8 bytes
+	// per plugged port per input poll, in port order. The reader yields one port's frames, one per
+	// poll; SoA polls once per field, so that is one frame per VI (compare info().input_count with
+	// info().vi_count for a movie of another game).
+	//
+	// Frames come out in InputPlan form, so a segment of a recorded run can be fed to
+	// DolphinWrapper::setInputPlan or turned into a BranchSpec (Core/Branching) with BranchSpecFromPlan.
+
+	GCInputFrame DecodeGcPadRecord(const uint8_t* rec);
+	void EncodeGcPadRecord(const GCInputFrame& f, uint8_t* rec);   // sets the connected bit
+
+	class DtmInputReader {
+	public:
+		static constexpr size_t kRecordSize = 8;
+
+		DtmInputReader() = default;
+		~DtmInputReader();
+
+		DtmInputReader(const DtmInputReader&) = delete;
+		DtmInputReader& operator=(const DtmInputReader&) = delete;
+
+		bool open(const std::string& path, std::string* error_out = nullptr);
+
+		// Reads an image already in memory; `data` must outlive the reader.
+		bool attach(const uint8_t* data, size_t size, std::string* error_out = nullptr);
+
+		void close();
+		bool is_open() const { return data_ != nullptr; }
+
+		const DtmInfo& info() const { return info_; }
+		uint64_t polls() const { return polls_; }
+		uint64_t position() const { return pos_; }
+		int port() const { return port_; }
+
+		// Port the frames are taken from; defaults to the first plugged one. false if unplugged.
+		bool select_port(int port);
+		bool seek(uint64_t poll);
+
+		// The frame at position() for the selected port, then advances; false past the last poll.
+		bool next(GCInputFrame& out);
+
+		// Up to `count` frames from position() appended to `out`; returns how many.
+		size_t read(InputPlan& out, uint64_t count);
+
+	private:
+		void unmap();
+
+		const uint8_t* data_{ nullptr };
+		size_t size_{ 0 };
+		void* map_{ nullptr };      // platform mapping handle / base, null when attached
+		void* file_{ nullptr };
+
+		DtmInfo info_{};
+		size_t stride_{ 0 };        // bytes per poll, all ports
+		size_t port_off_{ 0 };      // selected port's record within a poll
+		int port_{ -1 };
+		uint64_t polls_{ 0 };
+		uint64_t pos_{ 0 };
+	};
+
+	// Polls [first_poll, first_poll + count) of the movie at `path` as an InputPlan (count is clamped
+	// to the end of the movie). port < 0 takes the first plugged port.
+	bool DtmReadPlan(const std::string& path, uint64_t first_poll, uint64_t count, InputPlan& out,
+		int port = -1, std::string* error_out = nullptr);
+
+} // namespace simcore::tas
@@ -0,0 +1,295 @@
+#include "CpuAffinity.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <map>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace simcore::cpu {
+
+    uint32_t CpuMask::count() const
+    {
+        uint32_t n = 0;
+        for (uint64_t b = bits; b; b &= b - 1) ++n;
+        return n;
+    }
+
+    int CpuMask::first() const
+    {
+        for (int i = 0; i < 64; ++i)
+            if (bits & (1ull << i)) return i;
+        return -1;
+    }
+
+    std::string CpuMask::to_string() const
+    {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%u:%llx", (unsigned)group, (unsigned long long)bits);
+        return buf;
+    }
+
+    bool CpuMask::parse(const std::string& s, CpuMask& out)
+    {
+        const size_t colon = s.find(':');
+        if (colon == std::string::npos || colon == 0 || colon + 1 >= s.size()) return false;
+        try {
+            size_t used = 0;
+            const unsigned long g = std::stoul(s.substr(0, colon), &used, 10);
+            if (used != colon || g > 0xFFFF) return false;
+            const std::string hex = s.substr(colon + 1);
+            const unsigned long long b = std::stoull(hex, &used, 16);
+            if (used != hex.size()) return false;
+            out = CpuMask{ (uint16_t)g, (uint64_t)b };
+        }
+        catch (...) { return false; }
+        return true;
+    }
+
+    bool Topology::smt() const
+    {
+        for (const auto& c : cores)
+            if (c.lps.count() > 1) return true;
+        return false;
+    }
+
+    PlacementPlan PlanPlacement(const Topology& topo, size_t workers, const AffinityPolicy& policy)
+    {
+        PlacementPlan plan{};
+        plan.workers.resize(workers);
+        if (!policy.enabled || topo.cores.empty()) return plan;
+
+        std::vector<size_t> order(topo.cores.size());
+        std::iota(order.begin(), order.end(), size_t{ 0 });
+        auto eff = [&](size_t i) { return policy.prefer_fast_cores ? topo.cores[i].efficiency : 0u; };
+
+        // Coordinator: the slowest cores, lowest OS index first, all in one group
+        std::vector<bool> taken(topo.cores.size(), false);
+        if (topo.cores.size() > policy.parent_cores) {
+            std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return eff(a) < eff(b); });
+            uint32_t reserved = 0;
+            for (size_t i : order) {
+                if (reserved >= policy.parent_cores) break;
+                if (!plan.parent.empty() && topo.cores[i].lps.group != plan.parent.group) continue;
+                plan.parent = plan.parent | topo.cores[i].lps;
+                taken[i] = true;
+                ++reserved;
+            }
+        }
+
+        // Workers: fastest first, OS order within a class
+        std::iota(order.begin(), order.end(), size_t{ 0 });
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return eff(a) > eff(b); });
+        size_t w = 0;
+        for (size_t i : order) {
+            if (w >= workers) break;
+            if (taken[i]) continue;
+            const CpuMask& lps = topo.cores[i].lps;
+            const int primary = lps.first();
+            if (primary < 0) continue;
+
+            WorkerPlacement& p = plan.workers[w++];
+            p.emu = CpuMask{ lps.group, 1ull << primary };
+            const CpuMask siblings{ lps.group, lps.bits & ~p.emu.bits };
+            p.aux = (policy.aux_on_sibling && !siblings.empty()) ? siblings : p.emu;
+            taken[i] = true;
+            ++plan.dedicated;
+        }
+        return plan;
+    }
+
+#if defined(_WIN32)
+
+    Topology QueryTopology()
+    {
+        Topology t{};
+        DWORD len = 0;
+        GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &len);
+        if (GetLastError() != ERROR_INSUFFICIENT_BUFFER || len == 0) return t;
+
+        std::vector<uint8_t> buf(len);
+        auto* base = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buf.data());
+        if (!GetLogicalProcessorInformationEx(RelationProcessorCore, base, &len)) return t;
+
+        for (DWORD off = 0; off < len;) {
+            auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buf.data() + off);
+            if (info->Relationship == RelationProcessorCore && info->Processor.GroupCount >= 1) {
+                const GROUP_AFFINITY& ga = info->Processor.GroupMask[0];
+                PhysicalCore c{};
+                c.lps = CpuMask{ ga.Group, (uint64_t)ga.Mask };
+                c.efficiency = info->Processor.EfficiencyClass;
+                t.logical += c.lps.count();
+                t.cores.push_back(c);
+            }
+            off += info->Size;
+        }
+        return t;
+    }
+
+    static std::string last_error(const char* what)
+    {
+        return std::string(what) + " failed (err=" + std::to_string(GetLastError()) + ")";
+    }
+
+    bool PinCurrentThread(const CpuMask& m, std::string* error_out)
+    {
+        if (m.empty()) return true;
+        GROUP_AFFINITY ga{};
+        ga.Group = m.group;
+        ga.Mask = (KAFFINITY)m.bits;
+        if (!SetThreadGroupAffinity(GetCurrentThread(), &ga, nullptr)) {
+            if (error_out) *error_out = last_error("SetThreadGroupAffinity");
+            return false;
+        }
+        return true;
+    }
+
+    bool PinCurrentProcess(const CpuMask& m, std::string* error_out)
+    {
+        if (m.empty()) return true;
+        USHORT groups[4]{}; USHORT n = 4;
+        if (GetProcessGroupAffinity(GetCurrentProcess(), &n, groups) && n == 1 && groups[0] != m.group) {
+            if (error_out) *error_out = "process runs in group " + std::to_string(groups[0]) + ", not " + std::to_string(m.group);
+            return false;
+        }
+        if (!SetProcessAffinityMask(GetCurrentProcess(), (DWORD_PTR)m.bits)) {
+            if (error_out) *error_out = last_error("SetProcessAffinityMask");
+            return false;
+        }
+        return true;
+    }
+
+    CpuMask CurrentCpu()
+    {
+        PROCESSOR_NUMBER pn{};
+        GetCurrentProcessorNumberEx(&pn);
+        return CpuMask{ pn.Group, 1ull << pn.Number };
+    }
+
+#elif defined(__linux__)
+
+    static bool read_line(const std::string& path, std::string& out)
+    {
+        std::ifstream f(path);
+        return bool(std::getline(f, out));
+    }
+
+    // "0-3,8,10-11" -> cpu numbers
+    static std::vector<int> parse_cpu_list(const std::string& s)
+    {
+        std::vector<int> out;
+        size_t i = 0;
+        while (i < s.size()) {
+            size_t end = s.find(',', i);
+            if (end == std::string::npos) end = s.size();
+            const std::string part = s.substr(i, end - i);
+            const size_t dash = part.find('-');
+            try {
+                if (dash == std::string::npos) { if (!part.empty()) out.push_back(std::stoi(part)); }
+                else for (int c = std::stoi(part.substr(0, dash)), e = std::stoi(part.substr(dash + 1)); c <= e; ++c) out.push_back(c);
+            }
+            catch (...) { return {}; }
+            i = end + 1;
+        }
+        return out;
+    }
+
+    Topology QueryTopology()
+    {
+        Topology t{};
+        std::string online;
+        if (!read_line("/sys/devices/system/cpu/online", online)) return t;
+
+        std::map<std::vector<int>, size_t> by_siblings;  // sibling set -> core index
+        for (int cpu : parse_cpu_list(online)) {
+            const std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+            std::string sib;
+            std::vector<int> sibs = read_line(dir + "/topology/thread_siblings_list", sib) ? parse_cpu_list(sib) : std::vector<int>{};
+            if (sibs.empty()) sibs.push_back(cpu);
+            ++t.logical;
+
+            auto it = by_siblings.find(sibs);
+            if (it == by_siblings.end()) {
+                PhysicalCore c{};
+                c.lps.group = uint16_t(sibs.front() / 64);
+                std::string cap;
+                if (read_line(dir + "/cpu_capacity", cap)) {
+                    try { c.efficiency = (uint32_t)std::stoul(cap); } catch (...) {}
+                }
+                it = by_siblings.emplace(sibs, t.cores.size()).first;
+                t.cores.push_back(c);
+            }
+            PhysicalCore& c = t.cores[it->second];
+            if (cpu / 64 == c.lps.group) c.lps.bits |= 1ull << (cpu % 64);
+        }
+        return t;
+    }
+
+    static void to_cpu_set(const CpuMask& m, cpu_set_t& set)
+    {
+        CPU_ZERO(&set);
+        for (int i = 0; i < 64; ++i)
+            if (m.bits & (1ull << i)) CPU_SET(int(m.group) * 64 + i, &set);
+    }
+
+    bool PinCurrentThread(const CpuMask& m, std::string* error_out)
+    {
+        if (m.empty()) return true;
+        cpu_set_t set;
+        to_cpu_set(m, set);
+        if (const int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set); rc != 0) {
+            if (error_out) *error_out = std::string("pthread_setaffinity_np failed: ") + std::strerror(rc);
+            return false;
+        }
+        return true;
+    }
+
+    // Linux affinity is per thread: apply to every existing thread; new ones inherit their creator's.
+    bool PinCurrentProcess(const CpuMask& m, std::string* error_out)
+    {
+        if (m.empty()) return true;
+        cpu_set_t set;
+        to_cpu_set(m, set);
+        DIR* d = opendir("/proc/self/task");
+        if (!d) return PinCurrentThread(m, error_out);
+        bool ok = true;
+        while (dirent* e = readdir(d)) {
+            if (e->d_name[0] == '.') continue;
+            const pid_t tid = (pid_t)std::atoi(e->d_name);
+            if (sched_setaffinity(tid, sizeof(set), &set) != 0 && errno != ESRCH) {
+                if (error_out) *error_out = std::string("sched_setaffinity failed: ") + std::strerror(errno);
+                ok = false;
+            }
+        }
+        closedir(d);
+        return ok;
+    }
+
+    CpuMask CurrentCpu()
+    {
+        const int c = sched_getcpu();
+        if (c < 0) return {};
+        return CpuMask{ uint16_t(c / 64), 1ull << (c % 64) };
+    }
+
+#else
+
+    Topology QueryTopology() { return {}; }
+    bool PinCurrentThread(const CpuMask& m, std::string* error_out) { if (error_out && !m.empty()) *error_out = "not supported"; return m.empty(); }
+    bool PinCurrentProcess(const CpuMask& m, std::string* error_out) { if (error_out && !m.empty()) *error_out = "not supported"; return m.empty(); }
+    CpuMask CurrentCpu() { return {}; }
+
+#endif
+
+} // namespace simcore::cpu
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// CPU topology and thread placement for worker pools.
+//
+// A CpuMask is a set of logical processors inside one 64-processor group (Windows processor groups;
+// on Linux group g covers cpus [64g, 64g + 63]). Everything here is best effort: a failed pin is
+// logged by the caller and the thread keeps running wherever the scheduler puts it.
+
+namespace simcore::cpu {
+
+    struct CpuMask {
+        uint16_t group{ 0 };
+        uint64_t bits{ 0 };
+
+        bool empty() const { return bits == 0; }
+        uint32_t count() const;
+        int first() const;  // lowest set index, -1 if empty
+        CpuMask operator|(const CpuMask& o) const {  // masks of different groups do not combine; keeps *this
+            if (empty()) return o;
+            if (o.empty() || o.group != group) return *this;
+            return CpuMask{ group, bits | o.bits };
+        }
+
+        std::string to_string() const;                    // "g:hexbits", e.g. "0:30"
+        static bool parse(const std::string& s, CpuMask& out);
+    };
+
+    struct PhysicalCore {
+        CpuMask lps;                 // all SMT siblings; the lowest is the primary
+        uint32_t efficiency{ 0 };    // Windows EfficiencyClass / Linux cpu_capacity; higher = faster
+    };
+
+    struct Topology {
+        std::vector<PhysicalCore> cores;  // in OS enumeration order
+        uint32_t logical{ 0 };
+        bool smt() const;
+    };
+
+    // Reads the machine topology (GetLogicalProcessorInformationEx / sysfs). Empty on failure.
+    Topology QueryTopology();
+
+    // Placement of one worker process.
+    struct WorkerPlacement {
+        CpuMask emu;   // emulated CPU thread: the primary logical processor of a dedicated core
+        CpuMask aux;   // the worker's other threads (host loop, stdin reader, video/audio): SMT siblings
+        bool pinned() const { return !emu.empty(); }
+    };
+
+    struct AffinityPolicy {
+        bool     enabled{ false };
+        uint32_t parent_cores{ 1 };     // physical cores kept for the coordinator (dispatchers, readers, UI)
+        bool     aux_on_sibling{ true };  // false: aux shares emu (no SMT, or siblings should stay idle)
+        bool     prefer_fast_cores{ true };  // hybrid CPUs: hand out the highest efficiency class first
+    };
+
+    struct PlacementPlan {
+        std::vector<WorkerPlacement> workers;  // one per local worker; unpinned entries when cores ran out
+        CpuMask parent;                        // coordinator threads; empty => leave them unpinned
+        uint32_t dedicated{ 0 };               // workers that got a core of their own
+    };
+
+    // Reserves parent_cores for the coordinator (slowest class first, in OS order, so core 0 on
+    // uniform CPUs), then deals one physical core per worker: primary LP -> emu, its siblings -> aux.
+    // Workers beyond the remaining cores stay unpinned. With no more cores than parent_cores nothing
+    // is reserved and the parent mask stays empty.
+    PlacementPlan PlanPlacement(const Topology& topo, size_t workers, const AffinityPolicy& policy);
+
+    // Restricts the calling thread / the whole process to `m`. false (with the OS error in error_out)
+    // on failure; on Windows a process mask must be within the process's group.
+    bool PinCurrentThread(const CpuMask& m, std::string* error_out = nullptr);
+    bool PinCurrentProcess(const CpuMask& m, std::string* error_out = nullptr);
+
+    // Logical processor the calling thread last ran on (diagnostics).
+    CpuMask CurrentCpu();
+
+} // namespace simcore::cpu
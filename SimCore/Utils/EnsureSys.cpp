@@ -33,8 +33,15 @@ namespace simcore {
                 else if (it->is_regular_file()) {
                     std::filesystem::create_directories(to.parent_path(), ec);
                     ec.clear();
-                    std::filesystem::copy_file(p, to,
-                        std::filesystem::copy_options::overwrite_existing, ec);
+                    // Sys is read-only to Dolphin: a hardlink is as good as a copy when on the same volume
+                    std::filesystem::remove(to, ec);
+                    ec.clear();
+                    std::filesystem::create_hard_link(p, to, ec);
+                    if (ec) {
+                        ec.clear();
+                        std::filesystem::copy_file(p, to,
+                            std::filesystem::copy_options::overwrite_existing, ec);
+                    }
                 }
                 if (ec) return false;
             }
@@ -56,7 +63,7 @@ namespace simcore {
         HANDLE m = CreateMutexW(nullptr, FALSE, L"Global\\SimCore_CopySysOnce");
         WaitForSingleObject(m, INFINITE);
 
-        bool ok = fs::exists(dst / "dsp_coef.bin") || copy_tree(src, dst);
+        bool ok = fs::exists(dst / "GC" / "dsp_coef.bin") || copy_tree(src, dst);
 
         ReleaseMutex(m);
         CloseHandle(m);
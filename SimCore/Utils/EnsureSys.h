@@ -2,6 +2,6 @@
 #include <string>
 
 namespace simcore {
-	// Returns true if <exe_dir>\Sys exists (and contains dsp_coef.bin), else copies from qt_base\Sys.
+	// Returns true if <exe_dir>\Sys exists (and contains dsp_coef.bin), else hardlinks (or copies) it from qt_base\Sys.
 	bool EnsureSysBesideExe(const std::string& qt_base_dir);
 }
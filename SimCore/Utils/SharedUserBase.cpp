@@ -0,0 +1,230 @@
+#include "SharedUserBase.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace simcore {
+
+    static constexpr const char* kCompleteMarker = ".snapshot-complete";
+    static constexpr const char* kStampFile = ".simcore-base";
+    static constexpr const char* kLinkPolicy = "/shared-dirs2";  // stamp suffix; dirs built under an older list are rebuilt
+
+    static constexpr uint64_t FNV_OFFSET = 1469598103934665603ull;
+    static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+    static inline uint64_t fnv1a(uint64_t h, const void* p, size_t n) {
+        const auto* b = static_cast<const uint8_t*>(p);
+        for (size_t i = 0; i < n; ++i) { h ^= b[i]; h *= FNV_PRIME; }
+        return h;
+    }
+
+    // Top-level User/ directories a worker only reads. Besides the asset dirs this covers the two big
+    // ones: the Wii NAND (a GameCube title never touches it) and GameSettings (written only by the Qt
+    // game properties dialog). Anything not listed (Config, GC, Maps, caches, ...) may be rewritten in
+    // place and is copied per worker.
+    static const char* const kSharedDirs[] = {
+        "GameSettings", "Load", "ResourcePacks", "Shaders", "Styles", "Themes", "Wii",
+    };
+
+    static bool iequals(const std::string& a, const char* b)
+    {
+        size_t i = 0;
+        for (; i < a.size() && b[i]; ++i)
+            if (std::tolower((unsigned char)a[i]) != std::tolower((unsigned char)b[i])) return false;
+        return i == a.size() && !b[i];
+    }
+
+    bool IsSharedUserPath(const fs::path& rel)
+    {
+        // loose files directly in User/ (e.g. portable markers) are tiny; keep them private
+        if (std::distance(rel.begin(), rel.end()) < 2) return false;
+        const std::string top = rel.begin()->string();
+        for (const char* d : kSharedDirs) {
+            if (iequals(top, d)) return true;
+        }
+        return false;
+    }
+
+    struct ManifestEntry {
+        std::string rel;   // generic (forward slash) form
+        uint64_t size{ 0 };
+        int64_t mtime{ 0 };
+    };
+
+    static bool scan_manifest(const fs::path& root, std::vector<ManifestEntry>& out, std::string* error_out)
+    {
+        out.clear();
+        std::error_code ec;
+        for (auto it = fs::recursive_directory_iterator(root, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+            if (!it->is_regular_file(ec)) continue;
+            ManifestEntry e{};
+            e.rel = fs::relative(it->path(), root, ec).generic_string();
+            e.size = it->file_size(ec);
+            e.mtime = (int64_t)it->last_write_time(ec).time_since_epoch().count();
+            if (ec) break;
+            out.push_back(std::move(e));
+        }
+        if (ec) {
+            if (error_out) *error_out = "Scan of " + root.string() + " failed: " + ec.message();
+            return false;
+        }
+        std::sort(out.begin(), out.end(), [](const ManifestEntry& a, const ManifestEntry& b) { return a.rel < b.rel; });
+        return true;
+    }
+
+    static uint64_t manifest_key(const std::vector<ManifestEntry>& m)
+    {
+        uint64_t h = FNV_OFFSET;
+        for (const auto& e : m) {
+            h = fnv1a(h, e.rel.data(), e.rel.size());
+            h = fnv1a(h, "\0", 1);
+            h = fnv1a(h, &e.size, sizeof(e.size));
+            h = fnv1a(h, &e.mtime, sizeof(e.mtime));
+        }
+        return h;
+    }
+
+    static bool read_text(const fs::path& p, std::string& out)
+    {
+        std::ifstream f(p, std::ios::binary);
+        if (!f) return false;
+        std::getline(f, out);
+        return true;
+    }
+
+    static bool write_text(const fs::path& p, const std::string& s)
+    {
+        std::ofstream f(p, std::ios::binary | std::ios::trunc);
+        f << s << "\n";
+        return bool(f);
+    }
+
+    bool PrepareUserBaseSnapshot(const fs::path& base_user, const fs::path& store_root,
+        fs::path& snapshot_out, std::string* error_out)
+    {
+        std::vector<ManifestEntry> manifest;
+        if (!scan_manifest(base_user, manifest, error_out)) return false;
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx", (unsigned long long)manifest_key(manifest));
+        const fs::path snap = store_root / name;
+        snapshot_out = snap;
+
+        std::error_code ec;
+        if (fs::exists(snap / kCompleteMarker, ec)) return true;
+
+        fs::create_directories(store_root, ec);
+        const fs::path tmp = store_root / (std::string(name) + ".tmp-"
+            + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+        fs::remove_all(tmp, ec);
+        ec.clear();
+
+        for (const auto& e : manifest) {
+            const fs::path to = tmp / fs::path(e.rel);
+            fs::create_directories(to.parent_path(), ec);
+            ec.clear();
+            fs::copy_file(base_user / fs::path(e.rel), to, fs::copy_options::overwrite_existing, ec);
+            if (ec) {
+                if (error_out) *error_out = "Snapshot copy of " + e.rel + " failed: " + ec.message();
+                fs::remove_all(tmp, ec);
+                return false;
+            }
+        }
+        if (!write_text(tmp / kCompleteMarker, std::to_string(manifest.size()) + " files")) {
+            if (error_out) *error_out = "Could not finish snapshot in " + tmp.string();
+            fs::remove_all(tmp, ec);
+            return false;
+        }
+
+        fs::rename(tmp, snap, ec);
+        if (ec) {
+            // Another process published the same snapshot first
+            std::error_code ec2;
+            fs::remove_all(tmp, ec2);
+            if (!fs::exists(snap / kCompleteMarker, ec2)) {
+                if (error_out) *error_out = "Could not publish snapshot " + snap.string() + ": " + ec.message();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool LinkUserDirFromSnapshot(const fs::path& snapshot, const fs::path& dst,
+        bool force, UserLinkStats* stats, std::string* error_out)
+    {
+        UserLinkStats st{};
+        std::error_code ec;
+        if (!fs::exists(snapshot / kCompleteMarker, ec)) {
+            if (error_out) *error_out = "Not a complete user base snapshot: " + snapshot.string();
+            return false;
+        }
+
+        const std::string id = snapshot.filename().string() + kLinkPolicy;
+        std::string stamp;
+        if (!force && read_text(dst / kStampFile, stamp) && stamp == id) {
+            st.reused = true;
+            if (stats) *stats = st;
+            return true;
+        }
+
+        fs::create_directories(dst, ec);
+        ec.clear();
+        for (auto it = fs::recursive_directory_iterator(snapshot, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+            if (!it->is_regular_file(ec)) continue;
+            const fs::path rel = fs::relative(it->path(), snapshot, ec);
+            if (rel == kCompleteMarker) continue;
+            const fs::path to = dst / rel;
+            const uint64_t size = it->file_size(ec);
+            fs::create_directories(to.parent_path(), ec);
+            ec.clear();
+
+            if (IsSharedUserPath(rel)) {
+                // Already our link? Nothing to do.
+                if (fs::exists(to, ec) && fs::equivalent(it->path(), to, ec)) {
+                    ++st.files_linked; st.bytes_linked += size;
+                    continue;
+                }
+                ec.clear();
+                fs::remove(to, ec);
+                ec.clear();
+                fs::create_hard_link(it->path(), to, ec);
+                if (!ec) {
+                    ++st.files_linked; st.bytes_linked += size;
+                    continue;
+                }
+                ++st.link_fallbacks;
+                ec.clear();
+            }
+            else if (fs::exists(to, ec) && fs::equivalent(it->path(), to, ec)) {
+                // A private file must never alias the snapshot: drop the link before copying over it
+                fs::remove(to, ec);
+            }
+            ec.clear();
+
+            fs::copy_file(it->path(), to, fs::copy_options::overwrite_existing, ec);
+            if (ec) {
+                if (error_out) *error_out = "Copy of " + rel.generic_string() + " into " + dst.string() + " failed: " + ec.message();
+                return false;
+            }
+            ++st.files_copied; st.bytes_copied += size;
+        }
+        if (ec) {
+            if (error_out) *error_out = "Walk of " + snapshot.string() + " failed: " + ec.message();
+            return false;
+        }
+
+        if (!write_text(dst / kStampFile, id)) {
+            if (error_out) *error_out = "Could not write " + (dst / kStampFile).string();
+            return false;
+        }
+        if (stats) *stats = st;
+        return true;
+    }
+
+} // namespace simcore
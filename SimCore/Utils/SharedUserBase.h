@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Per-worker Dolphin User directories backed by one shared, immutable copy of the Qt base's User.
+//
+// PrepareUserBaseSnapshot copies <qt_base>/User once into <store>/<key>, where key hashes the base's
+// manifest (relative path, size, mtime of every file), so an edited base gets a fresh snapshot and
+// an unchanged one is reused across runs and processes. LinkUserDirFromSnapshot then fills a worker's
+// User dir from the snapshot: the directories a worker only reads (custom textures, resource packs,
+// shaders, styles, themes, GameSettings and the Wii NAND) are hardlinked, everything else is copied,
+// so a file Dolphin writes in place never changes under another worker. Volumes without hardlinks
+// fall back to copies. A stamp makes later boots of an up-to-date User dir skip the walk.
+
+namespace simcore {
+
+    struct UserLinkStats {
+        uint64_t files_linked{ 0 };
+        uint64_t files_copied{ 0 };   // files outside the shared dirs, plus link fallbacks
+        uint64_t bytes_linked{ 0 };
+        uint64_t bytes_copied{ 0 };
+        uint64_t link_fallbacks{ 0 }; // hardlink refused (other volume, FAT, ...) and copied instead
+        bool reused{ false };         // dst was already built from this snapshot; nothing touched
+    };
+
+    // True for paths (relative to User/) that workers may share through hardlinks.
+    bool IsSharedUserPath(const std::filesystem::path& rel);
+
+    // Builds (or finds) the snapshot of base_user under store_root. Safe against concurrent callers:
+    // the copy is made in a temporary directory and renamed into place.
+    bool PrepareUserBaseSnapshot(const std::filesystem::path& base_user, const std::filesystem::path& store_root,
+        std::filesystem::path& snapshot_out, std::string* error_out = nullptr);
+
+    // Materializes dst from a snapshot. A stamp in dst records the snapshot it was built from; with
+    // force == false a matching stamp makes this a no-op. Files in dst that the snapshot lacks are kept.
+    bool LinkUserDirFromSnapshot(const std::filesystem::path& snapshot, const std::filesystem::path& dst,
+        bool force, UserLinkStats* stats = nullptr, std::string* error_out = nullptr);
+
+} // namespace simcore
@@ -6,6 +6,14 @@ import sys, re, pathlib
 # - Assumes no templates, no unions, no bitfields, no base classes
 # - Handles C arrays, nested types, and simple comments
 # - Includes ALL declared fields (padding fields are fine: they are byte arrays -> no-op at swap time)
+#
+# Each reflect<> also carries `names`, the declared field names in member order (used to label
+# memory diffs, see Core/Memory/MemDiff.h).
+#
+# Next to the reflection header it writes <name>.swapmask.h: per struct, the byte-swap work of
+# fix_endianness_in_place flattened into 16-byte shuffle blocks (see Core/Memory/SwapPlan.h).
+# Layout is computed assuming #pragma pack(1), as in SoaStructs.h, and checked against its
+# static_assert(sizeof(...)) lines.
 
 STRUCT_RE = re.compile(r'\bstruct\s+([A-Za-z_][A-Za-z0-9_]*)\s*\{(.*?)\};', re.S)
 FIELD_LINE_RE = re.compile(r'^\s*([^;{}/]+?)\s+([A-Za-z_][A-Za-z0-9_]*)(\s*\[[^\]]+\])*\s*;\s*(?://.*|/\*.*\*/\s*)?$', re.S)
@@ -56,13 +64,84 @@ def parse_structs(ns_body: str):
                 continue
             ftype = m.group(1).strip()
             fname = m.group(2).strip()
-            farr  = m.group(3) or ''
-            # Keep array suffixes with the declaration via pointer-to-member on the array type.
-            # Member pointer to array is valid and our swapper handles arrays element-wise.
-            full = f'&type::{fname}'
-            fields.append(full)
+            dims = [int(d, 0) for d in re.findall(r'\[\s*([^\]]+?)\s*\]', line)]
+            fields.append((ftype, fname, dims))
         yield (name, fields)
 
+SCALAR_SIZES = {
+    'char': 1, 'int8_t': 1, 'uint8_t': 1, 'bool': 1,
+    'int16_t': 2, 'uint16_t': 2,
+    'int32_t': 4, 'uint32_t': 4, 'float': 4,
+    'int64_t': 8, 'uint64_t': 8, 'double': 8,
+}
+
+def flatten(ftype, layouts):
+    """(size, [(offset, width)] of multi-byte scalars) for one field type, packed."""
+    t = ftype.replace('std::', '').replace('const ', '').strip()
+    if t in SCALAR_SIZES:
+        w = SCALAR_SIZES[t]
+        return w, ([(0, w)] if w > 1 else [])
+    if t in layouts:
+        return layouts[t]
+    raise ValueError(f"unknown field type '{ftype}'")
+
+def compute_layouts(structs):
+    layouts = {}
+    for name, fields in structs:
+        off, swaps = 0, []
+        for ftype, _, dims in fields:
+            size, inner = flatten(ftype, layouts)
+            count = 1
+            for d in dims:
+                count *= d
+            for k in range(count):
+                swaps.extend((off + k * size + o, w) for o, w in inner)
+            off += size * count
+        layouts[name] = (off, swaps)
+    return layouts
+
+def swap_blocks(swaps):
+    """Greedy 16-byte windows that never split a scalar; shuffle indexes are window-relative."""
+    blocks, i = [], 0
+    while i < len(swaps):
+        start, end, j = swaps[i][0], swaps[i][0], i
+        shuf = list(range(16))
+        while j < len(swaps) and swaps[j][0] + swaps[j][1] <= start + 16:
+            o, w = swaps[j]
+            for k in range(w):
+                shuf[o - start + k] = o - start + w - 1 - k
+            end = o + w
+            j += 1
+        blocks.append((start, end - start, shuf))
+        i = j
+    return blocks
+
+def emit_swapmask(structs, layouts, asserted):
+    out = []
+    out.append("// AUTO-GENERATED. DO NOT EDIT.\n#pragma once\n")
+    out.append("#include <array>\n")
+    out.append("#include \"SoaStructs.h\"\n")
+    out.append("#include \"../SwapPlan.h\"\n\n")
+    out.append("namespace simcore::endian {\n\n")
+    for name, _ in structs:
+        size, swaps = layouts[name]
+        if name in asserted and asserted[name] != size:
+            raise ValueError(f"{name}: computed size {size}, static_assert says {asserted[name]}")
+        blocks = swap_blocks(swaps)
+        out.append(f"template <> struct swap_plan<soa::{name}> {{\n")
+        out.append(f"  static constexpr size_t size = {size};\n")
+        out.append(f"  static constexpr std::array<SwapBlock, {len(blocks)}> blocks{{{{")
+        if blocks:
+            rows = []
+            for off, ln, shuf in blocks:
+                rows.append(f"    {{ {off}, {ln}, {{ {', '.join(str(x) for x in shuf)} }} }}")
+            out.append("\n" + ",\n".join(rows) + "\n  ")
+        out.append("}};\n")
+        out.append("};\n")
+        out.append(f"static_assert(sizeof(soa::{name}) == swap_plan<soa::{name}>::size, \"regenerate SoaStructs.swapmask.h\");\n\n")
+    out.append("} // namespace simcore::endian\n")
+    return "".join(out)
+
 def main():
     if len(sys.argv) != 3:
         print("usage: gen_reflect.py <input SoaStructs.h> <output SoaStructs.reflect.h>", file=sys.stderr)
@@ -77,9 +156,13 @@ def main():
         sys.exit(2)
 
     structs = list(parse_structs(ns_body))
+    asserted = {m.group(1): int(m.group(2), 0)
+                for m in re.finditer(r'static_assert\s*\(\s*sizeof\s*\(\s*(\w+)\s*\)\s*==\s*(\w+)', no_comments)}
+    layouts = compute_layouts(structs)
 
     out_lines = []
     out_lines.append("// AUTO-GENERATED. DO NOT EDIT.\n#pragma once\n")
+    out_lines.append("#include <array>\n")
     out_lines.append("#include <tuple>\n")
     out_lines.append("#include \"SoaStructs.h\"\n\n")
     out_lines.append("namespace soa_reflect {\n")
@@ -92,15 +175,22 @@ def main():
         out_lines.append(f"template <> struct reflect<soa::{name}> {{\n")
         out_lines.append(f"  using type = soa::{name};\n")
         if fields:
-            fields_joined = ",\n    ".join(fields)
+            fields_joined = ",\n    ".join(f'&type::{fname}' for _, fname, _ in fields)
             out_lines.append("  static constexpr auto members = std::make_tuple(\n    ")
             out_lines.append(fields_joined)
             out_lines.append("\n  );\n")
+            names_joined = ", ".join(f'"{fname}"' for _, fname, _ in fields)
+            out_lines.append(f"  static constexpr std::array<const char*, {len(fields)}> names{{{{ {names_joined} }}}};\n")
         else:
             out_lines.append("  static constexpr auto members = std::make_tuple();\n")
+            out_lines.append("  static constexpr std::array<const char*, 0> names{};\n")
         out_lines.append("};\n\n")
 
     outp.write_text("".join(out_lines), encoding='utf-8')
 
+    maskp = outp.with_name(outp.name.replace('.reflect.h', '') + '.swapmask.h') if outp.name.endswith('.reflect.h') \
+        else outp.with_suffix('.swapmask.h')
+    maskp.write_text(emit_swapmask(structs, layouts, asserted), encoding='utf-8')
+
 if __name__ == '__main__':
     main()
@@ -5,13 +5,16 @@
 #include <iomanip>
 #include <limits>
 #include <unordered_set>
+#include <optional>
 
 #include "Core/Memory/Soa/SoaConstants.h"
 #include "Core/Memory/Soa/SoaAddrCatalog.h"
 #include "Core/Memory/Soa/SoaAddrRegistry.h"
 #include "Phases/Programs/BattleRunner/BattleOutcome.h"
 #include "Phases/BattleExplorer.h"
+#include "Phases/ResultColumns.h"
 #include "Phases/Programs/BattleRunner/BattleRunnerPayload.h"
+#include "Phases/Programs/BattleRunner/BattleRunnerCost.h"
 #include "Core/Input/InputPlanFmt.h"
 #include "Core/Input/SoaBattle/PlanWriter.h"
 
@@ -598,10 +601,35 @@ namespace sandbox {
         // Expect app to already hold a savestate path and a started runner.
         // Also expect a cached last_battle_ctx from Gather Context step or fetch it now.
         soa::battle::ctx::BattleContext bc = ex.gather_context(runner);
+        runner.set_cost_estimator(std::make_shared<phase::battle::runner::BattlePathCostEstimator>(bc));  // longest paths first
 
         render_battle_context(bc);
     }
 
+    // Above this many paths a run keeps its failures only in explore.sccr, not in the summary.
+    static constexpr size_t kRetainAllPaths = 50000;
+
+    static void print_result_file_summary(const std::string& path, const UI_Config& ui) {
+        using namespace simcore::battleexplorer;
+        ColumnarResultReader rd;
+        std::string err;
+        if (!rd.open(path, &err)) { SCLOGW("%s", err.c_str()); return; }
+
+        const auto by_outcome = rd.aggregate(ResultFilter{}, ResultGroupBy::Outcome);
+        std::cout << "Results: " << rd.rows() << " rows in " << rd.groups() << " row groups (" << path << ")\n";
+        for (const auto& [oc, n] : by_outcome.counts)
+            std::cout << "  " << std::setw(24) << std::left << simcore::battle::get_outcome_string((simcore::battle::Outcome)oc)
+                      << std::right << n << "\n";
+
+        ResultFilter pf{};
+        pf.outcome_mask = OutcomeBit((uint16_t)simcore::battle::Outcome::PredFailure);
+        const auto by_pred = rd.aggregate(pf, ResultGroupBy::PredFailed);
+        for (const auto& [id, n] : by_pred.counts) {
+            const std::string desc = id < ui.predicates.size() ? ui.predicates[(size_t)id].desc : "id=" + std::to_string(id);
+            std::cout << "    failed " << desc << ": " << n << "\n";
+        }
+    }
+
     void run_battle_explorer_menu(AppState& app) {
 
         std::string savestate_path = app.default_savestate;
@@ -625,10 +653,13 @@ namespace sandbox {
         }
 
         BattleExplorer ex = BattleExplorer(savestate_path);
+        ex.set_turn_state_dir((app.exe_dir / ".work" / "turnstates").string());
+        ex.set_journal_path((app.exe_dir / ".work" / "explore.scbj").string());  // resume an interrupted batch
         UI_Config ui;
         ui.initial_frames.emplace_back(GCInputFrame{});
 
         simcore::ParallelPhaseScriptRunner runner{ app.workers };
+        runner.attach_result_store(open_result_store(app));
 
         // Boot plan: use your Boot module; keep ISO and portable base fixed for the lifetime of the pool.
         simcore::BootPlan boot = make_boot_plan(app);
@@ -646,6 +677,9 @@ namespace sandbox {
         runner.increment_epoch();
         runner.reset_job_ids();
 
+        // Previous run of this session; later runs only re-simulate what the edits invalidated.
+        std::optional<simcore::battleexplorer::RunResultSummary> last_summary;
+
         for (;;) {
             render_overview(bc, ui, ex);
             std::cout << "\n[1] Add turn  [2] Modify turn  [3] Add predicate  [6] Remove predicate  [4] Set options  [5] Load First Battle Defaults [7] Add unique Input Frame Starts [R] Run  [B] Back\n> ";
@@ -680,6 +714,20 @@ namespace sandbox {
             else if (c == "4") {
                 ui.fakeattack_budget = std::max(0, prompt_int("FakeAttack Budget", ui.fakeattack_budget));
                 ui.max_retry_count = std::max(-1, prompt_int("Max Job Retries (-1=inf)", ui.max_retry_count));
+                auto sp = runner.speculation();
+                sp.enabled = prompt_int("Speculative duplicates for stragglers (0/1)", sp.enabled ? 1 : 0) != 0;
+                if (sp.enabled) {
+                    sp.min_elapsed_ms = (uint32_t)std::max(0, prompt_int("  Min job age before duplicating (ms)", (int)sp.min_elapsed_ms));
+                    sp.measure_baseline = prompt_int("  Let originals finish to time the tail without speculation (0/1)", sp.measure_baseline ? 1 : 0) != 0;
+                }
+                runner.set_speculation(sp);
+                auto tp = runner.timeout_model().policy();
+                tp.enabled = prompt_int("Learned per-segment timeouts (0/1)", tp.enabled ? 1 : 0) != 0;
+                if (tp.enabled) {
+                    tp.min_samples = (uint32_t)std::max(1, prompt_int("  Samples per breakpoint before learning", (int)tp.min_samples));
+                    tp.margin = std::max(1, prompt_int("  Margin over p99.9 (percent)", (int)(tp.margin * 100))) / 100.0;
+                }
+                runner.timeout_model().set_policy(tp);
             }
             else if (c == "5") {
                 get_first_battle_defaults(ui);
@@ -699,8 +747,52 @@ namespace sandbox {
             }
             else if (c == "R" || c == "r") {
                 auto paths = ex.enumerate_paths(bc, ui);
-                auto summary = ex.run_paths(ui, paths, runner);
+                runner.reset_tail_stats();
+                runner.timeout_model().reset_report();
+
+                // Every result goes to a columnar file; large runs keep only successes in memory.
+                const std::string results_path = (app.exe_dir / ".work" / "explore.sccr").string();
+                auto sink = std::make_shared<simcore::battleexplorer::ColumnarResultWriter>();
+                {
+                    std::error_code ec;
+                    std::filesystem::create_directories(app.exe_dir / ".work", ec);
+                    std::string err;
+                    const bool large = paths.size() * ui.initial_frames.size() > kRetainAllPaths;
+                    if (sink->open(results_path, simcore::battleexplorer::ColumnarResultWriter::DEFAULT_ROWS_PER_GROUP, &err))
+                        ex.set_result_sink(sink, large ? simcore::battleexplorer::ResultRetention::SuccessesOnly
+                                                       : simcore::battleexplorer::ResultRetention::All);
+                    else { SCLOGW("%s", err.c_str()); sink.reset(); }
+                }
+
+                auto summary = last_summary ? ex.run_paths_incremental(ui, paths, *last_summary, runner)
+                                            : ex.run_paths(ui, paths, runner);
+                if (sink) {
+                    sink->close();
+                    ex.set_result_sink(nullptr);
+                    print_result_file_summary(results_path, ui);
+                }
                 std::cout << "Submitted " << summary.jobs_total << " jobs; successes: " << summary.jobs_success << "\n";
+                if (last_summary)
+                    std::cout << "Incremental: " << summary.jobs_reused << " reused, " << summary.jobs_resumed << " resumed from turn states\n";
+                {
+                    const auto ts = runner.tail_stats();
+                    std::cout << "Job latency: p50=" << ts.p50_ms << "ms p99=" << ts.p99_ms << "ms max=" << ts.max_ms << "ms; tail=" << ts.tail_ms << "ms";
+                    if (runner.speculation().enabled)
+                        std::cout << " (without speculation " << (ts.no_spec_exact ? "" : ">=") << ts.tail_ms_no_spec << "ms; "
+                                  << ts.speculated << " copies, " << ts.spec_wins << " won, " << ts.cancelled << " cancelled)";
+                    std::cout << "\n";
+                }
+                if (runner.timeout_model().policy().enabled) {
+                    const auto tr = runner.timeout_model().report();
+                    std::cout << "Learned timeouts: " << tr.learned_keys << " breakpoints, " << tr.cut_short << "/" << tr.segments
+                              << " segments cut short; retries confirmed " << tr.confirmed << " cut(s), refuted " << tr.refuted
+                              << ", net " << (tr.reclaimed_ms / 1000) << "s of worker time reclaimed\n";
+                }
+                if (const auto st = runner.status(); st.worker_restarts > 0)
+                    std::cout << "Worker crashes: " << st.worker_restarts << " respawned, " << st.jobs_requeued << " jobs re-queued ("
+                              << st.running_workers << "/" << st.workers << " workers up)\n";
+                if (auto* store = runner.result_store())
+                    std::cout << "Result cache: " << store->hits() << " hits, " << store->misses() << " misses (" << store->size() << " stored)\n";
                 if (summary.successes.size() > 0) std::cout << "\nSuccesses found!";
                 for (auto r : summary.successes) {
                     std::cout << "\n  [jid=" << r.job_id << "] " << simcore::battle::get_outcome_string(r.outcome) << ": initframe=(" << simcore::DescribeFrame(r.spec.initial) << ") " << soa::battle::actions::get_battle_path_summary(r.spec.path);
@@ -725,6 +817,7 @@ namespace sandbox {
                     }
                     std::cout << "\n  [" << r.job_id << "] " << outcome_s << ":\n  initframe=(" << simcore::DescribeFrame(r.spec.initial) << ") " << soa::battle::actions::get_battle_path_summary(r.spec.path);
                 }
+                last_summary = summary;
                 std::cout << "\n\n Press Enter to Continue...";
                 std::string c; std::getline(std::cin, c);
             }
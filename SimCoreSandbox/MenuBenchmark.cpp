@@ -0,0 +1,96 @@
+#define NOMINMAX
+#include "MenuBenchmark.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+#include "Phases/ThroughputBench.h"
+#include "Utils/CpuAffinity.h"
+
+namespace sandbox {
+
+    static std::string join_counts(const std::vector<size_t>& v) {
+        std::string s;
+        for (size_t i = 0; i < v.size(); ++i) s += (i ? "," : "") + std::to_string(v[i]);
+        return s;
+    }
+
+    static std::vector<size_t> parse_counts(const std::string& s) {
+        std::vector<size_t> out;
+        std::stringstream ss(s);
+        for (std::string item; std::getline(ss, item, ',');) {
+            try { const size_t n = std::stoul(trim(item)); if (n >= 1 && n <= 128) out.push_back(n); }
+            catch (...) {}
+        }
+        return out;
+    }
+
+    static void print_row(const simcore::ViBenchRow& r) {
+        if (!r.boot_ok) { std::printf("%7zu  %-6s  boot failed\n", r.workers, r.pinned ? "pinned" : "free"); return; }
+        std::printf("%7zu  %-6s  %9u  %8u  %8llu  %10.0f  %10.0f  %7u  %7u\n", r.workers, r.pinned ? "pinned" : "free", r.dedicated,
+            r.boot_ms, (unsigned long long)r.jobs_ok, r.vi_per_s, r.vi_per_s_per_worker, r.p50_ms, r.p99_ms);
+        std::fflush(stdout);
+    }
+
+    void run_vi_benchmark_menu(AppState& app) {
+        simcore::ViBenchArgs a{};
+        bool shared_user_base = true;
+        a.savestate_path = app.default_savestate;
+        a.affinity.parent_cores = app.parent_cores;
+
+        const auto topo = simcore::cpu::QueryTopology();
+        a.worker_counts.clear();
+        for (size_t n = 1; n <= std::max<size_t>(app.workers, 1); n *= 2) a.worker_counts.push_back(n);
+        if (a.worker_counts.back() != app.workers) a.worker_counts.push_back(app.workers);
+
+        for (;;) {
+            std::cout << "\n--- Worker throughput (VI/s) ---\n";
+            std::cout << "CPU:              " << topo.cores.size() << " cores / " << topo.logical << " logical" << (topo.smt() ? " (SMT)" : "") << "\n";
+            std::cout << "Savestate:        " << (a.savestate_path.empty() ? "<unset>" : a.savestate_path) << "\n";
+            std::cout << "Worker counts:    " << join_counts(a.worker_counts) << "\n";
+            std::cout << "Jobs per worker:  " << a.jobs_per_worker << "\n";
+            std::cout << "Parent cores:     " << a.affinity.parent_cores << "\n";
+            std::cout << "Compare unpinned: " << (a.compare_unpinned ? "yes" : "no") << "\n";
+            std::cout << "User dirs:        " << (shared_user_base ? "linked from shared base" : "full copy per worker") << "\n";
+            std::cout << "\n"
+                << "1) Set savestate path\n"
+                << "2) Set worker counts\n"
+                << "3) Set jobs per worker\n"
+                << "4) Set parent cores\n"
+                << "5) Toggle unpinned comparison\n"
+                << "6) Toggle shared User base (startup time)\n"
+                << "r) Run\n"
+                << "b) Back\n> ";
+            std::string c; if (!std::getline(std::cin, c)) return;
+
+            if (c == "1") a.savestate_path = prompt_path("Savestate path: ", true, true, a.savestate_path).string();
+            else if (c == "2") {
+                std::cout << "Worker counts (e.g. 1,2,4,8,16): "; std::string s; std::getline(std::cin, s);
+                if (auto v = parse_counts(s); !v.empty()) a.worker_counts = v;
+            }
+            else if (c == "3") { std::cout << "Jobs per worker: "; std::string s; std::getline(std::cin, s); if (!s.empty()) a.jobs_per_worker = (uint32_t)std::clamp(std::stoi(s), 1, 10000); }
+            else if (c == "4") { std::cout << "Parent cores: "; std::string s; std::getline(std::cin, s); if (!s.empty()) a.affinity.parent_cores = (uint32_t)std::clamp(std::stoi(s), 0, 64); }
+            else if (c == "5") a.compare_unpinned = !a.compare_unpinned;
+            else if (c == "6") shared_user_base = !shared_user_base;
+            else if (c == "b" || c == "B") return;
+            else if (c == "r" || c == "R") {
+                if (app.iso_path.empty() || app.qt_base_dir.empty() || a.savestate_path.empty()) {
+                    std::cout << "Please set ISO, Dolphin base, and savestate first.\n";
+                    continue;
+                }
+                if (!ensure_sys_from_base_or_warn(app.qt_base_dir)) continue;
+
+                a.boot = make_boot_plan(app);
+                a.boot.shared_user_base = shared_user_base;
+                std::printf("\n%7s  %-6s  %9s  %8s  %8s  %10s  %10s  %7s  %7s\n",
+                    "workers", "cpus", "dedicated", "boot ms", "jobs", "VI/s", "VI/s/wkr", "p50 ms", "p99 ms");
+                simcore::RunViThroughputBench(a, print_row);
+                std::cout << "\n Press Enter to Continue...";
+                std::string e; std::getline(std::cin, e);
+            }
+        }
+    }
+
+} // namespace sandbox
@@ -0,0 +1,6 @@
+#pragma once
+#include "SandboxAppState.h"
+
+namespace sandbox {
+	void run_vi_benchmark_menu(AppState& app);
+} // namespace sandbox
@@ -12,13 +12,24 @@ void menu_configure_paths(AppState& g) {
             << "Dolphin base: " << (g.qt_base_dir.empty() ? "<unset>" : g.qt_base_dir) << "\n"
             << "Default savestate: " << (g.default_savestate.empty() ? "<unset>" : g.default_savestate) << "\n"
             << "Workers: " << g.workers << "\n"
-            << "1) Set ISO path\n2) Set Dolphin base\n3) Set default savestate\n4) Set worker count\ns) Save & back\n> ";
+            << "Remote agents: " << (g.agents.empty() ? "<none>" : g.agents) << "\n"
+            << "CPU affinity: " << (g.cpu_affinity ? "on (" + std::to_string(g.parent_cores) + " parent cores)" : std::string("off")) << "\n"
+            << "1) Set ISO path\n2) Set Dolphin base\n3) Set default savestate\n4) Set worker count\n5) Set remote agents\n6) Set CPU affinity\ns) Save & back\n> ";
 
         std::string c; if (!std::getline(std::cin, c)) return;
         if (c == "1") g.iso_path = prompt_path("ISO path: ", true, true, g.iso_path).string();
         else if (c == "2") g.qt_base_dir = prompt_path("Dolphin (portable) base dir: ", true, true, g.qt_base_dir).string();
         else if (c == "3") g.default_savestate = prompt_path("Default savestate (blank=clear): ", true, true, g.default_savestate).string();
         else if (c == "4") { std::cout << "Workers (1..128): "; std::string s; std::getline(std::cin, s); if (!s.empty()) g.workers = std::clamp<size_t>(std::stoul(s), 1u, 128u); }
+        else if (c == "5") { std::cout << "Agents (host:port,host:port; blank=none): "; std::getline(std::cin, g.agents); }
+        else if (c == "6") {
+            std::cout << "Pin workers to dedicated cores (0/1): "; std::string s; std::getline(std::cin, s);
+            if (!s.empty()) g.cpu_affinity = s != "0";
+            if (g.cpu_affinity) {
+                std::cout << "Cores kept for the sandbox (0..64) [" << g.parent_cores << "]: "; std::getline(std::cin, s);
+                if (!s.empty()) g.parent_cores = (uint32_t)std::clamp<unsigned long>(std::stoul(s), 0ul, 64ul);
+            }
+        }
         else if (c == "s" || c == "S") { save_appstate_ini(g, g.exe_dir / "sandbox.ini"); return; }
     }
 }
@@ -0,0 +1,106 @@
+#define NOMINMAX
+#include "MenuMemDiff.h"
+#include "utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "Core/Memory/MemDiff.h"
+
+namespace sandbox {
+
+    // A raw RAM image as written by Dolphin's "Dump MEM1/MEM2" or DolphinWrapper::getMem1.
+    // The size says which region it is.
+    static bool load_ram_image(const fs::path& p, std::vector<uint8_t>& out, uint32_t& base_va) {
+        std::ifstream f(p, std::ios::binary | std::ios::ate);
+        if (!f) { std::cout << "Cannot open " << p.string() << "\n"; return false; }
+        const auto size = static_cast<size_t>(f.tellg());
+        if (size == simcore::MemView::kMem1Size) base_va = simcore::MemView::kMem1Base;
+        else if (size == simcore::kMem2Size) base_va = simcore::kMem2Base;
+        else { std::cout << p.string() << ": " << size << " bytes is neither a MEM1 nor a MEM2 image\n"; return false; }
+        out.resize(size);
+        f.seekg(0);
+        return bool(f.read(reinterpret_cast<char*>(out.data()), std::streamsize(size)));
+    }
+
+    // Diffs `a` against each image in `bs`, printing the first `show` ranges of each and writing all
+    // of them to `report`.
+    static void run_diffs(const fs::path& a_path, const std::vector<fs::path>& bs, size_t show, const fs::path& report) {
+        std::vector<uint8_t> a, b;
+        uint32_t a_base = 0, b_base = 0;
+        if (!load_ram_image(a_path, a, a_base)) return;
+
+        simcore::MemDiffAnnotator ann;
+        const bool mem1 = a_base == simcore::MemView::kMem1Base;
+        if (mem1) ann.add_battle_structs(simcore::MemView(a.data(), a.size()));
+
+        std::ofstream out(report);
+        for (const fs::path& bp : bs) {
+            if (!load_ram_image(bp, b, b_base)) continue;
+            if (b_base != a_base) { std::cout << bp.string() << ": not the same region as A\n"; continue; }
+
+            const auto t0 = std::chrono::steady_clock::now();
+            const auto ranges = simcore::DiffMemory(a.data(), b.data(), a.size(), a_base);
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+            // Objects can move between the two; label what B points at as well
+            simcore::MemDiffAnnotator ann_b = ann;
+            if (mem1) ann_b.add_battle_structs(simcore::MemView(b.data(), b.size()));
+            const auto notes = ann_b.annotate(ranges);
+
+            size_t bytes = 0;
+            for (const auto& r : ranges) bytes += r.len;
+            std::printf("\n%s: %zu ranges, %zu bytes (%.2f ms)\n", bp.filename().string().c_str(), ranges.size(), bytes, ms);
+            out << "== " << a_path.string() << " vs " << bp.string() << ": " << ranges.size() << " ranges, " << bytes << " bytes\n";
+            for (size_t i = 0; i < notes.size(); ++i) {
+                const std::string line = simcore::MemDiffAnnotator::format(notes[i]);
+                if (i < show) std::printf("  %s\n", line.c_str());
+                out << line << "\n";
+            }
+            if (notes.size() > show) std::printf("  ... %zu more in %s\n", notes.size() - show, report.string().c_str());
+        }
+    }
+
+    void run_mem_diff_menu(AppState& app) {
+        fs::path a_path, b_path;
+        size_t show = 40;
+
+        for (;;) {
+            std::cout << "\n--- RAM snapshot diff ---\n";
+            std::cout << "A (reference):    " << (a_path.empty() ? "<unset>" : a_path.string()) << "\n";
+            std::cout << "B (file or dir):  " << (b_path.empty() ? "<unset>" : b_path.string()) << "\n";
+            std::cout << "Ranges shown:     " << show << "\n";
+            std::cout << "\n"
+                << "1) Set A image (24 MiB MEM1 or 64 MiB MEM2 dump)\n"
+                << "2) Set B image, or a directory of images to diff against A\n"
+                << "3) Set ranges shown per diff\n"
+                << "r) Run\n"
+                << "b) Back\n> ";
+            std::string c; if (!std::getline(std::cin, c)) return;
+
+            if (c == "1") a_path = prompt_path("A image: ", true, true, a_path.string());
+            else if (c == "2") b_path = prompt_path("B image or directory: ", true, true, b_path.string());
+            else if (c == "3") { std::cout << "Ranges shown: "; std::string s; std::getline(std::cin, s); if (!s.empty()) show = std::stoul(s); }
+            else if (c == "b" || c == "B") return;
+            else if (c == "r" || c == "R") {
+                if (a_path.empty() || b_path.empty()) { std::cout << "Please set A and B first.\n"; continue; }
+
+                std::vector<fs::path> bs;
+                if (fs::is_directory(b_path)) {
+                    for (const auto& e : fs::directory_iterator(b_path))
+                        if (e.is_regular_file() && e.path() != a_path) bs.push_back(e.path());
+                    std::sort(bs.begin(), bs.end());
+                }
+                else bs.push_back(b_path);
+
+                run_diffs(a_path, bs, show, app.exe_dir / "memdiff.txt");
+                std::cout << "\n Press Enter to Continue...";
+                std::string e; std::getline(std::cin, e);
+            }
+        }
+    }
+
+} // namespace sandbox
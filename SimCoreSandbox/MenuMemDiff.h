@@ -0,0 +1,6 @@
+#pragma once
+#include "SandboxAppState.h"
+
+namespace sandbox {
+	void run_mem_diff_menu(AppState& app);
+} // namespace sandbox
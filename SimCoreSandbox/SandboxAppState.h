@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <filesystem>
 
@@ -8,4 +9,7 @@ struct AppState {
 	std::string qt_base_dir;      // Dolphin portable base (has Sys/User)
 	std::string default_savestate;
 	size_t workers{ 10 };
+	std::string agents;           // "host:port,host:port" SimCoreWorkerAgents to add as remote workers
+	bool cpu_affinity{ false };   // pin local workers to dedicated physical cores (BootPlan::affinity)
+	uint32_t parent_cores{ 1 };   // cores kept for the sandbox's own threads when pinning
 };
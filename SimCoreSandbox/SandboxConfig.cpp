@@ -46,6 +46,12 @@ bool load_appstate_ini(AppState& s, std::filesystem::path ini_path)
             try { s.workers = std::clamp<size_t>(std::stoul(val), 1u, 128u); }
             catch (...) {}
         }
+        else if (key == "agents")         s.agents = val;
+        else if (key == "cpu_affinity")   s.cpu_affinity = (val == "1" || val == "true");
+        else if (key == "parent_cores") {
+            try { s.parent_cores = (uint32_t)std::clamp<unsigned long>(std::stoul(val), 0ul, 64ul); }
+            catch (...) {}
+        }
     }
     return true;
 }
@@ -65,5 +71,8 @@ bool save_appstate_ini(const AppState& s, std::filesystem::path ini_path)
     put_kv(out, "default_savestate", s.default_savestate);
     out << "\n[run]\n";
     out << "workers=" << s.workers << "\n";
+    put_kv(out, "agents", s.agents);
+    out << "cpu_affinity=" << (s.cpu_affinity ? 1 : 0) << "\n";
+    out << "parent_cores=" << s.parent_cores << "\n";
     return true;
 }
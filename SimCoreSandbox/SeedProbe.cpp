@@ -12,6 +12,7 @@
 #include <Utils/Log.h>
 #include <Utils/DeltaColorizer.h>
 #include "Phases/RNGSeedDeltaMap.h"
+#include "Phases/RngValidation.h"
 #include "Core/Input/InputPlanFmt.h"
 
 namespace sandbox {
@@ -114,6 +115,41 @@ namespace sandbox {
         std::fflush(stdout);
     }
 
+    // Adaptive maps have no lattice; view the dense map at N evenly spaced positions per axis.
+    void print_family_map(const simcore::RandSeedProbeResult& r, simcore::SeedFamily fam, int N, const char* title)
+    {
+        const simcore::SeedRegionMap* m = nullptr;
+        for (const auto& fm : r.maps)
+            if (fm.family == fam) m = &fm.map;
+        if (!m || m->delta.empty() || N < 2) {
+            std::printf("[SeedProbe] Map for %s missing.\n", title);
+            return;
+        }
+
+        color_lut_begin();
+        for (size_t i = 0; i < m->delta.size(); ++i) if (m->ok[i]) color_lut_ingest(m->delta[i]);
+        color_lut_finalize();
+
+        std::vector<int> at(N);
+        for (int i = 0; i < N; ++i) at[i] = m->minv + (m->maxv - m->minv) * i / (N - 1);
+
+        std::printf("[SeedProbe] %s delta map (%u samples, %zu regions, shown at N=%d)\n", title, m->samples, m->regions.size(), N);
+        std::printf("    ");
+        for (int col = 0; col < N; ++col) std::printf("\x1b[2;37m%02X\x1b[0m ", at[col]);
+        std::printf("\n");
+        for (int row = 0; row < N; ++row) {
+            std::printf(" \x1b[2;37m%02X\x1b[0m ", at[row]);
+            for (int col = 0; col < N; ++col) {
+                int32_t d = 0;
+                if (m->at(at[col], at[row], d)) std::printf("%s%s%s ", color_for_delta(d), fmt_delta_hex(d).c_str(), color_reset());
+                else std::printf("-- ");
+            }
+            std::printf("\n");
+        }
+        std::printf("\n\n");
+        std::fflush(stdout);
+    }
+
     void log_probe_summary(const simcore::RandSeedProbeResult& r) {
         SCLOGI("[SeedProbe] Summary: base=0x%08X, entries=%zu", r.base_seed, r.entries.size());
         for (const auto& e : r.entries) {
@@ -153,6 +189,7 @@ namespace sandbox {
         a.min_value = 0x30;
         a.max_value = 0xCF;
         a.cap_trigger_top = true;
+        a.atlas_dir = (g.exe_dir / "seed_atlas").string();
 
         bool find_combos = false;
 
@@ -164,12 +201,13 @@ namespace sandbox {
             std::cout << "Workers:          " << g.workers << "\n";
             std::cout << "Savestate:        " << (a.savestate_path.empty() ? "<unset>" : a.savestate_path) << "\n";
             std::cout << "samples_per_axis: " << a.samples_per_axis << "\n";
+            std::cout << "adaptive:         " << (a.adaptive ? "true" : "false") << "\n";
             std::cout << "min_value:        0x" << std::hex << std::uppercase << a.min_value << std::dec << " (" << a.min_value << ")\n";
             std::cout << "max_value:        0x" << std::hex << std::uppercase << a.max_value << std::dec << " (" << a.max_value << ")\n";
             std::cout << "cap_trigger_top:  " << (a.cap_trigger_top ? "true" : "false") << "\n";
             std::cout << "run_timeout_ms:   " << a.run_timeout_ms << "\n";
             std::cout << "combos_attempts_per_target: " << a.combos_attempts_per_target << "\n";
-            std::cout << "combos_sampler_tries: " << a.combos_sampler_tries << "\n";
+            std::cout << "atlas_dir:        " << (a.atlas_dir.empty() ? "<disabled>" : a.atlas_dir) << "\n";
             std::cout << "\n"
                 << "1) Set savestate path\n"
                 << "2) Set samples_per_axis\n"
@@ -178,7 +216,9 @@ namespace sandbox {
                 << "5) Toggle cap_trigger_top\n"
                 << "6) Set run_timeout_ms\n"
                 << "7) Set combos_attempts_per_target\n"
-                << "8) Set combos_sampler_tries\n"
+                << "8) Toggle adaptive refinement\n"
+                << "9) Set atlas_dir (blank disables)\n"
+                << "v) Validate host RNG model\n"
                 << "r) Run\n"
                 << "b) Back\n> ";
             std::string c; if (!std::getline(std::cin, c)) return;
@@ -190,7 +230,35 @@ namespace sandbox {
             else if (c == "5") a.cap_trigger_top = !a.cap_trigger_top;
             else if (c == "6") { std::cout << "timeout (ms): "; std::string s; std::getline(std::cin, s); if (!s.empty()) a.run_timeout_ms = std::max(1, std::stoi(s)); }
             else if (c == "7") { std::cout << "combos_attempts_per_target: "; std::string s; std::getline(std::cin, s); if (!s.empty()) a.combos_attempts_per_target = std::max(1, std::stoi(s)); }
-            else if (c == "8") { std::cout << "combos_sampler_tries: "; std::string s; std::getline(std::cin, s); if (!s.empty()) a.combos_sampler_tries = std::max(1, std::stoi(s)); }
+            else if (c == "8") a.adaptive = !a.adaptive;
+            else if (c == "9") a.atlas_dir = prompt_path("Atlas dir: ", false, true, "").string();
+            else if (c == "v" || c == "V")
+            {
+                if (g.iso_path.empty() || g.qt_base_dir.empty() || a.savestate_path.empty()) {
+                    std::cout << "Please set ISO, Dolphin base, and savestate first.\n";
+                    continue;
+                }
+                if (!ensure_sys_from_base_or_warn(g.qt_base_dir)) continue;
+
+                simcore::ParallelPhaseScriptRunner runner(g.workers);
+                if (!runner.start(make_boot_plan(g))) {
+                    SCLOGE("Failed to boot workers.");
+                    continue;
+                }
+
+                // A neutral frame plus a few stick extremes, so traces cover different seed paths
+                simcore::RngValidationArgs v{};
+                v.savestate_path = a.savestate_path;
+                v.run_timeout_ms = a.run_timeout_ms;
+                v.inputs = { simcore::GCInputFrame{}, simcore::GCInputFrame().JStick(0, 128), simcore::GCInputFrame().JStick(255, 128),
+                             simcore::GCInputFrame().CStick(128, 0), simcore::GCInputFrame().Triggers(255, 0) };
+
+                const auto r = simcore::RunRngValidation(runner, v);
+                std::cout << r.explained << "/" << r.pairs << " RNG read pairs explained by the model\n";
+                if (r.fitted)
+                    std::printf("Reads fit mul=0x%08X add=0x%08X instead\n", r.fit.mul, r.fit.add);
+                runner.stop();
+            }
             else if (c == "r" || c == "R")
             {
                 if (g.iso_path.empty() || g.qt_base_dir.empty() || a.savestate_path.empty()) {
@@ -218,7 +286,14 @@ namespace sandbox {
                 // Display results
                 auto seed_delta_grid = RunRngSeedDeltaMap(runner, args);
 
-                if (prompt_bool("Print delta grids?"))
+                if (a.adaptive) {
+                    if (prompt_bool("Print delta maps?")) {
+                        sandbox::print_family_map(seed_delta_grid, simcore::SeedFamily::Main, 16, "Main Stick");
+                        sandbox::print_family_map(seed_delta_grid, simcore::SeedFamily::CStick, 16, "C Stick");
+                        sandbox::print_family_map(seed_delta_grid, simcore::SeedFamily::Triggers, 16, "Triggers");
+                    }
+                }
+                else if (prompt_bool("Print delta grids?"))
                 {
                     sandbox::print_family_grid(seed_delta_grid, simcore::SeedFamily::Main, a.samples_per_axis, "Main Stick");
                     sandbox::print_family_grid(seed_delta_grid, simcore::SeedFamily::CStick, a.samples_per_axis, "C Stick");
@@ -243,6 +318,8 @@ namespace sandbox {
                     for (auto s : unique_seeds.entries) {
                         SCLOGI("Found delta=%d using %s", s.delta, simcore::DescribeFrame(s.input).c_str());
                     }
+                    std::cout << unique_seeds.satisfied << "/" << unique_seeds.targets << " combo targets found with "
+                        << unique_seeds.verified_runs << " emulator runs\n";
                 }
 
                 runner.stop();
@@ -12,6 +12,7 @@ namespace sandbox {
 
     void run_rng_seed_probe_menu(AppState& g);
     void print_family_grid(const simcore::RandSeedProbeResult& r, simcore::SeedFamily fam, int N, const char* title);
+    void print_family_map(const simcore::RandSeedProbeResult& r, simcore::SeedFamily fam, int N, const char* title);
     void log_probe_summary(const simcore::RandSeedProbeResult& r);
     std::vector<std::string> to_csv_lines(const simcore::RandSeedProbeResult& r);
 
@@ -21,6 +21,8 @@
 #include "TASMoviePlayer.h"
 #include "utils.h"
 #include "MenuBattleExplorer.h"
+#include "MenuBenchmark.h"
+#include "MenuMemDiff.h"
 
 using namespace simcore;
 
@@ -46,6 +48,8 @@ static void menu_loop(AppState& g)
         std::cout << "3) TAS Movie -> BP -> Savestate (scaffold)\n";
         std::cout << "4) Battle Context\n";
         std::cout << "5) Battle Runner\n";
+        std::cout << "6) Worker throughput benchmark (VI/s)\n";
+        std::cout << "7) Diff RAM snapshots (MEM1/MEM2 dumps)\n";
         std::cout << "q) Quit\n";
         std::cout << "> ";
 
@@ -57,6 +61,8 @@ static void menu_loop(AppState& g)
         else if (choice == "3") sandbox::menu_tas_movie(g);
         else if (choice == "4") sandbox::get_battle_context(g);
         else if (choice == "5") sandbox::run_battle_explorer_menu(g);
+        else if (choice == "6") sandbox::run_vi_benchmark_menu(g);
+        else if (choice == "7") sandbox::run_mem_diff_menu(g);
         else {
             std::cout << "Unknown option.\n";
         }
@@ -1,13 +1,16 @@
 #include "TASMoviePlayer.h"
 #define NOMINMAX
 #include "utils.h"
+#include <algorithm>
 #include <cstdio>
+#include <filesystem>
 #include <iostream>
 
 #include <Runner/IPC/Wire.h>
 #include <Runner/Script/KeyRegistry.h>
 #include <Runner/Script/PhaseScriptVM.h>
 #include <Phases/FirstBattleGenerator.h>
+#include <Phases/TasMovieVariants.h>
 
 namespace sandbox {
 
@@ -23,6 +26,10 @@ namespace sandbox {
         a.base_dtm = { "D:\\SoATAS\\beginning_in_first_battle.dtm" };
         a.out_dir = { "D:\\SoATAS\\beginning_output" };
 
+        VariantArgs v{};
+        v.checkpoint_dir = { "D:\\SoATAS\\checkpoints" };
+        std::string variant_dir;
+
         for (;;) {
             std::cout << "\n--- TAS Movie -> BP -> Savestate ---\n";
             std::cout << "ISO:                 " << (g.iso_path.empty() ? "<unset>" : g.iso_path) << "\n";
@@ -33,13 +40,17 @@ namespace sandbox {
             std::cout << "RTC range (start..end): " << a.rtc_delta_lo << " .. " << a.rtc_delta_hi << "\n";
             std::cout << "VI Timeout (ms):        " << a.vi_stall_ms << "\n";
             std::cout << "Require disc ID6:    " << a.gameid << "\n";
+            std::cout << "Checkpoint dir:      " << (v.checkpoint_dir.empty() ? "<off>" : v.checkpoint_dir) << " (every " << v.checkpoint_every_vi << " VI)\n";
             std::cout << "1) Set DTM path\n"
                 "2) Set output directory\n"
                 "3) Set RTC start\n"
                 "4) Set RTC end\n"
                 "5) Set timeout (ms)\n"
                 "6) Set require ID6 (6 chars)\n"
+                "7) Set checkpoint dir (empty = off)\n"
+                "8) Set checkpoint interval (VI)\n"
                 "r) Run\n"
+                "v) Run every DTM in a folder (checkpointed, DTM path seeds)\n"
                 "b) Back\n> ";
             std::string c; if (!std::getline(std::cin, c)) return;
 
@@ -49,6 +60,41 @@ namespace sandbox {
             else if (c == "4") { std::cout << "RTC end   (UNIX seconds): "; std::string s; std::getline(std::cin, s); if (!s.empty()) a.rtc_delta_hi = std::stoul(s); }
             else if (c == "5") { std::cout << "VI Timeout (ms): "; std::string s; std::getline(std::cin, s); if (!s.empty()) a.vi_stall_ms = std::max(1u, (uint32_t)std::stoul(s)); }
             else if (c == "6") { std::cout << "ID6 (exactly 6 chars): "; std::string s; std::getline(std::cin, s); a.gameid = s.size() > 6 ? s.substr(0, 6) : s; }
+            else if (c == "7") { std::cout << "Checkpoint dir: "; std::string s; std::getline(std::cin, s); v.checkpoint_dir = s; }
+            else if (c == "8") { std::cout << "Checkpoint every (VI): "; std::string s; std::getline(std::cin, s); if (!s.empty()) v.checkpoint_every_vi = std::max(1u, (uint32_t)std::stoul(s)); }
+            else if (c == "v" || c == "V")
+            {
+                if (g.iso_path.empty() || g.qt_base_dir.empty() || a.base_dtm.empty() || a.out_dir.empty()) {
+                    std::cout << "Please set ISO, Dolphin base, DTM, and output dir first.\n";
+                    continue;
+                }
+                variant_dir = prompt_path("Variant DTM folder: ", true, false, variant_dir).string();
+                if (!ensure_sys_from_base_or_warn(g.qt_base_dir)) continue;
+
+                // The DTM path runs first and seeds the checkpoints; the folder's movies follow in name order
+                v.dtms = { a.base_dtm };
+                std::vector<std::string> found;
+                std::error_code ec;
+                for (const auto& e : std::filesystem::directory_iterator(variant_dir, ec))
+                    if (e.path().extension() == ".dtm" && !std::filesystem::equivalent(e.path(), a.base_dtm, ec)) found.push_back(e.path().string());
+                std::sort(found.begin(), found.end());
+                v.dtms.insert(v.dtms.end(), found.begin(), found.end());
+                v.out_dir = a.out_dir;
+                v.vi_stall_ms = a.vi_stall_ms;
+                v.save_on_fail = a.save_on_fail;
+
+                simcore::BootPlan boot = make_boot_plan(g);
+                simcore::ParallelPhaseScriptRunner runner(g.workers);
+                if (!runner.start(boot)) { std::cout << "Failed to start runner.\n"; continue; }
+
+                auto result = RunTasMovieVariants(runner, v);
+                for (const auto& i : result.items) {
+                    if (i.ok) SCLOGI("[tas] %s -> %s%s", i.dtm_path.c_str(), i.save_path.c_str(), i.resumed_from.empty() ? "" : " (resumed)");
+                    else SCLOGW("[tas] %s failed", i.dtm_path.c_str());
+                }
+
+                runner.stop();
+            }
             else if (c == "r" || c == "R")
             {
                 if (g.iso_path.empty() || g.qt_base_dir.empty() || a.base_dtm.empty() || a.out_dir.empty()) {
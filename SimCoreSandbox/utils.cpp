@@ -1,6 +1,7 @@
 #include <filesystem>
 #include <string>
 #include <iostream>
+#include <sstream>
 #include "Utils/EnsureSys.h"
 #include "Utils/Log.h"
 #include "Runner/Parallel/ParallelPhaseScriptRunner.h"
@@ -27,9 +28,37 @@ simcore::BootPlan make_boot_plan(const AppState& g)
     boot.boot.force_resync_from_base = true;
     boot.boot.save_config_on_success = true;
     boot.iso_path = g.iso_path;
+
+    std::stringstream ss(g.agents);
+    for (std::string item; std::getline(ss, item, ',');) {
+        simcore::AgentEndpoint ep;
+        item.erase(0, item.find_first_not_of(" \t"));
+        item.erase(item.find_last_not_of(" \t") + 1);
+        if (item.empty()) continue;
+        if (simcore::ParseEndpoint(item, ep.host, ep.port)) boot.agents.push_back(ep);
+        else SCLOGW("Ignoring malformed agent endpoint '%s' (expected host:port)", item.c_str());
+    }
+
+    boot.affinity.enabled = g.cpu_affinity;
+    boot.affinity.parent_cores = g.parent_cores;
     return boot;
 }
 
+std::shared_ptr<simcore::ResultStore> open_result_store(const AppState& g)
+{
+    const fs::path dir = g.exe_dir / ".work";
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+
+    auto store = std::make_shared<simcore::ResultStore>();
+    std::string err;
+    if (!store->open((dir / "results.scrs").string(), &err)) {
+        SCLOGW("Result cache disabled: %s", err.c_str());
+        return nullptr;
+    }
+    return store;
+}
+
 std::string trim(std::string s) {
     auto ws = [](unsigned char c) { return std::isspace(c); };
     while (!s.empty() && ws(s.front())) s.erase(s.begin());
@@ -9,6 +9,9 @@ bool ensure_sys_from_base_or_warn(const std::string& base);
 
 simcore::BootPlan make_boot_plan(const AppState& g);
 
+// Shared on-disk job-result cache (<exe_dir>/.work/results.scrs); nullptr if it cannot be opened.
+std::shared_ptr<simcore::ResultStore> open_result_store(const AppState& g);
+
 std::string trim(std::string s);
 
 std::string strip_quotes(std::string s);
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include "Core/Memory/Soa/Battle/BattleContextView.h"
+#include "Core/Memory/Soa/Battle/BattleContextCodec.h"
+#include "Core/Memory/Endian.h"
+#include "Core/Input/SoaBattle/ActionLibrary.h"
+
+using namespace soa::battle::ctx;
+
+namespace {
+
+    // A MEM1 image with a battle in it: slots 0..1 players, enemies in 4 (dead), 5 and 7 (fled in 7)
+    struct FakeBattle {
+        std::vector<uint8_t> mem = std::vector<uint8_t>(simcore::MemView::kMem1Size);
+
+        uint8_t* at(uint32_t va) { return mem.data() + (va - simcore::MemView::kMem1Base); }
+        void put_u32(uint32_t va, uint32_t v) { uint8_t* p = at(va); p[0] = uint8_t(v >> 24); p[1] = uint8_t(v >> 16); p[2] = uint8_t(v >> 8); p[3] = uint8_t(v); }
+        void put_u16(uint32_t va, uint16_t v) { uint8_t* p = at(va); p[0] = uint8_t(v >> 8); p[1] = uint8_t(v); }
+        template <class T> void put(uint32_t va, T v) { simcore::endian::fix_endianness_in_place(v); std::memcpy(at(va), &v, sizeof(T)); }
+
+        FakeBattle() {
+            const uint32_t inst_base = 0x80400000u, def_base = 0x80500000u;
+            for (int i = 0; i < 12; ++i) {
+                put_u16(addr::Registry::base(addr::battle::CombatantIdTable) + i * 2, uint16_t(0x100 + i));
+                if (i == 2 || i == 3 || i == 6 || i > 7) continue;
+
+                const uint32_t va = inst_base + i * 0x200;
+                soa::CombatantInstance c{};
+                c.Current_HP = uint32_t(100 + i);
+                c.status_flags = (i == 4) ? StatusFlags::Dead : (i == 7) ? uint32_t(StatusFlags::Fled) : 0u;
+                if (i >= 4) c.Enemy_Definition = def_base + i * 0x400;
+                put(va, c);
+                put_u32(addr::Registry::base(addr::battle::CombatantInstancesTable) + i * 4, va);
+
+                if (i >= 4) {
+                    soa::EnemyDefinition d{};
+                    d.max_HP = uint32_t(500 + i);
+                    put(def_base + i * 0x400, d);
+                }
+            }
+            put_u32(addr::Registry::base(addr::battle::BattlePhase), 4);
+            at(addr::Registry::base(addr::battle::CurrentTurn))[0] = 1;
+        }
+
+        simcore::MemView view() const { return simcore::MemView(mem.data(), mem.size()); }
+    };
+
+} // namespace
+
+TEST(BattleContextView, MaterializeMatchesExtract) {
+    FakeBattle fb;
+    BattleContext ref{};
+    ASSERT_TRUE(codec::extract_from_mem1(fb.view(), ref));
+
+    simcore::MemViewGuestMemory mem(fb.view());
+    BattleContextView v(mem);
+    BattleContext got{};
+    ASSERT_TRUE(v.materialize(got));
+
+    for (int i = 0; i < 12; ++i) {
+        SCOPED_TRACE(i);
+        const auto& a = ref.slots[i];
+        const auto& b = got.slots[i];
+        EXPECT_EQ(a.present, b.present);
+        EXPECT_EQ(a.is_alive, b.is_alive);
+        EXPECT_EQ(a.is_player, b.is_player);
+        EXPECT_EQ(a.id, b.id);
+        EXPECT_EQ(a.has_enemy_def, b.has_enemy_def);
+        EXPECT_EQ(a.instance_addr, b.instance_addr);
+        EXPECT_EQ(a.enemy_def_addr, b.enemy_def_addr);
+        EXPECT_EQ(std::memcmp(&a.instance, &b.instance, sizeof(a.instance)), 0);
+        EXPECT_EQ(std::memcmp(&a.enemy_def, &b.enemy_def, sizeof(a.enemy_def)), 0);
+    }
+    EXPECT_EQ(ref.turn_count, got.turn_count);
+    EXPECT_EQ(ref.battle_phase, got.battle_phase);
+    EXPECT_EQ(std::memcmp(&ref.state, &got.state, sizeof(ref.state)), 0);
+
+    ASSERT_NE(v.enemy_def(5), nullptr);
+    EXPECT_EQ(uint32_t(v.enemy_def(5)->max_HP), 505u);   // copy out: packed member
+    EXPECT_EQ(v.enemy_def(7), nullptr);   // fled: never resolved
+}
+
+TEST(BattleContextView, ReadsOnlyWhatIsAsked) {
+    FakeBattle fb;
+    simcore::MemViewGuestMemory mem(fb.view());
+    BattleContextView v(mem);
+
+    // Presence and liveness: table pointer + status word per slot, no struct images
+    EXPECT_TRUE(v.present(5));
+    EXPECT_TRUE(v.is_alive(5));
+    EXPECT_TRUE(v.present(4));
+    EXPECT_FALSE(v.is_alive(4));
+    EXPECT_FALSE(v.present(7));
+    EXPECT_FALSE(v.present(6));
+    EXPECT_EQ(v.reads(), 7u);   // slot 6 has no pointer, so no status read
+
+    EXPECT_TRUE(v.present(5));
+    EXPECT_EQ(v.reads(), 7u);   // cached
+
+    ASSERT_NE(v.instance(5), nullptr);
+    EXPECT_EQ(uint32_t(v.instance(5)->Current_HP), 105u);
+    EXPECT_EQ(v.reads(), 8u);
+
+    // New stop: memory changed, cache dropped
+    soa::CombatantInstance c{};
+    c.status_flags = StatusFlags::Dead;
+    fb.put(0x80400000u + 5 * 0x200, c);
+    EXPECT_TRUE(v.is_alive(5));   // still the cached value
+    v.invalidate();
+    EXPECT_EQ(v.reads(), 0u);
+    EXPECT_FALSE(v.is_alive(5));
+}
+
+TEST(BattleContextView, PlansMatchMaterializedContext) {
+    FakeBattle fb;
+    BattleContext bc{};
+    ASSERT_TRUE(codec::extract_from_mem1(fb.view(), bc));
+
+    simcore::MemViewGuestMemory mem(fb.view());
+    BattleContextView live(mem);
+    BattleContextView wrapped(bc);
+
+    using namespace soa::battle::actions;
+    TurnPlan tp{};
+    tp.fake_attack_count = 1;
+    ActionPlan a{};
+    a.macro = BattleAction::Attack;
+    a.params.target_mask = 1u << 5;
+    tp.spec = { a, a };
+
+    simcore::InputPlan p1, p2;
+    MaterializeErr e1{}, e2{};
+    ASSERT_TRUE(ActionLibrary::generateTurnPlan(live, tp, p1, e1));
+    ASSERT_TRUE(ActionLibrary::generateTurnPlan(wrapped, tp, p2, e2));
+    ASSERT_EQ(p1.size(), p2.size());
+    EXPECT_EQ(std::memcmp(p1.data(), p2.data(), p1.size() * sizeof(simcore::GCInputFrame)), 0);
+    EXPECT_EQ(wrapped.reads(), 0u);
+
+    // Only enemy presence/liveness and the turn globals were fetched
+    EXPECT_LE(live.reads(), 2u * 8 + 2);
+}
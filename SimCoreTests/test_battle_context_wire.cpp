@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include "Core/Memory/Soa/Battle/BattleContextWire.h"
+#include "Core/Memory/Soa/Battle/BattleContextCodec.h"
+
+using namespace soa::battle::ctx;
+
+static BattleContext SampleContext() {
+    BattleContext bc{};
+    for (int i = 0; i < 12; ++i) {
+        bc.slots[i].is_player = i < 4;
+        bc.slots[i].id = uint16_t(0x40 + i);
+    }
+    for (int i : { 0, 1, 4, 5, 9 }) {
+        auto& s = bc.slots[i];
+        s.instance_addr = 0x80400000u + i * 0x200;
+        s.present = 1;
+        s.is_alive = i != 5;
+        s.instance.Current_HP = 10 * i;
+        if (i >= 4) {
+            s.has_enemy_def = 1;
+            s.enemy_def_addr = 0x80500000u + i * 0x400;
+            s.enemy_def.max_HP = 100u * i;
+        }
+    }
+    bc.state.curSP = 3;
+    bc.turn_type = soa::battle::TurnType(1);
+    bc.turn_count = 3;
+    bc.battle_phase = 4;
+    return bc;
+}
+
+TEST(BattleContextWire, ViewsEncodedBlobInPlace) {
+    const BattleContext bc = SampleContext();
+    std::string blob;
+    ASSERT_TRUE(codec::encode(bc, blob));
+    ASSERT_EQ(blob.size(), sizeof(wire::BattleContextWire));
+
+    std::string err;
+    const wire::BattleContextWire* w = wire::view(blob, &err);
+    ASSERT_NE(w, nullptr) << err;
+    EXPECT_EQ(static_cast<const void*>(w), static_cast<const void*>(blob.data()));
+
+    EXPECT_EQ(w->hdr.present_mask, (1u << 0) | (1u << 1) | (1u << 4) | (1u << 5) | (1u << 9));
+    EXPECT_EQ(w->hdr.player_mask, wire::kPlayerMask);
+    EXPECT_FALSE(w->is_alive(5));
+    EXPECT_TRUE(w->has_enemy_def(9));
+    EXPECT_EQ(uint32_t(w->slots[9].enemy_def.max_HP), 900u);
+    EXPECT_EQ(w->hdr.battle_phase, 4u);
+
+    BattleContext back{};
+    ASSERT_TRUE(codec::decode(blob, back));
+    for (int i = 0; i < 12; ++i) {
+        SCOPED_TRACE(i);
+        const auto& a = bc.slots[i];
+        const auto& b = back.slots[i];
+        EXPECT_EQ(a.present, b.present);
+        EXPECT_EQ(a.is_alive, b.is_alive);
+        EXPECT_EQ(a.is_player, b.is_player);
+        EXPECT_EQ(a.id, b.id);
+        EXPECT_EQ(a.has_enemy_def, b.has_enemy_def);
+        EXPECT_EQ(a.instance_addr, b.instance_addr);
+        EXPECT_EQ(a.enemy_def_addr, b.enemy_def_addr);
+        EXPECT_EQ(std::memcmp(&a.instance, &b.instance, sizeof(a.instance)), 0);
+        EXPECT_EQ(std::memcmp(&a.enemy_def, &b.enemy_def, sizeof(a.enemy_def)), 0);
+    }
+    EXPECT_EQ(std::memcmp(&bc.state, &back.state, sizeof(bc.state)), 0);
+    EXPECT_EQ(back.turn_count, 3u);
+}
+
+TEST(BattleContextWire, RejectsBadBlobs) {
+    std::string blob;
+    codec::encode(SampleContext(), blob);
+    std::string err;
+
+    EXPECT_EQ(wire::view(std::string_view(blob).substr(0, blob.size() - 8), &err), nullptr);
+
+    std::string bad = blob;
+    reinterpret_cast<wire::BattleContextWire*>(bad.data())->hdr.version = 1;
+    EXPECT_EQ(wire::view(bad, &err), nullptr);
+    EXPECT_NE(err.find("version"), std::string::npos);
+
+    bad = blob;
+    reinterpret_cast<wire::BattleContextWire*>(bad.data())->hdr.enemy_def_mask |= 1u << 2;   // player slot
+    EXPECT_EQ(wire::view(bad, &err), nullptr);
+
+    bad = blob;
+    reinterpret_cast<wire::BattleContextWire*>(bad.data())->hdr.present_mask |= 1u << 7;     // no instance
+    EXPECT_EQ(wire::view(bad, &err), nullptr);
+
+    bad = blob;
+    reinterpret_cast<wire::BattleContextWire*>(bad.data())->hdr.alive_mask |= 1u << 7;       // absent slot
+    EXPECT_EQ(wire::view(bad, &err), nullptr);
+    EXPECT_NE(err.find("alive"), std::string::npos);
+
+    bad = blob;
+    reinterpret_cast<wire::BattleContextWire*>(bad.data())->hdr.player_mask |= 1u << 4;      // enemy slot
+    EXPECT_EQ(wire::view(bad, &err), nullptr);
+    EXPECT_NE(err.find("player"), std::string::npos);
+
+    // Misaligned copy of a valid image
+    std::string shifted(blob.size() + 1, '\0');
+    std::memcpy(shifted.data() + 1, blob.data(), blob.size());
+    EXPECT_EQ(wire::view(shifted.data() + 1, blob.size(), &err), nullptr);
+    EXPECT_NE(err.find("misaligned"), std::string::npos);
+
+    BattleContext out{};
+    EXPECT_FALSE(codec::decode(std::string(16, 'x'), out));
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "Phases/Programs/BattleRunner/BattleRunnerPayload.h"
+#include "Runner/IPC/Wire.h"
+
+namespace br = phase::battle::runner;
+
+TEST(BattleRunnerPayload, ResultIdentityIgnoresResumePaths) {
+    br::EncodeSpec spec{};
+    spec.run_ms = 4000;
+
+    std::vector<uint8_t> plain, resumed, a, b;
+    ASSERT_TRUE(br::encode_payload(spec, plain));
+    spec.resume_state_path = "C:/work/turns/ab12/t1.sav";
+    spec.resume_turn = 1;
+    ASSERT_TRUE(br::encode_payload(spec, resumed));
+    ASSERT_NE(plain, resumed);
+
+    uint32_t va = 0, vb = 0;
+    ASSERT_TRUE(br::result_identity(plain, va, a));
+    ASSERT_TRUE(br::result_identity(resumed, vb, b));
+    EXPECT_EQ(va, 4u);
+    EXPECT_EQ(va, vb);
+    EXPECT_EQ(a, b);
+    EXPECT_LT(a.size(), plain.size());
+
+    // Still keyed on what the run does
+    spec.run_ms = 5000;
+    std::vector<uint8_t> longer, c;
+    ASSERT_TRUE(br::encode_payload(spec, longer));
+    ASSERT_TRUE(br::result_identity(longer, vb, c));
+    EXPECT_NE(a, c);
+}
+
+TEST(BattleRunnerPayload, SavingTurnStatesBypassesTheStore) {
+    br::EncodeSpec spec{};
+    spec.turn_state_paths = { "", "" };
+
+    std::vector<uint8_t> payload, key;
+    uint32_t v = 0;
+    ASSERT_TRUE(br::encode_payload(spec, payload));
+    EXPECT_TRUE(br::result_identity(payload, v, key));
+
+    spec.turn_state_paths[1] = "C:/work/turns/ab12/t2.sav";
+    ASSERT_TRUE(br::encode_payload(spec, payload));
+    EXPECT_FALSE(br::result_identity(payload, v, key));
+
+    payload[0] = PK_SeedProbe;
+    EXPECT_FALSE(br::result_identity(payload, v, key));
+}
+
+TEST(BattleRunnerPayload, DropTurnStatesKeepsTheRun) {
+    br::EncodeSpec spec{};
+    spec.run_ms = 4000;
+    std::vector<uint8_t> plain;
+    ASSERT_TRUE(br::encode_payload(spec, plain));
+
+    spec.resume_state_path = "C:/work/turns/ab12/t1.sav";
+    spec.resume_turn = 1;
+    spec.turn_state_paths = { "", "", "C:/work/turns/ab12/t2.sav" };
+    std::vector<uint8_t> reuse, stripped;
+    ASSERT_TRUE(br::encode_payload(spec, reuse));
+    ASSERT_TRUE(br::drop_turn_states(reuse, stripped));
+    EXPECT_EQ(stripped, plain);
+
+    PSContext ctx;
+    EXPECT_TRUE(br::decode_payload(stripped, ctx));
+}
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include "Core/Branching/BranchExecutor.h"
+
+using namespace simcore;
+
+static GCInputFrame btn(uint16_t b) { GCInputFrame f{}; f.buttons = b; return f; }
+
+// Emulator stand-in: the state is a hash of every input stepped so far.
+struct FakeHost : IBranchHost {
+    struct State { uint32_t frame = 0; uint64_t h = 1469598103934665603ull; };
+    State cur;
+    std::vector<State> slots;
+
+    bool save_slot(size_t slot) override {
+        if (slot >= slots.size()) slots.resize(slot + 1);
+        slots[slot] = cur;
+        return true;
+    }
+    bool load_slot(size_t slot) override {
+        if (slot >= slots.size()) return false;
+        cur = slots[slot];
+        return true;
+    }
+    bool step(const GCInputFrame& f) override {
+        cur.h = (cur.h ^ (uint64_t(f.buttons) << 8 | f.main_x)) * 1099511628211ull;
+        ++cur.frame;
+        return true;
+    }
+};
+
+static BranchSpec make_spec() {
+    BranchSpec spec;
+    spec.total_frames = 100;
+    spec.decisions = {
+        DecisionPoint{ 10, { btn(GC_A), btn(GC_B), btn(GC_X) } },
+        DecisionPoint{ 40, { btn(GC_START) } },
+        DecisionPoint{ 60, { btn(GC_L_BTN), btn(GC_R_BTN) } },
+        DecisionPoint{ 90, { btn(GC_Z), btn(GC_Y) } },
+    };
+    return spec;
+}
+
+TEST(BranchExecutor, MatchesFullReplays) {
+    const BranchSpec spec = make_spec();
+
+    // Reference: replay every materialized plan from frame 0
+    std::vector<uint64_t> expected;
+    std::vector<BranchTreeExecutor::Path> expected_paths;
+    BranchExplorer ex(spec);
+    while (auto inst = ex.next()) {
+        FakeHost h;
+        for (const auto& f : inst->plan) h.step(f);
+        expected.push_back(h.cur.h);
+        expected_paths.push_back(inst->chosen);
+    }
+
+    FakeHost host;
+    std::vector<uint64_t> got;
+    std::vector<BranchTreeExecutor::Path> paths;
+    BranchTreeExecutor exec(spec);
+    const auto stats = exec.run(host, [&](const BranchTreeExecutor::Path& p) {
+        EXPECT_EQ(host.cur.frame, spec.total_frames);
+        got.push_back(host.cur.h);
+        paths.push_back(p);
+        return true;
+        });
+
+    EXPECT_EQ(got, expected);
+    EXPECT_EQ(paths, expected_paths);
+    EXPECT_FALSE(stats.stopped);
+    EXPECT_EQ(stats.leaves, 12u);
+    EXPECT_EQ(stats.naive_frames, 1200u);
+    // 10 + 3 * 50 + 6 * 30 + 12 * 10
+    EXPECT_EQ(stats.frames_stepped, 460u);
+    EXPECT_EQ(stats.snapshots_saved, 1u + 3u + 6u);   // the single-option decision is stepped through
+    EXPECT_EQ(stats.snapshots_loaded, 2u + 3u + 6u);
+}
+
+TEST(BranchExecutor, PrunesAndStops) {
+    const BranchSpec spec = make_spec();
+    FakeHost host;
+    BranchTreeExecutor exec(spec);
+
+    // Skip everything under option B at frame 10
+    size_t leaves = 0;
+    auto stats = exec.run(host, [&](const BranchTreeExecutor::Path&) { ++leaves; return true; },
+        [](uint32_t frame, const BranchTreeExecutor::Path& p) { return !(frame == 40 && p.back().second == 1); });
+    EXPECT_EQ(leaves, 8u);
+    EXPECT_FALSE(stats.stopped);
+
+    stats = exec.run(host, [&](const BranchTreeExecutor::Path&) { return false; });
+    EXPECT_EQ(stats.leaves, 1u);
+    EXPECT_TRUE(stats.stopped);
+}
+
+TEST(BranchExecutor, SubtreePinsOneOption) {
+    const BranchSpec sub = BranchSubtree(make_spec(), 0, 2);
+    ASSERT_EQ(sub.decisions[0].options.size(), 1u);
+    EXPECT_EQ(sub.decisions[0].options[0].buttons, GC_X);
+
+    FakeHost host;
+    const auto stats = BranchTreeExecutor(sub).run(host, nullptr);
+    EXPECT_EQ(stats.leaves, 4u);
+}
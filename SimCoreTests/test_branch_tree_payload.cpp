@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "Phases/Programs/BranchTree/BranchTreePayload.h"
+#include "Core/Branching/BranchExecutor.h"
+#include "Runner/IPC/Wire.h"
+
+using namespace simcore;
+
+namespace {
+
+    BranchSpec two_forks() {
+        BranchSpec s{};
+        s.total_frames = 12;
+        s.decisions.push_back({ 2, { GCInputFrame().A(), GCInputFrame().B(), GCInputFrame().X() } });
+        s.decisions.push_back({ 5, { GCInputFrame().Start() } });
+        s.decisions.push_back({ 9, { GCInputFrame().JStick(0, 128), GCInputFrame().JStick(255, 128) } });
+        return s;
+    }
+
+    void put_u32(std::string& s, uint32_t v) {
+        const char b[4] = { char(v), char(v >> 8), char(v >> 16), char(v >> 24) };
+        s.append(b, sizeof(b));
+    }
+
+} // namespace
+
+TEST(BranchTreePayload, RoundTrip) {
+    branchtree::BranchTreeSpec spec{};
+    spec.spec = two_forks();
+    spec.watch_addrs = { 0x80001234u, 0x80400000u };
+    spec.step_ms = 250;
+
+    std::vector<uint8_t> payload;
+    ASSERT_TRUE(branchtree::encode_branch_tree_payload(spec, payload));
+    EXPECT_EQ(payload[0], PK_BranchTree);
+
+    PSContext ctx;
+    ASSERT_TRUE(branchtree::decode_branch_tree_payload(payload, ctx));
+    uint32_t step_ms = 0;
+    std::string blob, watch;
+    ASSERT_TRUE(ctx.get<uint32_t>(keys::core::BRANCH_STEP_MS, step_ms));
+    ASSERT_TRUE(ctx.get<std::string>(keys::core::BRANCH_SPEC, blob));
+    ASSERT_TRUE(ctx.get<std::string>(keys::core::BRANCH_WATCH, watch));
+    EXPECT_EQ(step_ms, 250u);
+    ASSERT_EQ(watch.size(), 8u);
+
+    BranchSpec back;
+    ASSERT_TRUE(branchtree::decode_branch_spec(blob, back));
+    EXPECT_EQ(back.total_frames, 12u);
+    ASSERT_EQ(back.decisions.size(), 3u);
+    EXPECT_EQ(back.decisions[2].frame_index, 9u);
+    ASSERT_EQ(back.decisions[0].options.size(), 3u);
+    EXPECT_EQ(std::memcmp(&back.decisions[0].options[1], &spec.spec.decisions[0].options[1], sizeof(GCInputFrame)), 0);
+
+    // Truncations and an invalid spec are refused
+    for (size_t cut : { payload.size() - 1, size_t(12), size_t(3) }) {
+        std::vector<uint8_t> bad(payload.begin(), payload.begin() + cut);
+        PSContext c;
+        EXPECT_FALSE(branchtree::decode_branch_tree_payload(bad, c)) << cut;
+    }
+    spec.spec.decisions[1].frame_index = 1;   // out of order
+    EXPECT_FALSE(branchtree::encode_branch_tree_payload(spec, payload));
+}
+
+TEST(BranchTreePayload, ResultLeaves) {
+    PSContext ctx;
+    std::string paths, values;
+    for (uint32_t leaf = 0; leaf < 2; ++leaf) {
+        put_u32(paths, 1); put_u32(paths, 0); put_u32(paths, leaf);
+        put_u32(values, 100 + leaf);
+    }
+    ctx[keys::core::BRANCH_PATHS] = paths;
+    ctx[keys::core::BRANCH_VALUES] = values;
+    ctx[keys::core::BRANCH_LEAVES] = uint32_t(2);
+    ctx[keys::core::BRANCH_FRAMES] = uint32_t(17);
+
+    std::vector<branchtree::BranchLeaf> leaves;
+    uint32_t frames = 0;
+    ASSERT_TRUE(branchtree::decode_branch_tree_result(ctx, 3, 1, leaves, frames));
+    EXPECT_EQ(frames, 17u);
+    ASSERT_EQ(leaves.size(), 2u);
+    EXPECT_EQ(leaves[1].options, (std::vector<uint32_t>{ 1, 0, 1 }));
+    EXPECT_EQ(leaves[1].values, (std::vector<uint32_t>{ 101 }));
+
+    // Sizes must agree with the spec the job ran
+    EXPECT_FALSE(branchtree::decode_branch_tree_result(ctx, 2, 1, leaves, frames));
+}
+
+TEST(BranchTreePayload, SubtreeShardsKeepTheRestOfTheTree) {
+    const BranchSpec s = two_forks();
+    const BranchSpec shard = BranchSubtree(s, 0, 2);
+    branchtree::BranchTreeSpec spec{};
+    spec.spec = shard;
+
+    std::vector<uint8_t> payload;
+    ASSERT_TRUE(branchtree::encode_branch_tree_payload(spec, payload));
+    PSContext ctx;
+    ASSERT_TRUE(branchtree::decode_branch_tree_payload(payload, ctx));
+    std::string blob;
+    ASSERT_TRUE(ctx.get<std::string>(keys::core::BRANCH_SPEC, blob));
+    BranchSpec back;
+    ASSERT_TRUE(branchtree::decode_branch_spec(blob, back));
+    ASSERT_EQ(back.decisions[0].options.size(), 1u);
+    EXPECT_EQ(std::memcmp(&back.decisions[0].options[0], &s.decisions[0].options[2], sizeof(GCInputFrame)), 0);
+    EXPECT_EQ(back.decisions[2].options.size(), 2u);
+}
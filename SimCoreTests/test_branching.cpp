@@ -27,3 +27,27 @@ TEST(Branching, EnumeratesCartesianProduct) {
     }
     EXPECT_EQ(count, 2u * 3u);
 }
+
+TEST(Branching, SpecFromPlanReproducesPlan) {
+    InputPlan plan(6);
+    plan[1] = btn(GC_A);
+    plan[4].JStick(0, 255);
+
+    BranchSpec spec = BranchSpecFromPlan(plan);
+    ASSERT_EQ(spec.total_frames, 6u);
+    ASSERT_EQ(spec.decisions.size(), 2u);
+    EXPECT_EQ(spec.decisions[0].frame_index, 1u);
+    EXPECT_EQ(spec.decisions[1].frame_index, 4u);
+
+    // Branch on frame 1: the recorded A press or B instead
+    spec.decisions[0].options.push_back(btn(GC_B));
+    BranchExplorer ex(spec);
+    auto a = ex.next();
+    auto b = ex.next();
+    ASSERT_TRUE(a && b);
+    EXPECT_FALSE(ex.next().has_value());
+    EXPECT_EQ(a->plan[1].buttons, GC_A);
+    EXPECT_EQ(b->plan[1].buttons, GC_B);
+    EXPECT_EQ(b->plan[4].main_x, 0);
+    EXPECT_EQ(b->plan[4].main_y, 255);
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "Utils/CpuAffinity.h"
+
+using namespace simcore::cpu;
+
+static Topology make_topo(int cores, bool smt, uint32_t eff = 0) {
+    Topology t{};
+    for (int i = 0; i < cores; ++i) {
+        PhysicalCore c{};
+        c.lps = smt ? CpuMask{ 0, 3ull << (2 * i) } : CpuMask{ 0, 1ull << i };
+        c.efficiency = eff;
+        t.cores.push_back(c);
+        t.logical += c.lps.count();
+    }
+    return t;
+}
+
+TEST(CpuAffinity, MaskRoundTrip) {
+    CpuMask m{ 1, 0x30 };
+    EXPECT_EQ(m.to_string(), "1:30");
+    CpuMask out{};
+    ASSERT_TRUE(CpuMask::parse(m.to_string(), out));
+    EXPECT_EQ(out.group, 1);
+    EXPECT_EQ(out.bits, 0x30u);
+    EXPECT_FALSE(CpuMask::parse("30", out));
+    EXPECT_FALSE(CpuMask::parse("0:xyz", out));
+}
+
+TEST(CpuAffinity, DisabledLeavesWorkersUnpinned) {
+    const auto plan = PlanPlacement(make_topo(8, true), 4, AffinityPolicy{});
+    ASSERT_EQ(plan.workers.size(), 4u);
+    for (const auto& w : plan.workers) EXPECT_FALSE(w.pinned());
+    EXPECT_TRUE(plan.parent.empty());
+}
+
+TEST(CpuAffinity, SmtSiblingsBecomeAux) {
+    const auto plan = PlanPlacement(make_topo(4, true), 2, AffinityPolicy{ true });
+    EXPECT_EQ(plan.parent.bits, 0x3u);          // core 0 for the coordinator
+    ASSERT_EQ(plan.dedicated, 2u);
+    EXPECT_EQ(plan.workers[0].emu.bits, 0x4u);
+    EXPECT_EQ(plan.workers[0].aux.bits, 0x8u);
+    EXPECT_EQ(plan.workers[1].emu.bits, 0x10u);
+    EXPECT_EQ(plan.workers[1].aux.bits, 0x20u);
+}
+
+TEST(CpuAffinity, ExcessWorkersStayUnpinned) {
+    const auto plan = PlanPlacement(make_topo(4, false), 6, AffinityPolicy{ true });
+    EXPECT_EQ(plan.dedicated, 3u);
+    EXPECT_TRUE(plan.workers[2].pinned());
+    EXPECT_EQ(plan.workers[2].aux.bits, plan.workers[2].emu.bits);  // no sibling: aux shares emu
+    EXPECT_FALSE(plan.workers[3].pinned());
+}
+
+TEST(CpuAffinity, HybridPrefersFastCores) {
+    Topology t = make_topo(4, false);
+    t.cores[2].efficiency = 1;
+    t.cores[3].efficiency = 1;
+    const auto plan = PlanPlacement(t, 2, AffinityPolicy{ true });
+    EXPECT_EQ(plan.parent.bits, 0x1u);          // slowest class, lowest index
+    EXPECT_EQ(plan.workers[0].emu.bits, 0x4u);
+    EXPECT_EQ(plan.workers[1].emu.bits, 0x8u);
+}
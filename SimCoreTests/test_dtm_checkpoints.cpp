@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "Tas/DtmCheckpoints.h"
+
+using namespace simcore::tas;
+
+// One GC pad, `polls` input records of 8 bytes each whose first byte is `fill` after `same` records.
+static DtmFile make_movie(uint64_t polls, uint64_t same, uint8_t fill, const char* author = "a") {
+    std::vector<uint8_t> img(DtmFile::kMinHeader + polls * 8, 0);
+    std::memcpy(img.data(), "DTM\x1A" "GEAE8P", 10);
+    img[DtmFile::kOffControllers] = 0x01;
+    img[DtmFile::kOffVICount] = uint8_t(polls * 2);
+    img[DtmFile::kOffInputCount] = uint8_t(polls);
+    std::strncpy((char*)img.data() + DtmFile::kOffAuthor, author, 32);
+    for (uint64_t i = 0; i < polls; ++i) img[DtmFile::kMinHeader + i * 8] = uint8_t(i < same ? i : fill);
+
+    DtmFile f;
+    EXPECT_TRUE(f.load(img.data(), img.size()));
+    return f;
+}
+
+TEST(DtmCheckpoints, PrefixHashIgnoresCountsButNotInputs) {
+    const DtmFile a = make_movie(10, 10, 0);
+    const DtmFile longer = make_movie(12, 6, 0xAA, "someone else");
+    const DtmFile diverged = make_movie(10, 4, 0xAA);
+
+    EXPECT_EQ(a.polls(), 10u);
+    EXPECT_NE(DtmPrefixHash(a, 6), 0u);
+    EXPECT_EQ(DtmPrefixHash(a, 6), DtmPrefixHash(longer, 6));
+    EXPECT_NE(DtmPrefixHash(a, 7), DtmPrefixHash(longer, 7));
+    EXPECT_EQ(DtmPrefixHash(a, 4), DtmPrefixHash(diverged, 4));
+    EXPECT_NE(DtmPrefixHash(a, 5), DtmPrefixHash(diverged, 5));
+    EXPECT_EQ(DtmPrefixHash(a, 11), 0u);
+}
+
+TEST(DtmCheckpoints, TailKeepsHeaderAndCutsInput) {
+    const DtmFile a = make_movie(10, 10, 0);
+    std::vector<uint8_t> tail;
+    ASSERT_TRUE(DtmTail(a, 4, 8, tail));
+
+    DtmFile t;
+    ASSERT_TRUE(t.load(tail.data(), tail.size()));
+    EXPECT_EQ(t.polls(), 6u);
+    EXPECT_EQ(t.info().input_count, 6u);
+    EXPECT_EQ(t.info().vi_count, 12u);
+    EXPECT_EQ(tail[DtmFile::kMinHeader], 4);
+    EXPECT_FALSE(DtmTail(a, 10, 20, tail));
+}
+
+TEST(DtmCheckpoints, PathRoundTrip) {
+    const std::string p = DtmCheckpointPath("ckpt", 0x0123456789abcdefull, 42, 84);
+    DtmCheckpoint c{};
+    ASSERT_TRUE(ParseDtmCheckpointPath(p, c));
+    EXPECT_EQ(c.prefix_hash, 0x0123456789abcdefull);
+    EXPECT_EQ(c.polls, 42u);
+    EXPECT_EQ(c.frame, 84u);
+    EXPECT_EQ(c.path, p);
+
+    EXPECT_FALSE(ParseDtmCheckpointPath("ckpt/0123456789abcdef_42_84.tmp", c));
+    EXPECT_FALSE(ParseDtmCheckpointPath("ckpt/0123456789abcdef_42_84x.sav", c));
+}
+
+TEST(DtmCheckpoints, ResumePicksDeepestMatchingPrefix) {
+    const DtmFile seed = make_movie(10, 10, 0);
+    DtmCheckpointIndex index;
+    for (uint64_t polls : { 2u, 4u, 6u, 8u, 10u })
+        index.add({ DtmPrefixHash(seed, polls), polls, polls * 2, DtmCheckpointPath("ckpt", DtmPrefixHash(seed, polls), polls, polls * 2) });
+
+    DtmCheckpoint c{};
+    ASSERT_TRUE(index.find_resume(make_movie(10, 7, 0xAA), c));
+    EXPECT_EQ(c.polls, 6u);
+    ASSERT_TRUE(index.find_resume(seed, c));
+    EXPECT_EQ(c.polls, 8u);     // the one at the very end leaves nothing to play
+    EXPECT_FALSE(index.find_resume(make_movie(10, 1, 0xAA), c));
+}
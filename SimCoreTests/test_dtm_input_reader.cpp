@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include "Tas/DtmInputReader.h"
+
+using namespace simcore;
+using namespace simcore::tas;
+
+// Pads on ports 0 and 2; poll i holds main_x = i on port 0 and A + c_x = 255 - i on port 2.
+static std::vector<uint8_t> make_image(uint64_t polls) {
+    std::vector<uint8_t> img(DtmFile::kMinHeader + polls * 16, 0);
+    std::memcpy(img.data(), "DTM\x1A" "GEAE8P", 10);
+    img[DtmFile::kOffControllers] = 0x05;
+    for (uint64_t i = 0; i < polls; ++i) {
+        uint8_t* rec = img.data() + DtmFile::kMinHeader + i * 16;
+        EncodeGcPadRecord(GCInputFrame{}.JStick(uint8_t(i), 128), rec);
+        EncodeGcPadRecord(GCInputFrame::new_btns(GC_A).CStick(uint8_t(255 - i), 128), rec + 8);
+    }
+    return img;
+}
+
+TEST(DtmInputReader, RecordRoundTrip) {
+    GCInputFrame f = GCInputFrame::new_btns(GC_START, GC_DR, GC_L_BTN).JStick(10, 20).CStick(30, 40).Triggers(50, 60);
+    uint8_t rec[8]{};
+    EncodeGcPadRecord(f, rec);
+    EXPECT_EQ(rec[0], 0x01);          // Start
+    EXPECT_EQ(rec[1], 0x40 | 0x04 | 0x02);  // connected | L | DPadRight
+
+    const GCInputFrame g = DecodeGcPadRecord(rec);
+    EXPECT_EQ(g.buttons, f.buttons);
+    EXPECT_EQ(g.main_x, 10); EXPECT_EQ(g.main_y, 20);
+    EXPECT_EQ(g.c_x, 30); EXPECT_EQ(g.c_y, 40);
+    EXPECT_EQ(g.trig_l, 50); EXPECT_EQ(g.trig_r, 60);
+}
+
+TEST(DtmInputReader, StreamsSelectedPort) {
+    const auto img = make_image(20);
+    DtmInputReader r;
+    ASSERT_TRUE(r.attach(img.data(), img.size()));
+    EXPECT_EQ(r.polls(), 20u);
+    EXPECT_EQ(r.port(), 0);
+
+    GCInputFrame f{};
+    ASSERT_TRUE(r.next(f));
+    EXPECT_EQ(f.main_x, 0);
+    ASSERT_TRUE(r.next(f));
+    EXPECT_EQ(f.main_x, 1);
+
+    EXPECT_FALSE(r.select_port(1));
+    ASSERT_TRUE(r.select_port(2));
+    ASSERT_TRUE(r.seek(5));
+    InputPlan plan;
+    EXPECT_EQ(r.read(plan, 100), 15u);
+    ASSERT_EQ(plan.size(), 15u);
+    EXPECT_EQ(plan.front().buttons, GC_A);
+    EXPECT_EQ(plan.front().c_x, 250);
+    EXPECT_EQ(plan.back().c_x, 236);
+    EXPECT_FALSE(r.next(f));
+    EXPECT_FALSE(r.seek(21));
+}
+
+TEST(DtmInputReader, MapsFileSegment) {
+    const auto img = make_image(300);
+    const auto path = (std::filesystem::temp_directory_path() / "simcore_test_reader.dtm").string();
+    { std::ofstream o(path, std::ios::binary); o.write((const char*)img.data(), img.size()); }
+
+    InputPlan plan;
+    std::string err;
+    ASSERT_TRUE(DtmReadPlan(path, 100, 50, plan, -1, &err)) << err;
+    ASSERT_EQ(plan.size(), 50u);
+    EXPECT_EQ(plan[0].main_x, 100);
+    EXPECT_EQ(plan[49].main_x, 149);
+    EXPECT_FALSE(DtmReadPlan(path, 301, 1, plan, -1, &err));
+    EXPECT_FALSE(DtmReadPlan(path, 0, 1, plan, 3, &err));
+
+    std::filesystem::remove(path);
+}
+
+TEST(DtmInputReader, RejectsWiiMovies) {
+    auto img = make_image(4);
+    img[DtmFile::kOffIsWii] = 1;
+    DtmInputReader r;
+    std::string err;
+    EXPECT_FALSE(r.attach(img.data(), img.size(), &err));
+    EXPECT_FALSE(r.is_open());
+}
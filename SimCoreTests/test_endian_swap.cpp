@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "Core/Memory/Endian.h"
+
+using namespace simcore::endian;
+
+template <class T>
+static void fill_random(T* p, size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    auto* b = reinterpret_cast<uint8_t*>(p);
+    for (size_t i = 0; i < sizeof(T) * n; ++i) b[i] = uint8_t(rng());
+}
+
+// The generated plan must agree with the reflection walk, byte for byte.
+template <class T>
+static void expect_matches_reflection(uint32_t seed) {
+    SCOPED_TRACE(typeid(T).name());
+    static_assert(has_swap_plan<T>::value);
+
+    T ref{}, fast{}, scalar{};
+    fill_random(&ref, 1, seed);
+    std::memcpy(&fast, &ref, sizeof(T));
+    std::memcpy(&scalar, &ref, sizeof(T));
+
+    fix_endianness_in_place(ref);
+    fix_endianness_fast(fast);
+    using P = swap_plan<T>;
+    apply_swap_blocks_scalar(reinterpret_cast<uint8_t*>(&scalar), P::size, P::size, 1, P::blocks.data(), P::blocks.size());
+
+    EXPECT_EQ(std::memcmp(&ref, &fast, sizeof(T)), 0);
+    EXPECT_EQ(std::memcmp(&ref, &scalar, sizeof(T)), 0);
+}
+
+TEST(EndianSwap, PlansMatchReflection) {
+    uint32_t seed = 1;
+    expect_matches_reflection<soa::Vec2>(seed++);
+    expect_matches_reflection<soa::Vec3Float>(seed++);
+    expect_matches_reflection<soa::Instruction>(seed++);
+    expect_matches_reflection<soa::InstructionSet>(seed++);
+    expect_matches_reflection<soa::Thread>(seed++);
+    expect_matches_reflection<soa::AllCombatInstances>(seed++);
+    expect_matches_reflection<soa::StatusEffectiveness>(seed++);
+    expect_matches_reflection<soa::Grid>(seed++);
+    expect_matches_reflection<soa::CombatantInstance>(seed++);
+    expect_matches_reflection<soa::PC_Data>(seed++);
+    expect_matches_reflection<soa::EnemyDefinition>(seed++);
+    expect_matches_reflection<soa::All_PC_Data>(seed++);
+    expect_matches_reflection<soa::BattleState>(seed++);
+}
+
+TEST(EndianSwap, ArrayAndStridedBatches) {
+    std::vector<soa::CombatantInstance> ref(12), fast(12);
+    fill_random(ref.data(), ref.size(), 77);
+    std::memcpy(fast.data(), ref.data(), sizeof(soa::CombatantInstance) * ref.size());
+
+    for (auto& v : ref) fix_endianness_in_place(v);
+    fix_endianness_array(fast.data(), fast.size());
+    EXPECT_EQ(std::memcmp(ref.data(), fast.data(), sizeof(soa::CombatantInstance) * ref.size()), 0);
+
+    // Structs embedded in larger records: the bytes between them must come through untouched
+    struct Rec { uint8_t tag[5]; soa::EnemyDefinition def; uint8_t tail[3]; };
+    std::vector<Rec> recs(8), orig(8);
+    fill_random(recs.data(), recs.size(), 99);
+    orig = recs;
+
+    fix_endianness_array(&recs[0].def, recs.size(), sizeof(Rec));
+    for (size_t i = 0; i < recs.size(); ++i) {
+        soa::EnemyDefinition d = orig[i].def;
+        fix_endianness_in_place(d);
+        EXPECT_EQ(std::memcmp(&d, &recs[i].def, sizeof(d)), 0);
+        EXPECT_EQ(std::memcmp(recs[i].tag, orig[i].tag, sizeof(Rec::tag)), 0);
+        EXPECT_EQ(std::memcmp(recs[i].tail, orig[i].tail, sizeof(Rec::tail)), 0);
+    }
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include "Core/Memory/MemDiff.h"
+#include "Core/Memory/Soa/SoaAddrRegistry.h"
+
+using simcore::MemView;
+
+namespace {
+
+    struct Mem1Pair {
+        std::vector<uint8_t> a = std::vector<uint8_t>(MemView::kMem1Size);
+        std::vector<uint8_t> b = std::vector<uint8_t>(MemView::kMem1Size);
+
+        Mem1Pair() {
+            for (size_t i = 0; i < a.size(); ++i) a[i] = uint8_t(i * 131 + (i >> 9));
+            b = a;
+        }
+        uint8_t* at(std::vector<uint8_t>& m, uint32_t va) { return m.data() + (va - MemView::kMem1Base); }
+        void put_u32(std::vector<uint8_t>& m, uint32_t va, uint32_t v) {
+            uint8_t* p = at(m, va); p[0] = uint8_t(v >> 24); p[1] = uint8_t(v >> 16); p[2] = uint8_t(v >> 8); p[3] = uint8_t(v);
+        }
+        std::vector<simcore::MemDiffRange> diff(const simcore::MemDiffOptions& o = {}) {
+            return simcore::DiffMemory(a.data(), b.data(), a.size(), MemView::kMem1Base, o);
+        }
+    };
+
+} // namespace
+
+TEST(MemDiff, FindsExactRangesAndMergesCloseOnes) {
+    Mem1Pair m;
+    EXPECT_TRUE(m.diff().empty());
+
+    const uint32_t base = MemView::kMem1Base;
+    m.b[0] ^= 1;                                     // first byte
+    for (int i = 60; i < 70; ++i) m.b[i] ^= 0xFF;    // straddles a block boundary
+    m.b[100] ^= 1; m.b[106] ^= 1;                    // gap of 5: merged
+    m.b[200] ^= 1; m.b[220] ^= 1;                    // gap of 19: separate
+    m.b[m.b.size() - 1] ^= 1;                        // last byte
+
+    const auto r = m.diff();
+    ASSERT_EQ(r.size(), 6u);
+    EXPECT_EQ(r[0].va, base + 0); EXPECT_EQ(r[0].len, 1u);
+    EXPECT_EQ(r[1].va, base + 60); EXPECT_EQ(r[1].len, 10u);
+    EXPECT_EQ(r[2].va, base + 100); EXPECT_EQ(r[2].len, 7u);
+    EXPECT_EQ(r[3].va, base + 200); EXPECT_EQ(r[3].len, 1u);
+    EXPECT_EQ(r[4].va, base + 220);
+    EXPECT_EQ(r[5].va, base + MemView::kMem1Size - 1);
+
+    simcore::MemDiffOptions exact{};
+    exact.merge_gap = 0;
+    EXPECT_EQ(m.diff(exact).size(), 7u);
+
+    // Size not a multiple of 64: the tail is compared too
+    const auto t = simcore::DiffMemory(m.a.data() + 1, m.b.data() + 1, 99, base + 1);
+    ASSERT_EQ(t.size(), 1u);
+    EXPECT_EQ(t[0].va, base + 60);
+}
+
+TEST(MemDiff, AnnotatesKeysAndStructFields) {
+    Mem1Pair m;
+    const uint32_t table = addr::Registry::base(addr::battle::CombatantInstancesTable);
+    const uint32_t inst = 0x80400000u, def = 0x80500000u;
+    for (auto* v : { &m.a, &m.b }) {
+        for (int i = 0; i < 12; ++i) m.put_u32(*v, table + i * 4, i == 5 ? inst : 0);
+        m.put_u32(*v, addr::Registry::base(addr::battle::MainInstancePtr), 0);
+        m.put_u32(*v, inst + uint32_t(offsetof(soa::CombatantInstance, Enemy_Definition)), def);
+    }
+
+    const uint32_t hp = inst + uint32_t(offsetof(soa::CombatantInstance, Current_HP));
+    m.put_u32(m.b, hp, 1);
+    const uint32_t drop = def + uint32_t(offsetof(soa::EnemyDefinition, items)) + 2 * sizeof(soa::ItemDrop);
+    m.at(m.b, drop)[0] ^= 0xFF;
+    m.at(m.b, addr::Registry::base(addr::battle::CurrentTurn))[0] ^= 1;
+    m.at(m.b, table + 7 * 4 + 3)[0] ^= 1;
+
+    simcore::MemDiffAnnotator ann;
+    ann.add_battle_structs(MemView(m.a.data(), m.a.size()));
+    const auto notes = ann.annotate(m.diff());
+    ASSERT_EQ(notes.size(), 4u);
+
+    // Address order: table entry, turn counter, instance, enemy definition
+    EXPECT_EQ(notes[0].key, "battle.CombatantInstancesTable+0x1F");
+    EXPECT_TRUE(notes[0].fields.empty());
+
+    EXPECT_EQ(notes[1].key, "battle.CurrentTurn");
+    EXPECT_NE(simcore::MemDiffAnnotator::format(notes[1]).find("battle.CurrentTurn"), std::string::npos);
+
+    ASSERT_EQ(notes[2].fields.size(), 1u);
+    EXPECT_EQ(notes[2].fields[0], "slot5.instance.Current_HP");
+    EXPECT_TRUE(notes[2].key.empty());
+
+    ASSERT_EQ(notes[3].fields.size(), 1u);
+    EXPECT_EQ(notes[3].fields[0].rfind("slot5.enemy_def.items[2].", 0), 0u) << notes[3].fields[0];
+}
+
+TEST(MemDiff, WholeMem1InMilliseconds) {
+    Mem1Pair m;
+    for (size_t i = 0; i < m.b.size(); i += 4096) m.b[i] ^= 1;   // one change per page
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto r = m.diff();
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    EXPECT_EQ(r.size(), MemView::kMem1Size / 4096);
+    EXPECT_LT(ms, 100);   // a few ms in release; generous for debug and sanitizer builds
+}
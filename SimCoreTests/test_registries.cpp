@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "Core/Memory/Soa/SoaAddrRegistry.h"
+#include "Runner/Breakpoints/BPRegistry.h"
+
+// Constant keys fold at compile time
+static_assert(addr::Registry::region(addr::core::RNG_SEED) == addr::Region::MEM1);
+static_assert(bp::BPRegistry::find(bp::battle::StartTurn) != nullptr);
+
+TEST(AddrRegistry, KeyIndexesTable) {
+    for (const auto& r : addr::Registry::all()) {
+        ASSERT_EQ(addr::Registry::find(r.key), &r);
+        EXPECT_EQ(addr::Registry::base(r.key), r.spec.base);
+        EXPECT_STREQ(addr::Registry::name(r.key), r.name);
+    }
+    const auto past = static_cast<addr::AddrKey>(addr::Registry::all().size());
+    EXPECT_EQ(addr::Registry::find(past), nullptr);
+    EXPECT_STREQ(addr::Registry::name(past), "");
+}
+
+TEST(BPRegistry, SharedPcResolvesToFirstRow) {
+    // StartTurn and StartAction share a PC; a scan returns StartTurn
+    EXPECT_EQ(bp::BPRegistry::pc(bp::battle::StartTurn), bp::BPRegistry::pc(bp::battle::StartAction));
+    EXPECT_EQ(bp::BPRegistry::match(bp::BPRegistry::pc(bp::battle::StartAction)), bp::battle::StartTurn);
+    EXPECT_FALSE(bp::BPRegistry::match(0x80000004u).has_value());
+    EXPECT_EQ(bp::BPRegistry::find(999), nullptr);
+}
+
+TEST(BreakpointMap, IndexesFollowEdits) {
+    BreakpointMap m = bp::BPRegistry::as_map();
+    ASSERT_NE(m.find(bp::battle::EndTurn), nullptr);
+    EXPECT_EQ(m.match(bp::BPRegistry::pc(bp::battle::EndTurn)), bp::battle::EndTurn);
+    EXPECT_EQ(m.find(7), nullptr);
+
+    // Hand edits: stale slots fall back to scanning until reindex()
+    m.addrs.push_back(BPAddr{ 7, 0x80001234u, "Extra" });
+    ASSERT_NE(m.find(7), nullptr);
+    EXPECT_EQ(m.match(0x80001234u), BPKey{ 7 });
+
+    for (auto& a : m.addrs) if (a.key == bp::battle::EndTurn) a.pc = 0x80005678u;
+    m.reindex();
+    EXPECT_EQ(m.match(0x80005678u), bp::battle::EndTurn);
+    EXPECT_FALSE(m.match(bp::BPRegistry::pc(bp::battle::EndTurn)).has_value());
+
+    // In-place edits without reindex(): the index misses the new PC and key, the scan finds them
+    for (auto& a : m.addrs) if (a.key == bp::battle::EndTurn) a.pc = 0x80009ABCu;
+    for (auto& a : m.addrs) if (a.key == 7) a.key = 8;
+    EXPECT_EQ(m.match(0x80009ABCu), bp::battle::EndTurn);
+    EXPECT_FALSE(m.match(0x80005678u).has_value());
+    ASSERT_NE(m.find(8), nullptr);
+    EXPECT_EQ(m.find(8)->pc, 0x80001234u);
+    EXPECT_EQ(m.find(7), nullptr);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <vector>
+#include "Phases/ResultColumns.h"
+
+using namespace simcore::battleexplorer;
+namespace fs = std::filesystem;
+
+namespace {
+
+    // 100 rows in groups of 16: outcome = i % 4, turn = i / 10, pred_failed = i % 7 on every 7th row
+    struct ResultFile {
+        std::string path = (fs::temp_directory_path() / "soasim_result_columns_test.sccr").string();
+
+        ResultFile() {
+            ColumnarResultWriter w;
+            EXPECT_TRUE(w.open(path, 16));
+            for (uint32_t i = 0; i < 100; ++i) {
+                ResultRow r{};
+                r.path_id = 1000 + i;
+                r.outcome = uint16_t(i % 4);
+                r.status = 3;
+                r.turn = uint16_t(i / 10);
+                if (i % 7 == 0) r.pred_failed = i % 5;
+                r.hit_pc = 0x80010000u + i;
+                r.elapsed_ms = i;
+                r.worker_id = i % 3;
+                r.path = { uint8_t(i), uint8_t(i + 1) };
+                w.append(r);
+            }
+            w.close();
+        }
+        ~ResultFile() { std::error_code ec; fs::remove(path, ec); }
+    };
+
+} // namespace
+
+TEST(ResultColumns, ScanFiltersRowsInFileOrder) {
+    ResultFile file;
+    ColumnarResultReader rd;
+    ASSERT_TRUE(rd.open(file.path));
+    EXPECT_TRUE(rd.complete());
+    EXPECT_EQ(rd.rows(), 100u);
+    EXPECT_EQ(rd.groups(), 7u);
+
+    ResultFilter f{};
+    f.outcome_mask = OutcomeBit(2);
+    f.min_turn = 3;
+    f.max_turn = 5;
+    std::vector<uint64_t> ids;
+    ASSERT_TRUE(rd.scan(f, [&](const ResultRow& r) {
+        EXPECT_EQ(r.outcome, 2u);
+        EXPECT_GE(r.turn, 3u);
+        EXPECT_LE(r.turn, 5u);
+        EXPECT_EQ(r.hit_pc, 0x80010000u + uint32_t(r.path_id - 1000));
+        ids.push_back(r.path_id);
+        return true;
+    }));
+    const std::vector<uint64_t> want = { 1030, 1034, 1038, 1042, 1046, 1050, 1054, 1058 };
+    EXPECT_EQ(ids, want);
+
+    // Early stop
+    size_t seen = 0;
+    ASSERT_TRUE(rd.scan(ResultFilter{}, [&](const ResultRow&) { return ++seen < 5; }));
+    EXPECT_EQ(seen, 5u);
+
+    ResultFilter pf{};
+    pf.pred_failed = 4u;   // rows 14, 49 and 84
+    const auto agg = rd.aggregate(pf, ResultGroupBy::Turn);
+    EXPECT_EQ(agg.rows_matched, 3u);
+    EXPECT_EQ(agg.elapsed_ms_sum, 14u + 49u + 84u);
+    EXPECT_EQ(agg.counts.size(), 3u);
+    EXPECT_EQ(agg.counts.at(8), 1u);
+}
+
+TEST(ResultColumns, ScanReadsOnlyRequestedColumns) {
+    ResultFile file;
+    ColumnarResultReader rd;
+    ASSERT_TRUE(rd.open(file.path));
+
+    // Only path ids: one u64 column, nothing else
+    uint64_t before = rd.bytes_read();
+    ASSERT_TRUE(rd.scan(ResultFilter{}, [&](const ResultRow& r) {
+        EXPECT_EQ(r.outcome, 0u);
+        EXPECT_EQ(r.hit_pc, 0u);
+        EXPECT_EQ(r.pred_failed, cols::NO_PRED);
+        EXPECT_TRUE(r.path.empty());
+        return true;
+    }, cols::bit(cols::PathId)));
+    EXPECT_EQ(rd.bytes_read() - before, 100u * 8);
+
+    // The filter column is read for every group, requested ones only where a row matched
+    ResultFilter f{};
+    f.hit_pc = 0x80010000u + 40;
+    before = rd.bytes_read();
+    ASSERT_TRUE(rd.scan(f, [&](const ResultRow& r) {
+        EXPECT_EQ(r.path_id, 1040u);
+        EXPECT_EQ(r.hit_pc, 0x80010000u + 40);
+        EXPECT_EQ(r.worker_id, 0u);
+        return true;
+    }, cols::bit(cols::PathId)));
+    EXPECT_EQ(rd.bytes_read() - before, 100u * 4 + 16u * 8);
+
+    // The path blob only when asked for
+    std::vector<uint8_t> path;
+    f.hit_pc = 0x80010000u + 3;
+    ASSERT_TRUE(rd.scan(f, [&](const ResultRow& r) { path = r.path; return true; }, cols::ALL));
+    EXPECT_EQ(path, (std::vector<uint8_t>{ 3, 4 }));
+
+    // Aggregates read the grouping column and elapsed time only
+    before = rd.bytes_read();
+    const auto agg = rd.aggregate(ResultFilter{}, ResultGroupBy::Outcome);
+    EXPECT_EQ(agg.rows_matched, 100u);
+    EXPECT_EQ(agg.counts.at(3), 25u);
+    EXPECT_EQ(rd.bytes_read() - before, 100u * (2 + 4));
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include "Phases/SeedDeltaAtlas.h"
+
+using namespace simcore;
+namespace fs = std::filesystem;
+
+static SeedAtlasSample sample(uint8_t mx, uint8_t my, uint32_t seed) {
+    SeedAtlasSample s{};
+    s.input.main_x = mx; s.input.main_y = my;
+    s.seed = seed;
+    return s;
+}
+
+TEST(SeedDeltaAtlas, ImageLookupsByFrameAndDelta) {
+    const std::vector<SeedAtlasSample> in{
+        sample(0x80, 0x80, 1000), sample(0x30, 0x30, 1003), sample(0xCF, 0x30, 997),
+        sample(0x30, 0xCF, 1003), sample(0x30, 0x30, 1004) };  // last duplicate wins
+
+    std::vector<uint8_t> img;
+    BuildSeedAtlasImage(0x1234, true, 1000, in, img);
+
+    SeedDeltaAtlas a;
+    std::string err;
+    ASSERT_TRUE(a.attach(img.data(), img.size(), 0x1234, &err)) << err;
+    EXPECT_EQ(a.size(), 4u);
+    EXPECT_TRUE(a.has_base());
+
+    uint32_t seed = 0;
+    ASSERT_TRUE(a.find(in[1].input, seed));
+    EXPECT_EQ(seed, 1004u);
+    GCInputFrame miss{}; miss.c_x = 1;
+    EXPECT_FALSE(a.find(miss, seed));
+
+    EXPECT_EQ(a.deltas(), (std::vector<int32_t>{ -3, 0, 3, 4 }));
+    const auto f3 = a.frames_for_delta(3);
+    ASSERT_EQ(f3.size(), 1u);
+    EXPECT_EQ(f3[0].main_y, 0xCF);
+    EXPECT_FALSE(a.has_delta(5));
+}
+
+TEST(SeedDeltaAtlas, RejectsOtherKeyAndCorruption) {
+    std::vector<uint8_t> img;
+    BuildSeedAtlasImage(7, false, 0, { sample(1, 2, 3) }, img);
+
+    SeedDeltaAtlas a;
+    EXPECT_FALSE(a.attach(img.data(), img.size(), 8));
+    EXPECT_TRUE(a.attach(img.data(), img.size(), 7));
+    EXPECT_TRUE(a.deltas().empty());  // no base, no delta index
+
+    img.back() ^= 0xFF;
+    EXPECT_FALSE(a.attach(img.data(), img.size(), 7));
+}
+
+TEST(SeedDeltaAtlas, SaveMergedRoundTripsThroughMapping) {
+    const fs::path dir = fs::temp_directory_path() / "soasim_seed_atlas_test";
+    fs::remove_all(dir);
+    const std::string path = SeedAtlasPath(dir.string(), 0xABCDEF);
+
+    SeedDeltaAtlas a;
+    std::string err;
+    ASSERT_TRUE(a.save_merged(path, 0xABCDEF, true, 50, { sample(0x80, 0x80, 50), sample(1, 1, 52) }, &err)) << err;
+    ASSERT_TRUE(a.save_merged(path, 0xABCDEF, false, 0, { sample(2, 2, 49) }, &err)) << err;
+    a.close();
+
+    SeedDeltaAtlas b;
+    ASSERT_TRUE(b.open(path, 0xABCDEF, &err)) << err;
+    EXPECT_EQ(b.size(), 3u);
+    EXPECT_EQ(b.base_seed(), 50u);
+    EXPECT_EQ(b.deltas(), (std::vector<int32_t>{ -1, 0, 2 }));
+    b.close();
+    fs::remove_all(dir);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include "Phases/SeedDeltaRefiner.h"
+
+using namespace simcore;
+
+static SeedRegionMap refine_all(SeedDeltaRefiner& r, const std::function<bool(int, int, int32_t&)>& f) {
+    while (!r.done()) {
+        for (const auto& p : r.pending()) {
+            int32_t d = 0;
+            const bool ok = f(p.x, p.y, d);
+            r.record(p.x, p.y, ok, d);
+        }
+        r.refine();
+    }
+    return r.build_map();
+}
+
+TEST(SeedDeltaRefiner, RecoversPiecewiseMapWithFewSamples) {
+    auto f = [](int x, int y, int32_t& d) {
+        d = (x >= 100 ? 1 : 0) + (y >= 37 ? 2 : 0) + (x + y >= 300 ? 4 : 0);
+        return true;
+    };
+    SeedDeltaRefiner r(0, 255, 5);
+    const auto m = refine_all(r, f);
+
+    ASSERT_EQ(m.side(), 256);
+    for (int y = 0; y < 256; ++y)
+        for (int x = 0; x < 256; ++x) {
+            int32_t want = 0, got = -1;
+            f(x, y, want);
+            ASSERT_TRUE(m.at(x, y, got)) << x << "," << y;
+            ASSERT_EQ(got, want) << x << "," << y;
+        }
+    EXPECT_LT(m.samples, 256u * 256u / 8u);
+    EXPECT_FALSE(m.regions.empty());
+}
+
+TEST(SeedDeltaRefiner, UniformRangeStaysCoarse) {
+    SeedDeltaRefiner r(0x30, 0xCF, 4);
+    const auto m = refine_all(r, [](int, int, int32_t& d) { d = 7; return true; });
+    EXPECT_EQ(m.samples, 16u);
+    EXPECT_EQ(m.regions.size(), 9u);
+    int32_t d = 0;
+    EXPECT_TRUE(m.at(0x80, 0x80, d));
+    EXPECT_EQ(d, 7);
+    EXPECT_FALSE(m.at(0x20, 0x80, d));
+}
+
+TEST(SeedDeltaRefiner, FailedSamplesAreTheirOwnRegion) {
+    SeedDeltaRefiner r(0, 63, 3);
+    const auto m = refine_all(r, [](int x, int, int32_t& d) { d = 1; return x < 20; });
+    int32_t d = 0;
+    EXPECT_TRUE(m.at(19, 5, d));
+    EXPECT_FALSE(m.at(20, 5, d));
+    for (const auto& reg : m.regions)
+        if (!reg.uniform) { EXPECT_LE(reg.x1 - reg.x0, 1); }
+}
+
+TEST(SeedDeltaRefiner, FailedCornersAreSplit) {
+    // Only an island inside a cell whose corners all fail reaches the seed read
+    auto f = [](int x, int y, int32_t& d) { d = 5; return x >= 10 && x <= 12 && y >= 10 && y <= 12; };
+    SeedDeltaRefiner r(0, 31, 2);
+    const auto m = refine_all(r, f);
+    EXPECT_EQ(m.samples, 32u * 32u);
+    int32_t d = 0;
+    EXPECT_TRUE(m.at(11, 11, d));
+    EXPECT_EQ(d, 5);
+    EXPECT_FALSE(m.at(9, 11, d));
+    for (const auto& reg : m.regions)
+        if (reg.uniform) { EXPECT_TRUE(reg.ok); }
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "Phases/SeedDeltaSolver.h"
+
+using namespace simcore;
+
+static void add(RandSeedProbeResult& g, SeedFamily f, uint8_t x, uint8_t y, long long d) {
+    RandSeedProbeEntry e{};
+    e.family = f; e.x = x; e.y = y; e.delta = d; e.ok = true;
+    g.entries.push_back(e);
+}
+
+TEST(SeedDeltaSolver, CoversEveryReachableSum) {
+    RandSeedProbeResult g{};
+    add(g, SeedFamily::Main, 0x00, 0x00, 0);
+    add(g, SeedFamily::Main, 0x80, 0x00, 1);
+    add(g, SeedFamily::Main, 0xFF, 0xFF, 2);
+    add(g, SeedFamily::CStick, 0x80, 0x00, 3);
+    add(g, SeedFamily::Triggers, 0xFF, 0x00, 10);
+    add(g, SeedFamily::Triggers, 0x00, 0xFF, -1);
+
+    const auto plan = PlanSeedDeltaCombos(g, 4);
+    std::vector<int32_t> targets;
+    for (const auto& t : plan.targets) targets.push_back(t.target);
+    // {0,1,2} + {0,3} + {0,10,-1}, minus the singletons {0,1,2,3,10,-1}
+    EXPECT_EQ(targets, (std::vector<int32_t>{ 4, 5, 11, 12, 13, 14, 15 }));
+
+    for (const auto& t : plan.targets) {
+        ASSERT_FALSE(t.candidates.empty());
+        for (const auto& c : t.candidates) EXPECT_EQ(c.jd + c.cd + c.td, t.target);
+    }
+}
+
+TEST(SeedDeltaSolver, PrefersFewerComponents) {
+    RandSeedProbeResult g{};
+    add(g, SeedFamily::Main, 0x80, 0x00, 1);
+    add(g, SeedFamily::Main, 0xFF, 0xFF, 2);
+    add(g, SeedFamily::CStick, 0x80, 0x00, 3);
+    add(g, SeedFamily::Triggers, 0x00, 0xFF, -1);
+
+    const auto plan = PlanSeedDeltaCombos(g, 4);
+    auto it = std::find_if(plan.targets.begin(), plan.targets.end(), [](const SeedComboTarget& t) { return t.target == 4; });
+    ASSERT_NE(it, plan.targets.end());
+    EXPECT_EQ(it->delta_triples, 2u);  // 1+3+0 and 2+3-1
+    EXPECT_EQ(it->candidates.front().td, 0);
+    EXPECT_EQ(it->candidates.front().input.trig_r, 0);  // zero component stays neutral
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "Phases/Programs/SeedProbe/SeedSweepPayload.h"
+#include "Runner/IPC/Wire.h"
+
+using namespace simcore;
+
+TEST(SeedSweepPayload, RoundTrip) {
+    seedprobe::SweepSpec spec{};
+    for (uint8_t i = 0; i < 5; ++i) { GCInputFrame f{}; f.main_x = uint8_t(0x10 * i); f.trig_r = i; spec.frames.push_back(f); }
+    spec.run_ms = 1234;
+
+    std::vector<uint8_t> payload;
+    ASSERT_TRUE(seedprobe::encode_sweep_payload(spec, payload));
+    EXPECT_EQ(payload[0], PK_SeedSweep);
+
+    PSContext ctx;
+    ASSERT_TRUE(seedprobe::decode_sweep_payload(payload, ctx));
+    uint32_t count = 0, run_ms = 0;
+    std::string frames;
+    ASSERT_TRUE(ctx.get<uint32_t>(keys::seed::SWEEP_COUNT, count));
+    ASSERT_TRUE(ctx.get<std::string>(keys::seed::SWEEP_INPUTS, frames));
+    ASSERT_TRUE(ctx.get<uint32_t>(keys::core::RUN_MS, run_ms));
+    EXPECT_EQ(count, 5u);
+    EXPECT_EQ(run_ms, 1234u);
+    ASSERT_EQ(frames.size(), 5 * sizeof(GCInputFrame));
+    GCInputFrame f3{};
+    std::memcpy(&f3, frames.data() + 3 * sizeof(GCInputFrame), sizeof(f3));
+    EXPECT_EQ(f3.main_x, 0x30);
+    EXPECT_EQ(f3.trig_r, 3);
+
+    payload.pop_back();  // truncated frame array
+    PSContext bad;
+    EXPECT_FALSE(seedprobe::decode_sweep_payload(payload, bad));
+}
+
+TEST(SeedSweepPayload, ResultArrays) {
+    PSContext ctx;
+    const char seeds[8] = { 0x78, 0x56, 0x34, 0x12, 0, 0, 0, 0 };
+    const char status[8] = { 0, 0, 0, 0, 1, 0, 0, 0 };
+    ctx[keys::seed::SWEEP_SEEDS] = std::string(seeds, 8);
+    ctx[keys::seed::SWEEP_STATUS] = std::string(status, 8);
+
+    std::vector<seedprobe::SweepSample> out;
+    ASSERT_TRUE(seedprobe::decode_sweep_result(ctx, 2, out));
+    EXPECT_EQ(out[0].seed, 0x12345678u);
+    EXPECT_TRUE(out[0].ok());
+    EXPECT_FALSE(out[1].ok());
+    EXPECT_FALSE(seedprobe::decode_sweep_result(ctx, 3, out));
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include "Utils/SharedUserBase.h"
+
+using namespace simcore;
+namespace fs = std::filesystem;
+
+static void write_file(const fs::path& p, const char* s) {
+    fs::create_directories(p.parent_path());
+    std::ofstream(p, std::ios::binary) << s;
+}
+
+TEST(SharedUserBase, LinksSharedAndCopiesPrivate) {
+    const fs::path root = fs::temp_directory_path() / "soasim_userbase_test";
+    fs::remove_all(root);
+    write_file(root / "Qt" / "User" / "Config" / "Dolphin.ini", "[Core]\n");
+    write_file(root / "Qt" / "User" / "Load" / "Textures" / "a.png", "png");
+    write_file(root / "Qt" / "User" / "Maps" / "GAME01.map", "map");
+    write_file(root / "Qt" / "User" / "Wii" / "shared2" / "sys" / "SYSCONF", "nand");
+
+    fs::path snap;
+    std::string err;
+    ASSERT_TRUE(PrepareUserBaseSnapshot(root / "Qt" / "User", root / "base", snap, &err)) << err;
+
+    fs::path again;
+    ASSERT_TRUE(PrepareUserBaseSnapshot(root / "Qt" / "User", root / "base", again, &err)) << err;
+    EXPECT_EQ(snap, again);
+
+    UserLinkStats st{};
+    const fs::path user = root / "runner-0" / "User";
+    ASSERT_TRUE(LinkUserDirFromSnapshot(snap, user, false, &st, &err)) << err;
+    EXPECT_EQ(st.files_copied, 2u + st.link_fallbacks);
+    EXPECT_EQ(st.files_linked + st.link_fallbacks, 2u);
+    EXPECT_FALSE(fs::equivalent(snap / "Config" / "Dolphin.ini", user / "Config" / "Dolphin.ini"));
+
+    // Files outside the shared dirs are private: writing one leaves the snapshot alone
+    EXPECT_FALSE(fs::equivalent(snap / "Maps" / "GAME01.map", user / "Maps" / "GAME01.map"));
+    write_file(user / "Maps" / "GAME01.map", "edited");
+    std::string snap_map;
+    std::getline(std::ifstream(snap / "Maps" / "GAME01.map"), snap_map);
+    EXPECT_EQ(snap_map, "map");
+
+    ASSERT_TRUE(LinkUserDirFromSnapshot(snap, user, false, &st, &err)) << err;
+    EXPECT_TRUE(st.reused);
+
+    // An edited base gets a new snapshot
+    write_file(root / "Qt" / "User" / "Load" / "Textures" / "b.png", "png2");
+    ASSERT_TRUE(PrepareUserBaseSnapshot(root / "Qt" / "User", root / "base", again, &err)) << err;
+    EXPECT_NE(snap, again);
+
+    fs::remove_all(root);
+}
+
+TEST(SharedUserBase, SharedPaths) {
+    EXPECT_FALSE(IsSharedUserPath("Config/Dolphin.ini"));
+    EXPECT_FALSE(IsSharedUserPath("gc/MemoryCardA.USA.raw"));
+    EXPECT_FALSE(IsSharedUserPath("portable.txt"));
+    EXPECT_TRUE(IsSharedUserPath("GameSettings/GAME01.ini"));
+    EXPECT_TRUE(IsSharedUserPath("Wii/shared2/sys/SYSCONF"));
+    EXPECT_FALSE(IsSharedUserPath("Maps/GAME01.map"));
+    EXPECT_FALSE(IsSharedUserPath("Load"));
+    EXPECT_TRUE(IsSharedUserPath("Load/Textures/a.png"));
+    EXPECT_TRUE(IsSharedUserPath("resourcepacks/pack.zip"));
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "Core/Memory/Soa/SoaRng.h"
+
+using namespace soa::rng;
+
+TEST(SoaRng, MatchesMslRandSequence) {
+    // srand(1); rand() x3 with the MSL constants
+    Rng r(1);
+    EXPECT_EQ(r.next(), 16838u);
+    EXPECT_EQ(r.next(), 5758u);
+    EXPECT_EQ(r.next(), 10113u);
+    EXPECT_EQ(r.consumed(), 3u);
+}
+
+TEST(SoaRng, JumpEqualsRepeatedSteps) {
+    uint32_t s = 0xDEADBEEF;
+    for (uint64_t k = 0; k < 300; ++k) {
+        ASSERT_EQ(Advance(kMslRand, 0xDEADBEEF, k), s) << k;
+        s = Step(kMslRand, s);
+    }
+    Rng a(42), b(42);
+    a.skip(1000);
+    for (int i = 0; i < 1000; ++i) b.next();
+    EXPECT_EQ(a.state(), b.state());
+    EXPECT_EQ(a.peek(), b.next());
+}
+
+TEST(SoaRng, StepsBetweenAndDistance) {
+    const uint32_t s0 = 7;
+    const std::vector<uint32_t> seq{ s0, Advance(kMslRand, s0, 3), Advance(kMslRand, s0, 3), Advance(kMslRand, s0, 40), 12345678u };
+    const auto steps = StepsBetween(kMslRand, seq, 64);
+    EXPECT_EQ(steps, (std::vector<int64_t>{ 3, 0, 37, -1 }));
+}
+
+TEST(SoaRng, FitRecoversConstants) {
+    const Lcg g{ 0x41C64E6Du, 0x3039u, 16, 0x7FFF };
+    std::vector<uint32_t> states{ 0x1234 };
+    for (int i = 0; i < 6; ++i) states.push_back(Step(g, states.back()));
+
+    Lcg fit{};
+    ASSERT_TRUE(FitLcg(states, fit));
+    EXPECT_EQ(fit, g);
+
+    const Lcg other{ 69069u, 1u, 16, 0x7FFF };
+    std::vector<uint32_t> s2{ 99 };
+    for (int i = 0; i < 6; ++i) s2.push_back(Step(other, s2.back()));
+    ASSERT_TRUE(FitLcg(s2, fit));
+    EXPECT_EQ(fit.mul, 69069u);
+    EXPECT_EQ(fit.add, 1u);
+
+    EXPECT_FALSE(FitLcg({ 1, 2, 4, 100 }, fit));
+}
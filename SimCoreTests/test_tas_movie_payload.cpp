@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "Phases/Programs/PlayTasMovie/TasMoviePayload.h"
+#include "Tas/DtmFile.h"
+#include "Runner/IPC/Wire.h"
+
+using namespace simcore;
+
+TEST(TasMoviePayload, BufferRoundTrip) {
+    tasmovie::BufferSpec spec{};
+    spec.id6 = "GEAE8P";
+    spec.rtc_delta = -7;
+    spec.save_path = "out/first_rtc-0007.sav";
+    spec.run_ms = 90000;
+    spec.vi_stall_ms = 1500;
+    spec.progress_enable = true;
+
+    std::vector<uint8_t> payload;
+    ASSERT_TRUE(tasmovie::encode_buffer_payload(spec, payload));
+    EXPECT_EQ(payload[0], PK_TasMovieBuffer);
+
+    PSContext ctx;
+    ASSERT_TRUE(tasmovie::decode_buffer_payload(payload, ctx));
+    uint32_t delta = 0, run_ms = 0, progress = 0;
+    std::string id6, save;
+    ASSERT_TRUE(ctx.get<uint32_t>(keys::tas::RTC_DELTA, delta));
+    ASSERT_TRUE(ctx.get<uint32_t>(keys::core::RUN_MS, run_ms));
+    ASSERT_TRUE(ctx.get<uint32_t>(keys::core::PROGRESS_ENABLE, progress));
+    ASSERT_TRUE(ctx.get<std::string>(keys::tas::DISC_ID6, id6));
+    ASSERT_TRUE(ctx.get<std::string>(keys::tas::SAVE_PATH, save));
+    EXPECT_EQ((int32_t)delta, -7);
+    EXPECT_EQ(run_ms, 90000u);
+    EXPECT_EQ(progress, 1u);
+    EXPECT_EQ(id6, "GEAE8P");
+    EXPECT_EQ(save, spec.save_path);
+
+    payload.pop_back();
+    PSContext bad;
+    EXPECT_FALSE(tasmovie::decode_buffer_payload(payload, bad));
+
+    spec.run_ms = 0;  // the worker cannot derive it from a movie it has not seen
+    EXPECT_FALSE(tasmovie::encode_buffer_payload(spec, payload));
+}
+
+TEST(TasMoviePayload, DtmPatchedInMemory) {
+    std::vector<uint8_t> img(tas::DtmFile::kMinHeader + 16, 0);
+    std::memcpy(img.data(), "DTM\x1A" "GEAE8P", 10);
+    img[tas::DtmFile::kOffRecordingStartTime] = 100;
+
+    tas::DtmFile f;
+    ASSERT_TRUE(f.load(img.data(), img.size()));
+    f.shift_recording_start_time(-3);
+    EXPECT_EQ(f.info().recording_start_time, 97u);
+    EXPECT_EQ(f.bytes().size(), img.size());
+    EXPECT_EQ(img[tas::DtmFile::kOffRecordingStartTime], 100);  // source untouched
+
+    img[0] = 'X';
+    EXPECT_FALSE(f.load(img.data(), img.size()));
+}
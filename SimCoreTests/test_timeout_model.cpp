@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "Runner/Parallel/TimeoutModel.h"
+#include "Runner/IPC/Wire.h"
+
+using namespace simcore;
+
+namespace {
+
+    WireRunSegment segment(RunToBpOutcome o, uint32_t elapsed, uint32_t run_ms, uint32_t run_ms_default) {
+        WireRunSegment s{};
+        s.from_bp = 1;
+        s.elapsed_ms = elapsed;
+        s.run_ms = run_ms;
+        s.run_ms_default = run_ms_default;
+        s.outcome = (uint8_t)o;
+        return s;
+    }
+
+    PSContext result(std::initializer_list<WireRunSegment> segs) {
+        std::string blob;
+        for (const auto& s : segs) blob.append(reinterpret_cast<const char*>(&s), sizeof(s));
+        PSContext ctx;
+        ctx[keys::core::RUN_SEGMENTS] = blob;
+        return ctx;
+    }
+
+} // namespace
+
+TEST(TimeoutModel, CutsCountOnlyOnceTheRetrySettlesThem) {
+    TimeoutModel m;
+    const uint8_t kind = 1;
+
+    // Two jobs cut at 3s of a 10s default budget, after a 500ms segment that hit
+    m.observe(kind, result({ segment(RunToBpOutcome::Hit, 500, 3000, 10000), segment(RunToBpOutcome::Timeout, 3000, 3000, 10000) }), 11, true);
+    m.observe(kind, result({ segment(RunToBpOutcome::Timeout, 3000, 3000, 10000) }), 22, true);
+    auto r = m.report();
+    EXPECT_EQ(r.cut_short, 2u);
+    EXPECT_EQ(r.reclaimed_ms, 0);
+
+    // Job 11's retry times out under the default budget too: the cut saved 7s
+    m.observe(kind, result({ segment(RunToBpOutcome::Hit, 500, 10000, 10000), segment(RunToBpOutcome::Timeout, 10000, 10000, 10000) }), 11, false);
+    r = m.report();
+    EXPECT_EQ(r.confirmed, 1u);
+    EXPECT_EQ(r.reclaimed_ms, 7000);
+
+    // Job 22's retry hits: the 3s cut attempt was wasted
+    m.observe(kind, result({ segment(RunToBpOutcome::Hit, 4200, 10000, 10000) }), 22, false);
+    r = m.report();
+    EXPECT_EQ(r.refuted, 1u);
+    EXPECT_EQ(r.reclaimed_ms, 4000);
+
+    // Settled once; an untracked job is never credited
+    m.observe(kind, result({ segment(RunToBpOutcome::Timeout, 10000, 10000, 10000) }), 11, false);
+    m.observe(kind, result({ segment(RunToBpOutcome::Timeout, 3000, 3000, 10000) }), 0, true);
+    r = m.report();
+    EXPECT_EQ(r.confirmed, 1u);
+    EXPECT_EQ(r.cut_short, 3u);
+    EXPECT_EQ(r.reclaimed_ms, 4000);
+}
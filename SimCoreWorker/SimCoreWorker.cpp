@@ -7,6 +7,11 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "Utils/Log.h"
 #include "Boot/Boot.h"
@@ -18,6 +23,7 @@
 #include "Phases/Programs/ProgramRegistry.h"
 #include "Runner/Parallel/ParallelPhaseScriptRunner.h"
 #include "Runner/IPC/Wire.h"
+#include "Utils/CpuAffinity.h"
 
 #include <windows.h>
 #include <Utils/ThreadName.h>
@@ -87,13 +93,91 @@ static bool read_tag(HANDLE h, uint32_t& tag) {
 
 static bool read_exact(HANDLE h, void* p, size_t n) { return read_all(h, p, n); }
 
+// One framed parent->worker message; body holds everything after the leading u32 tag
+// (MSG_JOB: WireJobHeader + payload + timeouts, MSG_SET_PROGRAM: rest of WireSetProgram + shared blob).
+struct InMsg {
+    uint32_t tag{ 0 };
+    std::vector<uint8_t> body;
+};
+
+// Job cancellation shared between the stdin reader and the main (VM) thread.
+// The mutex makes "is this job running?" and "request abort" one step, so a late
+// cancel can never abort the job that follows it. Jobs are matched on (id, epoch), and a
+// cancel is only kept while its job is still queued: ids restart after reset_job_ids(), so
+// a cancel that outlived its job would otherwise hit the next job given the same id.
+struct CancelState {
+    struct Queued { uint64_t job_id; uint32_t epoch; bool cancelled; };
+
+    std::mutex m;
+    uint64_t running_job{ 0 };    // 0 => idle (job ids start at 1)
+    uint32_t running_epoch{ 0 };
+    std::deque<Queued> queued;    // framed by the reader, not yet started (pipe order)
+};
+
+// Reads framed messages off stdin so MSG_CANCEL is seen while the main thread is inside vm.run().
+static void stdin_reader(HANDLE hIn, size_t worker_id, TSQueue<InMsg>* inbox, CancelState* cs, DolphinWrapper* host)
+{
+    set_this_thread_name_utf8((std::string("WorkerStdin-") + std::to_string(worker_id)).c_str());
+
+    for (;;) {
+        InMsg m{};
+        if (!read_tag(hIn, m.tag)) break;
+
+        if (m.tag == MSG_CANCEL) {
+            WireCancel wc{}; wc.tag = m.tag;
+            if (!read_exact(hIn, reinterpret_cast<uint8_t*>(&wc) + sizeof(wc.tag), sizeof(wc) - sizeof(wc.tag))) break;
+            std::lock_guard<std::mutex> lk(cs->m);
+            const bool running = cs->running_job == wc.job_id && cs->running_epoch == wc.epoch;
+            bool queued = false;
+            if (running) host->requestAbort();
+            else {
+                for (auto& q : cs->queued) {
+                    if (q.job_id == wc.job_id && q.epoch == wc.epoch) { q.cancelled = true; queued = true; }
+                }
+            }
+            // Neither: the job already finished and the cancel is dropped
+            SCLOGD("[Worker %zu] CANCEL job=%llu epoch=%u%s", worker_id, (unsigned long long)wc.job_id, wc.epoch,
+                running ? " (running)" : queued ? " (queued)" : " (finished)");
+            continue;
+        }
+
+        if (m.tag == MSG_SET_PROGRAM) {
+            WireSetProgram sp{};
+            const size_t fixed = sizeof(sp) - sizeof(sp.tag);
+            if (!read_exact(hIn, reinterpret_cast<uint8_t*>(&sp) + sizeof(sp.tag), fixed)) break;
+            m.body.resize(fixed + sp.shared_len);
+            std::memcpy(m.body.data(), reinterpret_cast<uint8_t*>(&sp) + sizeof(sp.tag), fixed);
+            if (sp.shared_len && !read_exact(hIn, m.body.data() + fixed, sp.shared_len)) break;
+        }
+        else if (m.tag == MSG_JOB) {
+            WireJobHeader jh{};
+            if (!read_exact(hIn, &jh, sizeof(jh))) break;
+            const size_t extra = (size_t)jh.payload_len + jh.timeouts_len;
+            m.body.resize(sizeof(jh) + extra);
+            std::memcpy(m.body.data(), &jh, sizeof(jh));
+            if (extra && !read_exact(hIn, m.body.data() + sizeof(jh), extra)) break;
+            std::lock_guard<std::mutex> lk(cs->m);
+            cs->queued.push_back({ jh.job_id, jh.epoch, false });
+        }
+        // MSG_RUN_INIT_ONCE / MSG_ACTIVATE_MAIN carry no body; unknown tags are handed to the main loop to close.
+
+        const bool unknown = m.tag != MSG_SET_PROGRAM && m.tag != MSG_JOB
+            && m.tag != MSG_RUN_INIT_ONCE && m.tag != MSG_ACTIVATE_MAIN;
+        inbox->push(std::move(m));
+        if (unknown) break;
+    }
+    inbox->close();
+}
+
 int main(int argc, char** argv)
 {
     // args:
-    // --id N --iso <path> --savestate <path> --qtbase <dir> --userdir <dir> [--log <file>]
+    // --id N --iso <path> --savestate <path> --qtbase <dir> --userdir <dir> [--userbase <dir>] [--log <file>]
+    // [--cpu-emu g:mask --cpu-aux g:mask]
     size_t worker_id = 0;
-    std::string iso, sav, qtbase, userdir, logfile; 
+    std::string iso, sav, qtbase, userdir, userbase, logfile; 
     uint32_t timeout_ms = 10000;
+    cpu::CpuMask cpu_emu, cpu_aux;
 
     for (int i = 1; i < argc; i++) {
         std::string k = argv[i];
@@ -101,6 +185,9 @@ int main(int argc, char** argv)
         else if (k == "--iso") iso = argv_next(i, argc, argv);
         else if (k == "--qtbase") qtbase = argv_next(i, argc, argv);
         else if (k == "--userdir") userdir = argv_next(i, argc, argv);
+        else if (k == "--userbase") userbase = argv_next(i, argc, argv);
+        else if (k == "--cpu-emu") cpu::CpuMask::parse(argv_next(i, argc, argv), cpu_emu);
+        else if (k == "--cpu-aux") cpu::CpuMask::parse(argv_next(i, argc, argv), cpu_aux);
     }
 
     set_this_thread_name_utf8((std::string("WorkerMain-") + std::to_string(worker_id)).c_str());
@@ -118,8 +205,16 @@ int main(int argc, char** argv)
 
     SCLOGI("[Worker %zu] Initializing", worker_id);
 
-    SCLOGD("[Worker %zu] args iso=%s sav=%s qtbase=%s userdir=%s timeout=%u",
-        worker_id, iso.c_str(), sav.c_str(), qtbase.c_str(), userdir.c_str(), timeout_ms);
+    SCLOGD("[Worker %zu] args iso=%s sav=%s qtbase=%s userdir=%s userbase=%s timeout=%u",
+        worker_id, iso.c_str(), sav.c_str(), qtbase.c_str(), userdir.c_str(), userbase.c_str(), timeout_ms);
+
+    // CPU placement: confine the process (and every Dolphin thread it starts) to our core, keep this
+    // host thread on the SMT sibling; the emulated CPU thread moves to the primary after loadGame.
+    if (!cpu_emu.empty()) {
+        std::string perr;
+        if (!cpu::PinCurrentProcess(cpu_emu | cpu_aux, &perr) || !cpu::PinCurrentThread(cpu_aux, &perr))
+            SCLOGW("[Worker %zu] CPU placement failed, running unpinned: %s", worker_id, perr.c_str());
+    }
 
     // Use inherited anonymous pipes as binary channels
     HANDLE hIn = GetStdHandle(STD_INPUT_HANDLE);
@@ -140,7 +235,8 @@ int main(int argc, char** argv)
     BootPlan boot{};
     boot.boot.user_dir = userdir;
     boot.boot.dolphin_qt_base = qtbase;
-    boot.boot.force_resync_from_base = true;
+    boot.boot.force_resync_from_base = userbase.empty();  // with a snapshot the User dir's stamp decides
+    boot.boot.user_base_snapshot = userbase;
     boot.boot.save_config_on_success = false;
     boot.iso_path = iso;
 
@@ -166,6 +262,15 @@ int main(int argc, char** argv)
     }
     SCLOGD("[Worker %zu] loadGame ok", worker_id);
 
+    if (!cpu_emu.empty()) {
+        std::string perr;
+        bool pinned = false;
+        if (!host.runOnCpuThread([&] { pinned = cpu::PinCurrentThread(cpu_emu, &perr); }) || !pinned)
+            SCLOGW("[Worker %zu] could not pin the CPU thread to %s: %s", worker_id, cpu_emu.to_string().c_str(), perr.c_str());
+        else
+            SCLOGI("[Worker %zu] CPU thread on %s, other threads on %s", worker_id, cpu_emu.to_string().c_str(), cpu_aux.to_string().c_str());
+    }
+
     host.ConfigurePortsStandardPadP1();
 
     // ----- New control-mode only -----
@@ -189,18 +294,25 @@ int main(int argc, char** argv)
     bool main_active = false;
     uint8_t active_pk;
 
+    TSQueue<InMsg> inbox;
+    CancelState cancel{};
+    std::thread reader(stdin_reader, hIn, worker_id, &inbox, &cancel, &host);
+    reader.detach();  // exits on EOF when the parent closes our stdin
+
     for (;;) {
-        uint32_t tag = 0;
-        if (!read_tag(hIn, tag)) break;
+        InMsg msg{};
+        if (!inbox.pop_wait(msg)) break;
+        const uint32_t tag = msg.tag;
 
         if (tag == MSG_SET_PROGRAM) {
             WireSetProgram sp{}; sp.tag = tag;
-            if (!read_all(hIn, reinterpret_cast<uint8_t*>(&sp) + sizeof(sp.tag),
-                sizeof(sp) - sizeof(sp.tag))) break;
+            const size_t fixed = sizeof(sp) - sizeof(sp.tag);
+            std::memcpy(reinterpret_cast<uint8_t*>(&sp) + sizeof(sp.tag), msg.body.data(), fixed);
 
             psinit.default_timeout_ms = sp.timeout_ms;
             psinit.savestate_path = sp.savestate_path;
             psinit.derived_buffer_type = (simcore::DBuf)sp.buff_kind;
+            psinit.shared_blob.assign(msg.body.begin() + fixed, msg.body.end());
 
             active_pk = sp.main_kind;
 
@@ -239,20 +351,40 @@ int main(int argc, char** argv)
             SCLOGD("[Worker %zu] ACTIVATE_MAIN ok", worker_id);
         }
         else if (tag == MSG_JOB) {
-            // Read header
+            // Header + payload were framed by the stdin reader
             WireJobHeader jh{};
-            if (!read_exact(hIn, &jh, sizeof(jh))) break;
+            std::memcpy(&jh, msg.body.data(), sizeof(jh));
 
             if (jh.tag != tag) break;
 
-            // Read payload bytes
-            std::vector<uint8_t> payload(jh.payload_len);
-            if (jh.payload_len) {
-                if (!read_all(hIn, payload.data(), payload.size())) break;
-            }
+            const auto payload_begin = msg.body.begin() + sizeof(jh);
+            std::vector<uint8_t> payload(payload_begin, payload_begin + jh.payload_len);
+            std::string budgets(payload_begin + jh.payload_len, msg.body.end());
 
             WireResult wr{}; wr.tag = MSG_RESULT; wr.job_id = jh.job_id; wr.epoch = jh.epoch; wr.err = WERR_None;
 
+            // Mark running; a cancel that arrived while the job was still queued skips it entirely.
+            bool cancelled_early = false;
+            {
+                std::lock_guard<std::mutex> lk(cancel.m);
+                host.clearAbort();
+                // The reader queued this job before handing it over, so it is at the front
+                if (!cancel.queued.empty()) {
+                    const auto q = cancel.queued.front();
+                    cancel.queued.pop_front();
+                    cancelled_early = q.cancelled && q.job_id == jh.job_id && q.epoch == jh.epoch;
+                }
+                cancel.running_job = cancelled_early ? 0 : jh.job_id;
+                cancel.running_epoch = jh.epoch;
+            }
+            if (cancelled_early) {
+                wr.ok = 0;
+                wr.err = WERR_Cancelled;
+                (void)write_all(hOut, &wr, sizeof(wr));
+                SCLOGD("[Worker %zu] JOB %llu cancelled before start", worker_id, (unsigned long long)jh.job_id);
+                continue;
+            }
+
             if (!main_active) {
                 wr.ok = 0;
                 wr.err = WERR_NoProgramLoaded;
@@ -272,6 +404,7 @@ int main(int argc, char** argv)
                 SCLOGE("[Worker %zu] payload decode failed for active program", worker_id);
                 continue;
             }
+            if (!budgets.empty()) pj.ctx[keys::core::RUN_TIMEOUT_TABLE] = std::move(budgets);
 
             auto progress_sink = [hOut, jh](uint32_t cur_frames,
                 uint32_t total_frames,
@@ -305,13 +438,22 @@ int main(int argc, char** argv)
             // --- clear sink after job ---
             host.setProgressSink(nullptr);
 
+            bool was_cancelled = false;
+            {
+                std::lock_guard<std::mutex> lk(cancel.m);
+                was_cancelled = host.abortRequested();
+                cancel.running_job = 0;
+                host.clearAbort();
+            }
+
             // Encode numeric context
             std::vector<uint8_t> blob;
             bool enc_ok = simcore::psctx::encode_numeric(R.ctx, blob);
 
             // Transport envelope
-            wr.ok = (R.ok && enc_ok) ? 1 : 0;
+            wr.ok = (R.ok && enc_ok && !was_cancelled) ? 1 : 0;
             if (!enc_ok) wr.err = WERR_EncodePayloadFail;
+            if (was_cancelled) wr.err = WERR_Cancelled;
 
             wr.ctx_len = static_cast<uint32_t>(blob.size());
 
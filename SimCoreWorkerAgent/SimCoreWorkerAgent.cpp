@@ -0,0 +1,471 @@
+// SimCoreWorkerAgent.cpp : hosts N SimCoreWorker processes for a remote ParallelPhaseScriptRunner.
+//
+// The coordinator connects over TCP (AgentWire.h). Each slot's Wire.h stream is relayed verbatim
+// between the connection and a local SimCoreWorker's stdin/stdout, so the worker cannot tell it is
+// remote. Files are fetched by content hash into --cache on first use and reused afterwards.
+// One coordinator at a time; when it goes away every slot is retired and the agent waits for the
+// next connection (the coordinator reconnects and re-opens its slots).
+// The agent has no authentication, so it listens on loopback unless started with --listen-any.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Utils/Log.h"
+#include "Utils/EnsureSys.h"
+#include "Utils/SharedUserBase.h"
+#include "Utils/ThreadName.h"
+#include "Runner/IPC/AgentWire.h"
+#include "Runner/IPC/TcpSocket.h"
+#include "Runner/Parallel/ProcessWorker.h"
+#include "Runner/Parallel/ResultStore.h"  // HashFileContents
+
+#include <windows.h>
+
+using namespace simcore;
+namespace fs = std::filesystem;
+
+static fs::path exe_dir() {
+    char buf[MAX_PATH]{};
+    GetModuleFileNameA(nullptr, buf, MAX_PATH);
+    return fs::path(buf).parent_path();
+}
+
+static uint32_t parse_u32(const char* s) {
+    return s ? static_cast<uint32_t>(std::strtoul(s, nullptr, 10)) : 0u;
+}
+static const char* argv_next(int& i, int argc, char** argv) { return (i + 1 < argc) ? argv[++i] : ""; }
+
+static int64_t now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct AgentConfig {
+    uint16_t port{ AGENT_DEFAULT_PORT };
+    uint32_t slots{ 4 };
+    bool loopback_only{ true };
+    fs::path cache_dir;
+    fs::path work_dir;
+    std::string worker_exe;
+    std::string qt_base;
+    std::string user_base;   // shared User snapshot (work_dir/base) the slots link from; empty => copy
+    uint32_t heartbeat_ms{ 1000 };
+    uint32_t dead_after_ms{ 6000 };
+};
+
+// One local SimCoreWorker. `relay` forwards its stdout until the process ends.
+struct ChildSlot {
+    HANDLE in_wr{ NULL };
+    HANDLE out_rd{ NULL };
+    HANDLE proc{ NULL };
+    HANDLE thread{ NULL };
+    std::thread relay;
+    std::atomic<bool> retiring{ false };
+    uint32_t seq{ 0 };
+    bool open{ false };
+};
+
+// A file being pulled from the coordinator, chunk by chunk (one FETCH outstanding).
+struct Fetch {
+    uint64_t size{ 0 };
+    uint64_t offset{ 0 };
+    std::string ext;
+    HANDLE h{ INVALID_HANDLE_VALUE };
+    std::vector<uint32_t> waiting;  // STAGE_FILE request ids to answer
+};
+
+class Agent {
+public:
+    explicit Agent(AgentConfig cfg) : cfg_(std::move(cfg)), slots_(cfg_.slots) {}
+
+    void serve(TcpSocket conn);
+
+private:
+    bool send_frame(uint8_t tag, uint32_t slot, const void* body, uint32_t len, const void* extra = nullptr, uint32_t extra_len = 0);
+    void send_status(uint32_t slot, uint8_t state, uint32_t code, uint32_t seq);
+
+    void open_slot(uint32_t slot, const AgentOpenSlot& os);
+    void retire(ChildSlot& s);
+    void relay_loop(uint32_t slot);
+
+    fs::path cached_path(uint64_t hash, const std::string& ext) const;
+    void stage(uint32_t req, const AgentStageFile& sf);
+    void on_file_data(const uint8_t* body, uint32_t len);
+    void answer(const std::vector<uint32_t>& reqs, uint64_t hash, bool ok, const std::string& path);
+
+    AgentConfig cfg_;
+    TcpSocket conn_;
+    std::mutex send_m_;
+    std::atomic<int64_t> last_rx_ms_{ 0 };
+
+    std::vector<ChildSlot> slots_;
+    std::unordered_map<uint64_t, std::string> by_hash_;  // hash -> cached path, for OPEN_SLOT's ISO
+    std::unordered_map<uint64_t, Fetch> fetches_;
+};
+
+bool Agent::send_frame(uint8_t tag, uint32_t slot, const void* body, uint32_t len, const void* extra, uint32_t extra_len)
+{
+    AgentFrame f{};
+    f.tag = tag;
+    f.slot = slot;
+    f.len = len + extra_len;
+    std::lock_guard<std::mutex> lk(send_m_);
+    if (!conn_.send_all(&f, sizeof(f))) return false;
+    if (len && !conn_.send_all(body, len)) return false;
+    if (extra_len && !conn_.send_all(extra, extra_len)) return false;
+    return true;
+}
+
+void Agent::send_status(uint32_t slot, uint8_t state, uint32_t code, uint32_t seq)
+{
+    AgentSlotStatus st{};
+    st.state = state;
+    st.code = code;
+    st.seq = seq;
+    (void)send_frame(AG_SLOT_STATUS, slot, &st, sizeof(st));
+}
+
+void Agent::retire(ChildSlot& s)
+{
+    if (!s.open) return;
+    s.open = false;
+    s.retiring.store(true);
+
+    // Same as ProcessWorker::stop(): closing stdin makes the worker leave its loop
+    if (s.in_wr) { CloseHandle(s.in_wr); s.in_wr = NULL; }
+    if (s.proc && WaitForSingleObject(s.proc, 3000) != WAIT_OBJECT_0) TerminateProcess(s.proc, 1);
+    if (s.relay.joinable()) s.relay.join();
+    if (s.out_rd) { CloseHandle(s.out_rd); s.out_rd = NULL; }
+    if (s.thread) { CloseHandle(s.thread); s.thread = NULL; }
+    if (s.proc) { CloseHandle(s.proc); s.proc = NULL; }
+}
+
+void Agent::relay_loop(uint32_t slot)
+{
+    set_this_thread_name_utf8(("AgentRelay-" + std::to_string(slot)).c_str());
+    ChildSlot& s = slots_[slot];
+    const uint32_t seq = s.seq;
+
+    std::vector<uint8_t> buf(64 * 1024);
+    for (;;) {
+        DWORD got = 0;
+        if (!ReadFile(s.out_rd, buf.data(), (DWORD)buf.size(), &got, NULL) || got == 0) break;
+        if (!send_frame(AG_SLOT_DATA, slot, buf.data(), got)) break;
+    }
+
+    // stdout closed: the worker is gone (or going). Report it unless we retired it on purpose.
+    DWORD code = 0;
+    WaitForSingleObject(s.proc, 5000);
+    GetExitCodeProcess(s.proc, &code);
+    if (!s.retiring.load()) {
+        SCLOGW("[agent] slot %u worker exited (code=0x%08X)", slot, (unsigned)code);
+        send_status(slot, AGSLOT_Exited, code, seq);
+    }
+}
+
+void Agent::open_slot(uint32_t slot, const AgentOpenSlot& os)
+{
+    ChildSlot& s = slots_[slot];
+    retire(s);  // previous incarnation, if any; not reported
+    s.seq = os.seq;
+
+    auto it = by_hash_.find(os.iso_hash);
+    if (it == by_hash_.end()) {
+        SCLOGE("[agent] slot %u: ISO %016llx was not staged", slot, (unsigned long long)os.iso_hash);
+        send_status(slot, AGSLOT_OpenFailed, 0, os.seq);
+        return;
+    }
+
+    ProcStartParams ps{};
+    ps.worker_id = os.worker_id;
+    ps.exe_path = cfg_.worker_exe;
+    ps.iso_path = it->second;
+    ps.qt_base_dir = cfg_.qt_base;
+    ps.user_dir = (cfg_.work_dir / ("runner-" + std::to_string(os.worker_id)) / "User").string();
+    ps.user_base = cfg_.user_base;
+    ps.vm_control = true;
+
+    unsigned long pid = 0;
+    if (!SpawnWorkerProcess(ps, s.in_wr, s.out_rd, s.proc, s.thread, pid)) {
+        SCLOGE("[agent] slot %u: failed to launch %s", slot, cfg_.worker_exe.c_str());
+        send_status(slot, AGSLOT_OpenFailed, GetLastError(), os.seq);
+        return;
+    }
+    s.open = true;
+    s.retiring.store(false);
+
+    // Opened goes out before any SLOT_DATA of the new worker (the relay starts after it)
+    send_status(slot, AGSLOT_Opened, 0, os.seq);
+    s.relay = std::thread(&Agent::relay_loop, this, slot);
+    SCLOGI("[agent] slot %u -> worker %u (pid %lu)", slot, os.worker_id, pid);
+}
+
+fs::path Agent::cached_path(uint64_t hash, const std::string& ext) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx", (unsigned long long)hash);
+    return cfg_.cache_dir / (std::string(name) + ext);
+}
+
+void Agent::answer(const std::vector<uint32_t>& reqs, uint64_t hash, bool ok, const std::string& path)
+{
+    AgentFileReady fr{};
+    fr.hash = hash;
+    fr.ok = ok && path.size() < sizeof(fr.path) ? 1 : 0;
+    if (fr.ok) std::memcpy(fr.path, path.data(), path.size());
+    if (ok && !fr.ok) SCLOGE("[agent] cache path too long: %s", path.c_str());
+    for (uint32_t req : reqs) (void)send_frame(AG_FILE_READY, req, &fr, sizeof(fr));
+}
+
+void Agent::stage(uint32_t req, const AgentStageFile& sf)
+{
+    const std::string ext(sf.ext, strnlen(sf.ext, sizeof(sf.ext)));
+    if (!agent_ext_ok(ext.data(), ext.size())) {
+        SCLOGE("[agent] rejected stage of %016llx: bad extension", (unsigned long long)sf.hash);
+        answer({ req }, sf.hash, false, {});
+        return;
+    }
+    const fs::path dst = cached_path(sf.hash, ext);
+
+    std::error_code ec;
+    if (fs::exists(dst, ec) && fs::file_size(dst, ec) == sf.size) {
+        by_hash_[sf.hash] = dst.string();
+        answer({ req }, sf.hash, true, dst.string());
+        return;
+    }
+
+    auto fit = fetches_.find(sf.hash);
+    if (fit != fetches_.end()) {  // already being pulled for another slot
+        fit->second.waiting.push_back(req);
+        return;
+    }
+
+    fs::create_directories(cfg_.cache_dir, ec);
+    const std::string part = dst.string() + ".part";
+    HANDLE h = CreateFileA(part.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE) {
+        SCLOGE("[agent] cannot create %s", part.c_str());
+        answer({ req }, sf.hash, false, {});
+        return;
+    }
+
+    Fetch& f = fetches_[sf.hash];
+    f.size = sf.size;
+    f.ext = ext;
+    f.h = h;
+    f.waiting.push_back(req);
+    SCLOGI("[agent] fetching %016llx%s (%llu bytes)", (unsigned long long)sf.hash, ext.c_str(), (unsigned long long)sf.size);
+
+    AgentFetch fe{ sf.hash, 0 };
+    (void)send_frame(AG_FETCH, 0, &fe, sizeof(fe));
+}
+
+void Agent::on_file_data(const uint8_t* body, uint32_t len)
+{
+    if (len < sizeof(AgentFileData)) return;
+    AgentFileData fd{};
+    std::memcpy(&fd, body, sizeof(fd));
+    const uint8_t* data = body + sizeof(fd);
+    const uint32_t n = len - (uint32_t)sizeof(fd);
+
+    auto it = fetches_.find(fd.hash);
+    if (it == fetches_.end() || fd.offset != it->second.offset) return;
+    Fetch& f = it->second;
+    const fs::path dst = cached_path(fd.hash, f.ext);
+    const std::string part = dst.string() + ".part";
+
+    bool ok = fd.ok != 0 && (n > 0 || f.offset == f.size);
+    if (ok && n) {
+        OVERLAPPED ov{};
+        ov.Offset = (DWORD)(f.offset & 0xFFFFFFFFu);
+        ov.OffsetHigh = (DWORD)(f.offset >> 32);
+        DWORD wrote = 0;
+        ok = WriteFile(f.h, data, n, &wrote, &ov) && wrote == n;
+        f.offset += n;
+    }
+
+    if (ok && f.offset < f.size) {
+        AgentFetch fe{ fd.hash, f.offset };
+        (void)send_frame(AG_FETCH, 0, &fe, sizeof(fe));
+        return;
+    }
+
+    CloseHandle(f.h);
+    const std::vector<uint32_t> waiting = std::move(f.waiting);
+    fetches_.erase(it);
+
+    std::error_code ec;
+    if (ok && HashFileContents(part) != fd.hash) {
+        SCLOGE("[agent] %016llx: content hash mismatch after transfer", (unsigned long long)fd.hash);
+        ok = false;
+    }
+    if (ok) {
+        fs::rename(part, dst, ec);
+        ok = !ec;
+    }
+    if (!ok) {
+        fs::remove(part, ec);
+        answer(waiting, fd.hash, false, {});
+        return;
+    }
+    by_hash_[fd.hash] = dst.string();
+    SCLOGI("[agent] cached %s", dst.string().c_str());
+    answer(waiting, fd.hash, true, dst.string());
+}
+
+void Agent::serve(TcpSocket conn)
+{
+    conn_ = std::move(conn);
+    last_rx_ms_.store(now_ms());
+    SCLOGI("[agent] coordinator %s connected", conn_.peer().c_str());
+
+    AgentHello h{};
+    h.magic = AGENT_MAGIC;
+    h.version = AGENT_PROTO_VERSION;
+    h.slots = (uint16_t)cfg_.slots;
+    DWORD name_len = sizeof(h.name);
+    GetComputerNameA(h.name, &name_len);
+    if (!send_frame(AG_HELLO, 0, &h, sizeof(h))) return;
+
+    // Heartbeats both ways; a silent coordinator is treated as gone
+    std::atomic<bool> done{ false };
+    std::thread hb([this, &done] {
+        set_this_thread_name_utf8("AgentHeartbeat");
+        while (!done.load()) {
+            Sleep(cfg_.heartbeat_ms);
+            if (now_ms() - last_rx_ms_.load() > (int64_t)cfg_.dead_after_ms || !send_frame(AG_HEARTBEAT, 0, nullptr, 0)) {
+                SCLOGW("[agent] coordinator silent; dropping the connection");
+                conn_.shutdown();
+                return;
+            }
+        }
+    });
+
+    std::vector<uint8_t> body;
+    for (;;) {
+        AgentFrame f{};
+        if (!conn_.recv_all(&f, sizeof(f))) break;
+        body.resize(f.len);
+        if (f.len && !conn_.recv_all(body.data(), f.len)) break;
+        last_rx_ms_.store(now_ms());
+
+        switch (f.tag) {
+        case AG_HEARTBEAT:
+            break;
+        case AG_OPEN_SLOT:
+            if (f.slot < slots_.size() && f.len >= sizeof(AgentOpenSlot)) {
+                AgentOpenSlot os{};
+                std::memcpy(&os, body.data(), sizeof(os));
+                open_slot(f.slot, os);
+            }
+            break;
+        case AG_CLOSE_SLOT:
+            if (f.slot < slots_.size()) retire(slots_[f.slot]);
+            break;
+        case AG_SLOT_DATA:
+            if (f.slot < slots_.size() && slots_[f.slot].open) {
+                const uint8_t* p = body.data();
+                size_t n = body.size();
+                while (n) {
+                    DWORD w = 0;
+                    if (!WriteFile(slots_[f.slot].in_wr, p, (DWORD)n, &w, NULL) || w == 0) break;  // relay reports the exit
+                    p += w; n -= w;
+                }
+            }
+            break;
+        case AG_STAGE_FILE:
+            if (f.len >= sizeof(AgentStageFile)) {
+                AgentStageFile sf{};
+                std::memcpy(&sf, body.data(), sizeof(sf));
+                stage(f.slot, sf);
+            }
+            break;
+        case AG_FILE_DATA:
+            on_file_data(body.data(), f.len);
+            break;
+        default:
+            break;
+        }
+    }
+
+    SCLOGW("[agent] coordinator disconnected; retiring %zu slots", slots_.size());
+    done.store(true);
+    conn_.shutdown();
+    for (auto& s : slots_) retire(s);
+    for (auto& [hash, fe] : fetches_) {
+        CloseHandle(fe.h);
+        std::error_code ec;
+        fs::remove(cached_path(hash, fe.ext).string() + ".part", ec);
+    }
+    fetches_.clear();
+    if (hb.joinable()) hb.join();
+    conn_.close();
+}
+
+int main(int argc, char** argv)
+{
+    // args:
+    // [--port N] [--slots N] [--cache <dir>] [--work <dir>] [--worker <SimCoreWorker.exe>] [--qtbase <dir>] [--listen-any]
+    AgentConfig cfg{};
+    const fs::path base = exe_dir();
+    cfg.cache_dir = base / ".agent" / "cache";
+    cfg.work_dir = base / ".agent" / "runner";
+    cfg.worker_exe = (base / "SimCoreWorker.exe").string();
+
+    for (int i = 1; i < argc; i++) {
+        std::string k = argv[i];
+        if (k == "--port") cfg.port = (uint16_t)parse_u32(argv_next(i, argc, argv));
+        else if (k == "--slots") cfg.slots = std::max<uint32_t>(1, parse_u32(argv_next(i, argc, argv)));
+        else if (k == "--cache") cfg.cache_dir = argv_next(i, argc, argv);
+        else if (k == "--work") cfg.work_dir = argv_next(i, argc, argv);
+        else if (k == "--worker") cfg.worker_exe = argv_next(i, argc, argv);
+        else if (k == "--qtbase") cfg.qt_base = argv_next(i, argc, argv);
+        else if (k == "--loopback") cfg.loopback_only = true;    // the default; kept for old command lines
+        else if (k == "--listen-any") cfg.loopback_only = false;
+    }
+
+    set_this_thread_name_utf8("AgentMain");
+    std::error_code ec;
+    fs::create_directories(cfg.work_dir, ec);
+    auto& L = simcore::log::Logger::get();
+    L.open_file((cfg.work_dir / "agent.log").string().c_str(), /*append=*/true);
+    L.set_levels(simcore::log::Level::Info, simcore::log::Level::Debug);
+
+    // Workers expect Sys beside their exe, exactly as for local runs
+    if (!cfg.qt_base.empty() && !simcore::EnsureSysBesideExe(cfg.qt_base)) {
+        SCLOGE("[agent] EnsureSysBesideExe(%s) failed", cfg.qt_base.c_str());
+        return 1;
+    }
+    if (!cfg.qt_base.empty()) {
+        fs::path snap;
+        std::string serr;
+        if (PrepareUserBaseSnapshot(fs::path(cfg.qt_base) / "User", cfg.work_dir / "base", snap, &serr)) cfg.user_base = snap.string();
+        else SCLOGW("[agent] shared User base unavailable, slots copy the Qt base: %s", serr.c_str());
+    }
+
+    TcpSocket listener;
+    std::string err;
+    if (!listener.listen(cfg.port, cfg.loopback_only, &err)) {
+        SCLOGE("[agent] listen on port %u failed: %s", cfg.port, err.c_str());
+        return 1;
+    }
+    SCLOGI("[agent] listening on %s:%u with %u slots (cache=%s)", cfg.loopback_only ? "127.0.0.1" : "*",
+        cfg.port, cfg.slots, cfg.cache_dir.string().c_str());
+
+    Agent agent(cfg);
+    for (;;) {
+        TcpSocket conn;
+        if (!listener.accept(conn, 0)) { Sleep(100); continue; }
+        agent.serve(std::move(conn));
+    }
+}